@@ -65,6 +65,7 @@
 
 #define UP_WFE() __asm__ __volatile__ ("wfe" : : : "memory")
 #define UP_SEV() __asm__ __volatile__ ("sev" : : : "memory")
+#define UP_RELAX() __asm__ __volatile__ ("yield" : : : "memory")
 
 #ifndef __ASSEMBLY__
 
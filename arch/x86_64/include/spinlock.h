@@ -42,6 +42,10 @@
 #define SP_UNLOCKED 0  /* The Un-locked state */
 #define SP_LOCKED   1  /* The Locked state */
 
+/* Pause in spin-wait loops */
+
+#define UP_RELAX()  __asm__ __volatile__ ("pause" : : : "memory")
+
 /* Memory barriers for use with NuttX spinlock logic
  *
  * Data Memory Barrier (DMB) acts as a memory barrier. It ensures that all
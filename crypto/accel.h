@@ -0,0 +1,117 @@
+/****************************************************************************
+ * crypto/accel.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __CRYPTO_ACCEL_H
+#define __CRYPTO_ACCEL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#include <crypto/aes.h>
+#include <crypto/gmac.h>
+
+#ifdef CONFIG_CRYPTO_SW_ACCEL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* CPU crypto extensions reported by crypto_accel_caps() */
+
+#define CRYPTO_ACCEL_AES     (1 << 0) /* AES round instructions */
+#define CRYPTO_ACCEL_GHASH   (1 << 1) /* Carry-less multiply */
+#define CRYPTO_ACCEL_SHA1    (1 << 2) /* SHA-1 round instructions */
+#define CRYPTO_ACCEL_SHA256  (1 << 3) /* SHA-256 round instructions */
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: crypto_accel_caps
+ *
+ * Description:
+ *   Return the set of CRYPTO_ACCEL_* extensions usable on this CPU.  The
+ *   CPU is probed on the first call and the result is cached, so the
+ *   answer never changes once a key schedule has been built with it.
+ *
+ ****************************************************************************/
+
+unsigned int crypto_accel_caps(void);
+
+/****************************************************************************
+ * Name: aes_accel_setkey
+ *
+ * Description:
+ *   Finish an accelerated key schedule.  On entry ctx->sk holds the
+ *   (num_rounds + 1) encryption round keys in byte order; this derives
+ *   the equivalent inverse cipher round keys into ctx->sk_exp.
+ *
+ ****************************************************************************/
+
+void aes_accel_setkey(FAR AES_CTX *ctx);
+
+/****************************************************************************
+ * Name: aes_accel_encrypt_ecb / aes_accel_decrypt_ecb
+ *
+ * Description:
+ *   Encrypt or decrypt num_blocks independent 16-byte blocks with a
+ *   schedule built by aes_accel_setkey().  src and dst may alias.
+ *
+ ****************************************************************************/
+
+void aes_accel_encrypt_ecb(FAR AES_CTX *ctx, FAR const uint8_t *src,
+                           FAR uint8_t *dst, size_t num_blocks);
+void aes_accel_decrypt_ecb(FAR AES_CTX *ctx, FAR const uint8_t *src,
+                           FAR uint8_t *dst, size_t num_blocks);
+
+/****************************************************************************
+ * Name: ghash_accel_update
+ *
+ * Description:
+ *   Drop-in replacement for ghash_update_mi() using carry-less multiply.
+ *
+ ****************************************************************************/
+
+void ghash_accel_update(FAR GHASH_CTX *ctx, FAR uint8_t *x, size_t len);
+
+/****************************************************************************
+ * Name: sha1_accel_transform / sha256_accel_transform
+ *
+ * Description:
+ *   Compress num_blocks consecutive 64-byte blocks into state.
+ *
+ ****************************************************************************/
+
+void sha1_accel_transform(FAR uint32_t *state, FAR const uint8_t *data,
+                          size_t num_blocks);
+void sha256_accel_transform(FAR uint32_t *state, FAR const uint8_t *data,
+                            size_t num_blocks);
+
+#endif /* CONFIG_CRYPTO_SW_ACCEL */
+#endif /* __CRYPTO_ACCEL_H */
@@ -0,0 +1,452 @@
+/****************************************************************************
+ * crypto/accel_arm64.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+
+#include <arm_neon.h>
+
+#include "accel.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TARGET_CE          __attribute__((target("+crypto")))
+
+/* ID_AA64ISAR0_EL1 fields */
+
+#define ISAR0_AES(r)       (((r) >> 4) & 0xf)  /* 1: AES, 2: AES + PMULL */
+#define ISAR0_SHA1(r)      (((r) >> 8) & 0xf)
+#define ISAR0_SHA2(r)      (((r) >> 12) & 0xf)
+
+#define CAPS_UNKNOWN       (~0u)
+
+/* Whole-register byte shifts with the x86 pslldq/psrldq semantics, and
+ * per-lane 32-bit shifts.  These are macros because the NEON intrinsics
+ * need immediate shift counts.
+ */
+
+#define BSHL(x, n)         vextq_u8(vdupq_n_u8(0), (x), 16 - (n))
+#define BSHR(x, n)         vextq_u8((x), vdupq_n_u8(0), (n))
+#define SHL32(x, n) \
+  vreinterpretq_u8_u32(vshlq_n_u32(vreinterpretq_u32_u8(x), (n)))
+#define SHR32(x, n) \
+  vreinterpretq_u8_u32(vshrq_n_u32(vreinterpretq_u32_u8(x), (n)))
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static unsigned int g_accel_caps = CAPS_UNKNOWN;
+
+static const uint32_t g_sha1_k[4] =
+{
+  0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6,
+};
+
+static const uint32_t g_sha256_k[64] =
+{
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+  0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+  0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+  0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+  0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+  0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+  0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+  0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+  0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline uint8x16_t bswap128(uint8x16_t x)
+{
+  x = vrev64q_u8(x);
+  return vextq_u8(x, x, 8);
+}
+
+TARGET_CE static inline uint8x16_t pmull_lo(uint8x16_t a, uint8x16_t b)
+{
+  poly64_t x = (poly64_t)vgetq_lane_u64(vreinterpretq_u64_u8(a), 0);
+  poly64_t y = (poly64_t)vgetq_lane_u64(vreinterpretq_u64_u8(b), 0);
+
+  return vreinterpretq_u8_p128(vmull_p64(x, y));
+}
+
+TARGET_CE static inline uint8x16_t pmull_hi(uint8x16_t a, uint8x16_t b)
+{
+  return vreinterpretq_u8_p128(vmull_high_p64(vreinterpretq_p64_u8(a),
+                                              vreinterpretq_p64_u8(b)));
+}
+
+TARGET_CE static inline uint8x16_t pmull_cross(uint8x16_t a, uint8x16_t b)
+{
+  return veorq_u8(pmull_lo(a, vextq_u8(b, b, 8)),
+                  pmull_lo(vextq_u8(a, a, 8), b));
+}
+
+/* GF(2^128) multiply of two byte-reflected operands, reduced modulo the
+ * GCM polynomial.  Same algorithm as the x86_64 backend, written with
+ * PMULL and NEON lane shifts.
+ */
+
+TARGET_CE static uint8x16_t ghash_gfmul(uint8x16_t a, uint8x16_t b)
+{
+  uint8x16_t lo;
+  uint8x16_t mid;
+  uint8x16_t hi;
+  uint8x16_t t1;
+  uint8x16_t t2;
+  uint8x16_t t3;
+
+  lo  = pmull_lo(a, b);
+  mid = pmull_cross(a, b);
+  hi  = pmull_hi(a, b);
+  lo  = veorq_u8(lo, BSHL(mid, 8));
+  hi  = veorq_u8(hi, BSHR(mid, 8));
+
+  /* Shift the 256-bit product left by one bit */
+
+  t1  = SHR32(lo, 31);
+  t2  = SHR32(hi, 31);
+  lo  = SHL32(lo, 1);
+  hi  = SHL32(hi, 1);
+  t3  = BSHR(t1, 12);
+  t2  = BSHL(t2, 4);
+  t1  = BSHL(t1, 4);
+  lo  = vorrq_u8(lo, t1);
+  hi  = vorrq_u8(vorrq_u8(hi, t2), t3);
+
+  /* Reduce modulo x^128 + x^7 + x^2 + x + 1 */
+
+  t1  = veorq_u8(veorq_u8(SHL32(lo, 31), SHL32(lo, 30)), SHL32(lo, 25));
+  t2  = BSHR(t1, 4);
+  lo  = veorq_u8(lo, BSHL(t1, 12));
+  t3  = veorq_u8(veorq_u8(SHR32(lo, 1), SHR32(lo, 2)), SHR32(lo, 7));
+  lo  = veorq_u8(lo, veorq_u8(t3, t2));
+
+  return veorq_u8(hi, lo);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+unsigned int crypto_accel_caps(void)
+{
+  unsigned int caps = g_accel_caps;
+  uint64_t isar0;
+
+  if (caps != CAPS_UNKNOWN)
+    {
+      return caps;
+    }
+
+  caps = 0;
+  __asm__ __volatile__("mrs %0, id_aa64isar0_el1" : "=r"(isar0));
+
+  if (ISAR0_AES(isar0) >= 1)
+    {
+      caps |= CRYPTO_ACCEL_AES;
+    }
+
+  if (ISAR0_AES(isar0) >= 2)
+    {
+      caps |= CRYPTO_ACCEL_GHASH;
+    }
+
+  if (ISAR0_SHA1(isar0) >= 1)
+    {
+      caps |= CRYPTO_ACCEL_SHA1;
+    }
+
+  if (ISAR0_SHA2(isar0) >= 1)
+    {
+      caps |= CRYPTO_ACCEL_SHA256;
+    }
+
+  /* Probing is idempotent, so a racing first call stores the same value */
+
+  g_accel_caps = caps;
+  return caps;
+}
+
+TARGET_CE void aes_accel_setkey(FAR AES_CTX *ctx)
+{
+  FAR const uint8_t *ek = (FAR const uint8_t *)ctx->sk;
+  FAR uint8_t *dk = (FAR uint8_t *)ctx->sk_exp;
+  unsigned int nr = ctx->num_rounds;
+  unsigned int i;
+
+  /* Equivalent inverse cipher: reverse the round keys and apply
+   * InvMixColumns to all but the first and last.
+   */
+
+  vst1q_u8(dk, vld1q_u8(ek + 16 * nr));
+  for (i = 1; i < nr; i++)
+    {
+      vst1q_u8(dk + 16 * i, vaesimcq_u8(vld1q_u8(ek + 16 * (nr - i))));
+    }
+
+  vst1q_u8(dk + 16 * nr, vld1q_u8(ek));
+}
+
+TARGET_CE void aes_accel_encrypt_ecb(FAR AES_CTX *ctx,
+                                     FAR const uint8_t *src,
+                                     FAR uint8_t *dst, size_t num_blocks)
+{
+  FAR const uint8_t *rk = (FAR const uint8_t *)ctx->sk;
+  unsigned int nr = ctx->num_rounds;
+  unsigned int i;
+  uint8x16_t k;
+
+  /* Four independent blocks keep the AES unit pipeline busy */
+
+  for (; num_blocks >= 4; num_blocks -= 4, src += 64, dst += 64)
+    {
+      uint8x16_t b0 = vld1q_u8(src);
+      uint8x16_t b1 = vld1q_u8(src + 16);
+      uint8x16_t b2 = vld1q_u8(src + 32);
+      uint8x16_t b3 = vld1q_u8(src + 48);
+
+      for (i = 0; i < nr - 1; i++)
+        {
+          k  = vld1q_u8(rk + 16 * i);
+          b0 = vaesmcq_u8(vaeseq_u8(b0, k));
+          b1 = vaesmcq_u8(vaeseq_u8(b1, k));
+          b2 = vaesmcq_u8(vaeseq_u8(b2, k));
+          b3 = vaesmcq_u8(vaeseq_u8(b3, k));
+        }
+
+      k  = vld1q_u8(rk + 16 * (nr - 1));
+      b0 = vaeseq_u8(b0, k);
+      b1 = vaeseq_u8(b1, k);
+      b2 = vaeseq_u8(b2, k);
+      b3 = vaeseq_u8(b3, k);
+
+      k = vld1q_u8(rk + 16 * nr);
+      vst1q_u8(dst, veorq_u8(b0, k));
+      vst1q_u8(dst + 16, veorq_u8(b1, k));
+      vst1q_u8(dst + 32, veorq_u8(b2, k));
+      vst1q_u8(dst + 48, veorq_u8(b3, k));
+    }
+
+  for (; num_blocks > 0; num_blocks--, src += 16, dst += 16)
+    {
+      uint8x16_t b = vld1q_u8(src);
+
+      for (i = 0; i < nr - 1; i++)
+        {
+          b = vaesmcq_u8(vaeseq_u8(b, vld1q_u8(rk + 16 * i)));
+        }
+
+      b = vaeseq_u8(b, vld1q_u8(rk + 16 * (nr - 1)));
+      vst1q_u8(dst, veorq_u8(b, vld1q_u8(rk + 16 * nr)));
+    }
+}
+
+TARGET_CE void aes_accel_decrypt_ecb(FAR AES_CTX *ctx,
+                                     FAR const uint8_t *src,
+                                     FAR uint8_t *dst, size_t num_blocks)
+{
+  FAR const uint8_t *rk = (FAR const uint8_t *)ctx->sk_exp;
+  unsigned int nr = ctx->num_rounds;
+  unsigned int i;
+  uint8x16_t k;
+
+  for (; num_blocks >= 4; num_blocks -= 4, src += 64, dst += 64)
+    {
+      uint8x16_t b0 = vld1q_u8(src);
+      uint8x16_t b1 = vld1q_u8(src + 16);
+      uint8x16_t b2 = vld1q_u8(src + 32);
+      uint8x16_t b3 = vld1q_u8(src + 48);
+
+      for (i = 0; i < nr - 1; i++)
+        {
+          k  = vld1q_u8(rk + 16 * i);
+          b0 = vaesimcq_u8(vaesdq_u8(b0, k));
+          b1 = vaesimcq_u8(vaesdq_u8(b1, k));
+          b2 = vaesimcq_u8(vaesdq_u8(b2, k));
+          b3 = vaesimcq_u8(vaesdq_u8(b3, k));
+        }
+
+      k  = vld1q_u8(rk + 16 * (nr - 1));
+      b0 = vaesdq_u8(b0, k);
+      b1 = vaesdq_u8(b1, k);
+      b2 = vaesdq_u8(b2, k);
+      b3 = vaesdq_u8(b3, k);
+
+      k = vld1q_u8(rk + 16 * nr);
+      vst1q_u8(dst, veorq_u8(b0, k));
+      vst1q_u8(dst + 16, veorq_u8(b1, k));
+      vst1q_u8(dst + 32, veorq_u8(b2, k));
+      vst1q_u8(dst + 48, veorq_u8(b3, k));
+    }
+
+  for (; num_blocks > 0; num_blocks--, src += 16, dst += 16)
+    {
+      uint8x16_t b = vld1q_u8(src);
+
+      for (i = 0; i < nr - 1; i++)
+        {
+          b = vaesimcq_u8(vaesdq_u8(b, vld1q_u8(rk + 16 * i)));
+        }
+
+      b = vaesdq_u8(b, vld1q_u8(rk + 16 * (nr - 1)));
+      vst1q_u8(dst, veorq_u8(b, vld1q_u8(rk + 16 * nr)));
+    }
+}
+
+TARGET_CE void ghash_accel_update(FAR GHASH_CTX *ctx, FAR uint8_t *x,
+                                  size_t len)
+{
+  uint8x16_t h = bswap128(vld1q_u8(ctx->H));
+  uint8x16_t y = bswap128(vld1q_u8(ctx->Z));
+
+  for (; len >= GMAC_BLOCK_LEN; len -= GMAC_BLOCK_LEN, x += GMAC_BLOCK_LEN)
+    {
+      y = ghash_gfmul(veorq_u8(y, bswap128(vld1q_u8(x))), h);
+    }
+
+  y = bswap128(y);
+  vst1q_u8(ctx->S, y);
+  vst1q_u8(ctx->Z, y);
+}
+
+TARGET_CE void sha1_accel_transform(FAR uint32_t *state,
+                                    FAR const uint8_t *data,
+                                    size_t num_blocks)
+{
+  uint32x4_t abcd = vld1q_u32(state);
+  uint32_t e0 = state[4];
+  int g;
+
+  for (; num_blocks > 0; num_blocks--, data += 64)
+    {
+      uint32x4_t abcd_save = abcd;
+      uint32_t e = e0;
+      uint32x4_t w[4];
+
+      w[0] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data)));
+      w[1] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16)));
+      w[2] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 32)));
+      w[3] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 48)));
+
+      for (g = 0; g < 20; g++)
+        {
+          uint32x4_t wk;
+          uint32_t enext;
+
+          if (g >= 4)
+            {
+              w[g & 3] = vsha1su1q_u32(vsha1su0q_u32(w[g & 3],
+                                                     w[(g + 1) & 3],
+                                                     w[(g + 2) & 3]),
+                                       w[(g + 3) & 3]);
+            }
+
+          wk = vaddq_u32(w[g & 3], vdupq_n_u32(g_sha1_k[g / 5]));
+          enext = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+          if (g < 5)
+            {
+              abcd = vsha1cq_u32(abcd, e, wk);
+            }
+          else if (g < 10 || g >= 15)
+            {
+              abcd = vsha1pq_u32(abcd, e, wk);
+            }
+          else
+            {
+              abcd = vsha1mq_u32(abcd, e, wk);
+            }
+
+          e = enext;
+        }
+
+      abcd = vaddq_u32(abcd, abcd_save);
+      e0 += e;
+    }
+
+  vst1q_u32(state, abcd);
+  state[4] = e0;
+}
+
+TARGET_CE void sha256_accel_transform(FAR uint32_t *state,
+                                      FAR const uint8_t *data,
+                                      size_t num_blocks)
+{
+  uint32x4_t abcd = vld1q_u32(&state[0]);
+  uint32x4_t efgh = vld1q_u32(&state[4]);
+  int g;
+
+  for (; num_blocks > 0; num_blocks--, data += 64)
+    {
+      uint32x4_t abcd_save = abcd;
+      uint32x4_t efgh_save = efgh;
+      uint32x4_t w[4];
+
+      w[0] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data)));
+      w[1] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16)));
+      w[2] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 32)));
+      w[3] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 48)));
+
+      for (g = 0; g < 16; g++)
+        {
+          uint32x4_t wk;
+          uint32x4_t tmp;
+
+          if (g >= 4)
+            {
+              w[g & 3] = vsha256su1q_u32(vsha256su0q_u32(w[g & 3],
+                                                         w[(g + 1) & 3]),
+                                         w[(g + 2) & 3], w[(g + 3) & 3]);
+            }
+
+          wk = vaddq_u32(w[g & 3], vld1q_u32(&g_sha256_k[4 * g]));
+          tmp = abcd;
+          abcd = vsha256hq_u32(abcd, efgh, wk);
+          efgh = vsha256h2q_u32(efgh, tmp, wk);
+        }
+
+      abcd = vaddq_u32(abcd, abcd_save);
+      efgh = vaddq_u32(efgh, efgh_save);
+    }
+
+  vst1q_u32(&state[0], abcd);
+  vst1q_u32(&state[4], efgh);
+}
@@ -0,0 +1,484 @@
+/****************************************************************************
+ * crypto/accel_x86_64.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <immintrin.h>
+
+#include "accel.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TARGET_AES    __attribute__((target("sse4.1,aes")))
+#define TARGET_GHASH  __attribute__((target("sse4.1,pclmul")))
+#define TARGET_SHA    __attribute__((target("sse4.1,sha")))
+
+/* CPUID feature bits */
+
+#define CPUID1_ECX_PCLMUL  (1 << 1)
+#define CPUID1_ECX_SSSE3   (1 << 9)
+#define CPUID1_ECX_SSE41   (1 << 19)
+#define CPUID1_ECX_AES     (1 << 25)
+#define CPUID7_EBX_SHA     (1 << 29)
+
+#define CAPS_UNKNOWN       (~0u)
+
+/* One SHA-1 four round step (see the Intel SHA extensions paper).  The
+ * message schedule is kept in w[0..3] as a ring indexed by group number,
+ * and e alternates between the value fed to sha1rnds4 and the saved
+ * abcd of the previous group.
+ */
+
+#define SHA1_GROUP(g, f)                                                   \
+  do                                                                       \
+    {                                                                      \
+      if ((g) >= 4)                                                        \
+        {                                                                  \
+          w[(g) & 3] = _mm_sha1msg1_epu32(w[(g) & 3], w[((g) + 1) & 3]);   \
+          w[(g) & 3] = _mm_xor_si128(w[(g) & 3], w[((g) + 2) & 3]);        \
+          w[(g) & 3] = _mm_sha1msg2_epu32(w[(g) & 3], w[((g) + 3) & 3]);   \
+        }                                                                  \
+                                                                           \
+      e = (g) == 0 ? _mm_add_epi32(e, w[0]) :                              \
+                     _mm_sha1nexte_epu32(prev, w[(g) & 3]);                \
+      prev = abcd;                                                         \
+      abcd = _mm_sha1rnds4_epu32(abcd, e, f);                              \
+    }                                                                      \
+  while (0)
+
+#define SHA1_GROUP5(g, f)       \
+  do                            \
+    {                           \
+      SHA1_GROUP((g), f);       \
+      SHA1_GROUP((g) + 1, f);   \
+      SHA1_GROUP((g) + 2, f);   \
+      SHA1_GROUP((g) + 3, f);   \
+      SHA1_GROUP((g) + 4, f);   \
+    }                           \
+  while (0)
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static unsigned int g_accel_caps = CAPS_UNKNOWN;
+
+static const uint32_t g_sha256_k[64] =
+{
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
+  0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+  0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc,
+  0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7,
+  0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+  0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3,
+  0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5,
+  0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+  0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint32_t accel_cpuid(uint32_t leaf, FAR uint32_t *ebx,
+                            FAR uint32_t *ecx)
+{
+  uint32_t eax = leaf;
+  uint32_t edx;
+
+  __asm__ __volatile__("cpuid"
+                       : "+a"(eax), "=b"(*ebx), "=c"(*ecx), "=d"(edx)
+                       : "c"(0));
+  return eax;
+}
+
+/* GF(2^128) multiply of two byte-reflected operands, reduced modulo the
+ * GCM polynomial.  This is the shift-and-reduce variant from the Intel
+ * carry-less multiplication white paper.
+ */
+
+TARGET_GHASH static __m128i ghash_gfmul(__m128i a, __m128i b)
+{
+  __m128i lo;
+  __m128i mid;
+  __m128i hi;
+  __m128i t1;
+  __m128i t2;
+  __m128i t3;
+
+  lo  = _mm_clmulepi64_si128(a, b, 0x00);
+  mid = _mm_xor_si128(_mm_clmulepi64_si128(a, b, 0x10),
+                      _mm_clmulepi64_si128(a, b, 0x01));
+  hi  = _mm_clmulepi64_si128(a, b, 0x11);
+  lo  = _mm_xor_si128(lo, _mm_slli_si128(mid, 8));
+  hi  = _mm_xor_si128(hi, _mm_srli_si128(mid, 8));
+
+  /* The operands are bit-reflected, so shift the 256-bit product left
+   * by one before reducing.
+   */
+
+  t1  = _mm_srli_epi32(lo, 31);
+  t2  = _mm_srli_epi32(hi, 31);
+  lo  = _mm_slli_epi32(lo, 1);
+  hi  = _mm_slli_epi32(hi, 1);
+  t3  = _mm_srli_si128(t1, 12);
+  t2  = _mm_slli_si128(t2, 4);
+  t1  = _mm_slli_si128(t1, 4);
+  lo  = _mm_or_si128(lo, t1);
+  hi  = _mm_or_si128(hi, t2);
+  hi  = _mm_or_si128(hi, t3);
+
+  /* Reduce modulo x^128 + x^7 + x^2 + x + 1 */
+
+  t1  = _mm_xor_si128(_mm_slli_epi32(lo, 31), _mm_slli_epi32(lo, 30));
+  t1  = _mm_xor_si128(t1, _mm_slli_epi32(lo, 25));
+  t2  = _mm_srli_si128(t1, 4);
+  t1  = _mm_slli_si128(t1, 12);
+  lo  = _mm_xor_si128(lo, t1);
+  t3  = _mm_xor_si128(_mm_srli_epi32(lo, 1), _mm_srli_epi32(lo, 2));
+  t3  = _mm_xor_si128(t3, _mm_srli_epi32(lo, 7));
+  t3  = _mm_xor_si128(t3, t2);
+  lo  = _mm_xor_si128(lo, t3);
+
+  return _mm_xor_si128(hi, lo);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+unsigned int crypto_accel_caps(void)
+{
+  unsigned int caps = g_accel_caps;
+  uint32_t maxleaf;
+  uint32_t ebx;
+  uint32_t ecx;
+
+  if (caps != CAPS_UNKNOWN)
+    {
+      return caps;
+    }
+
+  caps = 0;
+  maxleaf = accel_cpuid(0, &ebx, &ecx);
+  accel_cpuid(1, &ebx, &ecx);
+  if ((ecx & CPUID1_ECX_SSE41) != 0 && (ecx & CPUID1_ECX_SSSE3) != 0)
+    {
+      if ((ecx & CPUID1_ECX_AES) != 0)
+        {
+          caps |= CRYPTO_ACCEL_AES;
+        }
+
+      if ((ecx & CPUID1_ECX_PCLMUL) != 0)
+        {
+          caps |= CRYPTO_ACCEL_GHASH;
+        }
+
+      if (maxleaf >= 7)
+        {
+          accel_cpuid(7, &ebx, &ecx);
+          if ((ebx & CPUID7_EBX_SHA) != 0)
+            {
+              caps |= CRYPTO_ACCEL_SHA1 | CRYPTO_ACCEL_SHA256;
+            }
+        }
+    }
+
+  /* Probing is idempotent, so a racing first call stores the same value */
+
+  g_accel_caps = caps;
+  return caps;
+}
+
+TARGET_AES void aes_accel_setkey(FAR AES_CTX *ctx)
+{
+  FAR __m128i *ek = (FAR __m128i *)ctx->sk;
+  FAR __m128i *dk = (FAR __m128i *)ctx->sk_exp;
+  unsigned int nr = ctx->num_rounds;
+  unsigned int i;
+
+  /* Equivalent inverse cipher: reverse the round keys and apply
+   * InvMixColumns to all but the first and last.
+   */
+
+  _mm_storeu_si128(&dk[0], _mm_loadu_si128(&ek[nr]));
+  for (i = 1; i < nr; i++)
+    {
+      _mm_storeu_si128(&dk[i],
+                       _mm_aesimc_si128(_mm_loadu_si128(&ek[nr - i])));
+    }
+
+  _mm_storeu_si128(&dk[nr], _mm_loadu_si128(&ek[0]));
+}
+
+TARGET_AES void aes_accel_encrypt_ecb(FAR AES_CTX *ctx,
+                                      FAR const uint8_t *src,
+                                      FAR uint8_t *dst, size_t num_blocks)
+{
+  FAR const __m128i *rk = (FAR const __m128i *)ctx->sk;
+  FAR const __m128i *in = (FAR const __m128i *)src;
+  FAR __m128i *out = (FAR __m128i *)dst;
+  unsigned int nr = ctx->num_rounds;
+  unsigned int i;
+  __m128i k;
+
+  /* Four independent blocks keep the AES unit pipeline busy */
+
+  for (; num_blocks >= 4; num_blocks -= 4, in += 4, out += 4)
+    {
+      __m128i b0;
+      __m128i b1;
+      __m128i b2;
+      __m128i b3;
+
+      k  = _mm_loadu_si128(&rk[0]);
+      b0 = _mm_xor_si128(_mm_loadu_si128(&in[0]), k);
+      b1 = _mm_xor_si128(_mm_loadu_si128(&in[1]), k);
+      b2 = _mm_xor_si128(_mm_loadu_si128(&in[2]), k);
+      b3 = _mm_xor_si128(_mm_loadu_si128(&in[3]), k);
+      for (i = 1; i < nr; i++)
+        {
+          k  = _mm_loadu_si128(&rk[i]);
+          b0 = _mm_aesenc_si128(b0, k);
+          b1 = _mm_aesenc_si128(b1, k);
+          b2 = _mm_aesenc_si128(b2, k);
+          b3 = _mm_aesenc_si128(b3, k);
+        }
+
+      k = _mm_loadu_si128(&rk[nr]);
+      _mm_storeu_si128(&out[0], _mm_aesenclast_si128(b0, k));
+      _mm_storeu_si128(&out[1], _mm_aesenclast_si128(b1, k));
+      _mm_storeu_si128(&out[2], _mm_aesenclast_si128(b2, k));
+      _mm_storeu_si128(&out[3], _mm_aesenclast_si128(b3, k));
+    }
+
+  for (; num_blocks > 0; num_blocks--, in++, out++)
+    {
+      __m128i b = _mm_xor_si128(_mm_loadu_si128(in),
+                                _mm_loadu_si128(&rk[0]));
+
+      for (i = 1; i < nr; i++)
+        {
+          b = _mm_aesenc_si128(b, _mm_loadu_si128(&rk[i]));
+        }
+
+      _mm_storeu_si128(out,
+                       _mm_aesenclast_si128(b, _mm_loadu_si128(&rk[nr])));
+    }
+}
+
+TARGET_AES void aes_accel_decrypt_ecb(FAR AES_CTX *ctx,
+                                      FAR const uint8_t *src,
+                                      FAR uint8_t *dst, size_t num_blocks)
+{
+  FAR const __m128i *rk = (FAR const __m128i *)ctx->sk_exp;
+  FAR const __m128i *in = (FAR const __m128i *)src;
+  FAR __m128i *out = (FAR __m128i *)dst;
+  unsigned int nr = ctx->num_rounds;
+  unsigned int i;
+  __m128i k;
+
+  for (; num_blocks >= 4; num_blocks -= 4, in += 4, out += 4)
+    {
+      __m128i b0;
+      __m128i b1;
+      __m128i b2;
+      __m128i b3;
+
+      k  = _mm_loadu_si128(&rk[0]);
+      b0 = _mm_xor_si128(_mm_loadu_si128(&in[0]), k);
+      b1 = _mm_xor_si128(_mm_loadu_si128(&in[1]), k);
+      b2 = _mm_xor_si128(_mm_loadu_si128(&in[2]), k);
+      b3 = _mm_xor_si128(_mm_loadu_si128(&in[3]), k);
+      for (i = 1; i < nr; i++)
+        {
+          k  = _mm_loadu_si128(&rk[i]);
+          b0 = _mm_aesdec_si128(b0, k);
+          b1 = _mm_aesdec_si128(b1, k);
+          b2 = _mm_aesdec_si128(b2, k);
+          b3 = _mm_aesdec_si128(b3, k);
+        }
+
+      k = _mm_loadu_si128(&rk[nr]);
+      _mm_storeu_si128(&out[0], _mm_aesdeclast_si128(b0, k));
+      _mm_storeu_si128(&out[1], _mm_aesdeclast_si128(b1, k));
+      _mm_storeu_si128(&out[2], _mm_aesdeclast_si128(b2, k));
+      _mm_storeu_si128(&out[3], _mm_aesdeclast_si128(b3, k));
+    }
+
+  for (; num_blocks > 0; num_blocks--, in++, out++)
+    {
+      __m128i b = _mm_xor_si128(_mm_loadu_si128(in),
+                                _mm_loadu_si128(&rk[0]));
+
+      for (i = 1; i < nr; i++)
+        {
+          b = _mm_aesdec_si128(b, _mm_loadu_si128(&rk[i]));
+        }
+
+      _mm_storeu_si128(out,
+                       _mm_aesdeclast_si128(b, _mm_loadu_si128(&rk[nr])));
+    }
+}
+
+TARGET_GHASH void ghash_accel_update(FAR GHASH_CTX *ctx, FAR uint8_t *x,
+                                     size_t len)
+{
+  const __m128i bswap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7,
+                                     8, 9, 10, 11, 12, 13, 14, 15);
+  __m128i h;
+  __m128i y;
+
+  h = _mm_shuffle_epi8(_mm_loadu_si128((FAR __m128i *)ctx->H), bswap);
+  y = _mm_shuffle_epi8(_mm_loadu_si128((FAR __m128i *)ctx->Z), bswap);
+
+  for (; len >= GMAC_BLOCK_LEN; len -= GMAC_BLOCK_LEN, x += GMAC_BLOCK_LEN)
+    {
+      __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((FAR __m128i *)x),
+                                   bswap);
+
+      y = ghash_gfmul(_mm_xor_si128(y, b), h);
+    }
+
+  y = _mm_shuffle_epi8(y, bswap);
+  _mm_storeu_si128((FAR __m128i *)ctx->S, y);
+  _mm_storeu_si128((FAR __m128i *)ctx->Z, y);
+}
+
+TARGET_SHA void sha1_accel_transform(FAR uint32_t *state,
+                                     FAR const uint8_t *data,
+                                     size_t num_blocks)
+{
+  const __m128i bswap = _mm_set_epi64x(0x0001020304050607ull,
+                                       0x08090a0b0c0d0e0full);
+  __m128i abcd;
+  __m128i e0;
+
+  abcd = _mm_shuffle_epi32(_mm_loadu_si128((FAR __m128i *)state), 0x1b);
+  e0 = _mm_set_epi32(state[4], 0, 0, 0);
+
+  for (; num_blocks > 0; num_blocks--, data += 64)
+    {
+      FAR const __m128i *in = (FAR const __m128i *)data;
+      __m128i abcd_save = abcd;
+      __m128i prev;
+      __m128i w[4];
+      __m128i e;
+
+      w[0] = _mm_shuffle_epi8(_mm_loadu_si128(&in[0]), bswap);
+      w[1] = _mm_shuffle_epi8(_mm_loadu_si128(&in[1]), bswap);
+      w[2] = _mm_shuffle_epi8(_mm_loadu_si128(&in[2]), bswap);
+      w[3] = _mm_shuffle_epi8(_mm_loadu_si128(&in[3]), bswap);
+
+      e = e0;
+      prev = abcd;
+      SHA1_GROUP5(0, 0);
+      SHA1_GROUP5(5, 1);
+      SHA1_GROUP5(10, 2);
+      SHA1_GROUP5(15, 3);
+
+      e0 = _mm_sha1nexte_epu32(prev, e0);
+      abcd = _mm_add_epi32(abcd, abcd_save);
+    }
+
+  _mm_storeu_si128((FAR __m128i *)state, _mm_shuffle_epi32(abcd, 0x1b));
+  state[4] = _mm_extract_epi32(e0, 3);
+}
+
+TARGET_SHA void sha256_accel_transform(FAR uint32_t *state,
+                                       FAR const uint8_t *data,
+                                       size_t num_blocks)
+{
+  const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bull,
+                                       0x0405060700010203ull);
+  FAR const __m128i *k = (FAR const __m128i *)g_sha256_k;
+  __m128i abef;
+  __m128i cdgh;
+  __m128i tmp;
+  int g;
+
+  /* Reorder the state words into the ABEF/CDGH layout of sha256rnds2 */
+
+  tmp  = _mm_shuffle_epi32(_mm_loadu_si128((FAR __m128i *)&state[0]),
+                           0xb1);
+  cdgh = _mm_shuffle_epi32(_mm_loadu_si128((FAR __m128i *)&state[4]),
+                           0x1b);
+  abef = _mm_alignr_epi8(tmp, cdgh, 8);
+  cdgh = _mm_blend_epi16(cdgh, tmp, 0xf0);
+
+  for (; num_blocks > 0; num_blocks--, data += 64)
+    {
+      FAR const __m128i *in = (FAR const __m128i *)data;
+      __m128i abef_save = abef;
+      __m128i cdgh_save = cdgh;
+      __m128i w[4];
+      __m128i m;
+
+      w[0] = _mm_shuffle_epi8(_mm_loadu_si128(&in[0]), bswap);
+      w[1] = _mm_shuffle_epi8(_mm_loadu_si128(&in[1]), bswap);
+      w[2] = _mm_shuffle_epi8(_mm_loadu_si128(&in[2]), bswap);
+      w[3] = _mm_shuffle_epi8(_mm_loadu_si128(&in[3]), bswap);
+
+      for (g = 0; g < 16; g++)
+        {
+          if (g >= 4)
+            {
+              m = _mm_sha256msg1_epu32(w[g & 3], w[(g + 1) & 3]);
+              m = _mm_add_epi32(m, _mm_alignr_epi8(w[(g + 3) & 3],
+                                                   w[(g + 2) & 3], 4));
+              w[g & 3] = _mm_sha256msg2_epu32(m, w[(g + 3) & 3]);
+            }
+
+          m = _mm_add_epi32(w[g & 3], _mm_loadu_si128(&k[g]));
+          cdgh = _mm_sha256rnds2_epu32(cdgh, abef, m);
+          m = _mm_shuffle_epi32(m, 0x0e);
+          abef = _mm_sha256rnds2_epu32(abef, cdgh, m);
+        }
+
+      abef = _mm_add_epi32(abef, abef_save);
+      cdgh = _mm_add_epi32(cdgh, cdgh_save);
+    }
+
+  tmp  = _mm_shuffle_epi32(abef, 0x1b);
+  cdgh = _mm_shuffle_epi32(cdgh, 0xb1);
+  _mm_storeu_si128((FAR __m128i *)&state[0],
+                   _mm_blend_epi16(tmp, cdgh, 0xf0));
+  _mm_storeu_si128((FAR __m128i *)&state[4],
+                   _mm_alignr_epi8(cdgh, tmp, 8));
+}
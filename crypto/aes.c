@@ -36,6 +36,8 @@
 #include <sys/types.h>
 #include <crypto/aes.h>
 
+#include "accel.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -845,6 +847,33 @@ void aes_ct_bitslice_decrypt(unsigned num_rounds,
 
 int aes_setkey(FAR AES_CTX *ctx, FAR const uint8_t *key, int len)
 {
+#ifdef CONFIG_CRYPTO_SW_ACCEL
+  if ((crypto_accel_caps() & CRYPTO_ACCEL_AES) != 0)
+    {
+      uint32_t skey[60];
+      unsigned u;
+
+      /* The AES instructions take the plain FIPS 197 round keys, stored
+       * in byte order in ctx->sk.
+       */
+
+      ctx->num_rounds = aes_keysched_base(skey, key, len);
+      if (ctx->num_rounds == 0)
+        {
+          return -1;
+        }
+
+      for (u = 0; u < ((ctx->num_rounds + 1) << 2); u++)
+        {
+          enc32le(&ctx->sk[u], skey[u]);
+        }
+
+      explicit_bzero(skey, sizeof(skey));
+      aes_accel_setkey(ctx);
+      return 0;
+    }
+#endif
+
   ctx->num_rounds = aes_ct_keysched(ctx->sk, key, len);
   if (ctx->num_rounds == 0)
     {
@@ -858,6 +887,14 @@ int aes_setkey(FAR AES_CTX *ctx, FAR const uint8_t *key, int len)
 void aes_encrypt_ecb(FAR AES_CTX *ctx, FAR const uint8_t *src,
                      FAR uint8_t *dst, size_t num_blocks)
 {
+#ifdef CONFIG_CRYPTO_SW_ACCEL
+  if ((crypto_accel_caps() & CRYPTO_ACCEL_AES) != 0)
+    {
+      aes_accel_encrypt_ecb(ctx, src, dst, num_blocks);
+      return;
+    }
+#endif
+
   while (num_blocks > 0)
     {
       uint32_t q[8];
@@ -908,6 +945,14 @@ void aes_encrypt_ecb(FAR AES_CTX *ctx, FAR const uint8_t *src,
 void aes_decrypt_ecb(FAR AES_CTX *ctx, FAR const uint8_t *src,
                      FAR uint8_t *dst, size_t num_blocks)
 {
+#ifdef CONFIG_CRYPTO_SW_ACCEL
+  if ((crypto_accel_caps() & CRYPTO_ACCEL_AES) != 0)
+    {
+      aes_accel_decrypt_ecb(ctx, src, dst, num_blocks);
+      return;
+    }
+#endif
+
   while (num_blocks > 0)
     {
       uint32_t q[8];
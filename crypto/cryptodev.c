@@ -45,6 +45,8 @@
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/fs/fs.h>
+#include <nuttx/mutex.h>
+#include <nuttx/wqueue.h>
 #include <nuttx/crypto/crypto.h>
 #include <nuttx/drivers/drivers.h>
 
@@ -72,6 +74,18 @@ int cryptodevallowsoft = 0;
  * Private Types
  ****************************************************************************/
 
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+struct cryptreq
+{
+  TAILQ_ENTRY(cryptreq) next;
+  struct crypt_op cop;
+  uint32_t reqid;
+  int status;
+};
+
+TAILQ_HEAD(cryptreqlist, cryptreq);
+#endif
+
 struct csession
 {
   TAILQ_ENTRY(csession) next;
@@ -90,6 +104,13 @@ struct csession
   caddr_t mackey;
   int mackeylen;
   int error;
+
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+  FAR struct fcrypt *fcr;
+  struct cryptreqlist pending; /* Submitted, not yet started */
+  struct work_s work;
+  bool queued;                 /* work is queued or running */
+#endif
 };
 
 struct fcrypt
@@ -98,6 +119,12 @@ struct fcrypt
   TAILQ_HEAD(cryptkoplist, cryptkop) crpk_ret;
   int sesn;
   FAR struct pollfd *fds;
+
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+  struct cryptreqlist done;    /* Completed, not yet fetched */
+  unsigned int nreqs;          /* Submitted and not yet fetched */
+  mutex_t lock;                /* Protects the request lists */
+#endif
 };
 
 /****************************************************************************
@@ -137,6 +164,14 @@ static int csefree(FAR struct csession *);
 
 static int cryptodev_op(FAR struct csession *,
                         FAR struct crypt_op *);
+static int cryptodev_mop(FAR struct fcrypt *, FAR struct crypt_mop *);
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+static void cryptodev_worker(FAR void *);
+static int cryptodev_async(FAR struct fcrypt *, FAR struct crypt_mop *);
+static int cryptodev_fetch(FAR struct fcrypt *, FAR struct crypt_mop *);
+static void cryptodev_async_init(FAR struct fcrypt *);
+static void cryptodev_async_cancel(FAR struct fcrypt *);
+#endif
 static int cryptodev_key(FAR struct fcrypt *, FAR struct crypt_kop *);
 static int cryptodevkey_cb(FAR struct cryptkop *);
 static int cryptodev_getkeystatus(FAR struct fcrypt *,
@@ -179,6 +214,15 @@ static struct inode g_cryptoinode =
   .u.i_ops = &g_cryptofops
 };
 
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+/* Worker pool shared by all asynchronous requests.  Each session is
+ * drained by at most one worker at a time so its ops complete in order,
+ * while different sessions proceed in parallel.
+ */
+
+static FAR struct kwork_wqueue_s *g_cryptodev_wq;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -349,14 +393,40 @@ bail:
         break;
       case CIOCFSESSION:
         ses = *(FAR uint32_t *)arg;
+
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+        /* The worker clears queued under the lock, so check it and unlink
+         * the session under the lock too.
+         */
+
+        nxmutex_lock(&fcr->lock);
+#endif
+
         cse = csefind(fcr, ses);
         if (cse == NULL)
           {
-            return -EINVAL;
+            error = -EINVAL;
+          }
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+        else if (cse->queued)
+          {
+            error = -EBUSY;
+          }
+#endif
+        else
+          {
+            csedelete(fcr, cse);
+          }
+
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+        nxmutex_unlock(&fcr->lock);
+#endif
+
+        if (error == 0)
+          {
+            error = csefree(cse);
           }
 
-        csedelete(fcr, cse);
-        error = csefree(cse);
         break;
       case CIOCCRYPT:
         cop = (FAR struct crypt_op *)arg;
@@ -368,6 +438,17 @@ bail:
 
         error = cryptodev_op(cse, cop);
         break;
+      case CIOCCRYPTM:
+        error = cryptodev_mop(fcr, (FAR struct crypt_mop *)arg);
+        break;
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+      case CIOCASYNCCRYPT:
+        error = cryptodev_async(fcr, (FAR struct crypt_mop *)arg);
+        break;
+      case CIOCASYNCFETCH:
+        error = cryptodev_fetch(fcr, (FAR struct crypt_mop *)arg);
+        break;
+#endif
       case CIOCKEY:
         error = cryptodev_key(fcr, (FAR struct crypt_kop *)arg);
         break;
@@ -556,6 +637,223 @@ bail:
   return error;
 }
 
+/* Run a batch of operations back to back.  Each entry gets its own
+ * status; the ioctl itself only fails for a malformed batch.
+ */
+
+static int cryptodev_mop(FAR struct fcrypt *fcr, FAR struct crypt_mop *mop)
+{
+  FAR struct csession *cse = NULL;
+  FAR struct crypt_aop *aop;
+  uint32_t i;
+
+  if (mop->count > 0 && mop->reqs == NULL)
+    {
+      return -EINVAL;
+    }
+
+  for (i = 0; i < mop->count; i++)
+    {
+      aop = &mop->reqs[i];
+
+      /* Records of one flow share a session, so skip repeated lookups */
+
+      if (cse == NULL || cse->ses != aop->cop.ses)
+        {
+          cse = csefind(fcr, aop->cop.ses);
+        }
+
+      aop->status = cse != NULL ? cryptodev_op(cse, &aop->cop) : -EINVAL;
+    }
+
+  return OK;
+}
+
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+static void cryptodev_worker(FAR void *arg)
+{
+  FAR struct csession *cse = arg;
+  FAR struct fcrypt *fcr = cse->fcr;
+  FAR struct cryptreq *req;
+
+  for (; ; )
+    {
+      nxmutex_lock(&fcr->lock);
+      req = TAILQ_FIRST(&cse->pending);
+      if (req == NULL)
+        {
+          cse->queued = false;
+          nxmutex_unlock(&fcr->lock);
+          return;
+        }
+
+      TAILQ_REMOVE(&cse->pending, req, next);
+      nxmutex_unlock(&fcr->lock);
+
+      req->status = cryptodev_op(cse, &req->cop);
+
+      nxmutex_lock(&fcr->lock);
+      TAILQ_INSERT_TAIL(&fcr->done, req, next);
+      if (fcr->fds != NULL)
+        {
+          poll_notify(&fcr->fds, 1, POLLIN);
+        }
+
+      nxmutex_unlock(&fcr->lock);
+    }
+}
+
+/* Queue a batch for the worker pool.  On return mop->count holds the
+ * number of entries accepted; a partial batch is not an error, the
+ * caller resubmits the tail once completions have been fetched.
+ */
+
+static int cryptodev_async(FAR struct fcrypt *fcr,
+                           FAR struct crypt_mop *mop)
+{
+  FAR struct csession *cse = NULL;
+  FAR struct crypt_aop *aop;
+  FAR struct cryptreq *req;
+  uint32_t i;
+  int ret = OK;
+
+  if (g_cryptodev_wq == NULL)
+    {
+      return -ENOSYS;
+    }
+
+  if (mop->count > 0 && mop->reqs == NULL)
+    {
+      return -EINVAL;
+    }
+
+  nxmutex_lock(&fcr->lock);
+  for (i = 0; i < mop->count; i++)
+    {
+      aop = &mop->reqs[i];
+      if (fcr->nreqs >= CONFIG_CRYPTO_CRYPTODEV_ASYNC_MAXREQ)
+        {
+          ret = -EAGAIN;
+          break;
+        }
+
+      if (cse == NULL || cse->ses != aop->cop.ses)
+        {
+          cse = csefind(fcr, aop->cop.ses);
+          if (cse == NULL)
+            {
+              ret = -EINVAL;
+              break;
+            }
+        }
+
+      req = kmm_malloc(sizeof(struct cryptreq));
+      if (req == NULL)
+        {
+          ret = -ENOMEM;
+          break;
+        }
+
+      req->cop = aop->cop;
+      req->reqid = aop->reqid;
+      req->status = 0;
+      TAILQ_INSERT_TAIL(&cse->pending, req, next);
+      fcr->nreqs++;
+
+      if (!cse->queued)
+        {
+          cse->queued = true;
+          work_queue_wq(g_cryptodev_wq, &cse->work, cryptodev_worker,
+                        cse, 0);
+        }
+    }
+
+  nxmutex_unlock(&fcr->lock);
+
+  mop->count = i;
+  return i > 0 ? OK : ret;
+}
+
+/* Reap up to mop->count completions in completion order */
+
+static int cryptodev_fetch(FAR struct fcrypt *fcr,
+                           FAR struct crypt_mop *mop)
+{
+  FAR struct cryptreq *req;
+  uint32_t i;
+
+  if (mop->count > 0 && mop->reqs == NULL)
+    {
+      return -EINVAL;
+    }
+
+  nxmutex_lock(&fcr->lock);
+  for (i = 0; i < mop->count; i++)
+    {
+      req = TAILQ_FIRST(&fcr->done);
+      if (req == NULL)
+        {
+          break;
+        }
+
+      TAILQ_REMOVE(&fcr->done, req, next);
+      fcr->nreqs--;
+
+      mop->reqs[i].cop = req->cop;
+      mop->reqs[i].reqid = req->reqid;
+      mop->reqs[i].status = req->status;
+      kmm_free(req);
+    }
+
+  nxmutex_unlock(&fcr->lock);
+
+  mop->count = i;
+  return i > 0 ? OK : -EAGAIN;
+}
+
+static void cryptodev_async_init(FAR struct fcrypt *fcr)
+{
+  TAILQ_INIT(&fcr->done);
+  fcr->nreqs = 0;
+  nxmutex_init(&fcr->lock);
+}
+
+/* Called on close: drop requests that have not started and wait for the
+ * ones in flight, so no worker references the sessions afterwards.
+ */
+
+static void cryptodev_async_cancel(FAR struct fcrypt *fcr)
+{
+  FAR struct csession *cse;
+  FAR struct cryptreq *req;
+
+  nxmutex_lock(&fcr->lock);
+  TAILQ_FOREACH(cse, &fcr->csessions, next)
+    {
+      while ((req = TAILQ_FIRST(&cse->pending)) != NULL)
+        {
+          TAILQ_REMOVE(&cse->pending, req, next);
+          kmm_free(req);
+        }
+    }
+
+  nxmutex_unlock(&fcr->lock);
+
+  TAILQ_FOREACH(cse, &fcr->csessions, next)
+    {
+      work_cancel_sync_wq(g_cryptodev_wq, &cse->work);
+    }
+
+  while ((req = TAILQ_FIRST(&fcr->done)) != NULL)
+    {
+      TAILQ_REMOVE(&fcr->done, req, next);
+      kmm_free(req);
+    }
+
+  nxmutex_destroy(&fcr->lock);
+}
+#endif
+
 static int cryptodev_key(FAR struct fcrypt *fcr, FAR struct crypt_kop *kop)
 {
   FAR struct cryptkop *krp = NULL;
@@ -802,23 +1100,37 @@ static int cryptof_poll(FAR struct file *filep,
                         FAR struct pollfd *fds, bool setup)
 {
   FAR struct fcrypt *fcr = filep->f_priv;
+  int ret = OK;
 
   if (fcr == NULL || fds == NULL)
     {
       return -EINVAL;
     }
 
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+  nxmutex_lock(&fcr->lock);
+#endif
+
   if (setup)
     {
       if (!TAILQ_EMPTY(&fcr->crpk_ret))
         {
           poll_notify(&fds, 1, POLLIN);
-          return OK;
+          goto out;
         }
 
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+      if (!TAILQ_EMPTY(&fcr->done))
+        {
+          poll_notify(&fds, 1, POLLIN);
+          goto out;
+        }
+#endif
+
       if (fcr->fds)
         {
-          return -EBUSY;
+          ret = -EBUSY;
+          goto out;
         }
 
       fcr->fds = fds;
@@ -828,7 +1140,11 @@ static int cryptof_poll(FAR struct file *filep,
       fcr->fds = NULL;
     }
 
-  return OK;
+out:
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+  nxmutex_unlock(&fcr->lock);
+#endif
+  return ret;
 }
 
 /* ARGSUSED */
@@ -840,6 +1156,10 @@ static int cryptof_close(FAR struct file *filep)
   FAR struct cryptkop *krp;
   int i;
 
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+  cryptodev_async_cancel(fcr);
+#endif
+
   while ((cse = TAILQ_FIRST(&fcr->csessions)))
     {
       TAILQ_REMOVE(&fcr->csessions, cse, next);
@@ -901,6 +1221,10 @@ static int cryptof_open(FAR struct file *filep)
     }
 
   TAILQ_INIT(&fcrd->csessions);
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+  cryptodev_async_init(fcrd);
+#endif
+
   TAILQ_FOREACH(cse, &fcr->csessions, next)
     {
       bzero(&crie, sizeof(crie));
@@ -1027,10 +1351,16 @@ static int cryptoioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
         TAILQ_INIT(&fcr->csessions);
         TAILQ_INIT(&fcr->crpk_ret);
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+        cryptodev_async_init(fcr);
+#endif
 
         fd = file_allocate_from_inode(&g_cryptoinode, 0, 0, fcr, 0);
         if (fd < 0)
           {
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+            nxmutex_destroy(&fcr->lock);
+#endif
             kmm_free(fcr);
             return fd;
           }
@@ -1104,7 +1434,18 @@ static FAR struct csession *csecreate(FAR struct fcrypt *fcr, uint64_t sid,
       cse->txform = txform;
       cse->thash = thash;
       cse->error = 0;
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+      cse->fcr = fcr;
+      TAILQ_INIT(&cse->pending);
+      memset(&cse->work, 0, sizeof(cse->work));
+      cse->queued = false;
+
+      nxmutex_lock(&fcr->lock);
       cseadd(fcr, cse);
+      nxmutex_unlock(&fcr->lock);
+#else
+      cseadd(fcr, cse);
+#endif
     }
 
   return cse;
@@ -1144,4 +1485,12 @@ void devcrypto_register(void)
 #ifdef CONFIG_CRYPTO_CRYPTODEV_HARDWARE
   hwcr_init();
 #endif
+
+#ifdef CONFIG_CRYPTO_CRYPTODEV_ASYNC
+  g_cryptodev_wq = work_queue_create("cryptodev",
+                                     CONFIG_CRYPTO_CRYPTODEV_ASYNC_PRIORITY,
+                                     NULL,
+                                     CONFIG_CRYPTO_CRYPTODEV_ASYNC_STACKSIZE,
+                                     CONFIG_CRYPTO_CRYPTODEV_ASYNC_NTHREADS);
+#endif
 }
@@ -36,6 +36,8 @@
 #include <crypto/aes.h>
 #include <crypto/gmac.h>
 
+#include "accel.h"
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -143,6 +145,13 @@ void aes_gmac_setkey(FAR void *xctx, FAR const uint8_t *key, uint16_t klen)
   /* prepare a hash subkey */
 
   aes_encrypt(&ctx->K, ctx->ghash.H, ctx->ghash.H);
+
+#ifdef CONFIG_CRYPTO_SW_ACCEL
+  if ((crypto_accel_caps() & CRYPTO_ACCEL_GHASH) != 0)
+    {
+      ghash_update = ghash_accel_update;
+    }
+#endif
 }
 
 void aes_gmac_reinit(FAR void *xctx, FAR const uint8_t *iv, uint16_t ivlen)
@@ -18,6 +18,8 @@
 
 #include <crypto/sha1.h>
 
+#include "accel.h"
+
 /* #define LITTLE_ENDIAN * This should be #define'd already, if true. */
 
 /* #define SHA1HANDSOFF * Copies data before messing with it. */
@@ -108,10 +110,19 @@ void sha1transform(FAR uint32_t *state,
   } CHAR64LONG16;
 
   FAR CHAR64LONG16 *block;
-
 #ifdef SHA1HANDSOFF
   unsigned char workspace[SHA1_BLOCK_LENGTH];
+#endif
+
+#ifdef CONFIG_CRYPTO_SW_ACCEL
+  if ((crypto_accel_caps() & CRYPTO_ACCEL_SHA1) != 0)
+    {
+      sha1_accel_transform(state, buffer, 1);
+      return;
+    }
+#endif
 
+#ifdef SHA1HANDSOFF
   block = (FAR CHAR64LONG16 *)workspace;
   memcpy(block, buffer, SHA1_BLOCK_LENGTH);
 #else
@@ -252,6 +263,14 @@ void sha1update(FAR SHA1_CTX *context,
     {
       memcpy(&context->buffer[j], data, (i = 64 - j));
       sha1transform(context->state, context->buffer);
+#ifdef CONFIG_CRYPTO_SW_ACCEL
+      if ((crypto_accel_caps() & CRYPTO_ACCEL_SHA1) != 0 && i + 63 < len)
+        {
+          sha1_accel_transform(context->state, &data[i], (len - i) >> 6);
+          i += (len - i) & ~63;
+        }
+#endif
+
       for (; i + 63 < len; i += 64)
         {
           sha1transform(context->state, &data[i]);
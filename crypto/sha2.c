@@ -40,6 +40,8 @@
 #include <sys/time.h>
 #include <crypto/sha2.h>
 
+#include "accel.h"
+
 /* UNROLLED TRANSFORM LOOP NOTE:
  * You can define SHA2_UNROLL_TRANSFORM to use the unrolled transform
  * loop version for the hash transform rounds (defined using macros
@@ -361,6 +363,14 @@ void sha256transform(FAR uint32_t *state, FAR const uint8_t *data)
   uint32_t W256[16];
   int j;
 
+#ifdef CONFIG_CRYPTO_SW_ACCEL
+  if ((crypto_accel_caps() & CRYPTO_ACCEL_SHA256) != 0)
+    {
+      sha256_accel_transform(state, data, 1);
+      return;
+    }
+#endif
+
   /* Initialize registers with the prev. intermediate value */
 
   a = state[0];
@@ -438,6 +448,14 @@ void sha256transform(FAR uint32_t *state, FAR const uint8_t *data)
   uint32_t W256[16];
   int j;
 
+#ifdef CONFIG_CRYPTO_SW_ACCEL
+  if ((crypto_accel_caps() & CRYPTO_ACCEL_SHA256) != 0)
+    {
+      sha256_accel_transform(state, data, 1);
+      return;
+    }
+#endif
+
   /* Initialize registers with the prev. intermediate value */
 
   a = state[0];
@@ -564,6 +582,19 @@ void sha256update(FAR SHA2_CTX *context,
         }
     }
 
+#ifdef CONFIG_CRYPTO_SW_ACCEL
+  if ((crypto_accel_caps() & CRYPTO_ACCEL_SHA256) != 0 &&
+      len >= SHA256_BLOCK_LENGTH)
+    {
+      size_t nblocks = len / SHA256_BLOCK_LENGTH;
+
+      sha256_accel_transform(context->state.st32, data, nblocks);
+      context->bitcount[0] += (uint64_t)nblocks * SHA256_BLOCK_LENGTH << 3;
+      len -= nblocks * SHA256_BLOCK_LENGTH;
+      data += nblocks * SHA256_BLOCK_LENGTH;
+    }
+#endif
+
   while (len >= SHA256_BLOCK_LENGTH)
     {
       /* Process as many complete blocks as we can */
@@ -85,6 +85,9 @@ EXTERN const struct file_operations g_bch_fops;
 
 EXTERN int  bchlib_flushsector(FAR struct bchlib_s *bch, bool discard);
 EXTERN int  bchlib_readsector(FAR struct bchlib_s *bch, size_t sector);
+EXTERN ssize_t bchlib_transfer(FAR struct bchlib_s *bch,
+                               FAR uint8_t *buffer, size_t sector,
+                               size_t nsectors, bool write);
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -29,10 +29,14 @@
 
 #include <sys/types.h>
 #include <stdbool.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
 
+#include <nuttx/fs/bio.h>
+#include <nuttx/semaphore.h>
+
 #include "bch.h"
 
 #if defined(CONFIG_BCH_ENCRYPTION)
@@ -57,6 +61,17 @@ static void bch_xor(uint32_t *R, uint32_t *A, uint32_t *B)
 }
 #endif
 
+/****************************************************************************
+ * Name: bchlib_biodone
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_BIO
+static void bchlib_biodone(FAR struct bio_s *bio)
+{
+  nxsem_post(bio->arg);
+}
+#endif
+
 /****************************************************************************
  * Name: bch_cypher
  ****************************************************************************/
@@ -211,3 +226,56 @@ int bchlib_readsector(FAR struct bchlib_s *bch, size_t sector)
 
   return (int)ret;
 }
+
+/****************************************************************************
+ * Name: bchlib_transfer
+ *
+ * Description:
+ *   Read or write whole sectors directly between the device and buffer.
+ *   With CONFIG_FS_BIO the transfer is submitted as a block request, so
+ *   that drivers with a request queue can merge it with the I/O of the
+ *   other users of the device.
+ *
+ ****************************************************************************/
+
+ssize_t bchlib_transfer(FAR struct bchlib_s *bch, FAR uint8_t *buffer,
+                        size_t sector, size_t nsectors, bool write)
+{
+  FAR struct inode *inode = bch->inode;
+#ifdef CONFIG_FS_BIO
+  struct iovec iov;
+  struct bio_s bio;
+  sem_t done;
+  ssize_t ret;
+
+  iov.iov_base = buffer;
+  iov.iov_len  = nsectors * bch->sectsize;
+
+  memset(&bio, 0, sizeof(bio));
+  bio.iov      = &iov;
+  bio.iovcnt   = 1;
+  bio.sector   = sector;
+  bio.nsectors = nsectors;
+  bio.op       = write ? BIO_WRITE : BIO_READ;
+  bio.callback = bchlib_biodone;
+  bio.arg      = &done;
+
+  nxsem_init(&done, 0, 0);
+  ret = bio_submit(inode, &bio);
+  if (ret >= 0)
+    {
+      nxsem_wait_uninterruptible(&done);
+      ret = bio.result;
+    }
+
+  nxsem_destroy(&done);
+  return ret;
+#else
+  if (write)
+    {
+      return inode->u.i_bops->write(inode, buffer, sector, nsectors);
+    }
+
+  return inode->u.i_bops->read(inode, buffer, sector, nsectors);
+#endif
+}
@@ -148,8 +148,8 @@ ssize_t bchlib_read(FAR void *handle, FAR char *buffer, off_t offset,
           nsectors = bch->nsectors - sector;
         }
 
-      ret = bch->inode->u.i_bops->read(bch->inode, (FAR uint8_t *)buffer,
-                                       sector, nsectors);
+      ret = bchlib_transfer(bch, (FAR uint8_t *)buffer, sector, nsectors,
+                            false);
       if (ret < 0)
         {
           ferr("ERROR: Read failed: %d\n", ret);
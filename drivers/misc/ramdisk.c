@@ -39,6 +39,7 @@
 #include <errno.h>
 
 #include <nuttx/kmalloc.h>
+#include <nuttx/fs/bio.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/drivers/ramdisk.h>
 
@@ -99,6 +100,9 @@ static int     rd_ioctl(FAR struct inode *inode, int cmd,
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
 static int     rd_unlink(FAR struct inode *inode);
 #endif
+#ifdef CONFIG_FS_BIO
+static int     rd_submit(FAR struct inode *inode, FAR struct bio_s *bio);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -120,6 +124,9 @@ static const struct block_operations g_bops =
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   , rd_unlink  /* unlink   */
 #endif
+#ifdef CONFIG_FS_BIO
+  , rd_submit  /* submit   */
+#endif
 };
 
 /****************************************************************************
@@ -296,6 +303,68 @@ static ssize_t rd_write(FAR struct inode *inode,
   return -EFBIG;
 }
 
+/****************************************************************************
+ * Name: rd_submit
+ *
+ * Description:
+ *   Execute an asynchronous request.  Memory needs no queue: every
+ *   segment is copied at once and the request completes before return.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_FS_BIO
+static int rd_submit(FAR struct inode *inode, FAR struct bio_s *bio)
+{
+  FAR struct rd_struct_s *dev;
+  FAR uint8_t *media;
+  size_t nbytes = 0;
+  int i;
+
+  DEBUGASSERT(inode->i_private);
+  dev = inode->i_private;
+
+  if (bio->sector >= dev->rd_nsectors ||
+      bio->sector + bio->nsectors > dev->rd_nsectors)
+    {
+      return bio->op == BIO_READ ? -EINVAL : -EFBIG;
+    }
+
+  if (bio->op == BIO_WRITE && !RDFLAG_IS_WRENABLED(dev->rd_flags))
+    {
+      return -EACCES;
+    }
+
+  for (i = 0; i < bio->iovcnt; i++)
+    {
+      nbytes += bio->iov[i].iov_len;
+    }
+
+  if (nbytes != (size_t)bio->nsectors * dev->rd_sectsize)
+    {
+      return -EINVAL;
+    }
+
+  media = &dev->rd_buffer[bio->sector * dev->rd_sectsize];
+  for (i = 0; i < bio->iovcnt; i++)
+    {
+      if (bio->op == BIO_READ)
+        {
+          memcpy(bio->iov[i].iov_base, media, bio->iov[i].iov_len);
+        }
+      else
+        {
+          memcpy(media, bio->iov[i].iov_base, bio->iov[i].iov_len);
+        }
+
+      media += bio->iov[i].iov_len;
+    }
+
+  bio->result = bio->nsectors;
+  bio->callback(bio);
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: rd_geometry
  *
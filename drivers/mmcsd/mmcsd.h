@@ -29,6 +29,8 @@
 
 #include <nuttx/config.h>
 #include <nuttx/sdio.h>
+#include <nuttx/fs/bio.h>
+#include <nuttx/wqueue.h>
 #include <stdint.h>
 #include <debug.h>
 
@@ -46,6 +48,12 @@
 
 #define MMCSD_PART_COUNT             8
 
+/* Queued block requests are executed on the low priority work queue */
+
+#if defined(CONFIG_FS_BIO) && defined(CONFIG_SCHED_WORKQUEUE)
+#  define MMCSD_HAVE_BIO
+#endif
+
 /* Card type */
 
 #define MMCSD_CARDTYPE_UNKNOWN       0  /* Unknown card type */
@@ -68,6 +76,11 @@ struct mmcsd_part_s
 {
   FAR struct mmcsd_state_s *priv;
   blkcnt_t nblocks; /* Number of blocks */
+#ifdef MMCSD_HAVE_BIO
+  struct bio_queue_s queue; /* Queued block requests */
+  struct work_s work;       /* Executes the active request */
+  FAR struct bio_s *bio;    /* Active request chain */
+#endif
 };
 
 /* This structure is contains the unique state of the MMC/SD block driver */
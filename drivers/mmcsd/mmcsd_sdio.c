@@ -104,6 +104,10 @@
 #  define MMCSD_MULTIBLOCK_LIMIT CONFIG_MMCSD_MULTIBLOCK_LIMIT
 #endif
 
+/* Largest merged request handed to one transfer */
+
+#define MMCSD_BIO_MAXSECTORS    256
+
 #define MMCSD_CAPACITY(b, s)    ((s) >= 10 ? (b) << ((s) - 10) : (b) >> (10 - (s)))
 
 #ifdef CONFIG_BOARD_COREDUMP_BLKDEV
@@ -208,6 +212,9 @@ static int     mmcsd_geometry(FAR struct inode *inode,
                               FAR struct geometry *geometry);
 static int     mmcsd_ioctl(FAR struct inode *inode, int cmd,
                            unsigned long arg);
+#ifdef MMCSD_HAVE_BIO
+static int     mmcsd_submit(FAR struct inode *inode, FAR struct bio_s *bio);
+#endif
 
 /* Initialization/uninitialization/reset ************************************/
 
@@ -244,6 +251,12 @@ static const struct block_operations g_bops =
   mmcsd_write,    /* write    */
   mmcsd_geometry, /* geometry */
   mmcsd_ioctl     /* ioctl    */
+#ifdef MMCSD_HAVE_BIO
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , NULL          /* unlink   */
+#endif
+  , mmcsd_submit  /* submit   */
+#endif
 };
 
 static FAR const char *g_partname[MMCSD_PART_COUNT] =
@@ -2358,28 +2371,25 @@ static int mmcsd_close(FAR struct inode *inode)
 }
 
 /****************************************************************************
- * Name: mmcsd_read
+ * Name: mmcsd_readsectors
  *
  * Description:
- *   Read the specified number of sectors from the read-ahead buffer or from
- *   the physical device.
+ *   Read the specified number of sectors of a partition, splitting the
+ *   transfer as required by MMCSD_MULTIBLOCK_LIMIT.
  *
  ****************************************************************************/
 
-static ssize_t mmcsd_read(FAR struct inode *inode, unsigned char *buffer,
-                          blkcnt_t startsector, unsigned int nsectors)
+static ssize_t mmcsd_readsectors(FAR struct mmcsd_part_s *part,
+                                 FAR unsigned char *buffer,
+                                 blkcnt_t startsector,
+                                 unsigned int nsectors)
 {
-  FAR struct mmcsd_state_s *priv;
-  FAR struct mmcsd_part_s *part;
+  FAR struct mmcsd_state_s *priv = part->priv;
   size_t sector;
   size_t endsector;
   ssize_t nread;
   ssize_t ret = nsectors;
 
-  DEBUGASSERT(inode->i_private);
-  part = inode->i_private;
-  priv = part->priv;
-
   finfo("startsector: %" PRIuOFF " nsectors: %u sectorsize: %d\n",
         startsector, nsectors, priv->blocksize);
 
@@ -2438,29 +2448,42 @@ static ssize_t mmcsd_read(FAR struct inode *inode, unsigned char *buffer,
 }
 
 /****************************************************************************
- * Name: mmcsd_write
+ * Name: mmcsd_read
  *
  * Description:
- *   Write the specified number of sectors to the write buffer or to the
- *   physical device.
+ *   Read the specified number of sectors from the read-ahead buffer or from
+ *   the physical device.
  *
  ****************************************************************************/
 
-static ssize_t mmcsd_write(FAR struct inode *inode,
-                           FAR const unsigned char *buffer,
-                           blkcnt_t startsector, unsigned int nsectors)
+static ssize_t mmcsd_read(FAR struct inode *inode, unsigned char *buffer,
+                          blkcnt_t startsector, unsigned int nsectors)
 {
-  FAR struct mmcsd_state_s *priv;
-  FAR struct mmcsd_part_s *part;
+  DEBUGASSERT(inode->i_private);
+  return mmcsd_readsectors(inode->i_private, buffer, startsector,
+                           nsectors);
+}
+
+/****************************************************************************
+ * Name: mmcsd_writesectors
+ *
+ * Description:
+ *   Write the specified number of sectors of a partition, splitting the
+ *   transfer as required by MMCSD_MULTIBLOCK_LIMIT.
+ *
+ ****************************************************************************/
+
+static ssize_t mmcsd_writesectors(FAR struct mmcsd_part_s *part,
+                                  FAR const unsigned char *buffer,
+                                  blkcnt_t startsector,
+                                  unsigned int nsectors)
+{
+  FAR struct mmcsd_state_s *priv = part->priv;
   size_t sector;
   size_t endsector;
   ssize_t nwrite;
   ssize_t ret = nsectors;
 
-  DEBUGASSERT(inode->i_private);
-  part = inode->i_private;
-  priv = part->priv;
-
   finfo("startsector: %" PRIuOFF " nsectors: %u sectorsize: %d\n",
         startsector, nsectors, priv->blocksize);
 
@@ -2518,6 +2541,100 @@ static ssize_t mmcsd_write(FAR struct inode *inode,
   return ret;
 }
 
+/****************************************************************************
+ * Name: mmcsd_write
+ *
+ * Description:
+ *   Write the specified number of sectors to the write buffer or to the
+ *   physical device.
+ *
+ ****************************************************************************/
+
+static ssize_t mmcsd_write(FAR struct inode *inode,
+                           FAR const unsigned char *buffer,
+                           blkcnt_t startsector, unsigned int nsectors)
+{
+  DEBUGASSERT(inode->i_private);
+  return mmcsd_writesectors(inode->i_private, buffer, startsector,
+                            nsectors);
+}
+
+#ifdef MMCSD_HAVE_BIO
+/****************************************************************************
+ * Name: mmcsd_bio_worker
+ *
+ * Description:
+ *   Execute a merged request chain.  The queue only builds chains that
+ *   are a single contiguous buffer, so one multi-block transfer serves
+ *   every request in it.
+ *
+ ****************************************************************************/
+
+static void mmcsd_bio_worker(FAR void *arg)
+{
+  FAR struct mmcsd_part_s *part = arg;
+  FAR struct bio_s *bio = part->bio;
+  struct iovec iov;
+  ssize_t ret;
+
+  ret = bio_chain_iov(bio, &iov, 1);
+  if (ret >= 0)
+    {
+      if (bio->op == BIO_WRITE)
+        {
+          ret = mmcsd_writesectors(part, iov.iov_base, bio->sector,
+                                   bio->qsectors);
+        }
+      else
+        {
+          ret = mmcsd_readsectors(part, iov.iov_base, bio->sector,
+                                  bio->qsectors);
+        }
+    }
+
+  part->bio = NULL;
+  bio_queue_done(&part->queue, bio, ret);
+}
+
+/****************************************************************************
+ * Name: mmcsd_bio_dispatch
+ *
+ * Description:
+ *   The card runs one command at a time: hand the chain to the worker.
+ *   Requests arriving meanwhile wait in the queue and merge.
+ *
+ ****************************************************************************/
+
+static void mmcsd_bio_dispatch(FAR struct bio_queue_s *queue,
+                               FAR struct bio_s *bio)
+{
+  FAR struct mmcsd_part_s *part = queue->priv;
+
+  DEBUGASSERT(part->bio == NULL);
+  part->bio = bio;
+  work_queue(LPWORK, &part->work, mmcsd_bio_worker, part, 0);
+}
+
+/****************************************************************************
+ * Name: mmcsd_submit
+ ****************************************************************************/
+
+static int mmcsd_submit(FAR struct inode *inode, FAR struct bio_s *bio)
+{
+  FAR struct mmcsd_part_s *part;
+
+  DEBUGASSERT(inode->i_private);
+  part = inode->i_private;
+
+  if (bio->sector + bio->nsectors > part->nblocks)
+    {
+      return -EINVAL;
+    }
+
+  return bio_queue_submit(&part->queue, bio);
+}
+#endif
+
 /****************************************************************************
  * Name: mmcsd_geometry
  *
@@ -4375,6 +4492,12 @@ static int mmcsd_probe(FAR struct mmcsd_state_s *priv)
               priv->part[i].priv = priv;
               if (priv->part[i].nblocks != 0)
                 {
+#ifdef MMCSD_HAVE_BIO
+                  bio_queue_init(&priv->part[i].queue, 1, 1,
+                                 MMCSD_BIO_MAXSECTORS, mmcsd_bio_dispatch,
+                                 &priv->part[i]);
+#endif
+
                   snprintf(devname, sizeof(devname), "/dev/mmcsd%d%s",
                            priv->minor, g_partname[i]);
                   register_blockdriver(devname, &g_bops, 0666,
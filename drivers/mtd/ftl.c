@@ -46,6 +46,8 @@
 #include <nuttx/mtd/mtd.h>
 #include <nuttx/drivers/rwbuffer.h>
 
+#include "ftl_log.h"
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -82,6 +84,12 @@ struct ftl_struct_s
 
   FAR off_t            *lptable;
   off_t                 lpcount;
+
+#ifdef CONFIG_FTL_LOG
+  /* The page-mapped log, NULL if the geometry does not allow one */
+
+  FAR struct ftl_log_s *log;
+#endif
 };
 
 /****************************************************************************
@@ -217,6 +225,14 @@ static int ftl_open(FAR struct inode *inode)
   DEBUGASSERT(inode->i_private);
   dev = inode->i_private;
 
+#ifdef CONFIG_FTL_LOG
+  if (dev->log != NULL)
+    {
+      dev->refs++;
+      return OK;
+    }
+#endif
+
   if (dev->refs == 0)
     {
       /* Allocate one, in-memory erase block buffer */
@@ -256,12 +272,16 @@ static int ftl_close(FAR struct inode *inode)
       if (dev->eblock)
         {
           kmm_free(dev->eblock);
+          dev->eblock = NULL;
         }
 
       if (dev->unlinked)
         {
 #ifdef FTL_HAVE_RWBUFFER
           rwb_uninitialize(&dev->rwb);
+#endif
+#ifdef CONFIG_FTL_LOG
+          ftl_log_uninitialize(dev->log);
 #endif
           kmm_free(dev);
         }
@@ -442,6 +462,13 @@ static ssize_t ftl_reload(FAR void *priv, FAR uint8_t *buffer,
 {
   struct ftl_struct_s *dev = (struct ftl_struct_s *)priv;
 
+#ifdef CONFIG_FTL_LOG
+  if (dev->log != NULL)
+    {
+      return ftl_log_read(dev->log, buffer, startblock, nblocks);
+    }
+#endif
+
   /* Read the full erase block into the buffer */
 
   return ftl_mtd_bread(dev, startblock, nblocks, buffer);
@@ -492,6 +519,13 @@ static ssize_t ftl_flush(FAR void *priv, FAR const uint8_t *buffer,
   int    nbytes;
   int    ret;
 
+#ifdef CONFIG_FTL_LOG
+  if (dev->log != NULL)
+    {
+      return ftl_log_write(dev->log, buffer, startblock, nblocks);
+    }
+#endif
+
   /* Get the aligned block.  Here is is assumed: (1) The number of R/W blocks
    * per erase block is a power of 2, and (2) the erase begins with that same
    * alignment.
@@ -684,6 +718,12 @@ static int ftl_geometry(FAR struct inode *inode,
       geometry->geo_writeenabled  = true;
       geometry->geo_nsectors      = dev->geo.neraseblocks * dev->blkper;
       geometry->geo_sectorsize    = dev->geo.blocksize;
+#ifdef CONFIG_FTL_LOG
+      if (dev->log != NULL)
+        {
+          geometry->geo_nsectors  = ftl_log_nsectors(dev->log);
+        }
+#endif
 
       strlcpy(geometry->geo_model, dev->geo.model,
               sizeof(geometry->geo_model));
@@ -730,6 +770,42 @@ static int ftl_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 #endif
     }
 
+#ifdef CONFIG_FTL_LOG
+  if (cmd == BIOC_FTLSTATS)
+    {
+      FAR struct ftl_stats_s *stats =
+        (FAR struct ftl_stats_s *)((uintptr_t)arg);
+
+      if (dev->log == NULL || stats == NULL)
+        {
+          return -ENOTTY;
+        }
+
+      ftl_log_stats(dev->log, stats);
+      return OK;
+    }
+
+  /* The log owns the whole MTD: its sectors are not where the block
+   * numbers say, and erasing behind its back leaves the page map stale.
+   */
+
+  if (dev->log != NULL)
+    {
+      switch (cmd)
+        {
+          case BIOC_XIPBASE:
+            return -ENOTTY;
+
+          case MTDIOC_BULKERASE:
+          case MTDIOC_ERASESECTORS:
+            return -EPERM;
+
+          default:
+            break;
+        }
+    }
+#endif
+
   /* No other block driver ioctl commands are not recognized by this
    * driver.  Other possible MTD driver ioctl commands are passed through
    * to the MTD driver (unchanged).
@@ -765,6 +841,9 @@ static int ftl_unlink(FAR struct inode *inode)
 #ifdef FTL_HAVE_RWBUFFER
       rwb_uninitialize(&dev->rwb);
 #endif
+#ifdef CONFIG_FTL_LOG
+      ftl_log_uninitialize(dev->log);
+#endif
 
       kmm_free(dev);
     }
@@ -831,6 +910,24 @@ int ftl_initialize_by_path(FAR const char *path, FAR struct mtd_dev_s *mtd)
       dev->blkper = dev->geo.erasesize / dev->geo.blocksize;
       DEBUGASSERT(dev->blkper * dev->geo.blocksize == dev->geo.erasesize);
 
+#ifdef CONFIG_FTL_LOG
+      /* Rebuild the page map.  Devices with too few pages per erase block
+       * for the log keep the erase block FTL.
+       */
+
+      ret = ftl_log_initialize(&dev->log, mtd, &dev->geo);
+      if (ret == -EINVAL)
+        {
+          fwarn("WARNING: %s: geometry too small for the log FTL\n", path);
+        }
+      else if (ret < 0)
+        {
+          ferr("ERROR: ftl_log_initialize failed: %d\n", ret);
+          kmm_free(dev);
+          return ret;
+        }
+#endif
+
       /* Configure read-ahead/write buffering */
 
 #ifdef FTL_HAVE_RWBUFFER
@@ -845,6 +942,18 @@ int ftl_initialize_by_path(FAR const char *path, FAR struct mtd_dev_s *mtd)
       dev->rwb.wralignblocks = dev->blkper;
 #endif
 
+#ifdef CONFIG_FTL_LOG
+      /* The log has no erase block alignment to keep */
+
+      if (dev->log != NULL)
+        {
+          dev->rwb.nblocks       = ftl_log_nsectors(dev->log);
+#  if defined(CONFIG_FTL_WRITEBUFFER)
+          dev->rwb.wralignblocks = 1;
+#  endif
+        }
+#endif
+
 #ifdef CONFIG_FTL_READAHEAD
       dev->rwb.rhmaxblocks   = dev->blkper;
 #endif
@@ -853,12 +962,19 @@ int ftl_initialize_by_path(FAR const char *path, FAR struct mtd_dev_s *mtd)
       if (ret < 0)
         {
           ferr("ERROR: rwb_initialize failed: %d\n", ret);
+#ifdef CONFIG_FTL_LOG
+          ftl_log_uninitialize(dev->log);
+#endif
           kmm_free(dev);
           return ret;
         }
 #endif
 
+#ifdef CONFIG_FTL_LOG
+      if (dev->log == NULL && MTD_ISBAD(dev->mtd, 0) != -ENOSYS)
+#else
       if (MTD_ISBAD(dev->mtd, 0) != -ENOSYS)
+#endif
         {
           ret = ftl_init_map(dev);
           if (ret < 0)
@@ -877,6 +993,9 @@ int ftl_initialize_by_path(FAR const char *path, FAR struct mtd_dev_s *mtd)
 out:
 #ifdef FTL_HAVE_RWBUFFER
           rwb_uninitialize(&dev->rwb);
+#endif
+#ifdef CONFIG_FTL_LOG
+          ftl_log_uninitialize(dev->log);
 #endif
           kmm_free(dev);
         }
@@ -0,0 +1,1226 @@
+/****************************************************************************
+ * drivers/mtd/ftl_log.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* A page-mapped, log-structured flash translation layer.
+ *
+ * Every sector write is appended to the open ("head") erase block and the
+ * logical-to-physical page map is updated in RAM, so a small write costs
+ * one page program instead of an erase block read-erase-rewrite.
+ *
+ * On-flash layout of an erase block:
+ *
+ *   page 0      Header: magic and erase count, written right after erase.
+ *   page 1..    Data pages interleaved with summary pages.  A summary lists
+ *               the logical sector of every data page between it and the
+ *               previous summary (or the header) and links back to that
+ *               previous summary.
+ *
+ * A summary is written at the end of every ftl_log_write() call, so the
+ * map is persistent: at start-up the last written page of each block is
+ * found by binary search, the summary chain is walked backwards and the
+ * blocks are replayed newest first.  Data pages are never programmed with
+ * the erased pattern (such sectors are recorded in the summary only),
+ * which keeps the written part of each block contiguous.
+ *
+ * Space is reclaimed by greedy garbage collection of the block with the
+ * fewest live pages.  Free blocks are allocated least-worn first and, when
+ * the erase counts drift apart, the least-worn block holding data is
+ * recycled so that cold data does not pin it.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <sys/types.h>
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+
+#include <nuttx/crc32.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/mtd/mtd.h>
+
+#include "ftl_log.h"
+
+#ifdef CONFIG_FTL_LOG
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define FTL_LOG_HDR_MAGIC   0x4c544648  /* "HFTL" */
+#define FTL_LOG_SUM_MAGIC   0x4d555346  /* "FSUM" */
+
+/* Map values */
+
+#define FTL_LOG_NONE        UINT32_MAX        /* Never written */
+#define FTL_LOG_BLANK       (UINT32_MAX - 1)  /* Reads as erased */
+
+/* Summary entries.  An entry is a logical sector number; BLANKENT marks a
+ * sector that reads as erased and occupies no page, HOLE a page that holds
+ * nothing (a failed program).
+ */
+
+#define FTL_LOG_BLANKENT    0x80000000
+#define FTL_LOG_HOLE        0x7fffffff
+
+/* Consider static wear leveling on every this many collections */
+
+#define FTL_LOG_WL_INTERVAL 16
+
+/* Block states */
+
+#define FTL_LOG_BAD         0  /* Bad, never used */
+#define FTL_LOG_FREE        1  /* Erased, header written */
+#define FTL_LOG_OPEN        2  /* The head block being appended to */
+#define FTL_LOG_USED        3  /* Closed, may hold live data */
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct ftl_log_header_s
+{
+  uint32_t magic;
+  uint32_t erasecount;
+  uint32_t crc;
+};
+
+struct ftl_log_summary_s
+{
+  uint32_t magic;
+  uint32_t seq;               /* Sequence number of the block */
+  uint16_t prev;              /* Previous summary page, 0 if none */
+  uint16_t count;             /* Number of entries that follow */
+  uint32_t crc;               /* Over the fields above and the entries */
+};
+
+struct ftl_log_block_s
+{
+  uint32_t erasecount;
+  uint32_t seq;               /* Order in which blocks were opened */
+  uint16_t valid;             /* Live data pages */
+  uint16_t lastsum;           /* Last summary page, 0 if none */
+  uint8_t  state;             /* FTL_LOG_* */
+};
+
+struct ftl_log_s
+{
+  FAR struct mtd_dev_s *mtd;
+  mutex_t               lock;
+  uint32_t              blocksize;
+  uint32_t              nblocks;    /* Erase blocks */
+  uint32_t              nsectors;   /* Logical sectors exported */
+  uint32_t              nfree;      /* Blocks in FTL_LOG_FREE state */
+  uint32_t              seq;        /* Highest sequence number used */
+  uint32_t              head;       /* Open block or FTL_LOG_NONE */
+  uint16_t              blkper;     /* Pages per erase block */
+  uint16_t              sumcap;     /* Entries per summary page */
+  uint16_t              wp;         /* Next page of the head block */
+  uint16_t              npending;   /* Entries not yet summarised */
+  uint8_t               erasestate;
+  bool                  ingc;
+  FAR uint32_t         *map;        /* Logical sector -> physical page */
+  FAR uint32_t         *pending;    /* Entries not yet summarised */
+  FAR struct ftl_log_block_s *blocks;
+  FAR uint8_t          *pgbuf;      /* Data page */
+  FAR uint8_t          *sumbuf;     /* Summary or header being written */
+  FAR uint8_t          *gcbuf;      /* Summary being read */
+  struct ftl_stats_s    stats;
+};
+
+/* Used to replay the blocks newest first at start-up */
+
+struct ftl_log_order_s
+{
+  uint32_t seq;
+  uint32_t block;
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int ftl_log_append(FAR struct ftl_log_s *log, uint32_t lpn,
+                          FAR const uint8_t *data);
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ftl_log_isblank
+ ****************************************************************************/
+
+static bool ftl_log_isblank(FAR struct ftl_log_s *log,
+                            FAR const uint8_t *buf)
+{
+  uint32_t i;
+
+  for (i = 0; i < log->blocksize; i++)
+    {
+      if (buf[i] != log->erasestate)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+
+/****************************************************************************
+ * Name: ftl_log_readpage
+ ****************************************************************************/
+
+static int ftl_log_readpage(FAR struct ftl_log_s *log, uint32_t page,
+                            FAR uint8_t *buf)
+{
+  ssize_t ret;
+
+  ret = MTD_BREAD(log->mtd, page, 1, buf);
+  if (ret == 1 || ret == -EUCLEAN)
+    {
+      return OK;
+    }
+
+  ferr("ERROR: Read page %" PRIu32 " failed: %zd\n", page, ret);
+  return ret < 0 ? (int)ret : -EIO;
+}
+
+/****************************************************************************
+ * Name: ftl_log_program
+ ****************************************************************************/
+
+static int ftl_log_program(FAR struct ftl_log_s *log, uint32_t page,
+                           FAR const uint8_t *buf)
+{
+  ssize_t ret;
+
+  log->stats.flashwrites++;
+  ret = MTD_BWRITE(log->mtd, page, 1, buf);
+  if (ret == 1)
+    {
+      return OK;
+    }
+
+  ferr("ERROR: Write page %" PRIu32 " failed: %zd\n", page, ret);
+  return ret < 0 ? (int)ret : -EIO;
+}
+
+/****************************************************************************
+ * Name: ftl_log_sumcrc
+ ****************************************************************************/
+
+static uint32_t ftl_log_sumcrc(FAR const struct ftl_log_summary_s *sum)
+{
+  uint32_t crc;
+
+  crc = crc32((FAR const uint8_t *)sum,
+              offsetof(struct ftl_log_summary_s, crc));
+  return crc32part((FAR const uint8_t *)(sum + 1),
+                   sum->count * sizeof(uint32_t), crc);
+}
+
+/****************************************************************************
+ * Name: ftl_log_getsum
+ *
+ * Description:
+ *   Return the summary in buf if it is a valid summary stored at page
+ *   index 'page' of its block, otherwise NULL.
+ *
+ ****************************************************************************/
+
+static FAR struct ftl_log_summary_s *
+ftl_log_getsum(FAR struct ftl_log_s *log, FAR uint8_t *buf, uint16_t page)
+{
+  FAR struct ftl_log_summary_s *sum = (FAR struct ftl_log_summary_s *)buf;
+  FAR const uint32_t *ent = (FAR const uint32_t *)(sum + 1);
+  uint32_t npages = 0;
+  uint16_t i;
+
+  if (sum->magic != FTL_LOG_SUM_MAGIC || sum->count > log->sumcap + 1 ||
+      sum->prev >= page || ftl_log_sumcrc(sum) != sum->crc)
+    {
+      return NULL;
+    }
+
+  for (i = 0; i < sum->count; i++)
+    {
+      if ((ent[i] & FTL_LOG_BLANKENT) == 0)
+        {
+          npages++;
+        }
+    }
+
+  return sum->prev + 1 + npages == page ? sum : NULL;
+}
+
+/****************************************************************************
+ * Name: ftl_log_setmap
+ *
+ * Description:
+ *   Point lpn at a new location and keep the live page counts in step.
+ *
+ ****************************************************************************/
+
+static void ftl_log_setmap(FAR struct ftl_log_s *log, uint32_t lpn,
+                           uint32_t page)
+{
+  uint32_t old = log->map[lpn];
+
+  if (old < FTL_LOG_BLANK)
+    {
+      log->blocks[old / log->blkper].valid--;
+    }
+
+  if (page < FTL_LOG_BLANK)
+    {
+      log->blocks[page / log->blkper].valid++;
+    }
+
+  log->map[lpn] = page;
+}
+
+/****************************************************************************
+ * Name: ftl_log_format
+ *
+ * Description:
+ *   Erase a block and write its header.  A block that fails is marked bad
+ *   and retired.
+ *
+ ****************************************************************************/
+
+static int ftl_log_format(FAR struct ftl_log_s *log, uint32_t block)
+{
+  FAR struct ftl_log_block_s *blk = &log->blocks[block];
+  FAR struct ftl_log_header_s *hdr;
+  int ret;
+
+  DEBUGASSERT(blk->valid == 0 && blk->state == FTL_LOG_USED);
+
+  log->stats.erases++;
+  ret = MTD_ERASE(log->mtd, block, 1);
+  if (ret >= 0)
+    {
+      blk->erasecount++;
+
+      hdr = (FAR struct ftl_log_header_s *)log->sumbuf;
+      memset(log->sumbuf, log->erasestate, log->blocksize);
+      hdr->magic      = FTL_LOG_HDR_MAGIC;
+      hdr->erasecount = blk->erasecount;
+      hdr->crc        = crc32((FAR const uint8_t *)hdr,
+                              offsetof(struct ftl_log_header_s, crc));
+
+      ret = ftl_log_program(log, block * log->blkper, log->sumbuf);
+    }
+
+  if (ret < 0)
+    {
+      ferr("ERROR: Retiring block %" PRIu32 ": %d\n", block, ret);
+      MTD_MARKBAD(log->mtd, block);
+      blk->state = FTL_LOG_BAD;
+      return ret;
+    }
+
+  blk->state   = FTL_LOG_FREE;
+  blk->seq     = 0;
+  blk->lastsum = 0;
+  log->nfree++;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_log_close
+ *
+ * Description:
+ *   Retire the head block.  Live pages that could not be summarised are
+ *   dropped, since nothing on flash refers to them any more.
+ *
+ ****************************************************************************/
+
+static void ftl_log_close(FAR struct ftl_log_s *log)
+{
+  FAR struct ftl_log_block_s *blk = &log->blocks[log->head];
+  uint32_t page = log->head * log->blkper + blk->lastsum + 1;
+  uint16_t i;
+
+  for (i = 0; i < log->npending; i++)
+    {
+      uint32_t ent = log->pending[i];
+
+      if ((ent & FTL_LOG_BLANKENT) != 0)
+        {
+          continue;
+        }
+
+      if (ent < log->nsectors && log->map[ent] == page)
+        {
+          ferr("ERROR: Lost sector %" PRIu32 "\n", ent);
+          ftl_log_setmap(log, ent, FTL_LOG_NONE);
+        }
+
+      page++;
+    }
+
+  log->npending = 0;
+  blk->state    = FTL_LOG_USED;
+  log->head     = FTL_LOG_NONE;
+}
+
+/****************************************************************************
+ * Name: ftl_log_commit
+ *
+ * Description:
+ *   Write a summary of the pending entries to the head block.  A failed
+ *   summary page is recorded as a hole and the next page is tried.
+ *
+ ****************************************************************************/
+
+static int ftl_log_commit(FAR struct ftl_log_s *log)
+{
+  FAR struct ftl_log_block_s *blk = &log->blocks[log->head];
+  FAR struct ftl_log_summary_s *sum;
+  int ret;
+
+  while (log->npending > 0)
+    {
+      sum = (FAR struct ftl_log_summary_s *)log->sumbuf;
+      memset(log->sumbuf, log->erasestate, log->blocksize);
+      sum->magic = FTL_LOG_SUM_MAGIC;
+      sum->seq   = blk->seq;
+      sum->prev  = blk->lastsum;
+      sum->count = log->npending;
+      memcpy(sum + 1, log->pending, log->npending * sizeof(uint32_t));
+      sum->crc   = ftl_log_sumcrc(sum);
+
+      ret = ftl_log_program(log, log->head * log->blkper + log->wp,
+                            log->sumbuf);
+      if (ret >= 0)
+        {
+          blk->lastsum  = log->wp++;
+          log->npending = 0;
+          break;
+        }
+
+      /* One entry is always kept in reserve for this */
+
+      log->pending[log->npending++] = FTL_LOG_HOLE;
+      if (++log->wp >= log->blkper || log->npending > log->sumcap)
+        {
+          ftl_log_close(log);
+          return ret;
+        }
+    }
+
+  if (log->wp >= log->blkper)
+    {
+      ftl_log_close(log);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_log_gc
+ *
+ * Description:
+ *   Reclaim one block.  Its live pages are appended to the head block and
+ *   summarised before the block is erased, so an interruption at any point
+ *   leaves a copy of every sector on flash.
+ *
+ ****************************************************************************/
+
+static int ftl_log_gc(FAR struct ftl_log_s *log)
+{
+  FAR struct ftl_log_summary_s *sum;
+  FAR struct ftl_log_block_s *blk;
+  FAR const uint32_t *ent;
+  uint32_t victim = FTL_LOG_NONE;
+  uint32_t minec = UINT32_MAX;
+  uint32_t maxec = 0;
+  uint32_t base;
+  uint32_t cost;
+  uint32_t b;
+  uint16_t page;
+  uint16_t s;
+  int ret = OK;
+  int i;
+
+  for (b = 0; b < log->nblocks; b++)
+    {
+      blk = &log->blocks[b];
+      if (blk->state != FTL_LOG_BAD)
+        {
+          minec = MIN(minec, blk->erasecount);
+          maxec = MAX(maxec, blk->erasecount);
+        }
+    }
+
+  /* Static wear leveling: recycle the least worn block holding data */
+
+  if (log->stats.gcruns % FTL_LOG_WL_INTERVAL == 0 &&
+      maxec - minec > CONFIG_FTL_LOG_WL_THRESHOLD)
+    {
+      for (b = 0; b < log->nblocks; b++)
+        {
+          blk = &log->blocks[b];
+          if (blk->state == FTL_LOG_USED &&
+              (victim == FTL_LOG_NONE ||
+               blk->erasecount < log->blocks[victim].erasecount))
+            {
+              victim = b;
+            }
+        }
+
+      if (victim != FTL_LOG_NONE)
+        {
+          log->stats.wlmoves++;
+        }
+    }
+
+  /* Otherwise the block with the fewest live pages, least worn first */
+
+  if (victim == FTL_LOG_NONE)
+    {
+      for (b = 0; b < log->nblocks; b++)
+        {
+          blk = &log->blocks[b];
+          if (blk->state == FTL_LOG_USED &&
+              (victim == FTL_LOG_NONE ||
+               blk->valid < log->blocks[victim].valid ||
+               (blk->valid == log->blocks[victim].valid &&
+                blk->erasecount < log->blocks[victim].erasecount)))
+            {
+              victim = b;
+            }
+        }
+
+      if (victim == FTL_LOG_NONE)
+        {
+          return -ENOSPC;
+        }
+
+      /* Give up if moving the live pages takes as much room as it frees */
+
+      blk  = &log->blocks[victim];
+      cost = blk->valid + (blk->valid + log->sumcap - 1) / log->sumcap;
+      if (cost >= log->blkper - 1U)
+        {
+          return -ENOSPC;
+        }
+    }
+
+  log->stats.gcruns++;
+  log->ingc = true;
+
+  blk  = &log->blocks[victim];
+  base = victim * log->blkper;
+
+  for (s = blk->lastsum; s != 0; s = sum->prev)
+    {
+      ret = ftl_log_readpage(log, base + s, log->gcbuf);
+      if (ret < 0)
+        {
+          goto out;
+        }
+
+      sum = ftl_log_getsum(log, log->gcbuf, s);
+      if (sum == NULL)
+        {
+          ferr("ERROR: Bad summary at block %" PRIu32 " page %u\n",
+               victim, s);
+          ret = -EIO;
+          goto out;
+        }
+
+      /* Walk the entries backwards from the summary itself */
+
+      ent  = (FAR const uint32_t *)(sum + 1);
+      page = s;
+      for (i = sum->count - 1; i >= 0; i--)
+        {
+          uint32_t lpn = ent[i] & ~FTL_LOG_BLANKENT;
+
+          if ((ent[i] & FTL_LOG_BLANKENT) != 0)
+            {
+              /* Carry forward a blank record that is still current, or an
+               * older copy would come back after the next restart.
+               */
+
+              if (lpn < log->nsectors && log->map[lpn] == FTL_LOG_BLANK)
+                {
+                  ret = ftl_log_append(log, lpn, NULL);
+                }
+            }
+          else
+            {
+              page--;
+              if (lpn < log->nsectors && log->map[lpn] == base + page)
+                {
+                  ret = ftl_log_readpage(log, base + page, log->pgbuf);
+                  if (ret >= 0)
+                    {
+                      log->stats.gccopies++;
+                      ret = ftl_log_append(log, lpn, log->pgbuf);
+                    }
+                }
+            }
+
+          if (ret < 0)
+            {
+              goto out;
+            }
+        }
+    }
+
+  /* Make the copies durable before the originals go away */
+
+  if (log->head != FTL_LOG_NONE)
+    {
+      ret = ftl_log_commit(log);
+      if (ret < 0)
+        {
+          goto out;
+        }
+    }
+
+  if (blk->valid != 0)
+    {
+      ferr("ERROR: %u live pages left in block %" PRIu32 "\n",
+           blk->valid, victim);
+      ret = -EIO;
+      goto out;
+    }
+
+  ret = ftl_log_format(log, victim);
+
+out:
+  log->ingc = false;
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ftl_log_open
+ *
+ * Description:
+ *   Make the least worn free block the head block, collecting garbage
+ *   first if the free pool has run down to the reserve.
+ *
+ ****************************************************************************/
+
+static int ftl_log_open(FAR struct ftl_log_s *log)
+{
+  FAR struct ftl_log_block_s *blk;
+  uint32_t best = FTL_LOG_NONE;
+  uint32_t b;
+  int ret;
+
+  while (!log->ingc && log->nfree <= CONFIG_FTL_LOG_RESERVE)
+    {
+      ret = ftl_log_gc(log);
+      if (ret < 0)
+        {
+          return ret;
+        }
+
+      /* The collection may have left a head block open */
+
+      if (log->head != FTL_LOG_NONE)
+        {
+          return OK;
+        }
+    }
+
+  for (b = 0; b < log->nblocks; b++)
+    {
+      blk = &log->blocks[b];
+      if (blk->state == FTL_LOG_FREE &&
+          (best == FTL_LOG_NONE ||
+           blk->erasecount < log->blocks[best].erasecount))
+        {
+          best = b;
+        }
+    }
+
+  if (best == FTL_LOG_NONE)
+    {
+      return -ENOSPC;
+    }
+
+  blk          = &log->blocks[best];
+  blk->state   = FTL_LOG_OPEN;
+  blk->seq     = ++log->seq;
+  blk->lastsum = 0;
+  log->nfree--;
+  log->head     = best;
+  log->wp       = 1;
+  log->npending = 0;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_log_append
+ *
+ * Description:
+ *   Record one sector in the head block.  data == NULL, or data that reads
+ *   as erased, only adds a blank entry to the next summary.
+ *
+ ****************************************************************************/
+
+static int ftl_log_append(FAR struct ftl_log_s *log, uint32_t lpn,
+                          FAR const uint8_t *data)
+{
+  uint32_t page;
+  int ret;
+
+  if (data != NULL && ftl_log_isblank(log, data))
+    {
+      data = NULL;
+    }
+
+  /* Make room for the entry and, for data, a page that still leaves one
+   * for the summary.
+   */
+
+  for (; ; )
+    {
+      if (log->head != FTL_LOG_NONE)
+        {
+          if (log->npending < log->sumcap &&
+              (data == NULL || log->wp + 1U < log->blkper))
+            {
+              break;
+            }
+
+          if (log->npending > 0)
+            {
+              ret = ftl_log_commit(log);
+              if (ret < 0)
+                {
+                  return ret;
+                }
+            }
+          else
+            {
+              ftl_log_close(log);
+            }
+        }
+      else
+        {
+          ret = ftl_log_open(log);
+          if (ret < 0)
+            {
+              return ret;
+            }
+        }
+    }
+
+  if (data == NULL)
+    {
+      log->pending[log->npending++] = lpn | FTL_LOG_BLANKENT;
+      ftl_log_setmap(log, lpn, FTL_LOG_BLANK);
+      return OK;
+    }
+
+  page = log->head * log->blkper + log->wp++;
+  ret  = ftl_log_program(log, page, data);
+  if (ret < 0)
+    {
+      log->pending[log->npending++] = FTL_LOG_HOLE;
+      return ret;
+    }
+
+  log->pending[log->npending++] = lpn;
+  ftl_log_setmap(log, lpn, page);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: ftl_log_compare
+ ****************************************************************************/
+
+static int ftl_log_compare(FAR const void *a, FAR const void *b)
+{
+  FAR const struct ftl_log_order_s *oa = a;
+  FAR const struct ftl_log_order_s *ob = b;
+
+  /* Newest first */
+
+  return oa->seq < ob->seq ? 1 : oa->seq > ob->seq ? -1 : 0;
+}
+
+/****************************************************************************
+ * Name: ftl_log_scanblock
+ *
+ * Description:
+ *   Recover the erase count, state, sequence number and last summary of
+ *   one block.
+ *
+ ****************************************************************************/
+
+static void ftl_log_scanblock(FAR struct ftl_log_s *log, uint32_t block)
+{
+  FAR struct ftl_log_block_s *blk = &log->blocks[block];
+  FAR struct ftl_log_header_s *hdr;
+  FAR struct ftl_log_summary_s *sum;
+  uint32_t base = block * log->blkper;
+  uint16_t lo;
+  uint16_t hi;
+  uint16_t mid;
+  uint16_t p;
+
+  /* Anything that does not carry our header is reclaimed on demand */
+
+  blk->state = FTL_LOG_USED;
+
+  if (MTD_ISBAD(log->mtd, block) > 0)
+    {
+      blk->state = FTL_LOG_BAD;
+      return;
+    }
+
+  hdr = (FAR struct ftl_log_header_s *)log->pgbuf;
+  if (ftl_log_readpage(log, base, log->pgbuf) < 0 ||
+      hdr->magic != FTL_LOG_HDR_MAGIC ||
+      hdr->crc != crc32((FAR const uint8_t *)hdr,
+                        offsetof(struct ftl_log_header_s, crc)))
+    {
+      return;
+    }
+
+  blk->erasecount = hdr->erasecount;
+
+  /* Pages are programmed in order and never with the erased pattern, so
+   * the first erased page can be found by bisection.
+   */
+
+  lo = 1;
+  hi = log->blkper;
+  while (lo < hi)
+    {
+      mid = lo + (hi - lo) / 2;
+      if (ftl_log_readpage(log, base + mid, log->pgbuf) >= 0 &&
+          ftl_log_isblank(log, log->pgbuf))
+        {
+          hi = mid;
+        }
+      else
+        {
+          lo = mid + 1;
+        }
+    }
+
+  if (lo == 1)
+    {
+      blk->state = FTL_LOG_FREE;
+      log->nfree++;
+      return;
+    }
+
+  /* Pages written after the last summary were never acknowledged */
+
+  for (p = lo - 1; p > 0 && lo - p <= log->sumcap + 2; p--)
+    {
+      if (ftl_log_readpage(log, base + p, log->gcbuf) >= 0 &&
+          (sum = ftl_log_getsum(log, log->gcbuf, p)) != NULL)
+        {
+          blk->lastsum = p;
+          blk->seq     = sum->seq;
+          log->seq     = MAX(log->seq, sum->seq);
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: ftl_log_replay
+ *
+ * Description:
+ *   Rebuild the map from the summaries of one block.  Blocks are replayed
+ *   newest first and within a block the entries are walked backwards, so
+ *   the first entry seen for a sector is the current one.
+ *
+ ****************************************************************************/
+
+static void ftl_log_replay(FAR struct ftl_log_s *log, uint32_t block)
+{
+  FAR struct ftl_log_summary_s *sum;
+  FAR const uint32_t *ent;
+  uint32_t base = block * log->blkper;
+  uint16_t page;
+  uint16_t s;
+  int i;
+
+  for (s = log->blocks[block].lastsum; s != 0; s = sum->prev)
+    {
+      if (ftl_log_readpage(log, base + s, log->gcbuf) < 0 ||
+          (sum = ftl_log_getsum(log, log->gcbuf, s)) == NULL)
+        {
+          ferr("ERROR: Bad summary at block %" PRIu32 " page %u\n",
+               block, s);
+          break;
+        }
+
+      ent  = (FAR const uint32_t *)(sum + 1);
+      page = s;
+      for (i = sum->count - 1; i >= 0; i--)
+        {
+          uint32_t lpn = ent[i] & ~FTL_LOG_BLANKENT;
+
+          if ((ent[i] & FTL_LOG_BLANKENT) != 0)
+            {
+              if (lpn < log->nsectors && log->map[lpn] == FTL_LOG_NONE)
+                {
+                  log->map[lpn] = FTL_LOG_BLANK;
+                }
+            }
+          else
+            {
+              page--;
+              if (lpn < log->nsectors && log->map[lpn] == FTL_LOG_NONE)
+                {
+                  log->map[lpn] = base + page;
+                  log->blocks[block].valid++;
+                }
+            }
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: ftl_log_mount
+ ****************************************************************************/
+
+static int ftl_log_mount(FAR struct ftl_log_s *log)
+{
+  FAR struct ftl_log_order_s *order;
+  uint32_t norder = 0;
+  uint32_t b;
+
+  order = kmm_malloc(log->nblocks * sizeof(*order));
+  if (order == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (b = 0; b < log->nblocks; b++)
+    {
+      ftl_log_scanblock(log, b);
+      if (log->blocks[b].lastsum != 0)
+        {
+          order[norder].seq     = log->blocks[b].seq;
+          order[norder++].block = b;
+        }
+    }
+
+  qsort(order, norder, sizeof(*order), ftl_log_compare);
+
+  for (b = 0; b < norder; b++)
+    {
+      ftl_log_replay(log, order[b].block);
+    }
+
+  kmm_free(order);
+
+  finfo("%" PRIu32 " sectors, %" PRIu32 " free blocks, seq %" PRIu32 "\n",
+        log->nsectors, log->nfree, log->seq);
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ftl_log_initialize
+ ****************************************************************************/
+
+int ftl_log_initialize(FAR struct ftl_log_s **log, FAR struct mtd_dev_s *mtd,
+                       FAR const struct mtd_geometry_s *geo)
+{
+  FAR struct ftl_log_s *dev;
+  uint32_t blkper;
+  uint32_t sumcap;
+  uint32_t dpb;
+  uint64_t nsectors;
+  uint8_t erasestate;
+  int ret;
+
+  blkper = geo->erasesize / geo->blocksize;
+  if (blkper < 4 || blkper > UINT16_MAX ||
+      geo->blocksize < sizeof(struct ftl_log_summary_s) +
+                       2 * sizeof(uint32_t) ||
+      geo->neraseblocks <= CONFIG_FTL_LOG_RESERVE + 1)
+    {
+      return -EINVAL;
+    }
+
+  /* One entry per summary is kept back for recording a failed program */
+
+  sumcap = (geo->blocksize - sizeof(struct ftl_log_summary_s)) /
+           sizeof(uint32_t) - 1;
+  sumcap = MIN(sumcap, UINT16_MAX - 1);
+
+  /* Data pages per block once the header and summaries are accounted for,
+   * then hold back the collection reserve, the head block and the
+   * over-provisioned share.  The raw block count is used so that the size
+   * does not change as blocks go bad.
+   */
+
+  dpb      = blkper - 1 - (blkper - 1 + sumcap) / (sumcap + 1);
+  nsectors = (uint64_t)(geo->neraseblocks - CONFIG_FTL_LOG_RESERVE - 1) *
+             dpb * (100 - CONFIG_FTL_LOG_OVERPROVISION) / 100;
+  if (nsectors == 0 || nsectors >= FTL_LOG_HOLE)
+    {
+      return -EINVAL;
+    }
+
+  if (MTD_IOCTL(mtd, MTDIOC_ERASESTATE,
+                (unsigned long)((uintptr_t)&erasestate)) < 0)
+    {
+      erasestate = 0xff;
+    }
+
+  dev = kmm_zalloc(sizeof(struct ftl_log_s));
+  if (dev == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  nxmutex_init(&dev->lock);
+  dev->mtd        = mtd;
+  dev->blocksize  = geo->blocksize;
+  dev->nblocks    = geo->neraseblocks;
+  dev->nsectors   = nsectors;
+  dev->head       = FTL_LOG_NONE;
+  dev->blkper     = blkper;
+  dev->sumcap     = sumcap;
+  dev->erasestate = erasestate;
+
+  ret          = -ENOMEM;
+  dev->map     = kmm_malloc(nsectors * sizeof(uint32_t));
+  dev->pending = kmm_malloc((sumcap + 1) * sizeof(uint32_t));
+  dev->blocks  = kmm_zalloc(dev->nblocks * sizeof(struct ftl_log_block_s));
+  dev->pgbuf   = kmm_malloc(geo->blocksize);
+  dev->sumbuf  = kmm_malloc(geo->blocksize);
+  dev->gcbuf   = kmm_malloc(geo->blocksize);
+  if (dev->map == NULL || dev->pending == NULL || dev->blocks == NULL ||
+      dev->pgbuf == NULL || dev->sumbuf == NULL || dev->gcbuf == NULL)
+    {
+      goto errout;
+    }
+
+  memset(dev->map, 0xff, nsectors * sizeof(uint32_t));
+
+  ret = ftl_log_mount(dev);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  *log = dev;
+  return OK;
+
+errout:
+  ftl_log_uninitialize(dev);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ftl_log_uninitialize
+ ****************************************************************************/
+
+void ftl_log_uninitialize(FAR struct ftl_log_s *log)
+{
+  if (log != NULL)
+    {
+      nxmutex_destroy(&log->lock);
+      kmm_free(log->map);
+      kmm_free(log->pending);
+      kmm_free(log->blocks);
+      kmm_free(log->pgbuf);
+      kmm_free(log->sumbuf);
+      kmm_free(log->gcbuf);
+      kmm_free(log);
+    }
+}
+
+/****************************************************************************
+ * Name: ftl_log_nsectors
+ ****************************************************************************/
+
+blkcnt_t ftl_log_nsectors(FAR struct ftl_log_s *log)
+{
+  return log->nsectors;
+}
+
+/****************************************************************************
+ * Name: ftl_log_read
+ ****************************************************************************/
+
+ssize_t ftl_log_read(FAR struct ftl_log_s *log, FAR uint8_t *buffer,
+                     off_t startblock, size_t nblocks)
+{
+  size_t nread = 0;
+  ssize_t ret;
+
+  if (startblock < 0 || startblock + nblocks > log->nsectors)
+    {
+      return -ENOSPC;
+    }
+
+  ret = nxmutex_lock(&log->lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  while (nread < nblocks)
+    {
+      uint32_t page = log->map[startblock + nread];
+      size_t count = 1;
+
+      if (page >= FTL_LOG_BLANK)
+        {
+          memset(buffer, log->erasestate, log->blocksize);
+        }
+      else
+        {
+          /* Sectors written together usually sit next to each other */
+
+          while (nread + count < nblocks &&
+                 log->map[startblock + nread + count] == page + count &&
+                 (page + count) % log->blkper != 0)
+            {
+              count++;
+            }
+
+          ret = MTD_BREAD(log->mtd, page, count, buffer);
+          if (ret != (ssize_t)count && ret != -EUCLEAN)
+            {
+              ferr("ERROR: Read %zu pages at %" PRIu32 " failed: %zd\n",
+                   count, page, ret);
+              break;
+            }
+        }
+
+      nread  += count;
+      buffer += count * log->blocksize;
+    }
+
+  nxmutex_unlock(&log->lock);
+  return nread > 0 ? (ssize_t)nread : ret < 0 ? ret : -EIO;
+}
+
+/****************************************************************************
+ * Name: ftl_log_write
+ ****************************************************************************/
+
+ssize_t ftl_log_write(FAR struct ftl_log_s *log, FAR const uint8_t *buffer,
+                      off_t startblock, size_t nblocks)
+{
+  size_t nwritten;
+  int ret;
+
+  if (startblock < 0 || startblock + nblocks > log->nsectors)
+    {
+      return -ENOSPC;
+    }
+
+  ret = nxmutex_lock(&log->lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (nwritten = 0; nwritten < nblocks; nwritten++)
+    {
+      ret = ftl_log_append(log, startblock + nwritten, buffer);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      log->stats.hostwrites++;
+      buffer += log->blocksize;
+    }
+
+  /* Summarise what made it to flash, even after an error */
+
+  if (log->head != FTL_LOG_NONE && log->npending > 0)
+    {
+      int ret2 = ftl_log_commit(log);
+      if (ret2 < 0 && ret >= 0)
+        {
+          ret      = ret2;
+          nwritten = 0;
+        }
+    }
+
+  nxmutex_unlock(&log->lock);
+  return nwritten > 0 ? (ssize_t)nwritten : ret < 0 ? ret : 0;
+}
+
+/****************************************************************************
+ * Name: ftl_log_stats
+ ****************************************************************************/
+
+void ftl_log_stats(FAR struct ftl_log_s *log, FAR struct ftl_stats_s *stats)
+{
+  uint32_t b;
+
+  nxmutex_lock(&log->lock);
+
+  *stats          = log->stats;
+  stats->minerase = UINT32_MAX;
+  stats->maxerase = 0;
+  stats->nfree    = log->nfree;
+  stats->nbad     = 0;
+
+  for (b = 0; b < log->nblocks; b++)
+    {
+      FAR struct ftl_log_block_s *blk = &log->blocks[b];
+
+      if (blk->state == FTL_LOG_BAD)
+        {
+          stats->nbad++;
+          continue;
+        }
+
+      stats->minerase = MIN(stats->minerase, blk->erasecount);
+      stats->maxerase = MAX(stats->maxerase, blk->erasecount);
+    }
+
+  nxmutex_unlock(&log->lock);
+}
+
+#endif /* CONFIG_FTL_LOG */
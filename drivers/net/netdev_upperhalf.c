@@ -793,6 +793,34 @@ static int netdev_upper_txavail(FAR struct net_driver_s *dev)
   return OK;
 }
 
+/****************************************************************************
+ * Name: netdev_upper_rxpoll
+ *
+ * Description:
+ *   Receive the packets waiting in the lower half on the calling CPU, for
+ *   a task that busy polls the device (SO_BUSY_POLL).
+ *
+ * Input Parameters:
+ *   dev - Reference to the NuttX driver state structure
+ *
+ * Assumptions:
+ *   Called with the network locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_BUSY_POLL
+static int netdev_upper_rxpoll(FAR struct net_driver_s *dev)
+{
+  FAR struct netdev_upperhalf_s *upper = dev->d_private;
+
+  /* Same as the bottom half: RX first, then send the replies */
+
+  netdev_upper_rxpoll_work(upper);
+  netdev_upper_txavail_work(upper);
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: netdev_upper_wireless_ioctl
  *
@@ -1215,6 +1243,9 @@ int netdev_lower_register(FAR struct netdev_lowerhalf_s *dev,
 #endif
 #ifdef CONFIG_NETDEV_IOCTL
   dev->netdev.d_ioctl   = netdev_upper_ioctl;
+#endif
+#ifdef CONFIG_NET_BUSY_POLL
+  dev->netdev.d_rxpoll  = netdev_upper_rxpoll;
 #endif
   dev->netdev.d_private = upper;
 
@@ -40,6 +40,10 @@
 #include <nuttx/kmalloc.h>
 #include <nuttx/circbuf.h>
 #include <nuttx/mutex.h>
+#include <nuttx/mm/map.h>
+#include <nuttx/sched.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wdog.h>
 #include <nuttx/sensors/sensor.h>
 #include <nuttx/lib/lib.h>
 
@@ -52,6 +56,13 @@
 #define ROUND_DOWN(x, y)    (((x) / (y)) * (y))
 #define DEVNAME_FMT         "/dev/uorb/sensor_%s%d"
 #define TIMING_BUF_ESIZE    (sizeof(uint32_t))
+#define SENSOR_GROUP_PATH   "/dev/uorbgroup"
+
+/* The slot of sample n, from the kernel copy of the ring geometry */
+
+#define SENSOR_RING_KSLOT(upper, n) \
+  ((FAR uint8_t *)((upper)->ring + 1) + \
+   ((n) % (upper)->ringnbuffer) * (upper)->ringstride)
 
 /****************************************************************************
  * Private Types
@@ -102,6 +113,16 @@ struct sensor_user_s
   bool             flushing;   /* The is used to indicate user is flushing */
   sem_t            buffersem;  /* Wakeup user waiting for data in circular buffer */
   size_t           bufferpos;  /* The index of user generation in buffer */
+#ifdef CONFIG_SENSORS_MMAP
+  FAR struct sensor_upperhalf_s *upper; /* The topic, for munmap() */
+  unsigned int     mapped;              /* Live mappings made by the user */
+  bool             closed;              /* Freed with the last mapping */
+  uint32_t         ringseen;            /* Ring head at the last POLLIN */
+#endif
+#ifdef CONFIG_SENSORS_GROUP
+  FAR struct sensor_group_s *group; /* The wait group of the user */
+  int              groupidx;        /* The index of the user in the group */
+#endif
 
   /* The subscriber info
    * Support multi advertisers to subscribe their own data when they
@@ -111,6 +132,36 @@ struct sensor_user_s
   struct sensor_ustate_s state;
 };
 
+/* This structure describes a wait group, which gives one wakeup for new
+ * samples on any of a set of subscribed topics
+ */
+
+#ifdef CONFIG_SENSORS_GROUP
+struct sensor_group_member_s
+{
+  FAR struct file *filep;      /* Reference to the topic file, NULL if free */
+  int              fd;         /* The descriptor reported to the subscriber */
+  uint32_t         count;      /* Samples published since the last read */
+};
+
+struct sensor_group_s
+{
+  mutex_t          lock;       /* Serializes membership changes and reads */
+  spinlock_t       spinlock;   /* Protects fds and the pending state */
+  FAR struct pollfd *fds;      /* The poll structure of the waiting thread */
+  sem_t            waitsem;    /* Wakeup the thread blocked in read */
+  struct wdog_s    wdog;       /* Fires when the latency bound expires */
+  uint32_t         latency;    /* The batch latency in us, 0: no bound */
+  uint32_t         watermark;  /* Samples that complete a batch */
+  uint32_t         nsamples;   /* Samples published since the last read */
+  uint32_t         pending;    /* Bitmap of members with new samples */
+  bool             ready;      /* The batch is complete */
+  bool             closing;    /* The watchdog must not use the group */
+  bool             wdbusy;     /* The watchdog callback is running */
+  struct sensor_group_member_s members[CONFIG_SENSORS_GROUP_NMEMBERS];
+};
+#endif
+
 /* This structure describes the state of the upper half driver */
 
 struct sensor_upperhalf_s
@@ -121,6 +172,20 @@ struct sensor_upperhalf_s
   struct circbuf_s   buffer;             /* The circular buffer of data */
   rmutex_t           lock;               /* Manages exclusive access to file operations */
   struct list_node   userlist;           /* List of users */
+#ifdef CONFIG_SENSORS_MMAP
+  FAR struct sensor_ring_s *ring;        /* Ring shared with mmap() users */
+
+  /* User space can write to the ring, so the kernel keeps its own copy
+   * of the geometry and of the head and never reads them back.
+   */
+
+  uint32_t           ringesize;          /* The size of one sample */
+  uint32_t           ringnbuffer;        /* The number of slots */
+  uint32_t           ringstride;         /* The size of one slot */
+  uint32_t           ringhead;           /* The number of samples published */
+  unsigned int       ringmaps;           /* Live mappings of the ring */
+  bool               unregistered;       /* Freed with the last mapping */
+#endif
 };
 
 /****************************************************************************
@@ -137,10 +202,27 @@ static ssize_t sensor_write(FAR struct file *filep, FAR const char *buffer,
                             size_t buflen);
 static int     sensor_ioctl(FAR struct file *filep, int cmd,
                             unsigned long arg);
+#ifdef CONFIG_SENSORS_MMAP
+static int     sensor_mmap(FAR struct file *filep,
+                           FAR struct mm_map_entry_s *map);
+static int     sensor_munmap(FAR struct task_group_s *group,
+                             FAR struct mm_map_entry_s *map,
+                             FAR void *start, size_t length);
+#endif
 static int     sensor_poll(FAR struct file *filep, FAR struct pollfd *fds,
                            bool setup);
 static ssize_t sensor_push_event(FAR void *priv, FAR const void *data,
                                  size_t bytes);
+#ifdef CONFIG_SENSORS_GROUP
+static int     sensor_group_open(FAR struct file *filep);
+static int     sensor_group_close(FAR struct file *filep);
+static ssize_t sensor_group_read(FAR struct file *filep, FAR char *buffer,
+                                 size_t buflen);
+static int     sensor_group_ioctl(FAR struct file *filep, int cmd,
+                                  unsigned long arg);
+static int     sensor_group_poll(FAR struct file *filep,
+                                 FAR struct pollfd *fds, bool setup);
+#endif
 
 /****************************************************************************
  * Private Data
@@ -228,11 +310,30 @@ static const struct file_operations g_sensor_fops =
   sensor_write,   /* write */
   NULL,           /* seek  */
   sensor_ioctl,   /* ioctl */
+#ifdef CONFIG_SENSORS_MMAP
+  sensor_mmap,    /* mmap */
+#else
   NULL,           /* mmap */
+#endif
   NULL,           /* truncate */
   sensor_poll     /* poll  */
 };
 
+#ifdef CONFIG_SENSORS_GROUP
+static const struct file_operations g_sensor_group_fops =
+{
+  sensor_group_open,  /* open */
+  sensor_group_close, /* close */
+  sensor_group_read,  /* read */
+  NULL,               /* write */
+  NULL,               /* seek */
+  sensor_group_ioctl, /* ioctl */
+  NULL,               /* mmap */
+  NULL,               /* truncate */
+  sensor_group_poll,  /* poll */
+};
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
@@ -569,6 +670,155 @@ static ssize_t sensor_do_samples(FAR struct sensor_upperhalf_s *upper,
   return ret;
 }
 
+static void sensor_upper_free(FAR struct sensor_upperhalf_s *upper)
+{
+  nxrmutex_destroy(&upper->lock);
+  if (circbuf_is_init(&upper->buffer))
+    {
+      circbuf_uninit(&upper->buffer);
+      circbuf_uninit(&upper->timing);
+    }
+
+#ifdef CONFIG_SENSORS_MMAP
+  kumm_free(upper->ring);
+#endif
+
+  kmm_free(upper);
+}
+
+#ifdef CONFIG_SENSORS_MMAP
+static void sensor_ring_publish(FAR struct sensor_upperhalf_s *upper,
+                                FAR const void *data, unsigned long nums)
+{
+  FAR const uint8_t *src = data;
+  FAR uint8_t *slot;
+  uint32_t head;
+
+  if (upper->ring == NULL)
+    {
+      return;
+    }
+
+  /* Samples that would be overwritten in this same call are skipped, but
+   * still counted so that subscribers see them as lost.
+   */
+
+  head = upper->ringhead;
+  if (nums > upper->ringnbuffer)
+    {
+      src  += (nums - upper->ringnbuffer) * upper->ringesize;
+      head += nums - upper->ringnbuffer;
+      nums  = upper->ringnbuffer;
+    }
+
+  while (nums-- > 0)
+    {
+      /* The odd sequence keeps readers away while the slot is rewritten */
+
+      slot = SENSOR_RING_KSLOT(upper, head);
+      atomic_xchg((FAR atomic_t *)slot, 2 * head + 1);
+      memcpy(slot + SENSOR_RING_DATA, src, upper->ringesize);
+      atomic_set_release((FAR atomic_t *)slot, 2 * head + 2);
+
+      src += upper->ringesize;
+      head++;
+    }
+
+  upper->ringhead = head;
+  atomic_set_release(&upper->ring->head, head);
+}
+#endif
+
+#ifdef CONFIG_SENSORS_GROUP
+static void sensor_group_wakeup(FAR struct sensor_group_s *group)
+{
+  irqstate_t flags;
+  int semcount;
+
+  nxsem_get_value(&group->waitsem, &semcount);
+  if (semcount < 1)
+    {
+      nxsem_post(&group->waitsem);
+    }
+
+  /* Publishers and the watchdog race with poll setup and teardown */
+
+  flags = spin_lock_irqsave(&group->spinlock);
+  poll_notify(&group->fds, 1, POLLIN);
+  spin_unlock_irqrestore(&group->spinlock, flags);
+}
+
+static void sensor_group_timeout(wdparm_t arg)
+{
+  FAR struct sensor_group_s *group = (FAR struct sensor_group_s *)arg;
+  irqstate_t flags;
+  bool wakeup = false;
+
+  flags = spin_lock_irqsave(&group->spinlock);
+  if (group->closing)
+    {
+      spin_unlock_irqrestore(&group->spinlock, flags);
+      return;
+    }
+
+  /* Tell sensor_group_close() to wait until we are done with the group */
+
+  group->wdbusy = true;
+  if (group->pending != 0 && !group->ready)
+    {
+      group->ready = true;
+      wakeup = true;
+    }
+
+  spin_unlock_irqrestore(&group->spinlock, flags);
+  if (wakeup)
+    {
+      sensor_group_wakeup(group);
+    }
+
+  flags = spin_lock_irqsave(&group->spinlock);
+  group->wdbusy = false;
+  spin_unlock_irqrestore(&group->spinlock, flags);
+}
+
+static void sensor_group_notify(FAR struct sensor_user_s *user,
+                                unsigned long nums)
+{
+  FAR struct sensor_group_s *group = user->group;
+  irqstate_t flags;
+  bool wakeup = false;
+  bool first;
+
+  flags = spin_lock_irqsave(&group->spinlock);
+  first = group->pending == 0;
+  group->pending |= 1u << user->groupidx;
+  group->members[user->groupidx].count += nums;
+  group->nsamples += nums;
+  if (!group->ready && group->nsamples >= group->watermark)
+    {
+      group->ready = true;
+      wakeup = true;
+    }
+
+  spin_unlock_irqrestore(&group->spinlock, flags);
+
+  /* The latency bound starts with the first sample of a batch, the same
+   * way a hardware fifo batches its samples.
+   */
+
+  if (wakeup)
+    {
+      wd_cancel(&group->wdog);
+      sensor_group_wakeup(group);
+    }
+  else if (first && group->latency > 0)
+    {
+      wd_start(&group->wdog, USEC2TICK(group->latency),
+               sensor_group_timeout, (wdparm_t)group);
+    }
+}
+#endif
+
 static void sensor_pollnotify_one(FAR struct sensor_user_s *user,
                                   pollevent_t eventset,
                                   sensor_role_t role)
@@ -692,6 +942,7 @@ static int sensor_close(FAR struct file *filep)
   FAR struct sensor_upperhalf_s *upper = inode->i_private;
   FAR struct sensor_lowerhalf_s *lower = upper->lower;
   FAR struct sensor_user_s *user = filep->f_priv;
+  bool freeuser = true;
   int ret = 0;
 
   nxrmutex_lock(&upper->lock);
@@ -727,12 +978,23 @@ static int sensor_close(FAR struct file *filep)
   sensor_update_interval(filep, upper, user, UINT32_MAX);
   nxsem_destroy(&user->buffersem);
 
+#ifdef CONFIG_SENSORS_MMAP
+  /* The mappings of the user outlive the descriptor */
+
+  user->closed = user->mapped > 0;
+  freeuser = !user->closed;
+#endif
+
   /* The user is closed, notify to other users */
 
   sensor_pollnotify(upper, POLLPRI, SENSOR_ROLE_WR);
   nxrmutex_unlock(&upper->lock);
 
-  kmm_free(user);
+  if (freeuser)
+    {
+      kmm_free(user);
+    }
+
   return ret;
 }
 
@@ -914,7 +1176,11 @@ static int sensor_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
       case SNIOC_SET_BUFFER_NUMBER:
         {
           nxrmutex_lock(&upper->lock);
-          if (!circbuf_is_init(&upper->buffer))
+          if (!circbuf_is_init(&upper->buffer)
+#ifdef CONFIG_SENSORS_MMAP
+              && upper->ring == NULL
+#endif
+             )
             {
               if (arg1 >= lower->nbuffer)
                 {
@@ -1063,6 +1329,15 @@ static int sensor_poll(FAR struct file *filep,
                 }
             }
         }
+#ifdef CONFIG_SENSORS_MMAP
+      else if (user->mapped)
+        {
+          if (upper->ringhead != user->ringseen)
+            {
+              eventset |= POLLIN;
+            }
+        }
+#endif
       else if (sensor_is_updated(upper, user))
         {
           eventset |= POLLIN;
@@ -1077,6 +1352,17 @@ static int sensor_poll(FAR struct file *filep,
     }
   else
     {
+#ifdef CONFIG_SENSORS_MMAP
+      /* Everything published up to here is visible to the subscriber once
+       * poll() returns, so it will not be reported again.
+       */
+
+      if (user->mapped)
+        {
+          user->ringseen = upper->ringhead;
+        }
+#endif
+
       user->fds = NULL;
       fds->priv = NULL;
     }
@@ -1086,6 +1372,116 @@ errout:
   return ret;
 }
 
+#ifdef CONFIG_SENSORS_MMAP
+static int sensor_mmap(FAR struct file *filep,
+                       FAR struct mm_map_entry_s *map)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct sensor_upperhalf_s *upper = inode->i_private;
+  FAR struct sensor_lowerhalf_s *lower = upper->lower;
+  FAR struct sensor_user_s *user = filep->f_priv;
+  size_t size;
+  int ret = OK;
+
+  /* Drivers that fetch on demand have no buffer to share */
+
+  if (lower->ops->fetch != NULL)
+    {
+      return -ENOTSUP;
+    }
+
+  nxrmutex_lock(&upper->lock);
+  size = SENSOR_RING_SIZE(upper->state.esize, lower->nbuffer);
+  if (map->offset != 0 || map->length == 0 || map->length > size)
+    {
+      ret = -EINVAL;
+      goto out;
+    }
+
+  if (upper->ring == NULL)
+    {
+      /* The ring is read directly by user space */
+
+      upper->ring = kumm_zalloc(size);
+      if (upper->ring == NULL)
+        {
+          ret = -ENOMEM;
+          goto out;
+        }
+
+      upper->ringesize   = upper->state.esize;
+      upper->ringnbuffer = lower->nbuffer;
+      upper->ringstride  = SENSOR_RING_STRIDE(upper->state.esize);
+      upper->ringhead    = 0;
+
+      upper->ring->esize   = upper->ringesize;
+      upper->ring->nbuffer = upper->ringnbuffer;
+      upper->ring->stride  = upper->ringstride;
+    }
+
+  map->vaddr  = upper->ring;
+  map->priv.p = user;
+  map->munmap = sensor_munmap;
+  ret = mm_map_add(get_current_mm(), map);
+  if (ret < 0)
+    {
+      goto out;
+    }
+
+  user->upper    = upper;
+  user->mapped++;
+  user->ringseen = upper->ringhead;
+  upper->ringmaps++;
+
+out:
+  nxrmutex_unlock(&upper->lock);
+  return ret;
+}
+
+static int sensor_munmap(FAR struct task_group_s *group,
+                         FAR struct mm_map_entry_s *map,
+                         FAR void *start, size_t length)
+{
+  FAR struct sensor_user_s *user = map->priv.p;
+  FAR struct sensor_upperhalf_s *upper = user->upper;
+  bool freeupper;
+  bool freeuser;
+  int ret;
+
+  /* The ring is shared, so it is only unmapped as a whole */
+
+  if (start != map->vaddr || length < map->length)
+    {
+      return -ENOSYS;
+    }
+
+  ret = mm_map_remove(get_group_mm(group), map);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  nxrmutex_lock(&upper->lock);
+  user->mapped--;
+  upper->ringmaps--;
+  freeuser  = user->closed && user->mapped == 0;
+  freeupper = upper->unregistered && upper->ringmaps == 0;
+  nxrmutex_unlock(&upper->lock);
+
+  if (freeuser)
+    {
+      kmm_free(user);
+    }
+
+  if (freeupper)
+    {
+      sensor_upper_free(upper);
+    }
+
+  return OK;
+}
+#endif
+
 static ssize_t sensor_push_event(FAR void *priv, FAR const void *data,
                                  size_t bytes)
 {
@@ -1145,6 +1541,9 @@ static ssize_t sensor_push_event(FAR void *priv, FAR const void *data,
 
   circbuf_overwrite(&upper->buffer, data, bytes);
   sensor_generate_timing(upper, envcount);
+#ifdef CONFIG_SENSORS_MMAP
+  sensor_ring_publish(upper, data, envcount);
+#endif
   list_for_every_entry(&upper->userlist, user, struct sensor_user_s, node)
     {
       if (sensor_is_updated(upper, user))
@@ -1156,6 +1555,13 @@ static ssize_t sensor_push_event(FAR void *priv, FAR const void *data,
             }
 
           sensor_pollnotify_one(user, POLLIN, SENSOR_ROLE_RD);
+#ifdef CONFIG_SENSORS_GROUP
+          if (user->group != NULL)
+            {
+              sensor_group_notify(user, user->state.interval == UINT32_MAX ?
+                                        envcount : 1);
+            }
+#endif
         }
     }
 
@@ -1179,11 +1585,366 @@ static void sensor_notify_event(FAR void *priv)
         }
 
       sensor_pollnotify_one(user, POLLIN, SENSOR_ROLE_RD);
+#ifdef CONFIG_SENSORS_GROUP
+      if (user->group != NULL)
+        {
+          sensor_group_notify(user, 1);
+        }
+#endif
     }
 
   nxrmutex_unlock(&upper->lock);
 }
 
+#ifdef CONFIG_SENSORS_GROUP
+static int sensor_group_attach(FAR struct sensor_group_s *group, int fd)
+{
+  FAR struct sensor_upperhalf_s *upper;
+  FAR struct sensor_user_s *user;
+  FAR struct file *filep;
+  int ret;
+  int i;
+
+  ret = file_get(fd, &filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if (filep->f_inode == NULL ||
+      filep->f_inode->u.i_ops != &g_sensor_fops)
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  for (i = 0; i < CONFIG_SENSORS_GROUP_NMEMBERS; i++)
+    {
+      if (group->members[i].filep == NULL)
+        {
+          break;
+        }
+    }
+
+  if (i == CONFIG_SENSORS_GROUP_NMEMBERS)
+    {
+      ret = -ENOSPC;
+      goto errout;
+    }
+
+  upper = filep->f_inode->i_private;
+  user  = filep->f_priv;
+
+  nxrmutex_lock(&upper->lock);
+  if (!(user->role & SENSOR_ROLE_RD))
+    {
+      ret = -EACCES;
+    }
+  else if (user->group != NULL)
+    {
+      ret = -EBUSY;
+    }
+  else
+    {
+      if (group->latency > 0)
+        {
+          sensor_update_latency(filep, upper, user, group->latency);
+        }
+
+      /* The group keeps the file reference until the topic is removed */
+
+      group->members[i].filep = filep;
+      group->members[i].fd    = fd;
+      group->members[i].count = 0;
+      user->groupidx = i;
+      user->group    = group;
+
+      if (sensor_is_updated(upper, user))
+        {
+          sensor_group_notify(user, 1);
+        }
+    }
+
+  nxrmutex_unlock(&upper->lock);
+  if (ret >= 0)
+    {
+      return ret;
+    }
+
+errout:
+  file_put(filep);
+  return ret;
+}
+
+static void sensor_group_detach(FAR struct sensor_group_s *group, int i)
+{
+  FAR struct file *filep = group->members[i].filep;
+  FAR struct sensor_upperhalf_s *upper = filep->f_inode->i_private;
+  FAR struct sensor_user_s *user = filep->f_priv;
+  irqstate_t flags;
+
+  nxrmutex_lock(&upper->lock);
+  user->group = NULL;
+  nxrmutex_unlock(&upper->lock);
+
+  flags = spin_lock_irqsave(&group->spinlock);
+  group->nsamples -= group->members[i].count;
+  group->pending &= ~(1u << i);
+  group->members[i].filep = NULL;
+  if (group->pending == 0)
+    {
+      group->ready = false;
+    }
+
+  spin_unlock_irqrestore(&group->spinlock, flags);
+
+  file_put(filep);
+}
+
+static int sensor_group_open(FAR struct file *filep)
+{
+  FAR struct sensor_group_s *group;
+
+  group = kmm_zalloc(sizeof(struct sensor_group_s));
+  if (group == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  nxmutex_init(&group->lock);
+  spin_lock_init(&group->spinlock);
+  nxsem_init(&group->waitsem, 0, 0);
+  group->watermark = 1;
+
+  filep->f_priv = group;
+  return OK;
+}
+
+static int sensor_group_close(FAR struct file *filep)
+{
+  FAR struct sensor_group_s *group = filep->f_priv;
+  irqstate_t flags;
+  int i;
+
+  nxmutex_lock(&group->lock);
+  for (i = 0; i < CONFIG_SENSORS_GROUP_NMEMBERS; i++)
+    {
+      if (group->members[i].filep != NULL)
+        {
+          sensor_group_detach(group, i);
+        }
+    }
+
+  nxmutex_unlock(&group->lock);
+
+  /* No publisher can start the watchdog any more, but on SMP its callback
+   * may already run on another CPU, where wd_cancel() cannot stop it.
+   * Wait for it to let go of the group before freeing it.
+   */
+
+  flags = spin_lock_irqsave(&group->spinlock);
+  group->closing = true;
+  spin_unlock_irqrestore(&group->spinlock, flags);
+
+  wd_cancel(&group->wdog);
+
+  flags = spin_lock_irqsave(&group->spinlock);
+  while (group->wdbusy)
+    {
+      spin_unlock_irqrestore(&group->spinlock, flags);
+      UP_RELAX();
+      flags = spin_lock_irqsave(&group->spinlock);
+    }
+
+  spin_unlock_irqrestore(&group->spinlock, flags);
+
+  nxsem_destroy(&group->waitsem);
+  nxmutex_destroy(&group->lock);
+  kmm_free(group);
+  return OK;
+}
+
+static ssize_t sensor_group_read(FAR struct file *filep, FAR char *buffer,
+                                 size_t buflen)
+{
+  FAR struct sensor_group_s *group = filep->f_priv;
+  FAR struct sensor_group_event_s *event =
+    (FAR struct sensor_group_event_s *)buffer;
+  irqstate_t flags;
+  size_t nevents = 0;
+  int ret;
+  int i;
+
+  if (buffer == NULL || buflen < sizeof(struct sensor_group_event_s))
+    {
+      return -EINVAL;
+    }
+
+  while (!group->ready)
+    {
+      if (filep->f_oflags & O_NONBLOCK)
+        {
+          return -EAGAIN;
+        }
+
+      ret = nxsem_wait(&group->waitsem);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  nxmutex_lock(&group->lock);
+  flags = spin_lock_irqsave(&group->spinlock);
+  for (i = 0; i < CONFIG_SENSORS_GROUP_NMEMBERS &&
+              buflen - nevents * sizeof(*event) >= sizeof(*event); i++)
+    {
+      if (group->pending & (1u << i))
+        {
+          event[nevents].fd    = group->members[i].fd;
+          event[nevents].count = group->members[i].count;
+          nevents++;
+
+          group->nsamples -= group->members[i].count;
+          group->members[i].count = 0;
+          group->pending &= ~(1u << i);
+        }
+    }
+
+  /* Topics that did not fit stay pending and the group stays ready */
+
+  if (group->pending == 0)
+    {
+      group->ready = false;
+      wd_cancel(&group->wdog);
+    }
+
+  spin_unlock_irqrestore(&group->spinlock, flags);
+  nxmutex_unlock(&group->lock);
+
+  if (nevents == 0)
+    {
+      return -EAGAIN;
+    }
+
+  return nevents * sizeof(*event);
+}
+
+static int sensor_group_ioctl(FAR struct file *filep, int cmd,
+                              unsigned long arg)
+{
+  FAR struct sensor_group_s *group = filep->f_priv;
+  FAR struct sensor_upperhalf_s *upper;
+  FAR struct file *member;
+  int ret = OK;
+  int i;
+
+  nxmutex_lock(&group->lock);
+  switch (cmd)
+    {
+      case SNIOC_GROUP_ADD:
+        {
+          ret = sensor_group_attach(group, (int)arg);
+        }
+        break;
+
+      case SNIOC_GROUP_REMOVE:
+        {
+          ret = -ENOENT;
+          for (i = 0; i < CONFIG_SENSORS_GROUP_NMEMBERS; i++)
+            {
+              if (group->members[i].filep != NULL &&
+                  group->members[i].fd == (int)arg)
+                {
+                  sensor_group_detach(group, i);
+                  ret = OK;
+                  break;
+                }
+            }
+        }
+        break;
+
+      case SNIOC_GROUP_WATERMARK:
+        {
+          if (arg == 0)
+            {
+              ret = -EINVAL;
+              break;
+            }
+
+          group->watermark = arg;
+        }
+        break;
+
+      case SNIOC_BATCH:
+        {
+          /* Ask every member topic to batch at the same bound, so that the
+           * samples arrive in as few publications as possible.
+           */
+
+          group->latency = arg;
+          for (i = 0; i < CONFIG_SENSORS_GROUP_NMEMBERS; i++)
+            {
+              member = group->members[i].filep;
+              if (member == NULL)
+                {
+                  continue;
+                }
+
+              upper = member->f_inode->i_private;
+              nxrmutex_lock(&upper->lock);
+              sensor_update_latency(member, upper, member->f_priv, arg);
+              nxrmutex_unlock(&upper->lock);
+            }
+        }
+        break;
+
+      default:
+        ret = -ENOTTY;
+        break;
+    }
+
+  nxmutex_unlock(&group->lock);
+  return ret;
+}
+
+static int sensor_group_poll(FAR struct file *filep,
+                             FAR struct pollfd *fds, bool setup)
+{
+  FAR struct sensor_group_s *group = filep->f_priv;
+  irqstate_t flags;
+  int ret = OK;
+
+  nxmutex_lock(&group->lock);
+  flags = spin_lock_irqsave(&group->spinlock);
+  if (setup)
+    {
+      if (group->fds)
+        {
+          ret = -ENOSPC;
+          goto out;
+        }
+
+      group->fds = fds;
+      fds->priv  = filep;
+      if (group->ready)
+        {
+          poll_notify(&group->fds, 1, POLLIN);
+        }
+    }
+  else
+    {
+      group->fds = NULL;
+      fds->priv  = NULL;
+    }
+
+out:
+  spin_unlock_irqrestore(&group->spinlock, flags);
+  nxmutex_unlock(&group->lock);
+  return ret;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -1442,12 +2203,41 @@ void sensor_custom_unregister(FAR struct sensor_lowerhalf_s *lower,
   sensor_rpmsg_unregister(lower);
 #endif
 
-  nxrmutex_destroy(&upper->lock);
-  if (circbuf_is_init(&upper->buffer))
+#ifdef CONFIG_SENSORS_MMAP
+  /* The ring is freed with its last mapping, not under its users */
+
+  nxrmutex_lock(&upper->lock);
+  if (upper->ringmaps > 0)
     {
-      circbuf_uninit(&upper->buffer);
-      circbuf_uninit(&upper->timing);
+      upper->unregistered = true;
+      nxrmutex_unlock(&upper->lock);
+      return;
     }
 
-  kmm_free(upper);
+  nxrmutex_unlock(&upper->lock);
+#endif
+
+  sensor_upper_free(upper);
 }
+
+/****************************************************************************
+ * Name: sensor_group_initialize
+ *
+ * Description:
+ *   This function registers the "/dev/uorbgroup" character node.  Every
+ *   open of the node creates a wait group: topics are added with
+ *   SNIOC_GROUP_ADD and a single poll() or read() on the group reports the
+ *   topics with new samples once a batch is complete.
+ *
+ * Returned Value:
+ *   OK on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SENSORS_GROUP
+int sensor_group_initialize(void)
+{
+  return register_driver(SENSOR_GROUP_PATH, &g_sensor_group_fops, 0666,
+                         NULL);
+}
+#endif
@@ -53,6 +53,8 @@
 #include <nuttx/list.h>
 #include <nuttx/irq.h>
 
+#include "ramlog.h"
+
 #ifdef CONFIG_RAMLOG
 
 /****************************************************************************
@@ -74,19 +76,8 @@ struct ramlog_header_s
 
 struct ramlog_user_s
 {
-  struct list_node  rl_node;       /* The list_node of reader */
-  volatile uint32_t rl_tail;       /* The tail index (where data is removed) */
-  uint32_t          rl_threashold; /* The threshold of the reader to read log */
-#ifndef CONFIG_RAMLOG_NONBLOCKING
-  sem_t             rl_waitsem;    /* Used to wait for data */
-#endif
-
-  /* The following the poll structures of threads waiting for driver events.
-   * The 'struct pollfd' reference for each open is also  retained in the
-   * f_priv field of the 'struct file'.
-   */
-
-  FAR struct pollfd *rl_fds;
+  struct ramlog_reader_s rl_reader; /* Must be first, see ramlog_readerused */
+  volatile uint32_t      rl_tail;   /* The tail index (where data is removed) */
 };
 
 struct ramlog_dev_s
@@ -106,13 +97,6 @@ struct ramlog_dev_s
  * Private Function Prototypes
  ****************************************************************************/
 
-/* Helper functions */
-
-#ifndef CONFIG_RAMLOG_NONBLOCKING
-static void    ramlog_readnotify(FAR struct ramlog_dev_s *priv);
-#endif
-static void    ramlog_pollnotify(FAR struct ramlog_dev_s *priv);
-
 /* Character driver methods */
 
 static int     ramlog_file_open(FAR struct file *filep);
@@ -185,55 +169,13 @@ static uint32_t ramlog_bufferused(FAR struct ramlog_dev_s *priv,
 }
 
 /****************************************************************************
- * Name: ramlog_readnotify
+ * Name: ramlog_readerused
  ****************************************************************************/
 
-#ifndef CONFIG_RAMLOG_NONBLOCKING
-static void ramlog_readnotify(FAR struct ramlog_dev_s *priv)
+static uint32_t ramlog_readerused(FAR void *priv,
+                                  FAR struct ramlog_reader_s *reader)
 {
-  FAR struct ramlog_user_s *upriv;
-
-  /* Notify all waiting readers that they can read from the FIFO */
-
-  list_for_every_entry(&priv->rl_list, upriv, struct ramlog_user_s, rl_node)
-    {
-      for (; ; )
-        {
-          int semcount = 0;
-
-          nxsem_get_value(&upriv->rl_waitsem, &semcount);
-          if (semcount >= 0)
-            {
-              break;
-            }
-
-          nxsem_post(&upriv->rl_waitsem);
-        }
-    }
-}
-#endif
-
-/****************************************************************************
- * Name: ramlog_pollnotify
- ****************************************************************************/
-
-static void ramlog_pollnotify(FAR struct ramlog_dev_s *priv)
-{
-  FAR struct ramlog_user_s *upriv;
-
-  /* This function may be called from an interrupt handler */
-
-  list_for_every_entry(&priv->rl_list, upriv, struct ramlog_user_s, rl_node)
-    {
-      if (ramlog_bufferused(priv, upriv) >= upriv->rl_threashold)
-        {
-          /* Notify all poll/select waiters that they can read from
-           * the FIFO
-           */
-
-          poll_notify(&upriv->rl_fds, 1, POLLIN);
-        }
-    }
+  return ramlog_bufferused(priv, (FAR struct ramlog_user_s *)reader);
 }
 
 /****************************************************************************
@@ -245,7 +187,8 @@ static void ramlog_bufferflush(FAR struct ramlog_dev_s *priv)
   FAR struct ramlog_user_s *upriv;
 
   priv->rl_header->rl_head = 0;
-  list_for_every_entry(&priv->rl_list, upriv, struct ramlog_user_s, rl_node)
+  list_for_every_entry(&priv->rl_list, upriv, struct ramlog_user_s,
+                       rl_reader.rl_node)
     {
       upriv->rl_tail = 0;
     }
@@ -321,28 +264,7 @@ static ssize_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
 
   if (len > 0)
     {
-      /* Lock the scheduler do NOT switch out */
-
-      if (!up_interrupt_context())
-        {
-          sched_lock();
-        }
-
-#ifndef CONFIG_RAMLOG_NONBLOCKING
-      /* Are there threads waiting for read data? */
-
-      ramlog_readnotify(priv);
-#endif
-      /* Notify all poll/select waiters that they can read from the FIFO */
-
-      ramlog_pollnotify(priv);
-
-      /* Unlock the scheduler */
-
-      if (!up_interrupt_context())
-        {
-          sched_unlock();
-        }
+      ramlog_notify(&priv->rl_list, ramlog_readerused, priv);
     }
 
   /* We always have to return the number of bytes requested and NOT the
@@ -422,7 +344,7 @@ static ssize_t ramlog_file_read(FAR struct file *filep, FAR char *buffer,
            * but will be re-enabled while we are waiting.
            */
 
-          ret = nxsem_wait(&upriv->rl_waitsem);
+          ret = nxsem_wait(&upriv->rl_reader.rl_waitsem);
 
           /* Did we successfully get the rl_waitsem? */
 
@@ -516,7 +438,7 @@ static int ramlog_file_ioctl(FAR struct file *filep, int cmd,
         *(FAR int *)((uintptr_t)arg) = ramlog_bufferused(priv, upriv);
         break;
       case PIPEIOC_POLLINTHRD:
-        upriv->rl_threashold = (uint32_t)arg;
+        upriv->rl_reader.rl_threashold = (uint32_t)arg;
         break;
       case BIOC_FLUSH:
         ramlog_bufferflush(priv);
@@ -555,17 +477,18 @@ static int ramlog_file_poll(FAR struct file *filep, FAR struct pollfd *fds,
        * slot for the poll structure reference.
        */
 
-      if (!upriv->rl_fds)
+      if (!upriv->rl_reader.rl_fds)
         {
-          upriv->rl_fds = fds;
-          fds->priv     = &upriv->rl_fds;
+          upriv->rl_reader.rl_fds = fds;
+          fds->priv               = &upriv->rl_reader.rl_fds;
         }
 
       /* Should immediately notify on any of the requested events? */
 
       /* Check if the receive buffer is not empty. */
 
-      if (ramlog_bufferused(priv, upriv) >= upriv->rl_threashold)
+      if (ramlog_bufferused(priv, upriv) >=
+          upriv->rl_reader.rl_threashold)
         {
           eventset |= POLLIN;
         }
@@ -608,13 +531,13 @@ static int ramlog_file_open(FAR struct file *filep)
       return -ENOMEM;
     }
 
-  upriv->rl_threashold = CONFIG_RAMLOG_POLLTHRESHOLD;
+  upriv->rl_reader.rl_threashold = CONFIG_RAMLOG_POLLTHRESHOLD;
 #ifndef CONFIG_RAMLOG_NONBLOCKING
-  nxsem_init(&upriv->rl_waitsem, 0, 0);
+  nxsem_init(&upriv->rl_reader.rl_waitsem, 0, 0);
 #endif
 
   flags = enter_critical_section();
-  list_add_tail(&priv->rl_list, &upriv->rl_node);
+  list_add_tail(&priv->rl_list, &upriv->rl_reader.rl_node);
   upriv->rl_tail = header->rl_head > priv->rl_bufsize ?
                    header->rl_head - priv->rl_bufsize : 0;
   leave_critical_section(flags);
@@ -635,11 +558,11 @@ static int ramlog_file_close(FAR struct file *filep)
   /* Get exclusive access to the rl_tail index */
 
   flags = enter_critical_section();
-  list_delete(&upriv->rl_node);
+  list_delete(&upriv->rl_reader.rl_node);
   leave_critical_section(flags);
 
 #ifndef CONFIG_RAMLOG_NONBLOCKING
-  nxsem_destroy(&upriv->rl_waitsem);
+  nxsem_destroy(&upriv->rl_reader.rl_waitsem);
 #endif
   kmm_free(upriv);
   return 0;
@@ -0,0 +1,107 @@
+/****************************************************************************
+ * drivers/syslog/ramlog.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __DRIVERS_SYSLOG_RAMLOG_H
+#define __DRIVERS_SYSLOG_RAMLOG_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <poll.h>
+
+#include <nuttx/list.h>
+#include <nuttx/semaphore.h>
+
+#ifdef CONFIG_RAMLOG
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The part of an open RAMLOG that does not depend on the buffer layout.
+ * Each layout embeds it in its own per-open structure.
+ */
+
+struct ramlog_reader_s
+{
+  struct list_node  rl_node;       /* The list_node of reader */
+  uint32_t          rl_threashold; /* The threshold of the reader to read log */
+#ifndef CONFIG_RAMLOG_NONBLOCKING
+  sem_t             rl_waitsem;    /* Used to wait for data */
+#endif
+
+  /* The following the poll structures of threads waiting for driver events.
+   * The 'struct pollfd' reference for each open is also  retained in the
+   * f_priv field of the 'struct file'.
+   */
+
+  FAR struct pollfd *rl_fds;
+};
+
+/* Return the number of bytes that a reader has not read yet.  This may be
+ * called by a writer, so it must not modify the reader.
+ */
+
+typedef CODE uint32_t (*ramlog_used_t)(FAR void *priv,
+                                       FAR struct ramlog_reader_s *reader);
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: ramlog_notify
+ *
+ * Description:
+ *   Wake up the readers on 'list' that are blocked in read() and the
+ *   poll() waiters whose threshold is reached.  Must be called from within
+ *   a critical section.
+ *
+ * Input Parameters:
+ *   list - The list of struct ramlog_reader_s of the device
+ *   used - Returns the unread bytes of a reader
+ *   priv - The device, passed back to 'used'
+ *
+ ****************************************************************************/
+
+void ramlog_notify(FAR struct list_node *list, ramlog_used_t used,
+                   FAR void *priv);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_RAMLOG */
+#endif /* __DRIVERS_SYSLOG_RAMLOG_H */
@@ -0,0 +1,134 @@
+/****************************************************************************
+ * drivers/syslog/ramlog_common.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <poll.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/list.h>
+
+#include "ramlog.h"
+
+#ifdef CONFIG_RAMLOG
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ramlog_readnotify
+ ****************************************************************************/
+
+#ifndef CONFIG_RAMLOG_NONBLOCKING
+static void ramlog_readnotify(FAR struct list_node *list)
+{
+  FAR struct ramlog_reader_s *reader;
+
+  /* Notify all waiting readers that they can read from the FIFO */
+
+  list_for_every_entry(list, reader, struct ramlog_reader_s, rl_node)
+    {
+      for (; ; )
+        {
+          int semcount = 0;
+
+          nxsem_get_value(&reader->rl_waitsem, &semcount);
+          if (semcount >= 0)
+            {
+              break;
+            }
+
+          nxsem_post(&reader->rl_waitsem);
+        }
+    }
+}
+#endif
+
+/****************************************************************************
+ * Name: ramlog_pollnotify
+ ****************************************************************************/
+
+static void ramlog_pollnotify(FAR struct list_node *list,
+                              ramlog_used_t used, FAR void *priv)
+{
+  FAR struct ramlog_reader_s *reader;
+
+  /* This function may be called from an interrupt handler */
+
+  list_for_every_entry(list, reader, struct ramlog_reader_s, rl_node)
+    {
+      if (reader->rl_fds != NULL &&
+          used(priv, reader) >= reader->rl_threashold)
+        {
+          /* Notify all poll/select waiters that they can read from
+           * the FIFO
+           */
+
+          poll_notify(&reader->rl_fds, 1, POLLIN);
+        }
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ramlog_notify
+ ****************************************************************************/
+
+void ramlog_notify(FAR struct list_node *list, ramlog_used_t used,
+                   FAR void *priv)
+{
+  /* Lock the scheduler do NOT switch out */
+
+  if (!up_interrupt_context())
+    {
+      sched_lock();
+    }
+
+#ifndef CONFIG_RAMLOG_NONBLOCKING
+  /* Are there threads waiting for read data? */
+
+  ramlog_readnotify(list);
+#endif
+
+  /* Notify all poll/select waiters that they can read from the FIFO */
+
+  ramlog_pollnotify(list, used, priv);
+
+  /* Unlock the scheduler */
+
+  if (!up_interrupt_context())
+    {
+      sched_unlock();
+    }
+}
+
+#endif /* CONFIG_RAMLOG */
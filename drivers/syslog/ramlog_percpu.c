@@ -0,0 +1,1185 @@
+/****************************************************************************
+ * drivers/syslog/ramlog_percpu.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/* This is the per-CPU variant of the RAMLOG driver.  The RAM buffer is
+ * split into one segment per CPU.  A writer only ever touches the segment
+ * of the CPU it runs on, with local interrupts disabled, so concurrent
+ * logging from several CPUs never takes the global critical section.
+ *
+ * Every write is stored as a record (a small header followed by the
+ * payload).  Records are stamped with a global sequence number so that
+ * readers can merge the segments back into a single stream.  Writers
+ * overwrite the oldest records of their own segment when it is full;
+ * readers detect that by re-checking the oldest record index after each
+ * copy and silently resynchronize, like a sequence lock.
+ *
+ * Each segment also counts the payload bytes written, overwritten and
+ * flushed, so the number of unread bytes of a reader is computed in
+ * O(CONFIG_SMP_NCPUS) from those counters and the bytes the reader consumed,
+ * without walking the records.  Only the reader itself updates its read
+ * position.
+ *
+ * The critical section is only taken by a writer when there is a reader
+ * blocked in read() or poll(), to deliver the notification.
+ *
+ * Single characters from the syslog putc() interface are collected per CPU
+ * until a newline, so that a log line does not cost one record header per
+ * character.
+ */
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/ioctl.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <string.h>
+#include <poll.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <nuttx/arch.h>
+#include <nuttx/atomic.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/sched.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/ioctl.h>
+#include <nuttx/syslog/ramlog.h>
+#include <nuttx/compiler.h>
+#include <nuttx/list.h>
+#include <nuttx/irq.h>
+
+#include "ramlog.h"
+
+#ifdef CONFIG_RAMLOG_PERCPU
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* A different magic than the single ring layout, so that a warm reboot
+ * into a differently configured image re-initializes the buffer.
+ */
+
+#define RAMLOG_MAGIC_NUMBER   0x1234567d
+
+/* Segment control blocks are padded to this size so that two CPUs never
+ * write to the same cache line.
+ */
+
+#define RAMLOG_SEGMENT_ALIGN  64
+
+#define RAMLOG_RECORD_SIZE    sizeof(struct ramlog_record_s)
+
+/* Characters collected by ramlog_putc() before a record is written */
+
+#define RAMLOG_PUTC_SIZE      64
+
+/* Size of each per-CPU segment carved out of a buffer of 'n' bytes */
+
+#define RAMLOG_SEGSIZE(n) \
+  ((((n) - sizeof(struct ramlog_header_s)) / CONFIG_SMP_NCPUS) & ~3)
+
+/* Sequence numbers and indexes are free running and wrap around */
+
+#define RAMLOG_BEFORE(a, b)   ((int32_t)((uint32_t)(a) - (uint32_t)(b)) < 0)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct ramlog_record_s
+{
+  uint32_t rr_seq;             /* Global sequence number of the write */
+  uint32_t rr_len;             /* Number of payload bytes that follow */
+};
+
+struct ramlog_segment_s
+{
+  atomic_t rs_gen;             /* Odd while the writer updates the segment */
+  atomic_t rs_head;            /* Where the next record is added */
+  atomic_t rs_oldest;          /* Start of the oldest intact record */
+  atomic_t rs_wbytes;          /* Payload bytes before rs_head */
+  atomic_t rs_obytes;          /* Payload bytes before rs_oldest */
+  atomic_t rs_fbytes;          /* Payload bytes hidden by BIOC_FLUSH */
+  uint8_t  rs_pad[RAMLOG_SEGMENT_ALIGN - 6 * sizeof(atomic_t)];
+};
+
+/* A consistent copy of the indexes and counters of a segment */
+
+struct ramlog_segstate_s
+{
+  uint32_t head;
+  uint32_t oldest;
+  uint32_t wbytes;
+  uint32_t obytes;
+};
+
+struct ramlog_header_s
+{
+  uint32_t                rl_magic;    /* The rl_magic number for ramlog buffer init */
+  atomic_t                rl_seq;      /* The next global sequence number */
+  atomic_t                rl_flushseq; /* Records before this were flushed */
+  uint8_t                 rl_pad[RAMLOG_SEGMENT_ALIGN - 12];
+  struct ramlog_segment_s rl_segs[CONFIG_SMP_NCPUS];
+  char                    rl_buffer[]; /* Per-CPU circular RAM buffers */
+};
+
+struct ramlog_user_s
+{
+  struct ramlog_reader_s rl_reader; /* Must be first, see ramlog_readerused */
+  mutex_t                rl_lock;   /* Serializes readers of this open */
+
+  /* Per segment index of the next record to read, number of bytes of that
+   * record already returned to the reader and payload bytes consumed so
+   * far.  Only the reader updates these.
+   */
+
+  uint32_t               rl_tail[CONFIG_SMP_NCPUS];
+  uint32_t               rl_offset[CONFIG_SMP_NCPUS];
+  uint32_t               rl_rbytes[CONFIG_SMP_NCPUS];
+};
+
+struct ramlog_dev_s
+{
+  /* The following is the header of the RAM buffer, it holds the per-CPU
+   * segment indexes followed by the segments themselves.
+   */
+
+  FAR struct ramlog_header_s *rl_header;
+
+  uint32_t                   rl_segsize;  /* Size of each per-CPU segment */
+  atomic_t                   rl_nwaiters; /* Blocked readers and pollers */
+  struct list_node           rl_list;     /* The head of ramlog_user_s list */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* Character driver methods */
+
+static int     ramlog_file_open(FAR struct file *filep);
+static int     ramlog_file_close(FAR struct file *filep);
+static ssize_t ramlog_file_read(FAR struct file *filep, FAR char *buffer,
+                                size_t buflen);
+static ssize_t ramlog_file_write(FAR struct file *filep,
+                                 FAR const char *buffer, size_t buflen);
+static int     ramlog_file_ioctl(FAR struct file *filep, int cmd,
+                                 unsigned long arg);
+static int     ramlog_file_poll(FAR struct file *filep,
+                                FAR struct pollfd *fds, bool setup);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_ramlogfops =
+{
+  ramlog_file_open,  /* open */
+  ramlog_file_close, /* close */
+  ramlog_file_read,  /* read */
+  ramlog_file_write, /* write */
+  NULL,              /* seek */
+  ramlog_file_ioctl, /* ioctl */
+  NULL,              /* mmap */
+  NULL,              /* truncate */
+  ramlog_file_poll   /* poll */
+};
+
+/* Only used the first time a buffer without a valid magic is written */
+
+static spinlock_t g_ramlog_initlock = SP_UNLOCKED;
+
+/* This is the pre-allocated buffer used for the console RAM log and/or
+ * for the syslogging function.
+ */
+
+#ifdef CONFIG_RAMLOG_SYSLOG
+#  ifdef RAMLOG_BUFFER_SECTION
+static uint32_t g_sysbuffer[CONFIG_RAMLOG_BUFSIZE / 4]
+                       aligned_data(RAMLOG_SEGMENT_ALIGN)
+                       locate_data(RAMLOG_BUFFER_SECTION);
+#  else
+static uint32_t g_sysbuffer[CONFIG_RAMLOG_BUFSIZE / 4]
+                       aligned_data(RAMLOG_SEGMENT_ALIGN);
+#  endif
+
+/* This is the device structure for the console or syslogging function.  It
+ * must be statically initialized because the RAMLOG ramlog_putc function
+ * could be called before the driver initialization logic executes.
+ */
+
+static struct ramlog_dev_s g_sysdev =
+{
+  (FAR struct ramlog_header_s *)g_sysbuffer, /* rl_header */
+  RAMLOG_SEGSIZE(sizeof(g_sysbuffer)),       /* rl_segsize */
+  0,                                         /* rl_nwaiters */
+  LIST_INITIAL_VALUE(g_sysdev.rl_list)       /* rl_list */
+};
+
+/* Characters of ramlog_putc() not yet written, per CPU */
+
+static char     g_sysputc[CONFIG_SMP_NCPUS][RAMLOG_PUTC_SIZE];
+static uint32_t g_sysputclen[CONFIG_SMP_NCPUS];
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ramlog_segbuffer
+ ****************************************************************************/
+
+static inline FAR char *ramlog_segbuffer(FAR struct ramlog_dev_s *priv,
+                                         int cpu)
+{
+  return priv->rl_header->rl_buffer + cpu * priv->rl_segsize;
+}
+
+/****************************************************************************
+ * Name: ramlog_segread
+ *
+ * Description:
+ *   Copy out of a segment at the free running index 'pos', handling the
+ *   wrap around at the end of the segment.
+ *
+ ****************************************************************************/
+
+static void ramlog_segread(FAR struct ramlog_dev_s *priv, int cpu,
+                           uint32_t pos, FAR void *dest, size_t len)
+{
+  FAR char *buf = ramlog_segbuffer(priv, cpu);
+  uint32_t offset = pos % priv->rl_segsize;
+  uint32_t tail = priv->rl_segsize - offset;
+
+  if (len > tail)
+    {
+      memcpy(dest, &buf[offset], tail);
+      memcpy((FAR char *)dest + tail, buf, len - tail);
+    }
+  else
+    {
+      memcpy(dest, &buf[offset], len);
+    }
+}
+
+/****************************************************************************
+ * Name: ramlog_segwrite
+ ****************************************************************************/
+
+static void ramlog_segwrite(FAR struct ramlog_dev_s *priv, int cpu,
+                            uint32_t pos, FAR const void *src, size_t len)
+{
+  FAR char *buf = ramlog_segbuffer(priv, cpu);
+  uint32_t offset = pos % priv->rl_segsize;
+  uint32_t tail = priv->rl_segsize - offset;
+
+  if (len > tail)
+    {
+      memcpy(&buf[offset], src, tail);
+      memcpy(buf, (FAR const char *)src + tail, len - tail);
+    }
+  else
+    {
+      memcpy(&buf[offset], src, len);
+    }
+}
+
+/****************************************************************************
+ * Name: ramlog_initheader
+ ****************************************************************************/
+
+static void ramlog_initheader(FAR struct ramlog_dev_s *priv)
+{
+  FAR struct ramlog_header_s *header = priv->rl_header;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_ramlog_initlock);
+  if (header->rl_magic != RAMLOG_MAGIC_NUMBER)
+    {
+      memset(header, 0, sizeof(struct ramlog_header_s));
+      UP_DMB();
+      header->rl_magic = RAMLOG_MAGIC_NUMBER;
+    }
+
+  spin_unlock_irqrestore(&g_ramlog_initlock, flags);
+}
+
+/****************************************************************************
+ * Name: ramlog_segstate
+ *
+ * Description:
+ *   Take a consistent copy of the indexes and byte counters of a segment.
+ *   The writer of a segment keeps rs_gen odd while it updates them, it is
+ *   never blocked by readers.
+ *
+ ****************************************************************************/
+
+static void ramlog_segstate(FAR struct ramlog_dev_s *priv, int cpu,
+                            FAR struct ramlog_segstate_s *state)
+{
+  FAR struct ramlog_segment_s *seg = &priv->rl_header->rl_segs[cpu];
+  uint32_t gen;
+
+  for (; ; )
+    {
+      gen = atomic_read_acquire(&seg->rs_gen);
+      if ((gen & 1) != 0)
+        {
+          UP_RELAX();
+          continue;
+        }
+
+      UP_DMB();
+      state->head   = atomic_read(&seg->rs_head);
+      state->oldest = atomic_read(&seg->rs_oldest);
+      state->wbytes = atomic_read(&seg->rs_wbytes);
+      state->obytes = atomic_read(&seg->rs_obytes);
+      UP_DMB();
+
+      if (atomic_read(&seg->rs_gen) == gen)
+        {
+          break;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: ramlog_validtail
+ *
+ * Description:
+ *   Move the reader past records that were overwritten by the writer of
+ *   the segment.  Returns true if the reader had to be moved.  Only called
+ *   by the reader itself.
+ *
+ ****************************************************************************/
+
+static bool ramlog_validtail(FAR struct ramlog_dev_s *priv,
+                             FAR struct ramlog_user_s *upriv, int cpu,
+                             FAR struct ramlog_segstate_s *state)
+{
+  ramlog_segstate(priv, cpu, state);
+  if (RAMLOG_BEFORE(upriv->rl_tail[cpu], state->oldest))
+    {
+      upriv->rl_tail[cpu]   = state->oldest;
+      upriv->rl_offset[cpu] = 0;
+      upriv->rl_rbytes[cpu] = state->obytes;
+      return true;
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: ramlog_peek
+ *
+ * Description:
+ *   Return the header of the next unread, non-flushed record of a segment.
+ *   Returns false if the segment has nothing more to read.
+ *
+ ****************************************************************************/
+
+static bool ramlog_peek(FAR struct ramlog_dev_s *priv,
+                        FAR struct ramlog_user_s *upriv, int cpu,
+                        FAR struct ramlog_record_s *record)
+{
+  FAR struct ramlog_header_s *header = priv->rl_header;
+  uint32_t flushseq = atomic_read(&header->rl_flushseq);
+  struct ramlog_segstate_s state;
+
+  for (; ; )
+    {
+      ramlog_validtail(priv, upriv, cpu, &state);
+      if (upriv->rl_tail[cpu] == state.head)
+        {
+          return false;
+        }
+
+      ramlog_segread(priv, cpu, upriv->rl_tail[cpu], record,
+                     RAMLOG_RECORD_SIZE);
+
+      /* The header could have been overwritten while it was read */
+
+      if (ramlog_validtail(priv, upriv, cpu, &state))
+        {
+          continue;
+        }
+
+      if (record->rr_len > priv->rl_segsize - RAMLOG_RECORD_SIZE)
+        {
+          /* Should not happen, resynchronize at the segment head */
+
+          upriv->rl_tail[cpu]   = state.head;
+          upriv->rl_offset[cpu] = 0;
+          upriv->rl_rbytes[cpu] = state.wbytes;
+          return false;
+        }
+
+      if (!RAMLOG_BEFORE(record->rr_seq, flushseq))
+        {
+          return true;
+        }
+
+      /* Skip records that were discarded by BIOC_FLUSH */
+
+      upriv->rl_rbytes[cpu] += record->rr_len - upriv->rl_offset[cpu];
+      upriv->rl_tail[cpu]   += RAMLOG_RECORD_SIZE + record->rr_len;
+      upriv->rl_offset[cpu]  = 0;
+    }
+}
+
+/****************************************************************************
+ * Name: ramlog_readable
+ *
+ * Description:
+ *   Return true if the reader has a record to read in any segment.
+ *
+ ****************************************************************************/
+
+#ifndef CONFIG_RAMLOG_NONBLOCKING
+static bool ramlog_readable(FAR struct ramlog_dev_s *priv,
+                            FAR struct ramlog_user_s *upriv)
+{
+  struct ramlog_record_s record;
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      if (ramlog_peek(priv, upriv, cpu, &record))
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+#endif
+
+/****************************************************************************
+ * Name: ramlog_bufferused
+ *
+ * Description:
+ *   Return the number of payload bytes the reader has not read yet.  This
+ *   is called by writers to decide whether to notify a poller, so it only
+ *   works on copies and never modifies the reader.
+ *
+ ****************************************************************************/
+
+static uint32_t ramlog_bufferused(FAR struct ramlog_dev_s *priv,
+                                  FAR struct ramlog_user_s *upriv)
+{
+  FAR struct ramlog_header_s *header = priv->rl_header;
+  struct ramlog_segstate_s state;
+  uint32_t fbytes;
+  uint32_t used = 0;
+  uint32_t base;
+  int cpu;
+
+  if (header->rl_magic != RAMLOG_MAGIC_NUMBER)
+    {
+      return 0;
+    }
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      ramlog_segstate(priv, cpu, &state);
+      fbytes = atomic_read(&header->rl_segs[cpu].rs_fbytes);
+
+      /* Bytes that were overwritten or flushed are not readable anymore,
+       * even if the reader did not skip them yet.
+       */
+
+      base = upriv->rl_rbytes[cpu];
+      if (RAMLOG_BEFORE(base, state.obytes))
+        {
+          base = state.obytes;
+        }
+
+      if (RAMLOG_BEFORE(base, fbytes))
+        {
+          base = fbytes;
+        }
+
+      if (RAMLOG_BEFORE(base, state.wbytes))
+        {
+          used += state.wbytes - base;
+        }
+    }
+
+  return used;
+}
+
+/****************************************************************************
+ * Name: ramlog_readerused
+ ****************************************************************************/
+
+static uint32_t ramlog_readerused(FAR void *priv,
+                                  FAR struct ramlog_reader_s *reader)
+{
+  return ramlog_bufferused(priv, (FAR struct ramlog_user_s *)reader);
+}
+
+/****************************************************************************
+ * Name: ramlog_addbuf
+ ****************************************************************************/
+
+static ssize_t ramlog_addbuf(FAR struct ramlog_dev_s *priv,
+                             FAR const char *buffer, size_t len)
+{
+  FAR struct ramlog_header_s *header = priv->rl_header;
+  FAR struct ramlog_segment_s *seg;
+  struct ramlog_record_s record;
+  size_t buflen = len;
+  irqstate_t flags;
+  uint32_t dropped;
+  uint32_t oldest;
+  uint32_t head;
+  uint32_t need;
+  uint32_t gen;
+  int cpu;
+
+  if (len == 0)
+    {
+      return 0;
+    }
+
+  if (header->rl_magic != RAMLOG_MAGIC_NUMBER)
+    {
+      ramlog_initheader(priv);
+    }
+
+  /* Only local interrupts are disabled: this keeps us on this CPU and
+   * serializes against nested writes from interrupt handlers, which are
+   * the only other writers of this CPU's segment.
+   */
+
+  flags = up_irq_save();
+  cpu   = this_cpu();
+  seg   = &header->rl_segs[cpu];
+
+  if (buflen > priv->rl_segsize - RAMLOG_RECORD_SIZE)
+    {
+      buffer += buflen - (priv->rl_segsize - RAMLOG_RECORD_SIZE);
+      buflen = priv->rl_segsize - RAMLOG_RECORD_SIZE;
+    }
+
+  need   = RAMLOG_RECORD_SIZE + buflen;
+  head   = atomic_read(&seg->rs_head);
+  oldest = atomic_read(&seg->rs_oldest);
+
+  /* Let ramlog_segstate() retry until the indexes and counters match */
+
+  gen = atomic_read(&seg->rs_gen);
+  atomic_set(&seg->rs_gen, gen + 1);
+  UP_DMB();
+
+  /* Drop the oldest records until the new one fits.  The new oldest index
+   * must be visible to readers before the data is overwritten.
+   */
+
+  if (head + need - oldest > priv->rl_segsize)
+    {
+      dropped = 0;
+      do
+        {
+          ramlog_segread(priv, cpu, oldest, &record, RAMLOG_RECORD_SIZE);
+          oldest  += RAMLOG_RECORD_SIZE + record.rr_len;
+          dropped += record.rr_len;
+        }
+      while (head + need - oldest > priv->rl_segsize);
+
+      atomic_set(&seg->rs_obytes, atomic_read(&seg->rs_obytes) + dropped);
+      atomic_xchg(&seg->rs_oldest, oldest);
+      UP_DMB();
+    }
+
+  record.rr_seq = atomic_fetch_add(&header->rl_seq, 1);
+  record.rr_len = buflen;
+
+  ramlog_segwrite(priv, cpu, head, &record, RAMLOG_RECORD_SIZE);
+  ramlog_segwrite(priv, cpu, head + RAMLOG_RECORD_SIZE, buffer, buflen);
+
+  /* Publish the record */
+
+  UP_DMB();
+  atomic_set(&seg->rs_wbytes, atomic_read(&seg->rs_wbytes) + buflen);
+  atomic_set_release(&seg->rs_head, head + need);
+  UP_DMB();
+  atomic_set(&seg->rs_gen, gen + 2);
+  up_irq_restore(flags);
+
+  /* Only wake up readers if somebody is actually waiting, this is the only
+   * place where a writer takes the global critical section.
+   */
+
+  UP_DMB();
+  if (atomic_read(&priv->rl_nwaiters) > 0)
+    {
+      flags = enter_critical_section();
+      ramlog_notify(&priv->rl_list, ramlog_readerused, priv);
+      leave_critical_section(flags);
+    }
+
+  /* We always have to return the number of bytes requested and NOT the
+   * number of bytes that were actually written.  Otherwise, callers
+   * probably retry, causing same error condition again.
+   */
+
+  return len;
+}
+
+/****************************************************************************
+ * Name: ramlog_readmerge
+ *
+ * Description:
+ *   Copy records from all segments into the user buffer, oldest sequence
+ *   number first.  Returns the number of bytes copied.
+ *
+ ****************************************************************************/
+
+static ssize_t ramlog_readmerge(FAR struct ramlog_dev_s *priv,
+                                FAR struct ramlog_user_s *upriv,
+                                FAR char *buffer, size_t len)
+{
+  struct ramlog_segstate_s state;
+  struct ramlog_record_s record;
+  struct ramlog_record_s best;
+  uint32_t offset;
+  uint32_t ncopy;
+  ssize_t nread = 0;
+  int bestcpu;
+  int cpu;
+
+  if (priv->rl_header->rl_magic != RAMLOG_MAGIC_NUMBER)
+    {
+      return 0;
+    }
+
+  while ((size_t)nread < len)
+    {
+      /* Select the segment holding the oldest pending record */
+
+      bestcpu = -1;
+      for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+        {
+          if (ramlog_peek(priv, upriv, cpu, &record) &&
+              (bestcpu < 0 || RAMLOG_BEFORE(record.rr_seq, best.rr_seq)))
+            {
+              bestcpu = cpu;
+              best    = record;
+            }
+        }
+
+      if (bestcpu < 0)
+        {
+          break;
+        }
+
+      offset = upriv->rl_offset[bestcpu];
+      ncopy  = best.rr_len - offset;
+      if (ncopy > len - nread)
+        {
+          ncopy = len - nread;
+        }
+
+      ramlog_segread(priv, bestcpu,
+                     upriv->rl_tail[bestcpu] + RAMLOG_RECORD_SIZE + offset,
+                     &buffer[nread], ncopy);
+
+      /* Discard the copy if the writer overwrote the record meanwhile */
+
+      if (ramlog_validtail(priv, upriv, bestcpu, &state))
+        {
+          continue;
+        }
+
+      nread += ncopy;
+      upriv->rl_rbytes[bestcpu] += ncopy;
+      if (offset + ncopy < best.rr_len)
+        {
+          upriv->rl_offset[bestcpu] = offset + ncopy;
+        }
+      else
+        {
+          upriv->rl_tail[bestcpu]  += RAMLOG_RECORD_SIZE + best.rr_len;
+          upriv->rl_offset[bestcpu] = 0;
+        }
+    }
+
+  return nread;
+}
+
+/****************************************************************************
+ * Name: ramlog_file_read
+ ****************************************************************************/
+
+static ssize_t ramlog_file_read(FAR struct file *filep, FAR char *buffer,
+                                size_t len)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct ramlog_dev_s *priv = inode->i_private;
+  FAR struct ramlog_user_s *upriv = filep->f_priv;
+  ssize_t nread;
+  int ret;
+
+  /* This function may NOT be called from an interrupt handler. */
+
+  DEBUGASSERT(!up_interrupt_context());
+
+  ret = nxmutex_lock(&upriv->rl_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  for (; ; )
+    {
+      nread = ramlog_readmerge(priv, upriv, buffer, len);
+
+#ifdef CONFIG_RAMLOG_NONBLOCKING
+      /* Return what we have (with zero mean the end-of-file) */
+
+      break;
+#else
+      irqstate_t flags;
+
+      if (nread > 0 || len == 0)
+        {
+          break;
+        }
+
+      /* If the driver was opened with O_NONBLOCK option, then don't
+       * wait.
+       */
+
+      if (filep->f_oflags & O_NONBLOCK)
+        {
+          nread = -EAGAIN;
+          break;
+        }
+
+      /* Announce the waiter before checking for data again, so that a
+       * writer either sees the waiter or we see its record.
+       */
+
+      flags = enter_critical_section();
+      atomic_fetch_add(&priv->rl_nwaiters, 1);
+
+      if (!ramlog_readable(priv, upriv))
+        {
+          ret = nxsem_wait(&upriv->rl_reader.rl_waitsem);
+        }
+
+      atomic_fetch_sub(&priv->rl_nwaiters, 1);
+      leave_critical_section(flags);
+
+      if (ret < 0)
+        {
+          nread = ret;
+          break;
+        }
+#endif /* CONFIG_RAMLOG_NONBLOCKING */
+    }
+
+  nxmutex_unlock(&upriv->rl_lock);
+
+  /* Return the number of characters actually read */
+
+  return nread;
+}
+
+/****************************************************************************
+ * Name: ramlog_file_write
+ ****************************************************************************/
+
+static ssize_t ramlog_file_write(FAR struct file *filep,
+                                 FAR const char *buffer, size_t len)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct ramlog_dev_s *priv = inode->i_private;
+
+  return ramlog_addbuf(priv, buffer, len);
+}
+
+/****************************************************************************
+ * Name: ramlog_file_ioctl
+ ****************************************************************************/
+
+static int ramlog_file_ioctl(FAR struct file *filep, int cmd,
+                             unsigned long arg)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct ramlog_dev_s *priv = inode->i_private;
+  FAR struct ramlog_header_s *header = priv->rl_header;
+  FAR struct ramlog_user_s *upriv = filep->f_priv;
+  int cpu;
+  int ret;
+
+  ret = nxmutex_lock(&upriv->rl_lock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  switch (cmd)
+    {
+      case FIONREAD:
+        *(FAR int *)((uintptr_t)arg) = ramlog_bufferused(priv, upriv);
+        break;
+      case PIPEIOC_POLLINTHRD:
+        upriv->rl_reader.rl_threashold = (uint32_t)arg;
+        break;
+      case BIOC_FLUSH:
+
+        /* Hide everything written so far from all readers, without
+         * having to stop the writers.
+         */
+
+        if (header->rl_magic != RAMLOG_MAGIC_NUMBER)
+          {
+            ramlog_initheader(priv);
+          }
+
+        atomic_set(&header->rl_flushseq, atomic_read(&header->rl_seq));
+        for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+          {
+            FAR struct ramlog_segment_s *seg = &header->rl_segs[cpu];
+
+            atomic_set(&seg->rs_fbytes, atomic_read(&seg->rs_wbytes));
+          }
+
+        break;
+      default:
+        ret = -ENOTTY;
+        break;
+    }
+
+  nxmutex_unlock(&upriv->rl_lock);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ramlog_file_poll
+ ****************************************************************************/
+
+static int ramlog_file_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                            bool setup)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct ramlog_dev_s *priv = inode->i_private;
+  FAR struct ramlog_user_s *upriv = filep->f_priv;
+  pollevent_t eventset = POLLOUT;
+  irqstate_t flags;
+
+  /* Get exclusive access to the poll structures */
+
+  flags = enter_critical_section();
+
+  /* Are we setting up the poll?  Or tearing it down? */
+
+  if (setup)
+    {
+      /* This is a request to set up the poll.  Find an available
+       * slot for the poll structure reference.
+       */
+
+      if (!upriv->rl_reader.rl_fds)
+        {
+          upriv->rl_reader.rl_fds = fds;
+          fds->priv               = &upriv->rl_reader.rl_fds;
+          atomic_fetch_add(&priv->rl_nwaiters, 1);
+        }
+
+      /* Should immediately notify on any of the requested events? */
+
+      /* Check if the receive buffer is not empty. */
+
+      if (ramlog_bufferused(priv, upriv) >=
+          upriv->rl_reader.rl_threashold)
+        {
+          eventset |= POLLIN;
+        }
+
+      poll_notify(&fds, 1, eventset);
+    }
+  else if (fds->priv)
+    {
+      /* This is a request to tear down the poll. */
+
+      FAR struct pollfd **slot = (FAR struct pollfd **)fds->priv;
+
+      /* Remove all memory of the poll setup */
+
+      *slot     = NULL;
+      fds->priv = NULL;
+      atomic_fetch_sub(&priv->rl_nwaiters, 1);
+    }
+
+  leave_critical_section(flags);
+  return 0;
+}
+
+/****************************************************************************
+ * Name: ramlog_file_open
+ ****************************************************************************/
+
+static int ramlog_file_open(FAR struct file *filep)
+{
+  FAR struct inode *inode = filep->f_inode;
+  FAR struct ramlog_dev_s *priv = inode->i_private;
+  FAR struct ramlog_header_s *header = priv->rl_header;
+  FAR struct ramlog_user_s *upriv;
+  struct ramlog_segstate_s state;
+  irqstate_t flags;
+  int cpu;
+
+  upriv = kmm_zalloc(sizeof(struct ramlog_user_s));
+  if (upriv == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  upriv->rl_reader.rl_threashold = CONFIG_RAMLOG_POLLTHRESHOLD;
+  nxmutex_init(&upriv->rl_lock);
+#ifndef CONFIG_RAMLOG_NONBLOCKING
+  nxsem_init(&upriv->rl_reader.rl_waitsem, 0, 0);
+#endif
+
+  if (header->rl_magic != RAMLOG_MAGIC_NUMBER)
+    {
+      ramlog_initheader(priv);
+    }
+
+  /* Start from the oldest record still held in each segment */
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      ramlog_segstate(priv, cpu, &state);
+      upriv->rl_tail[cpu]   = state.oldest;
+      upriv->rl_rbytes[cpu] = state.obytes;
+    }
+
+  flags = enter_critical_section();
+  list_add_tail(&priv->rl_list, &upriv->rl_reader.rl_node);
+  leave_critical_section(flags);
+
+  filep->f_priv = upriv;
+  return 0;
+}
+
+/****************************************************************************
+ * Name: ramlog_file_close
+ ****************************************************************************/
+
+static int ramlog_file_close(FAR struct file *filep)
+{
+  FAR struct ramlog_user_s *upriv = filep->f_priv;
+  irqstate_t flags;
+
+  flags = enter_critical_section();
+  list_delete(&upriv->rl_reader.rl_node);
+  leave_critical_section(flags);
+
+#ifndef CONFIG_RAMLOG_NONBLOCKING
+  nxsem_destroy(&upriv->rl_reader.rl_waitsem);
+#endif
+  nxmutex_destroy(&upriv->rl_lock);
+  kmm_free(upriv);
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ramlog_register
+ *
+ * Description:
+ *   Create the RAM logging device and register it at the specified path.
+ *
+ ****************************************************************************/
+
+int ramlog_register(FAR const char *devpath, FAR char *buffer, size_t buflen)
+{
+  FAR struct ramlog_dev_s *priv;
+  int ret = -ENOMEM;
+
+  /* Sanity checking */
+
+  DEBUGASSERT(devpath && buffer && buflen > sizeof(struct ramlog_header_s));
+  DEBUGASSERT(((uintptr_t)buffer & 3) == 0);
+
+  /* Allocate a RAM logging device structure */
+
+  priv = kmm_zalloc(sizeof(struct ramlog_dev_s));
+  if (priv != NULL)
+    {
+      /* Initialize the non-zero values in the RAM logging device structure */
+
+      list_initialize(&priv->rl_list);
+      priv->rl_segsize = RAMLOG_SEGSIZE(buflen);
+      priv->rl_header = (FAR struct ramlog_header_s *)buffer;
+
+      DEBUGASSERT(priv->rl_segsize > RAMLOG_RECORD_SIZE);
+
+      /* Register the character driver */
+
+      ret = register_driver(devpath, &g_ramlogfops, 0666, priv);
+      if (ret < 0)
+        {
+          kmm_free(priv);
+        }
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ramlog_syslog_register
+ *
+ * Description:
+ *   Use a pre-allocated RAM logging device and register it at the path
+ *   specified by CONFIG_RAMLOG_SYSLOG
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_SYSLOG
+void ramlog_syslog_register(void)
+{
+  /* Register the syslog character driver */
+
+  register_driver(CONFIG_SYSLOG_DEVPATH, &g_ramlogfops, 0666, &g_sysdev);
+}
+#endif
+
+/****************************************************************************
+ * Name: ramlog_putc
+ *
+ * Description:
+ *   This is the low-level system logging interface.  The characters are
+ *   collected per CPU and written as one record at the end of the line.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_RAMLOG_SYSLOG
+int ramlog_putc(FAR syslog_channel_t *channel, int ch)
+{
+  irqstate_t flags;
+  int cpu;
+
+  UNUSED(channel);
+
+  /* Local interrupts stay disabled until the characters are written, so
+   * that a nested putc() or write() cannot reorder the output of this CPU.
+   */
+
+  flags = up_irq_save();
+  cpu   = this_cpu();
+
+  g_sysputc[cpu][g_sysputclen[cpu]++] = ch;
+  if (ch == '\n' || g_sysputclen[cpu] >= RAMLOG_PUTC_SIZE)
+    {
+      ramlog_addbuf(&g_sysdev, g_sysputc[cpu], g_sysputclen[cpu]);
+      g_sysputclen[cpu] = 0;
+    }
+
+  up_irq_restore(flags);
+
+  /* Return the character added on success */
+
+  return ch;
+}
+
+/****************************************************************************
+ * Name: ramlog_write
+ *
+ * Description:
+ *   This is the low-level system logging interface.
+ *
+ ****************************************************************************/
+
+ssize_t ramlog_write(FAR syslog_channel_t *channel,
+                     FAR const char *buffer, size_t buflen)
+{
+  irqstate_t flags;
+  ssize_t ret;
+  int cpu;
+
+  flags = up_irq_save();
+  cpu   = this_cpu();
+
+  /* Write the characters of ramlog_putc() first to keep the order */
+
+  if (g_sysputclen[cpu] > 0)
+    {
+      ramlog_addbuf(&g_sysdev, g_sysputc[cpu], g_sysputclen[cpu]);
+      g_sysputclen[cpu] = 0;
+    }
+
+  ret = ramlog_addbuf(&g_sysdev, buffer, buflen);
+  up_irq_restore(flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: ramlog_flush
+ *
+ * Description:
+ *   Write the characters that ramlog_putc() collected on this CPU.
+ *
+ ****************************************************************************/
+
+int ramlog_flush(FAR syslog_channel_t *channel)
+{
+  irqstate_t flags;
+  int cpu;
+
+  UNUSED(channel);
+
+  flags = up_irq_save();
+  cpu   = this_cpu();
+
+  if (g_sysputclen[cpu] > 0)
+    {
+      ramlog_addbuf(&g_sysdev, g_sysputc[cpu], g_sysputclen[cpu]);
+      g_sysputclen[cpu] = 0;
+    }
+
+  up_irq_restore(flags);
+  return OK;
+}
+#endif
+
+#endif /* CONFIG_RAMLOG_PERCPU */
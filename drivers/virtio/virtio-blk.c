@@ -28,8 +28,10 @@
 #include <errno.h>
 #include <stdio.h>
 
+#include <nuttx/fs/bio.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/fs/ioctl.h>
+#include <nuttx/kmalloc.h>
 #include <nuttx/semaphore.h>
 #include <nuttx/spinlock.h>
 #include <nuttx/virtio/virtio.h>
@@ -45,6 +47,7 @@
 
 /* Block feature bits */
 
+#define VIRTIO_BLK_F_SEG_MAX        2  /* Maximum segments in a request */
 #define VIRTIO_BLK_F_RO             5  /* Disk is read-only */
 #define VIRTIO_BLK_F_BLK_SIZE       6  /* Block size of disk is available */
 #define VIRTIO_BLK_F_FLUSH          9  /* Cache flush command support */
@@ -66,6 +69,15 @@
 #define VIRTIO_BLK_SECTOR_BITS      9
 #define VIRTIO_BLK_SECTOR_SIZE      (1UL << VIRTIO_BLK_SECTOR_BITS)
 
+/* Asynchronous request limits.  Each queued request uses its data
+ * segments plus two header descriptors; VIRTIO_BLK_SYNC_DESCS are kept
+ * free for the synchronous read, write and flush paths.
+ */
+
+#define VIRTIO_BLK_BIO_MAXSEGS      16
+#define VIRTIO_BLK_BIO_MAXSECTORS   1024
+#define VIRTIO_BLK_SYNC_DESCS       3
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -86,6 +98,21 @@ begin_packed_struct struct virtio_blk_resp_s
   uint8_t status;
 } end_packed_struct;
 
+/* One request on the virtqueue, also the virtqueue cookie.  Synchronous
+ * requests wait on sem, queued requests complete bio.
+ */
+
+struct virtio_blk_cmd_s
+{
+  struct virtio_blk_req_s  req;
+  struct virtio_blk_resp_s resp;
+  FAR sem_t               *sem;
+#ifdef CONFIG_FS_BIO
+  FAR struct bio_s        *bio;
+  FAR struct virtio_blk_cmd_s *flink; /* Free list link */
+#endif
+};
+
 begin_packed_struct struct virtio_blk_config_s
 {
   uint64_t capacity;
@@ -121,6 +148,11 @@ struct virtio_blk_priv_s
   uint64_t                      nsectors;       /* Sectore numbers */
   uint32_t                      block_size;     /* Block size */
   char                          name[NAME_MAX]; /* Device name */
+#ifdef CONFIG_FS_BIO
+  struct bio_queue_s            queue;          /* Queued requests */
+  FAR struct virtio_blk_cmd_s  *cmds;           /* Command pool */
+  FAR struct virtio_blk_cmd_s  *freecmd;        /* Free commands */
+#endif
 };
 
 /****************************************************************************
@@ -145,6 +177,13 @@ static int     virtio_blk_geometry(FAR struct inode *inode,
 static int     virtio_blk_ioctl(FAR struct inode *inode, int cmd,
                                 unsigned long arg);
 static int     virtio_blk_flush(FAR struct virtio_blk_priv_s *priv);
+#ifdef CONFIG_FS_BIO
+static void    virtio_blk_dispatch(FAR struct bio_queue_s *queue,
+                                   FAR struct bio_s *bio);
+static int     virtio_blk_submit(FAR struct inode *inode,
+                                 FAR struct bio_s *bio);
+static int     virtio_blk_bio_init(FAR struct virtio_blk_priv_s *priv);
+#endif
 
 /* Other functions */
 
@@ -175,6 +214,12 @@ static const struct block_operations g_virtio_blk_bops =
   virtio_blk_write,    /* write    */
   virtio_blk_geometry, /* geometry */
   virtio_blk_ioctl     /* ioctl    */
+#ifdef CONFIG_FS_BIO
+#ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
+  , NULL               /* unlink   */
+#endif
+  , virtio_blk_submit  /* submit   */
+#endif
 };
 
 static int g_virtio_blk_idx = 0;
@@ -183,6 +228,45 @@ static int g_virtio_blk_idx = 0;
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: virtio_blk_complete
+ *
+ * Description:
+ *   Finish a command returned by the device
+ *
+ ****************************************************************************/
+
+static void virtio_blk_complete(FAR struct virtio_blk_priv_s *priv,
+                                FAR struct virtio_blk_cmd_s *cmd)
+{
+#ifdef CONFIG_FS_BIO
+  FAR struct bio_s *bio = cmd->bio;
+  irqstate_t flags;
+
+  if (bio != NULL)
+    {
+      ssize_t result = bio->qsectors;
+
+      if (cmd->resp.status != VIRTIO_BLK_S_OK)
+        {
+          vrterr("%s Error\n", bio->op == BIO_WRITE ? "Write" : "Read");
+          result = -EIO;
+        }
+
+      flags = spin_lock_irqsave(&priv->lock);
+      cmd->bio      = NULL;
+      cmd->flink    = priv->freecmd;
+      priv->freecmd = cmd;
+      spin_unlock_irqrestore(&priv->lock, flags);
+
+      bio_queue_done(&priv->queue, bio, result);
+      return;
+    }
+#endif
+
+  nxsem_post(cmd->sem);
+}
+
 /****************************************************************************
  * Name: virtio_blk_wait_complete
  *
@@ -192,29 +276,29 @@ static int g_virtio_blk_idx = 0;
  ****************************************************************************/
 
 static void virtio_blk_wait_complete(FAR struct virtqueue *vq,
-                                     FAR sem_t *respsem)
+                                     FAR struct virtio_blk_cmd_s *respcmd)
 {
   FAR struct virtio_blk_priv_s *priv = vq->vq_dev->priv;
-  FAR sem_t *sem;
+  FAR struct virtio_blk_cmd_s *cmd;
 
   if (up_interrupt_context())
     {
       for (; ; )
         {
-          sem = virtqueue_get_buffer_lock(vq, NULL, NULL, &priv->lock);
-          if (sem == respsem)
+          cmd = virtqueue_get_buffer_lock(vq, NULL, NULL, &priv->lock);
+          if (cmd == respcmd)
             {
               break;
             }
-          else if (sem != NULL)
+          else if (cmd != NULL)
             {
-              nxsem_post(sem);
+              virtio_blk_complete(priv, cmd);
             }
         }
     }
   else
     {
-      nxsem_wait_uninterruptible(respsem);
+      nxsem_wait_uninterruptible(respcmd->sem);
     }
 }
 
@@ -233,8 +317,7 @@ static ssize_t virtio_blk_rdwr(FAR struct virtio_blk_priv_s *priv,
   FAR struct virtio_device *vdev = priv->vdev;
   FAR struct virtqueue *vq = vdev->vrings_info[0].vq;
   FAR struct virtqueue_buf vb[3];
-  struct virtio_blk_resp_s resp;
-  struct virtio_blk_req_s req;
+  struct virtio_blk_cmd_s cmd;
   irqstate_t flags;
   sem_t respsem;
   ssize_t ret;
@@ -244,10 +327,15 @@ static ssize_t virtio_blk_rdwr(FAR struct virtio_blk_priv_s *priv,
 
   /* Build the block request */
 
-  req.type     = write ? VIRTIO_BLK_T_OUT : VIRTIO_BLK_T_IN;
-  req.reserved = 0;
-  req.sector   = startsector * priv->block_size >> VIRTIO_BLK_SECTOR_BITS;
-  resp.status  = VIRTIO_BLK_S_IOERR;
+  cmd.req.type     = write ? VIRTIO_BLK_T_OUT : VIRTIO_BLK_T_IN;
+  cmd.req.reserved = 0;
+  cmd.req.sector   = startsector * priv->block_size >>
+                     VIRTIO_BLK_SECTOR_BITS;
+  cmd.resp.status  = VIRTIO_BLK_S_IOERR;
+  cmd.sem          = &respsem;
+#ifdef CONFIG_FS_BIO
+  cmd.bio          = NULL;
+#endif
 
   /* Fill the virtqueue buffer:
    * Buffer 0: the block out header;
@@ -255,11 +343,11 @@ static ssize_t virtio_blk_rdwr(FAR struct virtio_blk_priv_s *priv,
    * Buffer 2: the block in header, return the status.
    */
 
-  vb[0].buf = &req;
+  vb[0].buf = &cmd.req;
   vb[0].len = VIRTIO_BLK_REQ_HEADER_SIZE;
   vb[1].buf = buffer;
   vb[1].len = nsectors * priv->block_size;
-  vb[2].buf = &resp;
+  vb[2].buf = &cmd.resp;
   vb[2].len = VIRTIO_BLK_RESP_HEADER_SIZE;
   readnum = write ? 2 : 1;
 
@@ -269,7 +357,7 @@ static ssize_t virtio_blk_rdwr(FAR struct virtio_blk_priv_s *priv,
     }
 
   flags = spin_lock_irqsave(&priv->lock);
-  ret = virtqueue_add_buffer(vq, vb, readnum, 3 - readnum, &respsem);
+  ret = virtqueue_add_buffer(vq, vb, readnum, 3 - readnum, &cmd);
   if (ret < 0)
     {
       spin_unlock_irqrestore(&priv->lock, flags);
@@ -282,9 +370,9 @@ static ssize_t virtio_blk_rdwr(FAR struct virtio_blk_priv_s *priv,
 
   /* Wait for the request completion */
 
-  virtio_blk_wait_complete(vq, &respsem);
+  virtio_blk_wait_complete(vq, &cmd);
 
-  if (resp.status != VIRTIO_BLK_S_OK)
+  if (cmd.resp.status != VIRTIO_BLK_S_OK)
     {
       vrterr("%s Error\n", write ? "Write" : "Read");
       ret = -EIO;
@@ -409,8 +497,7 @@ static int virtio_blk_flush(FAR struct virtio_blk_priv_s *priv)
   FAR struct virtio_device *vdev = priv->vdev;
   FAR struct virtqueue *vq = vdev->vrings_info[0].vq;
   FAR struct virtqueue_buf vb[2];
-  struct virtio_blk_resp_s resp;
-  struct virtio_blk_req_s req;
+  struct virtio_blk_cmd_s cmd;
   irqstate_t flags;
   sem_t respsem;
   int ret;
@@ -419,18 +506,22 @@ static int virtio_blk_flush(FAR struct virtio_blk_priv_s *priv)
 
   /* Build the block request */
 
-  req.type     = VIRTIO_BLK_T_FLUSH;
-  req.reserved = 0;
-  req.sector   = 0;
-  resp.status  = VIRTIO_BLK_S_IOERR;
+  cmd.req.type     = VIRTIO_BLK_T_FLUSH;
+  cmd.req.reserved = 0;
+  cmd.req.sector   = 0;
+  cmd.resp.status  = VIRTIO_BLK_S_IOERR;
+  cmd.sem          = &respsem;
+#ifdef CONFIG_FS_BIO
+  cmd.bio          = NULL;
+#endif
 
-  vb[0].buf = &req;
+  vb[0].buf = &cmd.req;
   vb[0].len = VIRTIO_BLK_REQ_HEADER_SIZE;
-  vb[1].buf = &resp;
+  vb[1].buf = &cmd.resp;
   vb[1].len = VIRTIO_BLK_RESP_HEADER_SIZE;
 
   flags = spin_lock_irqsave(&priv->lock);
-  ret = virtqueue_add_buffer(vq, vb, 1, 1, &respsem);
+  ret = virtqueue_add_buffer(vq, vb, 1, 1, &cmd);
   if (ret < 0)
     {
       spin_unlock_irqrestore(&priv->lock, flags);
@@ -443,7 +534,7 @@ static int virtio_blk_flush(FAR struct virtio_blk_priv_s *priv)
   /* Wait for the request completion */
 
   nxsem_wait_uninterruptible(&respsem);
-  if (resp.status != VIRTIO_BLK_S_OK)
+  if (cmd.resp.status != VIRTIO_BLK_S_OK)
     {
       vrterr("Flush Error\n");
       ret = -EIO;
@@ -478,6 +569,174 @@ static int virtio_blk_ioctl(FAR struct inode *inode, int cmd,
   return ret;
 }
 
+#ifdef CONFIG_FS_BIO
+/****************************************************************************
+ * Name: virtio_blk_dispatch
+ *
+ * Description:
+ *   Put a merged request chain on the virtqueue as a single device
+ *   request.  Called by the request queue, possibly from virtio_blk_done().
+ *
+ ****************************************************************************/
+
+static void virtio_blk_dispatch(FAR struct bio_queue_s *queue,
+                                FAR struct bio_s *bio)
+{
+  FAR struct virtio_blk_priv_s *priv = queue->priv;
+  FAR struct virtqueue *vq = priv->vdev->vrings_info[0].vq;
+  struct virtqueue_buf vb[VIRTIO_BLK_BIO_MAXSEGS + 2];
+  struct iovec iov[VIRTIO_BLK_BIO_MAXSEGS];
+  FAR struct virtio_blk_cmd_s *cmd;
+  irqstate_t flags;
+  int nsegs;
+  int ret;
+  int i;
+
+  nsegs = bio_chain_iov(bio, iov, queue->maxsegs);
+  if (nsegs < 0)
+    {
+      bio_queue_done(queue, bio, nsegs);
+      return;
+    }
+
+  /* The pool holds one command per queue slot, so one is always free */
+
+  flags = spin_lock_irqsave(&priv->lock);
+  cmd = priv->freecmd;
+  DEBUGASSERT(cmd != NULL);
+  priv->freecmd = cmd->flink;
+
+  cmd->req.type     = bio->op == BIO_WRITE ? VIRTIO_BLK_T_OUT :
+                                             VIRTIO_BLK_T_IN;
+  cmd->req.reserved = 0;
+  cmd->req.sector   = bio->sector * priv->block_size >>
+                      VIRTIO_BLK_SECTOR_BITS;
+  cmd->resp.status  = VIRTIO_BLK_S_IOERR;
+  cmd->bio          = bio;
+
+  vb[0].buf = &cmd->req;
+  vb[0].len = VIRTIO_BLK_REQ_HEADER_SIZE;
+  for (i = 0; i < nsegs; i++)
+    {
+      vb[i + 1].buf = iov[i].iov_base;
+      vb[i + 1].len = iov[i].iov_len;
+    }
+
+  vb[nsegs + 1].buf = &cmd->resp;
+  vb[nsegs + 1].len = VIRTIO_BLK_RESP_HEADER_SIZE;
+
+  if (bio->op == BIO_WRITE)
+    {
+      ret = virtqueue_add_buffer(vq, vb, nsegs + 1, 1, cmd);
+    }
+  else
+    {
+      ret = virtqueue_add_buffer(vq, vb, 1, nsegs + 1, cmd);
+    }
+
+  if (ret >= 0)
+    {
+      virtqueue_kick(vq);
+    }
+  else
+    {
+      cmd->bio      = NULL;
+      cmd->flink    = priv->freecmd;
+      priv->freecmd = cmd;
+    }
+
+  spin_unlock_irqrestore(&priv->lock, flags);
+
+  if (ret < 0)
+    {
+      vrterr("virtqueue_add_buffer failed, ret=%d\n", ret);
+      bio_queue_done(queue, bio, ret);
+    }
+}
+
+/****************************************************************************
+ * Name: virtio_blk_submit
+ ****************************************************************************/
+
+static int virtio_blk_submit(FAR struct inode *inode, FAR struct bio_s *bio)
+{
+  FAR struct virtio_blk_priv_s *priv;
+
+  DEBUGASSERT(inode->i_private);
+  priv = inode->i_private;
+
+  if (bio->op == BIO_WRITE &&
+      virtio_has_feature(priv->vdev, VIRTIO_BLK_F_RO))
+    {
+      return -EPERM;
+    }
+
+  if (bio->sector + bio->nsectors > priv->nsectors)
+    {
+      return -EINVAL;
+    }
+
+  return bio_queue_submit(&priv->queue, bio);
+}
+
+/****************************************************************************
+ * Name: virtio_blk_bio_init
+ *
+ * Description:
+ *   Size the request queue to the virtqueue: every queued request needs
+ *   its data segments plus two header descriptors.
+ *
+ ****************************************************************************/
+
+static int virtio_blk_bio_init(FAR struct virtio_blk_priv_s *priv)
+{
+  FAR struct virtqueue *vq = priv->vdev->vrings_info[0].vq;
+  unsigned int nentries = vq->vq_nentries - VIRTIO_BLK_SYNC_DESCS;
+  unsigned int maxsegs = VIRTIO_BLK_BIO_MAXSEGS;
+  unsigned int depth;
+  unsigned int i;
+  uint32_t segmax;
+
+  if (virtio_has_feature(priv->vdev, VIRTIO_BLK_F_SEG_MAX))
+    {
+      virtio_read_config_member(priv->vdev, struct virtio_blk_config_s,
+                                seg_max, &segmax);
+      if (segmax > 0 && segmax < maxsegs)
+        {
+          maxsegs = segmax;
+        }
+    }
+
+  if (vq->vq_nentries < VIRTIO_BLK_SYNC_DESCS + 3)
+    {
+      return -EINVAL;
+    }
+
+  depth = nentries / (maxsegs + 2);
+  if (depth == 0)
+    {
+      maxsegs = nentries - 2;
+      depth   = 1;
+    }
+
+  priv->cmds = kmm_zalloc(depth * sizeof(struct virtio_blk_cmd_s));
+  if (priv->cmds == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  for (i = 0; i < depth; i++)
+    {
+      priv->cmds[i].flink = priv->freecmd;
+      priv->freecmd       = &priv->cmds[i];
+    }
+
+  bio_queue_init(&priv->queue, depth, maxsegs, VIRTIO_BLK_BIO_MAXSECTORS,
+                 virtio_blk_dispatch, priv);
+  return OK;
+}
+#endif
+
 /****************************************************************************
  * Name: virtio_blk_done
  ****************************************************************************/
@@ -485,17 +744,17 @@ static int virtio_blk_ioctl(FAR struct inode *inode, int cmd,
 static void virtio_blk_done(FAR struct virtqueue *vq)
 {
   FAR struct virtio_blk_priv_s *priv = vq->vq_dev->priv;
-  FAR sem_t *respsem;
+  FAR struct virtio_blk_cmd_s *cmd;
 
   for (; ; )
     {
-      respsem = virtqueue_get_buffer_lock(vq, NULL, NULL, &priv->lock);
-      if (respsem == NULL)
+      cmd = virtqueue_get_buffer_lock(vq, NULL, NULL, &priv->lock);
+      if (cmd == NULL)
         {
           break;
         }
 
-      nxsem_post(respsem);
+      virtio_blk_complete(priv, cmd);
     }
 }
 
@@ -517,7 +776,8 @@ static int virtio_blk_init(FAR struct virtio_blk_priv_s *priv,
   /* Initialize the virtio device */
 
   virtio_set_status(vdev, VIRTIO_CONFIG_STATUS_DRIVER);
-  virtio_negotiate_features(vdev, (1UL << VIRTIO_BLK_F_RO) |
+  virtio_negotiate_features(vdev, (1UL << VIRTIO_BLK_F_SEG_MAX) |
+                                  (1UL << VIRTIO_BLK_F_RO) |
                                   (1UL << VIRTIO_BLK_F_BLK_SIZE) |
                                   (1UL << VIRTIO_BLK_F_FLUSH), NULL);
   virtio_set_status(vdev, VIRTIO_CONFIG_FEATURES_OK);
@@ -592,6 +852,15 @@ static int virtio_blk_probe(FAR struct virtio_device *vdev)
       priv->block_size = VIRTIO_BLK_SECTOR_SIZE;
     }
 
+#ifdef CONFIG_FS_BIO
+  ret = virtio_blk_bio_init(priv);
+  if (ret < 0)
+    {
+      vrterr("virtio_blk_bio_init failed, ret=%d\n", ret);
+      goto err_with_init;
+    }
+#endif
+
   /* Register block driver */
 
   snprintf(priv->name, NAME_MAX, "/dev/virtblk%d", g_virtio_blk_idx);
@@ -607,6 +876,9 @@ static int virtio_blk_probe(FAR struct virtio_device *vdev)
 
 err_with_init:
   virtio_blk_uninit(priv);
+#ifdef CONFIG_FS_BIO
+  kmm_free(priv->cmds);
+#endif
 err_with_priv:
   kmm_free(priv);
   return ret;
@@ -622,6 +894,9 @@ static void virtio_blk_remove(FAR struct virtio_device *vdev)
 
   unregister_driver(priv->name);
   virtio_blk_uninit(priv);
+#ifdef CONFIG_FS_BIO
+  kmm_free(priv->cmds);
+#endif
   kmm_free(priv);
 }
 
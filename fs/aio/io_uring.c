@@ -0,0 +1,1451 @@
+/****************************************************************************
+ * fs/aio/io_uring.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/io_uring.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <stddef.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <debug.h>
+
+#include <nuttx/atomic.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/mm/map.h>
+#include <nuttx/net/net.h>
+
+#include "inode/inode.h"
+#include "fs_heap.h"
+
+#ifdef CONFIG_FS_IO_URING
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define URING_MAX_ENTRIES   32768
+#define URING_MAX_IOV       1024
+
+#ifdef CONFIG_FS_LARGEFILE
+#  define URING_OFF_MAX     INT64_MAX
+#else
+#  define URING_OFF_MAX     INT32_MAX
+#endif
+#define URING_ALIGN(n)      (((n) + 7) & ~7)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The part of the ring memory shared with user space.  It is followed by
+ * the SQ index array and then by the CQE array.
+ */
+
+struct uring_rings_s
+{
+  atomic_t sq_head;         /* Advanced by the kernel on submission */
+  atomic_t sq_tail;         /* Advanced by the application */
+  uint32_t sq_ring_mask;
+  uint32_t sq_ring_entries;
+  uint32_t sq_flags;
+  uint32_t sq_dropped;      /* Invalid SQ array entries skipped */
+  atomic_t cq_head;         /* Advanced by the application */
+  atomic_t cq_tail;         /* Advanced by the kernel on completion */
+  uint32_t cq_ring_mask;
+  uint32_t cq_ring_entries;
+  uint32_t cq_overflow;     /* Always zero, see IORING_FEAT_NODROP */
+  uint32_t cq_flags;
+};
+
+/* A submitted operation.  The SQE and a READV/WRITEV vector are copied in
+ * at submission time so the application may reuse its SQ slot and iovec
+ * array as soon as io_uring_enter() returns (IORING_FEAT_SUBMIT_STABLE).
+ */
+
+struct uring_req_s
+{
+  struct work_s           work;      /* Queued to the uring work queue */
+  FAR struct uring_req_s *flink;     /* Free list link */
+  FAR struct uring_ctx_s *ctx;       /* Owning ring */
+  FAR struct file        *filep;     /* Referenced target file */
+  FAR void               *addr;      /* Buffer or iovec array */
+  FAR struct iovec       *iov;       /* Copy of a READV/WRITEV vector */
+  size_t                  len;       /* Buffer length or iovec count */
+  off_t                   off;       /* File offset, -1 for file position */
+  uint64_t                user_data; /* Echoed in the CQE */
+  uint32_t                msg_flags; /* MSG_* for SEND and RECV */
+  uint8_t                 opcode;    /* IORING_OP_* */
+  bool                    inuse;     /* Not on the free list */
+  bool                    queued;    /* Queued to a worker, not started */
+#ifdef CONFIG_NET
+  bool                    polling;   /* Waiting in pfd for the socket */
+  struct pollfd           pfd;       /* Readiness of a SEND or RECV */
+#endif
+};
+
+/* Private state of one io_uring instance */
+
+struct uring_ctx_s
+{
+  mutex_t                   lock;     /* Serializes submit and register */
+  spinlock_t                cqlock;   /* Protects CQ tail, pool, waiters */
+  sem_t                     cqsem;    /* Wakes io_uring_enter() waiters */
+  unsigned int              nwaiters; /* Threads blocked on cqsem */
+  unsigned int              inflight; /* Requests not yet completed */
+  bool                      closing;  /* No socket request is rearmed */
+
+  FAR struct uring_rings_s *rings;    /* Shared ring header + arrays */
+  FAR uint32_t             *sq_array; /* SQ index array inside rings */
+  FAR struct io_uring_cqe  *cqes;     /* CQE array inside rings */
+  FAR struct io_uring_sqe  *sqes;     /* Shared SQE array */
+  size_t                    ringsize; /* Size of the rings allocation */
+  uint32_t                  sq_entries;
+  uint32_t                  cq_entries;
+
+  FAR struct uring_req_s   *reqs;     /* Pool of cq_entries requests */
+  FAR struct uring_req_s   *freereq;  /* Free list of the pool */
+
+  FAR struct iovec         *bufs;     /* Registered buffers */
+  unsigned int              nbufs;
+  FAR struct file         **files;    /* Registered files */
+  unsigned int              nfiles;
+
+  FAR struct pollfd        *fds[CONFIG_FS_IO_URING_NPOLLWAITERS];
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int uring_close(FAR struct file *filep);
+static int uring_mmap(FAR struct file *filep,
+                      FAR struct mm_map_entry_s *map);
+static int uring_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                      bool setup);
+#ifdef CONFIG_NET
+static void uring_pollcb(FAR struct pollfd *fds);
+#endif
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_uring_fops =
+{
+  NULL,         /* open */
+  uring_close,  /* close */
+  NULL,         /* read */
+  NULL,         /* write */
+  NULL,         /* seek */
+  NULL,         /* ioctl */
+  uring_mmap,   /* mmap */
+  NULL,         /* truncate */
+  uring_poll    /* poll */
+};
+
+static struct inode g_uring_inode =
+{
+  NULL,                   /* i_parent */
+  NULL,                   /* i_peer */
+  NULL,                   /* i_child */
+  1,                      /* i_crefs */
+  FSNODEFLAG_TYPE_DRIVER, /* i_flags */
+  {
+    &g_uring_fops         /* u */
+  }
+};
+
+/* The I/O worker threads are shared by every ring and created on the
+ * first io_uring_setup().
+ */
+
+static FAR struct kwork_wqueue_s *g_uring_wq;
+static mutex_t g_uring_wqlock = NXMUTEX_INITIALIZER;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: uring_cq_pending
+ *
+ * Description:
+ *   Return the number of CQEs not yet consumed by the application.
+ *
+ ****************************************************************************/
+
+static inline uint32_t uring_cq_pending(FAR struct uring_ctx_s *ctx)
+{
+  return (uint32_t)atomic_read(&ctx->rings->cq_tail) -
+         (uint32_t)atomic_read_acquire(&ctx->rings->cq_head);
+}
+
+/****************************************************************************
+ * Name: uring_complete
+ *
+ * Description:
+ *   Post the completion of req and return it to the free pool.  Callable
+ *   from the submitting thread and from the worker threads.
+ *
+ ****************************************************************************/
+
+static void uring_complete(FAR struct uring_req_s *req, int res)
+{
+  FAR struct uring_ctx_s *ctx = req->ctx;
+  FAR struct io_uring_cqe *cqe;
+  FAR struct file *filep = req->filep;
+  FAR struct iovec *iov = req->iov;
+  irqstate_t flags;
+  uint32_t tail;
+
+  req->iov = NULL;
+  flags = spin_lock_irqsave(&ctx->cqlock);
+
+  /* Submission reserved this slot, so the CQ cannot be full here */
+
+  tail = atomic_read(&ctx->rings->cq_tail);
+  DEBUGASSERT(tail - atomic_read(&ctx->rings->cq_head) < ctx->cq_entries);
+
+  cqe            = &ctx->cqes[tail & ctx->rings->cq_ring_mask];
+  cqe->user_data = req->user_data;
+  cqe->res       = res;
+  cqe->flags     = 0;
+
+  /* Publish the entry before the new tail becomes visible */
+
+  atomic_set_release(&ctx->rings->cq_tail, tail + 1);
+
+  req->inuse   = false;
+  req->queued  = false;
+  req->filep   = NULL;
+  req->flink   = ctx->freereq;
+  ctx->freereq = req;
+  ctx->inflight--;
+
+  while (ctx->nwaiters > 0)
+    {
+      ctx->nwaiters--;
+      nxsem_post(&ctx->cqsem);
+    }
+
+  poll_notify(ctx->fds, CONFIG_FS_IO_URING_NPOLLWAITERS, POLLIN);
+
+  spin_unlock_irqrestore(&ctx->cqlock, flags);
+
+  if (iov != NULL)
+    {
+      fs_heap_free(iov);
+    }
+
+  if (filep != NULL)
+    {
+      file_put(filep);
+    }
+}
+
+/****************************************************************************
+ * Name: uring_prwv
+ *
+ * Description:
+ *   Positional vectored transfer.  There is no file_preadv(), so the
+ *   vector is walked with file_pread()/file_pwrite(), which leaves the
+ *   file position untouched just like the non-vectored variants.
+ *
+ ****************************************************************************/
+
+static ssize_t uring_prwv(FAR struct uring_req_s *req, bool write)
+{
+  FAR const struct iovec *iov = req->addr;
+  off_t off = req->off;
+  ssize_t total = 0;
+  ssize_t ret;
+  size_t i;
+
+  for (i = 0; i < req->len; i++)
+    {
+      if (write)
+        {
+          ret = file_pwrite(req->filep, iov[i].iov_base, iov[i].iov_len,
+                            off);
+        }
+      else
+        {
+          ret = file_pread(req->filep, iov[i].iov_base, iov[i].iov_len,
+                           off);
+        }
+
+      if (ret < 0)
+        {
+          return total > 0 ? total : ret;
+        }
+
+      total += ret;
+      off   += ret;
+
+      if ((size_t)ret < iov[i].iov_len)
+        {
+          break;
+        }
+    }
+
+  return total;
+}
+
+/****************************************************************************
+ * Name: uring_execute
+ *
+ * Description:
+ *   Perform the I/O described by req.  Returns the CQE result.
+ *
+ ****************************************************************************/
+
+static ssize_t uring_execute(FAR struct uring_req_s *req)
+{
+  FAR struct file *filep = req->filep;
+#ifdef CONFIG_NET
+  FAR struct socket *psock;
+#endif
+
+  switch (req->opcode)
+    {
+      case IORING_OP_NOP:
+        return OK;
+
+      case IORING_OP_READ:
+      case IORING_OP_READ_FIXED:
+        if (req->off < 0)
+          {
+            return file_read(filep, req->addr, req->len);
+          }
+
+        return file_pread(filep, req->addr, req->len, req->off);
+
+      case IORING_OP_WRITE:
+      case IORING_OP_WRITE_FIXED:
+        if (req->off < 0)
+          {
+            return file_write(filep, req->addr, req->len);
+          }
+
+        return file_pwrite(filep, req->addr, req->len, req->off);
+
+      case IORING_OP_READV:
+        if (req->off < 0)
+          {
+            return file_readv(filep, req->addr, req->len);
+          }
+
+        return uring_prwv(req, false);
+
+      case IORING_OP_WRITEV:
+        if (req->off < 0)
+          {
+            return file_writev(filep, req->addr, req->len);
+          }
+
+        return uring_prwv(req, true);
+
+      case IORING_OP_FSYNC:
+        return file_fsync(filep);
+
+#ifdef CONFIG_NET
+      /* Socket requests never block, see uring_sockio() */
+
+      case IORING_OP_SEND:
+        psock = file_socket(filep);
+        if (psock == NULL)
+          {
+            return -ENOTSOCK;
+          }
+
+        return psock_send(psock, req->addr, req->len,
+                          req->msg_flags | MSG_DONTWAIT);
+
+      case IORING_OP_RECV:
+        psock = file_socket(filep);
+        if (psock == NULL)
+          {
+            return -ENOTSOCK;
+          }
+
+        return psock_recv(psock, req->addr, req->len,
+                          req->msg_flags | MSG_DONTWAIT);
+#endif
+
+      default:
+        return -EINVAL;
+    }
+}
+
+/****************************************************************************
+ * Name: uring_worker
+ *
+ * Description:
+ *   Run a queued request on one of the uring worker threads.
+ *
+ ****************************************************************************/
+
+static void uring_worker(FAR void *arg)
+{
+  FAR struct uring_req_s *req = arg;
+  FAR struct uring_ctx_s *ctx = req->ctx;
+  irqstate_t flags;
+  ssize_t ret;
+
+  /* Once started, the request is no longer ours to cancel */
+
+  flags = spin_lock_irqsave(&ctx->cqlock);
+  req->queued = false;
+  spin_unlock_irqrestore(&ctx->cqlock, flags);
+
+  ret = uring_execute(req);
+  uring_complete(req, ret);
+}
+
+#ifdef CONFIG_NET
+/****************************************************************************
+ * Name: uring_sockio
+ *
+ * Description:
+ *   Try a SEND or RECV without blocking.  If the socket is not ready, wait
+ *   for it with a poll callback rather than parking a worker thread, which
+ *   would let a few idle sockets starve every other ring.
+ *
+ ****************************************************************************/
+
+static void uring_sockio(FAR struct uring_req_s *req)
+{
+  FAR struct uring_ctx_s *ctx = req->ctx;
+  irqstate_t flags;
+  ssize_t ret;
+
+  ret = uring_execute(req);
+  if (ret != -EAGAIN || (req->msg_flags & MSG_DONTWAIT) != 0)
+    {
+      uring_complete(req, ret);
+      return;
+    }
+
+  flags = spin_lock_irqsave(&ctx->cqlock);
+  if (ctx->closing)
+    {
+      spin_unlock_irqrestore(&ctx->cqlock, flags);
+      uring_complete(req, -ECANCELED);
+      return;
+    }
+
+  req->polling = true;
+  spin_unlock_irqrestore(&ctx->cqlock, flags);
+
+  memset(&req->pfd, 0, sizeof(req->pfd));
+  req->pfd.events = req->opcode == IORING_OP_RECV ? POLLIN : POLLOUT;
+  req->pfd.arg    = req;
+  req->pfd.cb     = uring_pollcb;
+
+  ret = file_poll(req->filep, &req->pfd, true);
+  if (ret < 0)
+    {
+      flags = spin_lock_irqsave(&ctx->cqlock);
+      req->polling = false;
+      spin_unlock_irqrestore(&ctx->cqlock, flags);
+
+      uring_complete(req, ret);
+    }
+}
+
+/****************************************************************************
+ * Name: uring_sockworker
+ *
+ * Description:
+ *   Retry a socket request once its socket reported readiness.
+ *
+ ****************************************************************************/
+
+static void uring_sockworker(FAR void *arg)
+{
+  FAR struct uring_req_s *req = arg;
+  FAR struct uring_ctx_s *ctx = req->ctx;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&ctx->cqlock);
+  req->queued = false;
+  spin_unlock_irqrestore(&ctx->cqlock, flags);
+
+  file_poll(req->filep, &req->pfd, false);
+
+  flags = spin_lock_irqsave(&ctx->cqlock);
+  req->polling = false;
+  spin_unlock_irqrestore(&ctx->cqlock, flags);
+
+  uring_sockio(req);
+}
+
+/****************************************************************************
+ * Name: uring_pollcb
+ *
+ * Description:
+ *   The socket of a waiting request became ready.  May run in interrupt
+ *   context or with the network locked, so only hand it to a worker.
+ *
+ ****************************************************************************/
+
+static void uring_pollcb(FAR struct pollfd *fds)
+{
+  FAR struct uring_req_s *req = fds->arg;
+  FAR struct uring_ctx_s *ctx = req->ctx;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&ctx->cqlock);
+  if (req->polling && !req->queued && !ctx->closing)
+    {
+      req->queued = true;
+      work_queue_wq(g_uring_wq, &req->work, uring_sockworker, req, 0);
+    }
+
+  spin_unlock_irqrestore(&ctx->cqlock, flags);
+}
+#endif
+
+/****************************************************************************
+ * Name: uring_prep
+ *
+ * Description:
+ *   Validate sqe and translate it into req.  On success req holds a
+ *   reference to the target file.
+ *
+ ****************************************************************************/
+
+static int uring_prep(FAR struct uring_ctx_s *ctx,
+                      FAR const struct io_uring_sqe *sqe,
+                      FAR struct uring_req_s *req)
+{
+  FAR struct iovec *buf;
+  int ret;
+
+  req->opcode    = sqe->opcode;
+  req->user_data = sqe->user_data;
+  req->msg_flags = sqe->msg_flags;
+  req->addr      = (FAR void *)(uintptr_t)sqe->addr;
+  req->len       = sqe->len;
+  req->off       = sqe->off == (uint64_t)-1 ? -1 : (off_t)sqe->off;
+  req->filep     = NULL;
+
+  if ((sqe->flags & ~IOSQE_FIXED_FILE) != 0)
+    {
+      return -EINVAL;
+    }
+
+  /* Do not let the cast above truncate a 64-bit offset */
+
+  if (sqe->off != (uint64_t)-1 && sqe->off > URING_OFF_MAX)
+    {
+      return -EOVERFLOW;
+    }
+
+  switch (sqe->opcode)
+    {
+      case IORING_OP_NOP:
+        return OK;
+
+      case IORING_OP_READ_FIXED:
+      case IORING_OP_WRITE_FIXED:
+
+        /* The buffer must lie inside the registered region */
+
+        if (sqe->buf_index >= ctx->nbufs)
+          {
+            return -EFAULT;
+          }
+
+        buf = &ctx->bufs[sqe->buf_index];
+        if ((uintptr_t)req->addr < (uintptr_t)buf->iov_base ||
+            (uintptr_t)req->addr + req->len >
+            (uintptr_t)buf->iov_base + buf->iov_len)
+          {
+            return -EFAULT;
+          }
+
+        break;
+
+      case IORING_OP_READV:
+      case IORING_OP_WRITEV:
+
+        /* The worker must not depend on the caller's iovec array */
+
+        if (req->len > URING_MAX_IOV)
+          {
+            return -EINVAL;
+          }
+
+        if (req->len > 0)
+          {
+            req->iov = fs_heap_malloc(req->len * sizeof(struct iovec));
+            if (req->iov == NULL)
+              {
+                return -ENOMEM;
+              }
+
+            memcpy(req->iov, req->addr, req->len * sizeof(struct iovec));
+            req->addr = req->iov;
+          }
+
+        break;
+
+      case IORING_OP_READ:
+      case IORING_OP_WRITE:
+      case IORING_OP_FSYNC:
+#ifdef CONFIG_NET
+      case IORING_OP_SEND:
+      case IORING_OP_RECV:
+#endif
+        break;
+
+      default:
+        return -EINVAL;
+    }
+
+  if ((sqe->flags & IOSQE_FIXED_FILE) != 0)
+    {
+      if (sqe->fd < 0 || (unsigned int)sqe->fd >= ctx->nfiles ||
+          ctx->files[sqe->fd] == NULL)
+        {
+          return -EBADF;
+        }
+
+      req->filep = ctx->files[sqe->fd];
+      file_ref(req->filep);
+      return OK;
+    }
+
+  ret = file_get(sqe->fd, &req->filep);
+  if (ret < 0)
+    {
+      req->filep = NULL;
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: uring_submit_one
+ *
+ * Description:
+ *   Start one SQE.  Socket operations are attempted without blocking in
+ *   the caller's context and retried on a worker when the socket becomes
+ *   ready; everything else except NOP runs on a worker.
+ *
+ ****************************************************************************/
+
+static void uring_submit_one(FAR struct uring_ctx_s *ctx,
+                             FAR const struct io_uring_sqe *sqe,
+                             FAR struct uring_req_s *req)
+{
+  ssize_t ret;
+
+  ret = uring_prep(ctx, sqe, req);
+  if (ret < 0 || req->opcode == IORING_OP_NOP)
+    {
+      uring_complete(req, ret);
+      return;
+    }
+
+#ifdef CONFIG_NET
+  if (req->opcode == IORING_OP_SEND || req->opcode == IORING_OP_RECV)
+    {
+      uring_sockio(req);
+      return;
+    }
+#endif
+
+  req->queued = true;
+  work_queue_wq(g_uring_wq, &req->work, uring_worker, req, 0);
+}
+
+/****************************************************************************
+ * Name: uring_submit
+ *
+ * Description:
+ *   Consume up to to_submit entries from the SQ.  Each submission reserves
+ *   a CQ slot, so submission stops early rather than ever overflowing the
+ *   CQ.
+ *
+ ****************************************************************************/
+
+static int uring_submit(FAR struct uring_ctx_s *ctx, unsigned int to_submit)
+{
+  FAR struct uring_rings_s *rings = ctx->rings;
+  FAR struct uring_req_s *req;
+  struct io_uring_sqe sqe;
+  irqstate_t flags;
+  uint32_t head;
+  uint32_t tail;
+  uint32_t idx;
+  unsigned int submitted = 0;
+
+  head = atomic_read(&rings->sq_head);
+  tail = atomic_read_acquire(&rings->sq_tail);
+
+  while (submitted < to_submit && head != tail)
+    {
+      idx = ctx->sq_array[head & ctx->rings->sq_ring_mask];
+      if (idx >= ctx->sq_entries)
+        {
+          rings->sq_dropped++;
+          head++;
+          continue;
+        }
+
+      flags = spin_lock_irqsave(&ctx->cqlock);
+      if (ctx->inflight + uring_cq_pending(ctx) >= ctx->cq_entries)
+        {
+          spin_unlock_irqrestore(&ctx->cqlock, flags);
+          break;
+        }
+
+      req          = ctx->freereq;
+      ctx->freereq = req->flink;
+      req->inuse   = true;
+      ctx->inflight++;
+      spin_unlock_irqrestore(&ctx->cqlock, flags);
+
+      /* The application may rewrite the SQE at any time, so every field
+       * is read from one private copy.
+       */
+
+      memcpy(&sqe, &ctx->sqes[idx], sizeof(sqe));
+      uring_submit_one(ctx, &sqe, req);
+
+      /* The SQE has been copied, hand the slot back to the application */
+
+      atomic_set_release(&rings->sq_head, ++head);
+      submitted++;
+    }
+
+  /* Publish any skipped invalid entries too */
+
+  atomic_set_release(&rings->sq_head, head);
+  return submitted == 0 && head != tail ? -EBUSY : (int)submitted;
+}
+
+/****************************************************************************
+ * Name: uring_wait
+ *
+ * Description:
+ *   Block until at least min_complete CQEs are available.
+ *
+ ****************************************************************************/
+
+static int uring_wait(FAR struct uring_ctx_s *ctx, unsigned int min_complete)
+{
+  irqstate_t flags;
+  int ret;
+
+  if (min_complete > ctx->cq_entries)
+    {
+      min_complete = ctx->cq_entries;
+    }
+
+  for (; ; )
+    {
+      flags = spin_lock_irqsave(&ctx->cqlock);
+      if (uring_cq_pending(ctx) >= min_complete)
+        {
+          spin_unlock_irqrestore(&ctx->cqlock, flags);
+          return OK;
+        }
+
+      /* Nothing in flight can ever satisfy the wait */
+
+      if (ctx->inflight == 0)
+        {
+          spin_unlock_irqrestore(&ctx->cqlock, flags);
+          return -EAGAIN;
+        }
+
+      ctx->nwaiters++;
+      spin_unlock_irqrestore(&ctx->cqlock, flags);
+
+      ret = nxsem_wait(&ctx->cqsem);
+      if (ret < 0)
+        {
+          flags = spin_lock_irqsave(&ctx->cqlock);
+          if (ctx->nwaiters > 0)
+            {
+              ctx->nwaiters--;
+            }
+
+          spin_unlock_irqrestore(&ctx->cqlock, flags);
+          return ret;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: uring_unregister_files
+ ****************************************************************************/
+
+static void uring_unregister_files(FAR struct uring_ctx_s *ctx)
+{
+  unsigned int i;
+
+  for (i = 0; i < ctx->nfiles; i++)
+    {
+      if (ctx->files[i] != NULL)
+        {
+          file_put(ctx->files[i]);
+        }
+    }
+
+  fs_heap_free(ctx->files);
+  ctx->files  = NULL;
+  ctx->nfiles = 0;
+}
+
+/****************************************************************************
+ * Name: uring_register_files
+ *
+ * Description:
+ *   Take a reference on each descriptor in fds so that IOSQE_FIXED_FILE
+ *   submissions skip the per-request descriptor lookup.  -1 leaves a
+ *   sparse slot.
+ *
+ ****************************************************************************/
+
+static int uring_register_files(FAR struct uring_ctx_s *ctx,
+                                FAR const int *fds, unsigned int nfds)
+{
+  unsigned int i;
+  int ret;
+
+  if (ctx->files != NULL)
+    {
+      return -EBUSY;
+    }
+
+  if (fds == NULL || nfds == 0 || nfds > URING_MAX_ENTRIES)
+    {
+      return -EINVAL;
+    }
+
+  ctx->files = fs_heap_zalloc(nfds * sizeof(FAR struct file *));
+  if (ctx->files == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  ctx->nfiles = nfds;
+  for (i = 0; i < nfds; i++)
+    {
+      if (fds[i] == -1)
+        {
+          continue;
+        }
+
+      ret = file_get(fds[i], &ctx->files[i]);
+      if (ret < 0)
+        {
+          ctx->files[i] = NULL;
+          uring_unregister_files(ctx);
+          return ret;
+        }
+
+      /* A ring holding a reference to itself (or to another ring that
+       * holds one to it) would never be closed.
+       */
+
+      if (ctx->files[i]->f_inode == &g_uring_inode)
+        {
+          uring_unregister_files(ctx);
+          return -EBADF;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: uring_register_buffers
+ *
+ * Description:
+ *   Record the buffers that READ_FIXED and WRITE_FIXED may target.  With a
+ *   flat address space the buffers are used in place; registration only
+ *   bounds-checks the fixed requests against them.
+ *
+ ****************************************************************************/
+
+static int uring_register_buffers(FAR struct uring_ctx_s *ctx,
+                                  FAR const struct iovec *iov,
+                                  unsigned int niov)
+{
+  if (ctx->bufs != NULL)
+    {
+      return -EBUSY;
+    }
+
+  if (iov == NULL || niov == 0 || niov > UINT16_MAX)
+    {
+      return -EINVAL;
+    }
+
+  ctx->bufs = fs_heap_malloc(niov * sizeof(struct iovec));
+  if (ctx->bufs == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  memcpy(ctx->bufs, iov, niov * sizeof(struct iovec));
+  ctx->nbufs = niov;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: uring_free
+ ****************************************************************************/
+
+static void uring_free(FAR struct uring_ctx_s *ctx)
+{
+  if (ctx->files != NULL)
+    {
+      uring_unregister_files(ctx);
+    }
+
+  fs_heap_free(ctx->bufs);
+  fs_heap_free(ctx->reqs);
+  kumm_free(ctx->sqes);
+  kumm_free(ctx->rings);
+  nxsem_destroy(&ctx->cqsem);
+  nxmutex_destroy(&ctx->lock);
+  fs_heap_free(ctx);
+}
+
+/****************************************************************************
+ * Name: uring_close
+ *
+ * Description:
+ *   Cancel requests still queued or waiting for their socket, and wait for
+ *   the ones already running.  Running requests never block on a socket,
+ *   so the wait is bounded.
+ *
+ ****************************************************************************/
+
+static int uring_close(FAR struct file *filep)
+{
+  FAR struct uring_ctx_s *ctx = filep->f_priv;
+  FAR struct uring_req_s *req;
+  irqstate_t flags;
+  bool cancel;
+#ifdef CONFIG_NET
+  bool armed;
+#endif
+  uint32_t i;
+
+  /* Keep socket requests from being queued or rearmed from now on */
+
+  flags = spin_lock_irqsave(&ctx->cqlock);
+  ctx->closing = true;
+  spin_unlock_irqrestore(&ctx->cqlock, flags);
+
+  for (i = 0; i < ctx->cq_entries; i++)
+    {
+      req = &ctx->reqs[i];
+      if (!req->inuse)
+        {
+          continue;
+        }
+
+      /* This waits for a running worker.  A request that ran and
+       * completed meanwhile must not be completed a second time, so only
+       * cancel what never started.
+       */
+
+      work_cancel_sync_wq(g_uring_wq, &req->work);
+
+      flags  = spin_lock_irqsave(&ctx->cqlock);
+      cancel = req->inuse && req->queued;
+#ifdef CONFIG_NET
+      armed  = req->inuse && req->polling;
+      req->polling = false;
+#endif
+      spin_unlock_irqrestore(&ctx->cqlock, flags);
+
+#ifdef CONFIG_NET
+      /* A socket request waiting for readiness has no worker to wait for */
+
+      if (armed)
+        {
+          file_poll(req->filep, &req->pfd, false);
+          cancel = true;
+        }
+#endif
+
+      if (cancel)
+        {
+          uring_complete(req, -ECANCELED);
+        }
+    }
+
+  DEBUGASSERT(ctx->inflight == 0);
+  uring_free(ctx);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: uring_mmap
+ *
+ * Description:
+ *   Map the rings (IORING_OFF_SQ_RING and IORING_OFF_CQ_RING share one
+ *   region) or the SQE array (IORING_OFF_SQES).
+ *
+ ****************************************************************************/
+
+static int uring_mmap(FAR struct file *filep,
+                      FAR struct mm_map_entry_s *map)
+{
+  FAR struct uring_ctx_s *ctx = filep->f_priv;
+
+  switch (map->offset)
+    {
+      case IORING_OFF_SQ_RING:
+      case IORING_OFF_CQ_RING:
+        if (map->length > ctx->ringsize)
+          {
+            return -EINVAL;
+          }
+
+        map->vaddr = ctx->rings;
+        return OK;
+
+      case IORING_OFF_SQES:
+        if (map->length > ctx->sq_entries * sizeof(struct io_uring_sqe))
+          {
+            return -EINVAL;
+          }
+
+        map->vaddr = ctx->sqes;
+        return OK;
+
+      default:
+        return -EINVAL;
+    }
+}
+
+/****************************************************************************
+ * Name: uring_poll
+ *
+ * Description:
+ *   The ring is readable while the CQ holds unconsumed entries.
+ *
+ ****************************************************************************/
+
+static int uring_poll(FAR struct file *filep, FAR struct pollfd *fds,
+                      bool setup)
+{
+  FAR struct uring_ctx_s *ctx = filep->f_priv;
+  irqstate_t flags;
+  int ret = -EBUSY;
+  int i;
+
+  flags = spin_lock_irqsave(&ctx->cqlock);
+
+  if (!setup)
+    {
+      FAR struct pollfd **slot = (FAR struct pollfd **)fds->priv;
+
+      *slot     = NULL;
+      fds->priv = NULL;
+      spin_unlock_irqrestore(&ctx->cqlock, flags);
+      return OK;
+    }
+
+  for (i = 0; i < CONFIG_FS_IO_URING_NPOLLWAITERS; i++)
+    {
+      if (ctx->fds[i] == NULL)
+        {
+          ctx->fds[i] = fds;
+          fds->priv   = &ctx->fds[i];
+          ret         = OK;
+          break;
+        }
+    }
+
+  if (ret == OK && uring_cq_pending(ctx) > 0)
+    {
+      poll_notify(&fds, 1, POLLIN);
+    }
+
+  spin_unlock_irqrestore(&ctx->cqlock, flags);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: uring_alloc
+ ****************************************************************************/
+
+static FAR struct uring_ctx_s *uring_alloc(uint32_t sq_entries)
+{
+  FAR struct uring_ctx_s *ctx;
+  uint32_t cq_entries = 2 * sq_entries;
+  size_t cqoff;
+  uint32_t i;
+
+  ctx = fs_heap_zalloc(sizeof(struct uring_ctx_s));
+  if (ctx == NULL)
+    {
+      return NULL;
+    }
+
+  nxmutex_init(&ctx->lock);
+  spin_lock_init(&ctx->cqlock);
+  nxsem_init(&ctx->cqsem, 0, 0);
+
+  /* The shared memory comes from the user heap so that the application
+   * can access it in the protected build.
+   */
+
+  cqoff         = URING_ALIGN(sizeof(struct uring_rings_s) +
+                              sq_entries * sizeof(uint32_t));
+  ctx->ringsize = cqoff + cq_entries * sizeof(struct io_uring_cqe);
+  ctx->rings    = kumm_zalloc(ctx->ringsize);
+  ctx->sqes     = kumm_zalloc(sq_entries * sizeof(struct io_uring_sqe));
+  ctx->reqs     = fs_heap_zalloc(cq_entries * sizeof(struct uring_req_s));
+  if (ctx->rings == NULL || ctx->sqes == NULL || ctx->reqs == NULL)
+    {
+      uring_free(ctx);
+      return NULL;
+    }
+
+  ctx->sq_entries = sq_entries;
+  ctx->cq_entries = cq_entries;
+  ctx->sq_array   = (FAR uint32_t *)(ctx->rings + 1);
+  ctx->cqes       = (FAR struct io_uring_cqe *)
+                    ((FAR uint8_t *)ctx->rings + cqoff);
+
+  ctx->rings->sq_ring_mask    = sq_entries - 1;
+  ctx->rings->sq_ring_entries = sq_entries;
+  ctx->rings->cq_ring_mask    = cq_entries - 1;
+  ctx->rings->cq_ring_entries = cq_entries;
+
+  for (i = 0; i < cq_entries; i++)
+    {
+      ctx->reqs[i].ctx   = ctx;
+      ctx->reqs[i].flink = ctx->freereq;
+      ctx->freereq       = &ctx->reqs[i];
+    }
+
+  return ctx;
+}
+
+/****************************************************************************
+ * Name: uring_get
+ *
+ * Description:
+ *   Look up the ring behind fd and take a reference on it.
+ *
+ ****************************************************************************/
+
+static int uring_get(int fd, FAR struct file **filep)
+{
+  int ret;
+
+  ret = file_get(fd, filep);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  if ((*filep)->f_inode != &g_uring_inode)
+    {
+      file_put(*filep);
+      return -EINVAL;
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: io_uring_setup
+ *
+ * Description:
+ *   Create a submission/completion ring pair with at least entries SQ
+ *   slots and return a file descriptor for it.  The layout of the shared
+ *   memory is returned in p; map it with mmap() at IORING_OFF_SQ_RING and
+ *   IORING_OFF_SQES.
+ *
+ * Returned Value:
+ *   A new file descriptor on success; -1 with errno set on failure.
+ *
+ ****************************************************************************/
+
+int io_uring_setup(unsigned int entries, FAR struct io_uring_params *p)
+{
+  FAR struct uring_ctx_s *ctx;
+  uint32_t sq_entries;
+  int ret;
+
+  if (p == NULL || entries == 0 || entries > URING_MAX_ENTRIES ||
+      p->flags != 0)
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  nxmutex_lock(&g_uring_wqlock);
+  if (g_uring_wq == NULL)
+    {
+      g_uring_wq = work_queue_create("uring",
+                                     CONFIG_FS_IO_URING_PRIORITY,
+                                     NULL,
+                                     CONFIG_FS_IO_URING_STACKSIZE,
+                                     CONFIG_FS_IO_URING_NTHREADS);
+    }
+
+  nxmutex_unlock(&g_uring_wqlock);
+  if (g_uring_wq == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  for (sq_entries = 1; sq_entries < entries; sq_entries <<= 1);
+
+  ctx = uring_alloc(sq_entries);
+  if (ctx == NULL)
+    {
+      ret = -ENOMEM;
+      goto errout;
+    }
+
+  memset(&p->sq_off, 0, sizeof(p->sq_off));
+  memset(&p->cq_off, 0, sizeof(p->cq_off));
+
+  p->sq_entries = ctx->sq_entries;
+  p->cq_entries = ctx->cq_entries;
+  p->features   = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP |
+                  IORING_FEAT_SUBMIT_STABLE;
+
+  p->sq_off.head         = offsetof(struct uring_rings_s, sq_head);
+  p->sq_off.tail         = offsetof(struct uring_rings_s, sq_tail);
+  p->sq_off.ring_mask    = offsetof(struct uring_rings_s, sq_ring_mask);
+  p->sq_off.ring_entries = offsetof(struct uring_rings_s, sq_ring_entries);
+  p->sq_off.flags        = offsetof(struct uring_rings_s, sq_flags);
+  p->sq_off.dropped      = offsetof(struct uring_rings_s, sq_dropped);
+  p->sq_off.array        = sizeof(struct uring_rings_s);
+
+  p->cq_off.head         = offsetof(struct uring_rings_s, cq_head);
+  p->cq_off.tail         = offsetof(struct uring_rings_s, cq_tail);
+  p->cq_off.ring_mask    = offsetof(struct uring_rings_s, cq_ring_mask);
+  p->cq_off.ring_entries = offsetof(struct uring_rings_s, cq_ring_entries);
+  p->cq_off.overflow     = offsetof(struct uring_rings_s, cq_overflow);
+  p->cq_off.flags        = offsetof(struct uring_rings_s, cq_flags);
+  p->cq_off.cqes         = (FAR uint8_t *)ctx->cqes -
+                           (FAR uint8_t *)ctx->rings;
+
+  ret = file_allocate_from_inode(&g_uring_inode, O_RDWR | O_CLOEXEC,
+                                 0, ctx, 0);
+  if (ret < 0)
+    {
+      uring_free(ctx);
+      goto errout;
+    }
+
+  return ret;
+
+errout:
+  set_errno(-ret);
+  return ERROR;
+}
+
+/****************************************************************************
+ * Name: io_uring_enter
+ *
+ * Description:
+ *   Submit up to to_submit entries from the SQ and, with
+ *   IORING_ENTER_GETEVENTS, wait until min_complete CQEs are available.
+ *   A single call can therefore both submit a batch and reap it.
+ *
+ * Returned Value:
+ *   The number of SQEs consumed on success; -1 with errno set on failure.
+ *
+ ****************************************************************************/
+
+int io_uring_enter(int fd, unsigned int to_submit,
+                   unsigned int min_complete, unsigned int flags)
+{
+  FAR struct uring_ctx_s *ctx;
+  FAR struct file *filep;
+  int submitted = 0;
+  int ret;
+
+  if ((flags & ~IORING_ENTER_GETEVENTS) != 0)
+    {
+      ret = -EINVAL;
+      goto errout;
+    }
+
+  ret = uring_get(fd, &filep);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  ctx = filep->f_priv;
+
+  if (to_submit > 0)
+    {
+      ret = nxmutex_lock(&ctx->lock);
+      if (ret >= 0)
+        {
+          ret = uring_submit(ctx, to_submit);
+          nxmutex_unlock(&ctx->lock);
+        }
+
+      if (ret < 0)
+        {
+          goto errout_with_filep;
+        }
+
+      submitted = ret;
+    }
+
+  if ((flags & IORING_ENTER_GETEVENTS) != 0 && min_complete > 0)
+    {
+      ret = uring_wait(ctx, min_complete);
+      if (ret < 0 && submitted == 0)
+        {
+          goto errout_with_filep;
+        }
+    }
+
+  file_put(filep);
+  return submitted;
+
+errout_with_filep:
+  file_put(filep);
+
+errout:
+  set_errno(-ret);
+  return ERROR;
+}
+
+/****************************************************************************
+ * Name: io_uring_register
+ *
+ * Description:
+ *   Register or unregister fixed buffers (arg is a struct iovec array) or
+ *   fixed files (arg is an int array) with the ring.  Unregistration waits
+ *   for nothing: in-flight requests hold their own file references.
+ *
+ * Returned Value:
+ *   Zero on success; -1 with errno set on failure.
+ *
+ ****************************************************************************/
+
+int io_uring_register(int fd, unsigned int opcode, FAR void *arg,
+                      unsigned int nr_args)
+{
+  FAR struct uring_ctx_s *ctx;
+  FAR struct file *filep;
+  int ret;
+
+  ret = uring_get(fd, &filep);
+  if (ret < 0)
+    {
+      goto errout;
+    }
+
+  ctx = filep->f_priv;
+  ret = nxmutex_lock(&ctx->lock);
+  if (ret < 0)
+    {
+      goto errout_with_filep;
+    }
+
+  switch (opcode)
+    {
+      case IORING_REGISTER_BUFFERS:
+        ret = uring_register_buffers(ctx, arg, nr_args);
+        break;
+
+      case IORING_UNREGISTER_BUFFERS:
+        if (ctx->bufs == NULL)
+          {
+            ret = -ENXIO;
+            break;
+          }
+
+        fs_heap_free(ctx->bufs);
+        ctx->bufs  = NULL;
+        ctx->nbufs = 0;
+        break;
+
+      case IORING_REGISTER_FILES:
+        ret = uring_register_files(ctx, arg, nr_args);
+        break;
+
+      case IORING_UNREGISTER_FILES:
+        if (ctx->files == NULL)
+          {
+            ret = -ENXIO;
+            break;
+          }
+
+        uring_unregister_files(ctx);
+        break;
+
+      default:
+        ret = -EINVAL;
+        break;
+    }
+
+  nxmutex_unlock(&ctx->lock);
+
+errout_with_filep:
+  file_put(filep);
+  if (ret >= 0)
+    {
+      return OK;
+    }
+
+errout:
+  set_errno(-ret);
+  return ERROR;
+}
+
+#endif /* CONFIG_FS_IO_URING */
@@ -0,0 +1,746 @@
+/****************************************************************************
+ * fs/driver/fs_bio.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/atomic.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/fs/bio.h>
+
+#ifdef CONFIG_FS_BIO
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A request that exceeds the driver limits is queued as several pieces
+ * that share one allocation.  The submitter's request completes when the
+ * last piece does.
+ */
+
+struct bio_split_s
+{
+  FAR struct bio_s *parent;  /* The request that was split */
+  atomic_t          pending; /* Pieces not completed yet */
+  unsigned int      npieces; /* Number of entries in piece[] */
+  struct bio_s      piece[]; /* Followed by the iovec of all pieces */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bio_iov_contig
+ *
+ * Description:
+ *   Return true if segment b starts where segment a ends.
+ *
+ ****************************************************************************/
+
+static inline bool bio_iov_contig(FAR const struct iovec *a,
+                                  FAR const struct iovec *b)
+{
+  return (FAR uint8_t *)a->iov_base + a->iov_len ==
+         (FAR uint8_t *)b->iov_base;
+}
+
+/****************************************************************************
+ * Name: bio_sector_size
+ *
+ * Description:
+ *   Return the sector size implied by the request, or zero if the iovec
+ *   lengths are not whole sectors.
+ *
+ ****************************************************************************/
+
+static size_t bio_sector_size(FAR const struct bio_s *bio)
+{
+  size_t secsize;
+  size_t total = 0;
+  int i;
+
+  for (i = 0; i < bio->iovcnt; i++)
+    {
+      total += bio->iov[i].iov_len;
+    }
+
+  secsize = total / bio->nsectors;
+  if (secsize == 0 || secsize * bio->nsectors != total)
+    {
+      return 0;
+    }
+
+  for (i = 0; i < bio->iovcnt; i++)
+    {
+      if (bio->iov[i].iov_len % secsize != 0)
+        {
+          return 0;
+        }
+    }
+
+  return secsize;
+}
+
+/****************************************************************************
+ * Name: bio_init_chain
+ *
+ * Description:
+ *   Make bio a chain of its own.
+ *
+ ****************************************************************************/
+
+static void bio_init_chain(FAR struct bio_s *bio)
+{
+  int i;
+
+  bio->flink    = NULL;
+  bio->merged   = NULL;
+  bio->last     = bio;
+  bio->qsectors = bio->nsectors;
+  bio->qsegs    = bio->iovcnt;
+
+  for (i = 1; i < bio->iovcnt; i++)
+    {
+      if (bio_iov_contig(&bio->iov[i - 1], &bio->iov[i]))
+        {
+          bio->qsegs--;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: bio_join_segs
+ *
+ * Description:
+ *   Return the number of coalesced segments of chain a followed by chain b.
+ *
+ ****************************************************************************/
+
+static unsigned int bio_join_segs(FAR struct bio_s *a, FAR struct bio_s *b)
+{
+  FAR struct bio_s *last = a->last;
+
+  if (bio_iov_contig(&last->iov[last->iovcnt - 1], &b->iov[0]))
+    {
+      return a->qsegs + b->qsegs - 1;
+    }
+
+  return a->qsegs + b->qsegs;
+}
+
+/****************************************************************************
+ * Name: bio_try_join
+ *
+ * Description:
+ *   Append chain b to chain a if they are adjacent on the media, go in the
+ *   same direction and the result fits the driver limits.
+ *
+ ****************************************************************************/
+
+static bool bio_try_join(FAR struct bio_queue_s *queue,
+                         FAR struct bio_s *a, FAR struct bio_s *b)
+{
+  unsigned int segs;
+
+  if (a->op != b->op || a->sector + a->qsectors != b->sector ||
+      a->qsectors + b->qsectors > queue->maxsectors)
+    {
+      return false;
+    }
+
+  segs = bio_join_segs(a, b);
+  if (segs > queue->maxsegs)
+    {
+      return false;
+    }
+
+  a->last->merged = b;
+  a->last         = b->last;
+  a->qsectors    += b->qsectors;
+  a->qsegs        = segs;
+  return true;
+}
+
+/****************************************************************************
+ * Name: bio_queue_insert
+ *
+ * Description:
+ *   Insert bio into the sorted pending list, merging it with its
+ *   neighbours where possible.  Called with the queue lock held.
+ *
+ ****************************************************************************/
+
+static void bio_queue_insert(FAR struct bio_queue_s *queue,
+                             FAR struct bio_s *bio)
+{
+  FAR struct bio_s *prev = NULL;
+  FAR struct bio_s *curr = queue->pending;
+
+  /* Requests starting at the same sector stay in submission order */
+
+  while (curr != NULL && curr->sector <= bio->sector)
+    {
+      prev = curr;
+      curr = curr->flink;
+    }
+
+  /* Back merge into the previous chain, which may then also close the gap
+   * to the next one.
+   */
+
+  if (prev != NULL && bio_try_join(queue, prev, bio))
+    {
+      if (curr != NULL && bio_try_join(queue, prev, curr))
+        {
+          prev->flink = curr->flink;
+        }
+
+      return;
+    }
+
+  /* Front merge: bio takes the place of the following chain */
+
+  if (curr != NULL && bio_try_join(queue, bio, curr))
+    {
+      bio->flink = curr->flink;
+    }
+  else
+    {
+      bio->flink = curr;
+    }
+
+  if (prev != NULL)
+    {
+      prev->flink = bio;
+    }
+  else
+    {
+      queue->pending = bio;
+    }
+}
+
+/****************************************************************************
+ * Name: bio_split_walk
+ *
+ * Description:
+ *   Cut bio into pieces of at most maxsegs segments and maxsectors
+ *   sectors.  With piece and iov NULL only count the pieces and the iovec
+ *   entries they need.
+ *
+ ****************************************************************************/
+
+static unsigned int bio_split_walk(FAR struct bio_queue_s *queue,
+                                   FAR struct bio_s *bio, size_t secsize,
+                                   FAR struct bio_s *piece,
+                                   FAR struct iovec *iov,
+                                   FAR unsigned int *niov)
+{
+  FAR struct bio_s *curr = NULL;
+  FAR uint8_t *end = NULL;
+  blkcnt_t sector = bio->sector;
+  unsigned int npieces = 0;
+  unsigned int nsectors = 0;
+  unsigned int nsegs = 0;
+  unsigned int total = 0;
+  int i;
+
+  for (i = 0; i < bio->iovcnt; i++)
+    {
+      FAR uint8_t *base = bio->iov[i].iov_base;
+      size_t len = bio->iov[i].iov_len;
+
+      while (len > 0)
+        {
+          bool contig = npieces > 0 && base == end;
+          unsigned int n;
+
+          if (npieces == 0 || nsectors == queue->maxsectors ||
+              (!contig && nsegs == queue->maxsegs))
+            {
+              /* Start a new piece */
+
+              if (piece != NULL)
+                {
+                  curr           = &piece[npieces];
+                  curr->iov      = &iov[total];
+                  curr->iovcnt   = 0;
+                  curr->sector   = sector;
+                  curr->nsectors = 0;
+                }
+
+              npieces++;
+              nsectors = 0;
+              nsegs    = 0;
+              contig   = false;
+            }
+
+          n = len / secsize;
+          if (n > queue->maxsectors - nsectors)
+            {
+              n = queue->maxsectors - nsectors;
+            }
+
+          if (!contig)
+            {
+              if (piece != NULL)
+                {
+                  iov[total].iov_base = base;
+                  iov[total].iov_len  = 0;
+                  curr->iovcnt++;
+                }
+
+              total++;
+              nsegs++;
+            }
+
+          if (piece != NULL)
+            {
+              iov[total - 1].iov_len += n * secsize;
+              curr->nsectors         += n;
+            }
+
+          nsectors += n;
+          sector   += n;
+          base     += n * secsize;
+          len      -= n * secsize;
+          end       = base;
+        }
+    }
+
+  *niov = total;
+  return npieces;
+}
+
+/****************************************************************************
+ * Name: bio_split_done
+ *
+ * Description:
+ *   Completion of one piece of a split request.  The last one reports the
+ *   sectors transferred from the start of the request, up to the first
+ *   piece that failed or came up short.
+ *
+ ****************************************************************************/
+
+static void bio_split_done(FAR struct bio_s *piece)
+{
+  FAR struct bio_split_s *split = piece->arg;
+  FAR struct bio_s *parent;
+  ssize_t result = 0;
+  unsigned int i;
+
+  if (atomic_fetch_sub(&split->pending, 1) != 1)
+    {
+      return;
+    }
+
+  for (i = 0; i < split->npieces; i++)
+    {
+      ssize_t ret = split->piece[i].result;
+
+      if (ret < 0)
+        {
+          if (result == 0)
+            {
+              result = ret;
+            }
+
+          break;
+        }
+
+      result += ret;
+      if (ret < (ssize_t)split->piece[i].nsectors)
+        {
+          break;
+        }
+    }
+
+  parent         = split->parent;
+  parent->result = result;
+  kmm_free(split);
+  parent->callback(parent);
+}
+
+/****************************************************************************
+ * Name: bio_split
+ *
+ * Description:
+ *   Allocate the pieces of a request that exceeds the driver limits.
+ *
+ ****************************************************************************/
+
+static int bio_split(FAR struct bio_queue_s *queue, FAR struct bio_s *bio,
+                     FAR struct bio_split_s **splitp)
+{
+  FAR struct bio_split_s *split;
+  unsigned int npieces;
+  unsigned int niov;
+  unsigned int i;
+  size_t secsize;
+
+  secsize = bio_sector_size(bio);
+  if (secsize == 0)
+    {
+      return -EINVAL;
+    }
+
+  npieces = bio_split_walk(queue, bio, secsize, NULL, NULL, &niov);
+  split   = kmm_malloc(sizeof(struct bio_split_s) +
+                       npieces * sizeof(struct bio_s) +
+                       niov * sizeof(struct iovec));
+  if (split == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  split->parent  = bio;
+  split->npieces = npieces;
+  atomic_set(&split->pending, npieces);
+
+  bio_split_walk(queue, bio, secsize, split->piece,
+                 (FAR struct iovec *)&split->piece[npieces], &niov);
+
+  for (i = 0; i < npieces; i++)
+    {
+      split->piece[i].op       = bio->op;
+      split->piece[i].callback = bio_split_done;
+      split->piece[i].arg      = split;
+      bio_init_chain(&split->piece[i]);
+    }
+
+  *splitp = split;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bio_queue_pick
+ *
+ * Description:
+ *   Remove and return the next chain in elevator order: the first one at
+ *   or after the cursor, wrapping to the lowest sector.  Called with the
+ *   queue lock held.
+ *
+ ****************************************************************************/
+
+static FAR struct bio_s *bio_queue_pick(FAR struct bio_queue_s *queue)
+{
+  FAR struct bio_s *prev = NULL;
+  FAR struct bio_s *curr = queue->pending;
+
+  while (curr != NULL && curr->sector < queue->cursor)
+    {
+      prev = curr;
+      curr = curr->flink;
+    }
+
+  if (curr == NULL)
+    {
+      prev = NULL;
+      curr = queue->pending;
+      if (curr == NULL)
+        {
+          return NULL;
+        }
+    }
+
+  if (prev != NULL)
+    {
+      prev->flink = curr->flink;
+    }
+  else
+    {
+      queue->pending = curr->flink;
+    }
+
+  curr->flink   = NULL;
+  queue->cursor = curr->sector + curr->qsectors;
+  return curr;
+}
+
+/****************************************************************************
+ * Name: bio_queue_kick
+ *
+ * Description:
+ *   Hand chains to the driver until the queue is empty or full.  Only one
+ *   context dispatches at a time; the others leave their work to it.
+ *
+ ****************************************************************************/
+
+static void bio_queue_kick(FAR struct bio_queue_s *queue)
+{
+  FAR struct bio_s *bio;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&queue->lock);
+  if (queue->kicking)
+    {
+      spin_unlock_irqrestore(&queue->lock, flags);
+      return;
+    }
+
+  queue->kicking = true;
+  while (queue->inflight < queue->depth &&
+         (bio = bio_queue_pick(queue)) != NULL)
+    {
+      queue->inflight++;
+      spin_unlock_irqrestore(&queue->lock, flags);
+
+      queue->dispatch(queue, bio);
+
+      flags = spin_lock_irqsave(&queue->lock);
+    }
+
+  queue->kicking = false;
+  spin_unlock_irqrestore(&queue->lock, flags);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: bio_submit
+ ****************************************************************************/
+
+int bio_submit(FAR struct inode *inode, FAR struct bio_s *bio)
+{
+  FAR const struct block_operations *bops;
+  blkcnt_t sector;
+  ssize_t result = 0;
+  ssize_t ret = 0;
+  size_t secsize;
+  int i;
+
+  DEBUGASSERT(inode != NULL && bio != NULL && bio->callback != NULL);
+
+  if (bio->nsectors == 0 || bio->iovcnt <= 0 || bio->iov == NULL ||
+      (bio->op != BIO_READ && bio->op != BIO_WRITE))
+    {
+      return -EINVAL;
+    }
+
+  bops = inode->u.i_bops;
+  if (bops == NULL)
+    {
+      return -ENODEV;
+    }
+
+  if (bops->submit != NULL)
+    {
+      return bops->submit(inode, bio);
+    }
+
+  if ((bio->op == BIO_READ && bops->read == NULL) ||
+      (bio->op == BIO_WRITE && bops->write == NULL))
+    {
+      return -EACCES;
+    }
+
+  /* Emulate the request with the synchronous methods.  The sector size
+   * follows from the request itself.
+   */
+
+  secsize = bio_sector_size(bio);
+  if (secsize == 0)
+    {
+      return -EINVAL;
+    }
+
+  sector = bio->sector;
+  for (i = 0; i < bio->iovcnt; i++)
+    {
+      unsigned int n = bio->iov[i].iov_len / secsize;
+
+      if (bio->op == BIO_READ)
+        {
+          ret = bops->read(inode, bio->iov[i].iov_base, sector, n);
+        }
+      else
+        {
+          ret = bops->write(inode, bio->iov[i].iov_base, sector, n);
+        }
+
+      if (ret < 0)
+        {
+          break;
+        }
+
+      result += ret;
+      sector += ret;
+      if (ret < (ssize_t)n)
+        {
+          break;
+        }
+    }
+
+  bio->result = result > 0 || ret >= 0 ? result : ret;
+  bio->callback(bio);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bio_queue_init
+ ****************************************************************************/
+
+void bio_queue_init(FAR struct bio_queue_s *queue, unsigned int depth,
+                    unsigned int maxsegs, unsigned int maxsectors,
+                    bio_dispatch_t dispatch, FAR void *priv)
+{
+  DEBUGASSERT(depth > 0 && maxsegs > 0 && maxsectors > 0);
+
+  spin_lock_init(&queue->lock);
+  queue->pending    = NULL;
+  queue->cursor     = 0;
+  queue->inflight   = 0;
+  queue->depth      = depth;
+  queue->maxsegs    = maxsegs;
+  queue->maxsectors = maxsectors;
+  queue->kicking    = false;
+  queue->dispatch   = dispatch;
+  queue->priv       = priv;
+}
+
+/****************************************************************************
+ * Name: bio_queue_submit
+ ****************************************************************************/
+
+int bio_queue_submit(FAR struct bio_queue_s *queue, FAR struct bio_s *bio)
+{
+  FAR struct bio_split_s *split = NULL;
+  irqstate_t flags;
+  unsigned int i;
+  int ret;
+
+  bio_init_chain(bio);
+  if (bio->qsegs > queue->maxsegs || bio->qsectors > queue->maxsectors)
+    {
+      ret = bio_split(queue, bio, &split);
+      if (ret < 0)
+        {
+          return ret;
+        }
+    }
+
+  flags = spin_lock_irqsave(&queue->lock);
+  if (split != NULL)
+    {
+      for (i = 0; i < split->npieces; i++)
+        {
+          bio_queue_insert(queue, &split->piece[i]);
+        }
+    }
+  else
+    {
+      bio_queue_insert(queue, bio);
+    }
+
+  spin_unlock_irqrestore(&queue->lock, flags);
+
+  bio_queue_kick(queue);
+  return OK;
+}
+
+/****************************************************************************
+ * Name: bio_queue_done
+ ****************************************************************************/
+
+void bio_queue_done(FAR struct bio_queue_s *queue, FAR struct bio_s *bio,
+                    ssize_t result)
+{
+  FAR struct bio_s *next;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&queue->lock);
+  DEBUGASSERT(queue->inflight > 0);
+  queue->inflight--;
+  spin_unlock_irqrestore(&queue->lock, flags);
+
+  /* Split the chain result over its members in media order.  Members
+   * past a short transfer fail with -EIO.
+   */
+
+  for (; bio != NULL; bio = next)
+    {
+      next = bio->merged;
+
+      if (result < 0)
+        {
+          bio->result = result;
+        }
+      else if (result == 0)
+        {
+          bio->result = -EIO;
+        }
+      else
+        {
+          bio->result = result < (ssize_t)bio->nsectors ?
+                        result : (ssize_t)bio->nsectors;
+          result     -= bio->result;
+        }
+
+      bio->callback(bio);
+    }
+
+  bio_queue_kick(queue);
+}
+
+/****************************************************************************
+ * Name: bio_chain_iov
+ ****************************************************************************/
+
+int bio_chain_iov(FAR struct bio_s *bio, FAR struct iovec *iov, int maxiov)
+{
+  int n = 0;
+  int i;
+
+  for (; bio != NULL; bio = bio->merged)
+    {
+      for (i = 0; i < bio->iovcnt; i++)
+        {
+          if (n > 0 && bio_iov_contig(&iov[n - 1], &bio->iov[i]))
+            {
+              iov[n - 1].iov_len += bio->iov[i].iov_len;
+            }
+          else if (n < maxiov)
+            {
+              iov[n++] = bio->iov[i];
+            }
+          else
+            {
+              return -E2BIG;
+            }
+        }
+    }
+
+  return n;
+}
+
+#endif /* CONFIG_FS_BIO */
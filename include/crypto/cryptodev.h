@@ -371,6 +371,23 @@ struct crypt_op
   caddr_t aad;
 };
 
+/* One element of a batched or asynchronous request (CIOCCRYPTM,
+ * CIOCASYNCCRYPT, CIOCASYNCFETCH).
+ */
+
+struct crypt_aop
+{
+  struct crypt_op cop;
+  uint32_t reqid;     /* caller cookie, returned with the completion */
+  int status;         /* returns: 0 or a negated errno value */
+};
+
+struct crypt_mop
+{
+  uint32_t count;     /* in: entries in reqs, out: entries consumed */
+  FAR struct crypt_aop *reqs;
+};
+
 /* hamc buffer, software & hardware need it */
 
 extern const uint8_t hmac_ipad_buffer[HMAC_MAX_BLOCK_LEN];
@@ -392,6 +409,9 @@ extern const uint8_t hmac_opad_buffer[HMAC_MAX_BLOCK_LEN];
 #define CIOCKEY                 104
 #define CIOCKEYRET              105
 #define CIOCASYMFEAT            106
+#define CIOCCRYPTM              107 /* Run a batch of crypt_aop in order */
+#define CIOCASYNCCRYPT          108 /* Queue a batch to the crypto workers */
+#define CIOCASYNCFETCH          109 /* Reap completed CIOCASYNCCRYPT ops */
 
 int crypto_newsession(FAR uint64_t *, FAR struct cryptoini *, int);
 int crypto_freesession(uint64_t);
@@ -28,6 +28,7 @@
  ****************************************************************************/
 
 #include <sys/socket.h>
+#include <stdint.h>
 
 /****************************************************************************
  * Pre-processor Definitions
@@ -58,4 +59,52 @@
                                            * Argument: max retry count */
 #define TCP_MAXSEG    (__SO_PROTOCOL + 4) /* The maximum segment size */
 
+/* Congestion control algorithm.  Argument: the name string */
+
+#define TCP_CONGESTION (__SO_PROTOCOL + 5)
+
+/* The maximum length of a congestion control algorithm name, including the
+ * terminating NUL.
+ */
+
+#define TCP_CA_NAME_MAX 16
+
+/* Connection information.  Argument: struct tcp_info */
+
+#define TCP_INFO       (__SO_PROTOCOL + 6)
+
+/* Bits of tcpi_options */
+
+#define TCPI_OPT_TIMESTAMPS 0x01  /* RFC 7323 timestamps are used */
+#define TCPI_OPT_SACK       0x02  /* Selective ACKs are used */
+#define TCPI_OPT_WSCALE     0x04  /* Window scaling is used */
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The TCP_INFO option.  Times are in microseconds, windows and buffer
+ * fill levels in bytes.
+ */
+
+struct tcp_info
+{
+  uint8_t  tcpi_state;        /* TCP state (TCP_ESTABLISHED, ...) */
+  uint8_t  tcpi_options;      /* TCPI_OPT_* */
+  uint8_t  tcpi_snd_wscale;   /* Window scale shift of the peer */
+  uint8_t  tcpi_rcv_wscale;   /* Window scale shift we advertised */
+  uint32_t tcpi_rto;          /* Retransmission timeout */
+  uint32_t tcpi_snd_mss;      /* Send maximum segment size */
+  uint32_t tcpi_rtt;          /* Smoothed round trip time */
+  uint32_t tcpi_rttvar;       /* Round trip time variation */
+  uint32_t tcpi_retransmits;  /* Retransmissions of the oldest segment */
+  uint32_t tcpi_unacked;      /* Bytes sent but not yet ACKed */
+  uint32_t tcpi_snd_cwnd;     /* Congestion window */
+  uint32_t tcpi_snd_ssthresh; /* Slow start threshold */
+  uint32_t tcpi_snd_wnd;      /* Window advertised by the peer */
+  uint32_t tcpi_snd_buf;      /* Bytes queued for sending */
+  uint32_t tcpi_rcv_buf;      /* Bytes received but not yet read */
+  uint32_t tcpi_ofo_segs;     /* Out-of-order segments held */
+};
+
 #endif /* __INCLUDE_NETINET_TCP_H */
@@ -0,0 +1,220 @@
+/****************************************************************************
+ * include/nuttx/fs/bio.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_FS_BIO_H
+#define __INCLUDE_NUTTX_FS_BIO_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <stdbool.h>
+
+#include <nuttx/spinlock.h>
+
+#ifdef CONFIG_FS_BIO
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Request direction */
+
+#define BIO_READ  0
+#define BIO_WRITE 1
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* An asynchronous block request.  The submitter fills in the fields up to
+ * and including arg and must keep the structure and the iovec array alive
+ * until callback runs.  Every iovec length must be a multiple of the
+ * sector size and together they must cover exactly nsectors sectors.
+ *
+ * callback may run in interrupt context, on a worker thread, or in the
+ * submitting thread before block_operations::submit returns.
+ *
+ * A request with more segments or sectors than the driver accepts is cut
+ * into pieces by the request queue, so submitters need not know the
+ * driver limits.
+ *
+ * Overlapping requests in flight at the same time are not ordered with
+ * respect to each other; wait for a write to complete before submitting a
+ * request that depends on it.
+ */
+
+struct bio_s;
+typedef CODE void (*bio_callback_t)(FAR struct bio_s *bio);
+
+struct bio_s
+{
+  FAR const struct iovec *iov;      /* Scatter-gather list */
+  int                     iovcnt;   /* Number of iovec entries */
+  blkcnt_t                sector;   /* First sector */
+  unsigned int            nsectors; /* Sectors covered by iov */
+  uint8_t                 op;       /* BIO_READ or BIO_WRITE */
+  bio_callback_t          callback; /* Called exactly once on completion */
+  FAR void               *arg;      /* Opaque submitter data */
+
+  /* Set before callback: sectors transferred or a negated errno value */
+
+  ssize_t                 result;
+
+  /* The following are owned by the request queue while the request is
+   * queued or in flight.
+   */
+
+  FAR struct bio_s       *flink;    /* Next request in the elevator */
+  FAR struct bio_s       *merged;   /* Next request merged behind this */
+  FAR struct bio_s       *last;     /* Last request of the merged chain */
+  unsigned int            qsectors; /* Sectors of the whole chain */
+  unsigned int            qsegs;    /* Coalesced segments of the chain */
+};
+
+/* A per-device request queue.  Pending requests are kept sorted by sector
+ * and adjacent requests in the same direction are merged into a chain that
+ * the driver executes as one device command.  Up to depth chains are
+ * handed to the driver at a time, taken in one-way elevator (C-SCAN)
+ * order.
+ */
+
+struct bio_queue_s;
+typedef CODE void (*bio_dispatch_t)(FAR struct bio_queue_s *queue,
+                                    FAR struct bio_s *bio);
+
+struct bio_queue_s
+{
+  spinlock_t        lock;       /* Protects the fields below */
+  FAR struct bio_s *pending;    /* Sorted by sector, not yet dispatched */
+  blkcnt_t          cursor;     /* Elevator position */
+  unsigned int      inflight;   /* Chains owned by the driver */
+  unsigned int      depth;      /* Maximum inflight */
+  unsigned int      maxsegs;    /* Maximum coalesced segments per chain */
+  unsigned int      maxsectors; /* Maximum sectors per chain */
+  bool              kicking;    /* A thread is dispatching */
+  bio_dispatch_t    dispatch;   /* Start a chain, see bio_queue_done() */
+  FAR void         *priv;       /* Driver data */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+struct inode;
+
+/****************************************************************************
+ * Name: bio_submit
+ *
+ * Description:
+ *   Submit bio to the block driver behind inode.  Drivers without a
+ *   submit method are served synchronously through their read and write
+ *   methods, so callers need only one code path.
+ *
+ * Returned Value:
+ *   Zero if the request was accepted; its outcome is reported through the
+ *   callback.  A negated errno value if it was rejected, in which case
+ *   the callback is not called.
+ *
+ ****************************************************************************/
+
+int bio_submit(FAR struct inode *inode, FAR struct bio_s *bio);
+
+/****************************************************************************
+ * Name: bio_queue_init
+ *
+ * Description:
+ *   Initialize a request queue.  dispatch is called without the queue lock
+ *   held, possibly from bio_queue_done() in interrupt context, and must
+ *   eventually report the chain through bio_queue_done().
+ *
+ ****************************************************************************/
+
+void bio_queue_init(FAR struct bio_queue_s *queue, unsigned int depth,
+                    unsigned int maxsegs, unsigned int maxsectors,
+                    bio_dispatch_t dispatch, FAR void *priv);
+
+/****************************************************************************
+ * Name: bio_queue_submit
+ *
+ * Description:
+ *   Add bio to the queue, merging it with an adjacent pending request when
+ *   the limits allow, and dispatch as much as the queue depth permits.
+ *   A request beyond maxsegs or maxsectors is queued as several pieces.
+ *
+ * Returned Value:
+ *   Zero if the request was queued.  A negated errno value if it could
+ *   not be split, in which case the callback is not called.
+ *
+ ****************************************************************************/
+
+int bio_queue_submit(FAR struct bio_queue_s *queue, FAR struct bio_s *bio);
+
+/****************************************************************************
+ * Name: bio_queue_done
+ *
+ * Description:
+ *   Called by the driver when the chain headed by bio has finished.
+ *   result is the number of sectors transferred for the whole chain or a
+ *   negated errno value.  Completes every request in the chain and
+ *   dispatches more work.  May be called from interrupt context.
+ *
+ ****************************************************************************/
+
+void bio_queue_done(FAR struct bio_queue_s *queue, FAR struct bio_s *bio,
+                    ssize_t result);
+
+/****************************************************************************
+ * Name: bio_chain_iov
+ *
+ * Description:
+ *   Flatten the chain headed by bio into at most maxiov segments, joining
+ *   segments that are contiguous in memory.  A chain built by the queue
+ *   always fits in queue->maxsegs entries.
+ *
+ * Returned Value:
+ *   The number of entries written to iov, or -E2BIG if the chain does not
+ *   fit.
+ *
+ ****************************************************************************/
+
+int bio_chain_iov(FAR struct bio_s *bio, FAR struct iovec *iov, int maxiov);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_FS_BIO */
+#endif /* __INCLUDE_NUTTX_FS_BIO_H */
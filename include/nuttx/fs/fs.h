@@ -189,6 +189,7 @@ struct statfs;
 struct pollfd;
 struct mtd_dev_s;
 struct uio;
+struct bio_s;
 
 /* The internal representation of type DIR is just a container for an inode
  * reference, and the path of directory.
@@ -274,6 +275,9 @@ struct block_operations
 #ifndef CONFIG_DISABLE_PSEUDOFS_OPERATIONS
   CODE int     (*unlink)(FAR struct inode *inode);
 #endif
+#ifdef CONFIG_FS_BIO
+  CODE int     (*submit)(FAR struct inode *inode, FAR struct bio_s *bio);
+#endif
 };
 
 /* This structure is provided by a filesystem to describe a mount point.
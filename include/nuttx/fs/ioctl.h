@@ -362,6 +362,11 @@
                                            * IN:  None
                                            * OUT: None (ioctl return value provides
                                            *      success/failure indication). */
+#define BIOC_FTLSTATS   _BIOC(0x0012)     /* Get log-structured FTL counters
+                                           * IN:  Pointer to writable instance
+                                           *      of struct ftl_stats_s
+                                           * OUT: Data return in user-provided
+                                           *      buffer. */
 
 /* NuttX MTD driver ioctl definitions ***************************************/
 
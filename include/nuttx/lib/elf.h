@@ -34,6 +34,10 @@
 
 #include <nuttx/addrenv.h>
 
+#ifdef CONFIG_LIBC_ELF_SYMHASH
+#  include <nuttx/symtab.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -84,6 +88,19 @@
 #  define LIBC_ELF_NAMEMAX NAME_MAX
 #endif
 
+/* Load time phases, see mod_loadinfo_s::loadtime.  SYMBOLS and RELREAD are
+ * the parts of BIND spent resolving symbols and reading relocations.
+ */
+
+#ifdef CONFIG_LIBC_ELF_LOADTIME
+#  define LIBELF_TIME_INIT     0  /* libelf_initialize() */
+#  define LIBELF_TIME_LOAD     1  /* libelf_load() */
+#  define LIBELF_TIME_BIND     2  /* libelf_bind() */
+#  define LIBELF_TIME_SYMBOLS  3  /* Symbol resolution */
+#  define LIBELF_TIME_RELREAD  4  /* Relocation table reads */
+#  define LIBELF_TIME_NPHASES  5
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -158,6 +175,9 @@ struct module_s
   char modname[LIBC_ELF_NAMEMAX];        /* Module name */
 #endif
   struct mod_info_s modinfo;           /* Module information */
+#ifdef CONFIG_LIBC_ELF_SYMHASH
+  struct symtab_hash_s exporthash;     /* Index of modinfo.exports */
+#endif
   FAR void *textalloc;                 /* Allocated kernel text memory */
   FAR void *dataalloc;                 /* Allocated kernel memory */
   uintptr_t xipbase;                   /* if elf is position independent, and use
@@ -240,6 +260,19 @@ struct mod_loadinfo_s
                               * romfs/tmps, we can try get xipbase,
                               * skip the copy.
                               */
+#ifdef CONFIG_LIBC_ELF_XIP
+  uintptr_t     xipfile;     /* File contents mapped in place, if not 0 */
+#endif
+
+#ifdef CONFIG_LIBC_ELF_BULKREAD
+  FAR Elf_Sym  *symbols;     /* Whole symbol table while binding */
+  FAR uint8_t  *symdone;     /* Bitmap of resolved symbols[] entries */
+  size_t        nsymbols;    /* Number of symbols[] entries */
+#endif
+
+#ifdef CONFIG_LIBC_ELF_LOADTIME
+  uint32_t      loadtime[LIBELF_TIME_NPHASES]; /* Microseconds per phase */
+#endif
 
   /* Address environment.
    *
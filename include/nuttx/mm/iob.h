@@ -129,6 +129,7 @@ struct iob_s
 
 #ifdef CONFIG_IOB_ALLOC
   iob_free_cb_t io_free;  /* Custom free callback */
+  FAR void     *io_priv;  /* The argument of the free callback */
   FAR uint8_t  *io_data;
 #else
   uint8_t       io_data[CONFIG_IOB_BUFSIZE];
@@ -262,6 +263,10 @@ FAR struct iob_s *iob_alloc_dynamic(uint16_t size);
  *             perform additional operations on the data before it is freed.
  *             The free_cb is called when the iob is freed.
  *
+ *   free_cb receives io_priv, which is initialized to data.  The owner may
+ *   point io_priv to its own bookkeeping instead, e.g. when many iobs
+ *   share one external buffer.
+ *
  ****************************************************************************/
 
 FAR struct iob_s *iob_alloc_with_data(FAR void *data, uint16_t size,
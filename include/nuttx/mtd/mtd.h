@@ -121,6 +121,24 @@ struct mtd_geometry_s
   char     model[NAME_MAX + 1];
 };
 
+/* Counters returned by BIOC_FTLSTATS from a log-structured FTL.  Write
+ * amplification is flashwrites / hostwrites.
+ */
+
+struct ftl_stats_s
+{
+  uint64_t hostwrites;    /* Sectors written through the block driver */
+  uint64_t flashwrites;   /* Pages programmed, including metadata and GC */
+  uint32_t erases;        /* Erase block erasures */
+  uint32_t gcruns;        /* Erase blocks garbage collected */
+  uint32_t gccopies;      /* Live pages moved by garbage collection */
+  uint32_t wlmoves;       /* Collections done for static wear leveling */
+  uint32_t minerase;      /* Lowest erase count of a good block */
+  uint32_t maxerase;      /* Highest erase count of a good block */
+  uint32_t nfree;         /* Erased blocks ready for use */
+  uint32_t nbad;          /* Retired blocks */
+};
+
 /* This structure describes a range of sectors to be protected or
  * unprotected.
  */
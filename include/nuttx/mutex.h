@@ -30,6 +30,7 @@
 #include <assert.h>
 #include <stdbool.h>
 
+#include <nuttx/atomic.h>
 #include <nuttx/semaphore.h>
 
 /****************************************************************************
@@ -41,16 +42,47 @@
 
 #define NXRMUTEX_INITIALIZER   {NXMUTEX_INITIALIZER, 0}
 
+/* Spinning needs the scheduler state, which only the kernel can see */
+
+#if defined(CONFIG_LIBC_MUTEX_SPIN) && CONFIG_LIBC_MUTEX_SPIN > 0 && \
+    (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+#  define NXMUTEX_SPIN CONFIG_LIBC_MUTEX_SPIN
+#endif
+
+#if defined(NXMUTEX_SPIN) || defined(CONFIG_LIBC_MUTEX_STATS)
+#  define NXMUTEX_ADAPTIVE
+#endif
+
+#ifdef CONFIG_LIBC_MUTEX_STATS
+#  define nxmutex_count(mutex, field) \
+     atomic_fetch_add(&(mutex)->stats.field, 1)
+#else
+#  define nxmutex_count(mutex, field)
+#endif
+
 /****************************************************************************
  * Public Type Definitions
  ****************************************************************************/
 
+#ifdef CONFIG_LIBC_MUTEX_STATS
+struct mutex_stats_s
+{
+  atomic_t nlocks;      /* Successful lock operations */
+  atomic_t ncontended;  /* Lock operations that found the mutex held */
+  atomic_t nspin;       /* Contended locks that got the mutex spinning */
+  atomic_t nblocked;    /* Contended locks that had to block */
+};
+#endif
+
 struct mutex_s
 {
   sem_t sem;
 #if CONFIG_LIBC_MUTEX_BACKTRACE > 0
   FAR void *backtrace[CONFIG_LIBC_MUTEX_BACKTRACE];
 #endif
+#ifdef CONFIG_LIBC_MUTEX_STATS
+  struct mutex_stats_s stats;
+#endif
 };
 
 typedef struct mutex_s mutex_t;
@@ -77,6 +109,19 @@ extern "C"
 #define EXTERN extern
 #endif
 
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef NXMUTEX_SPIN
+/* The thread that each CPU runs.  The scheduler publishes it on every
+ * context switch, so nxmutex_spin() can tell whether the holder runs
+ * without looking up its TCB.
+ */
+
+EXTERN atomic_t g_running_pids[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Name: nxmutex_add_backtrace
  *
@@ -96,6 +141,44 @@ void nxmutex_add_backtrace(FAR mutex_t *mutex);
 #  define nxmutex_add_backtrace(mutex)
 #endif
 
+/****************************************************************************
+ * Name: nxmutex_spin
+ *
+ * Description:
+ *   Try to take the mutex without blocking.  If the mutex is held by a
+ *   thread that is running on another CPU, poll it up to
+ *   CONFIG_LIBC_MUTEX_SPIN times before giving up, the holder will likely
+ *   release it sooner than a block and wakeup would take.
+ *
+ * Parameters:
+ *   mutex - mutex descriptor.
+ *
+ * Return Value:
+ *   Zero (OK) if the mutex was taken; -EAGAIN if the caller has to block.
+ *
+ ****************************************************************************/
+
+#ifdef NXMUTEX_ADAPTIVE
+int nxmutex_spin(FAR mutex_t *mutex);
+#endif
+
+/****************************************************************************
+ * Name: nxmutex_get_stats
+ *
+ * Description:
+ *   Return a snapshot of the contention statistics of the mutex.
+ *
+ * Parameters:
+ *   mutex - mutex descriptor.
+ *   stats - Location to return the statistics.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_MUTEX_STATS
+void nxmutex_get_stats(FAR mutex_t *mutex,
+                       FAR struct mutex_stats_s *stats);
+#endif
+
 /****************************************************************************
  * Name: nxmutex_init
  *
@@ -505,9 +588,17 @@ static inline_function int nxmutex_lock(FAR mutex_t *mutex)
 {
   int ret;
 
+#ifdef NXMUTEX_ADAPTIVE
+  if (nxmutex_spin(mutex) >= 0)
+    {
+      return OK;
+    }
+#endif
+
   ret = nxsem_wait(&mutex->sem);
   if (ret >= 0)
     {
+      nxmutex_count(mutex, nlocks);
       nxmutex_add_backtrace(mutex);
     }
 
@@ -542,6 +633,7 @@ static inline_function int nxmutex_trylock(FAR mutex_t *mutex)
   ret = nxsem_trywait(&mutex->sem);
   if (ret >= 0)
     {
+      nxmutex_count(mutex, nlocks);
       nxmutex_add_backtrace(mutex);
     }
 
@@ -47,6 +47,10 @@
 #  define CONFIG_NET_IPv6_NCONF_ENTRIES 8
 #endif
 
+#ifndef CONFIG_NET_IPv6_NCONF_MAXENTRIES
+#  define CONFIG_NET_IPv6_NCONF_MAXENTRIES CONFIG_NET_IPv6_NCONF_ENTRIES
+#endif
+
 /****************************************************************************
  * Public Types
  ****************************************************************************/
@@ -641,6 +641,14 @@
 #  define CONFIG_NET_ARPTAB_SIZE 8
 #endif
 
+#ifndef CONFIG_NET_ARPTAB_MAXSIZE
+/* The ARP table grows on the heap up to this size before entries are
+ * replaced.
+ */
+
+#  define CONFIG_NET_ARPTAB_MAXSIZE CONFIG_NET_ARPTAB_SIZE
+#endif
+
 #ifndef CONFIG_NET_ARP_MAXAGE
 /* The maximum age of ARP table entries measured in 10ths of seconds.
  *
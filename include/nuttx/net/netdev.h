@@ -541,6 +541,13 @@ struct net_driver_s
   CODE int (*d_ioctl)(FAR struct net_driver_s *dev, int cmd,
                       unsigned long arg);
 #endif
+#ifdef CONFIG_NET_BUSY_POLL
+  /* Receive the packets waiting in the driver now, with the network
+   * locked.  Optional, used by SO_BUSY_POLL.
+   */
+
+  CODE int (*d_rxpoll)(FAR struct net_driver_s *dev);
+#endif
 
   /* Drivers may attached device-specific, private information */
 
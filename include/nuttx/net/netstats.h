@@ -80,6 +80,17 @@
  * Public Type Definitions
  ****************************************************************************/
 
+/* Statistics of the ARP and the IPv6 Neighbor tables */
+
+#if defined(CONFIG_NET_ARP) || defined(CONFIG_NET_IPv6)
+struct neighbor_stats_s
+{
+  net_stats_t hit;          /* Lookups that found a usable entry */
+  net_stats_t miss;         /* Lookups that did not */
+  net_stats_t evict;        /* Entries replaced to make room */
+};
+#endif
+
 /* The structure holding the networking statistics that are gathered if
  * CONFIG_NET_STATISTICS is defined.
  */
@@ -121,6 +132,14 @@ struct net_stats_s
 #ifdef CONFIG_NET_CAN
   struct can_stats_s  can;      /* CAN statistics */
 #endif
+
+#ifdef CONFIG_NET_ARP
+  struct neighbor_stats_s arp;  /* ARP table statistics */
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  struct neighbor_stats_s nd;   /* IPv6 Neighbor table statistics */
+#endif
 };
 
 /****************************************************************************
@@ -511,6 +511,30 @@
 #define SNIOC_COLD_START              _SNIOC(0X00A7)
 #define SNIOC_FULL_COLD_START         _SNIOC(0X00A8)
 
+/* Command:      SNIOC_GROUP_ADD
+ * Description:  Add a subscribed topic to a wait group.  SNIOC_BATCH on
+ *               the group sets the batch latency of all of its topics.
+ * Argument:     The descriptor of the topic, (int)
+ */
+
+#define SNIOC_GROUP_ADD               _SNIOC(0x00A9)
+
+/* Command:      SNIOC_GROUP_REMOVE
+ * Description:  Remove a topic from a wait group.
+ * Argument:     The descriptor given to SNIOC_GROUP_ADD, (int)
+ */
+
+#define SNIOC_GROUP_REMOVE            _SNIOC(0x00AA)
+
+/* Command:      SNIOC_GROUP_WATERMARK
+ * Description:  Set the number of samples, summed over all topics of a
+ *               wait group, that wake the group up before the batch
+ *               latency expires.  Default: 1
+ * Argument:     The number of samples, (uint32_t)
+ */
+
+#define SNIOC_GROUP_WATERMARK         _SNIOC(0x00AB)
+
 /****************************************************************************
  * Public types
  ****************************************************************************/
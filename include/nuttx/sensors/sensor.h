@@ -795,6 +795,23 @@ void sensor_rpmsg_unregister(FAR struct sensor_lowerhalf_s *lower);
 int sensor_rpmsg_initialize(void);
 #endif
 
+/****************************************************************************
+ * Name: sensor_group_initialize
+ *
+ * Description:
+ *   This function registers the "/dev/uorbgroup" character node, which
+ *   lets an application wait for new samples on a set of topics with a
+ *   single wakeup per batch.
+ *
+ * Returned Value:
+ *   OK on success; A negated errno value is returned on any failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SENSORS_GROUP
+int sensor_group_initialize(void);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -79,6 +79,12 @@ extern "C"
 #  define UP_SEV()
 #endif
 
+/* A pause between two polls of a busy location */
+
+#if !defined(UP_RELAX)
+#  define UP_RELAX()
+#endif
+
 #if !defined(__SP_UNLOCK_FUNCTION) && (defined(CONFIG_TICKET_SPINLOCK) || \
      defined(CONFIG_SCHED_INSTRUMENTATION_SPINLOCKS))
 #  define __SP_UNLOCK_FUNCTION 1
@@ -29,6 +29,8 @@
 
 #include <nuttx/config.h>
 
+#include <stdint.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -57,6 +59,26 @@ struct symtab_s
   FAR const void *sym_value; /* The value associated with the string */
 };
 
+/* A hashed index over a symbol table, laid out like the ELF .gnu.hash
+ * section: a Bloom filter rejects most misses with one word test, then
+ * each bucket is a run of chain[] entries holding the symbol hashes with
+ * bit 0 set on the last entry of the run.  Since the indexed table is
+ * const, order[] maps chain positions back to table entries.
+ */
+
+struct symtab_hash_s
+{
+  FAR const struct symtab_s *symtab;   /* The table indexed */
+  int                        nsyms;    /* Number of entries in symtab */
+  uint32_t                   nbuckets; /* Power of two */
+  uint32_t                   nbloom;   /* Bloom words, power of two */
+  uint32_t                   shift;    /* Shift for the second Bloom bit */
+  FAR uintptr_t             *bloom;    /* Bloom filter */
+  FAR uint32_t              *buckets;  /* Start of each run or UINT32_MAX */
+  FAR uint32_t              *chain;    /* Symbol hashes */
+  FAR uint32_t              *order;    /* Table index of each chain entry */
+};
+
 /****************************************************************************
  * Public Functions Definitions
  ****************************************************************************/
@@ -121,6 +143,53 @@ symtab_findbyvalue(FAR const struct symtab_s *symtab,
 
 void symtab_sortbyname(FAR struct symtab_s *symtab, int nsyms);
 
+/****************************************************************************
+ * Name: symtab_gnuhash
+ *
+ * Description:
+ *   Return the GNU (DJB) hash of a symbol name, as used in .gnu.hash.
+ *
+ ****************************************************************************/
+
+uint32_t symtab_gnuhash(FAR const char *name);
+
+/****************************************************************************
+ * Name: symtab_hashinit
+ *
+ * Description:
+ *   Build a hashed index over symtab.  The table must stay unchanged while
+ *   the index is in use.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOMEM if the index could not be allocated.
+ *
+ ****************************************************************************/
+
+int symtab_hashinit(FAR struct symtab_hash_s *hash,
+                    FAR const struct symtab_s *symtab, int nsyms);
+
+/****************************************************************************
+ * Name: symtab_hashfind
+ *
+ * Description:
+ *   Find the symbol with the matching name, in constant expected time.
+ *   Gives the same result as symtab_findbyname() on an unordered table.
+ *
+ ****************************************************************************/
+
+FAR const struct symtab_s *
+symtab_hashfind(FAR const struct symtab_hash_s *hash, FAR const char *name);
+
+/****************************************************************************
+ * Name: symtab_hashfree
+ *
+ * Description:
+ *   Release the memory held by a hashed index.
+ *
+ ****************************************************************************/
+
+void symtab_hashfree(FAR struct symtab_hash_s *hash);
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -150,6 +150,19 @@ ssize_t ramlog_write(FAR syslog_channel_t *channel,
                      FAR const char *buffer, size_t buflen);
 #endif
 
+/****************************************************************************
+ * Name: ramlog_flush
+ *
+ * Description:
+ *   Write the characters that ramlog_putc() holds back until the end of
+ *   the line on the calling CPU.
+ *
+ ****************************************************************************/
+
+#if defined(CONFIG_RAMLOG_SYSLOG) && defined(CONFIG_RAMLOG_PERCPU)
+int ramlog_flush(FAR syslog_channel_t *channel);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
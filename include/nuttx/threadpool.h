@@ -0,0 +1,175 @@
+/****************************************************************************
+ * include/nuttx/threadpool.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_NUTTX_THREADPOOL_H
+#define __INCLUDE_NUTTX_THREADPOOL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <semaphore.h>
+
+#include <nuttx/atomic.h>
+#include <nuttx/list.h>
+
+#ifdef CONFIG_LIBC_THREADPOOL
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* The pool itself is opaque */
+
+struct threadpool_s;
+
+/* The task callback */
+
+typedef CODE void (*threadpool_func_t)(FAR void *arg);
+
+/* The threadpool_parallel_for() callback, called for [begin, end) */
+
+typedef CODE void (*threadpool_range_t)(size_t begin, size_t end,
+                                        FAR void *arg);
+
+/* One task, which is also the future to wait for it.  The caller provides
+ * the storage, which must stay valid until threadpool_wait() returned; all
+ * fields are managed by the thread pool.
+ */
+
+struct threadpool_task_s
+{
+  struct list_node  node;      /* Link in the deque of a worker */
+  threadpool_func_t func;      /* The task callback */
+  FAR void         *arg;       /* The argument of the callback */
+  sem_t             done;      /* Posted when the callback returned */
+  atomic_t          finished;  /* 1 when run, -1 when cancelled */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: threadpool_create
+ *
+ * Description:
+ *   Create a pool of worker threads.  Every worker has its own deque of
+ *   tasks: it runs the newest task of its own deque first and, when that
+ *   is empty, steals the oldest task from the deque of another worker.
+ *
+ * Input Parameters:
+ *   nthreads  - The number of worker threads, 0 for one per CPU
+ *   priority  - The priority of the workers, 0 for the default
+ *   stacksize - The stack size of the workers, 0 for the default
+ *
+ * Returned Value:
+ *   The pool on success; NULL on failure.
+ *
+ ****************************************************************************/
+
+FAR struct threadpool_s *threadpool_create(int nthreads, int priority,
+                                           size_t stacksize);
+
+/****************************************************************************
+ * Name: threadpool_destroy
+ *
+ * Description:
+ *   Stop and join the workers and free the pool.  Tasks that are still
+ *   queued are not run: they are cancelled and threadpool_wait() returns
+ *   -ECANCELED for them.
+ *
+ ****************************************************************************/
+
+void threadpool_destroy(FAR struct threadpool_s *pool);
+
+/****************************************************************************
+ * Name: threadpool_submit
+ *
+ * Description:
+ *   Queue func(arg) on the pool.  When called from a worker of the pool
+ *   the task goes to the deque of that worker, otherwise the deques are
+ *   used in turn.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int threadpool_submit(FAR struct threadpool_s *pool,
+                      FAR struct threadpool_task_s *task,
+                      threadpool_func_t func, FAR void *arg);
+
+/****************************************************************************
+ * Name: threadpool_wait
+ *
+ * Description:
+ *   Wait until a submitted task has run.  A worker of the pool that waits
+ *   runs other queued tasks in the meantime, so tasks may wait for the
+ *   tasks they submitted without exhausting the pool.  Only one thread
+ *   may wait for a task.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ECANCELED if the pool was destroyed before the
+ *   task ran; another negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int threadpool_wait(FAR struct threadpool_s *pool,
+                    FAR struct threadpool_task_s *task);
+
+/****************************************************************************
+ * Name: threadpool_parallel_for
+ *
+ * Description:
+ *   Call func on sub-ranges of [begin, end) of at least grain elements in
+ *   parallel and return when all of them have run.  The calling thread
+ *   runs one of the sub-ranges itself.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; a negated errno value on failure.
+ *
+ ****************************************************************************/
+
+int threadpool_parallel_for(FAR struct threadpool_s *pool,
+                            size_t begin, size_t end, size_t grain,
+                            threadpool_range_t func, FAR void *arg);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif /* CONFIG_LIBC_THREADPOOL */
+#endif /* __INCLUDE_NUTTX_THREADPOOL_H */
@@ -34,6 +34,7 @@
 #include <stdbool.h>
 #include <limits.h>
 
+#include <nuttx/atomic.h>
 #include <nuttx/sensors/ioctl.h>
 
 /****************************************************************************
@@ -1186,6 +1187,56 @@ struct sensor_ustate_s
   uint64_t generation;         /* The recent generation of circular buffer */
 };
 
+/* Layout of the memory that mmap() returns for a topic: a ring holding
+ * the most recent nbuffer samples, which subscribers read in place without
+ * taking a lock.
+ *
+ * The header is followed by nbuffer slots of stride bytes.  Sample n
+ * (counted from 0 since the ring was created) lives in slot n % nbuffer,
+ * which holds a sequence word followed by the sample at SENSOR_RING_DATA.
+ * The sequence word is 2 * n + 1 while the publisher writes sample n and
+ * 2 * n + 2 once it is complete.  head is the number of samples published
+ * and is updated after the slots.  All counts wrap modulo 2^32.  The
+ * header is written for subscribers only, the publisher never reads it.
+ *
+ * To use sample n, load its sequence word with acquire semantics and
+ * check that it is 2 * n + 2; otherwise the sample is not published yet
+ * or has been overwritten.  Then use the sample in place, issue an
+ * acquire fence and load the sequence word again.  If it changed, the
+ * sample was overwritten meanwhile and what was read must be discarded.
+ *
+ * Once a subscriber has mapped the topic, poll() reports POLLIN once per
+ * batch of publications: each wakeup marks all samples published so far
+ * as seen, whether or not the subscriber reads them.
+ */
+
+#define SENSOR_RING_DATA              8
+#define SENSOR_RING_STRIDE(esize)     (((esize) + SENSOR_RING_DATA + 7) & ~7)
+#define SENSOR_RING_SIZE(esize, nbuffer) \
+  (sizeof(struct sensor_ring_s) + (nbuffer) * SENSOR_RING_STRIDE(esize))
+#define SENSOR_RING_SLOT(ring, n) \
+  ((FAR uint8_t *)((ring) + 1) + ((n) % (ring)->nbuffer) * (ring)->stride)
+#define SENSOR_RING_SEQ(ring, n)      ((FAR atomic_t *)SENSOR_RING_SLOT(ring, n))
+
+struct sensor_ring_s
+{
+  uint32_t esize;              /* The size of one sample */
+  uint32_t nbuffer;            /* The number of slots */
+  uint32_t stride;             /* The size of one slot, see above */
+  atomic_t head;               /* The number of samples published */
+};
+
+/* read() on a wait group ("/dev/uorbgroup") returns an array of these, one
+ * for each topic of the group with new samples.  The samples themselves
+ * are read from the topic descriptor as usual.
+ */
+
+struct sensor_group_event_s
+{
+  int      fd;                 /* The descriptor given to SNIOC_GROUP_ADD */
+  uint32_t count;              /* Samples published since the last read */
+};
+
 /* This structure describes the register info for the user sensor */
 
 #ifdef CONFIG_USENSOR
@@ -36,6 +36,10 @@
 #include <nuttx/list.h>
 #include <nuttx/wdog.h>
 
+#ifdef CONFIG_WQUEUE_PENDING_TREE
+#  include <sys/tree.h>
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -101,6 +105,7 @@
 
 #  undef CONFIG_SCHED_HPWORK
 #  undef CONFIG_SCHED_LPWORK
+#  undef CONFIG_SCHED_CPUWORK
 #  undef CONFIG_SCHED_WORKQUEUE
 
   /* User-space worker threads are not built in a kernel build when we are
@@ -250,6 +255,9 @@ typedef CODE void (*worker_t)(FAR void *arg);
 struct work_s
 {
   struct list_node node;   /* Implements a double linked list */
+#ifdef CONFIG_WQUEUE_PENDING_TREE
+  RB_ENTRY(work_s) entry;  /* Node in the tree of delayed work */
+#endif
   clock_t          qtime;  /* Time work queued */
   worker_t         worker; /* Work callback */
   FAR void        *arg;    /* Callback argument */
@@ -485,6 +493,33 @@ int work_cancel(int qid, FAR struct work_s *work);
 int work_cancel_wq(FAR struct kwork_wqueue_s *wqueue,
                    FAR struct work_s *work);
 
+/****************************************************************************
+ * Name: work_queue_on/work_cancel_on
+ *
+ * Description:
+ *   Queue work to, or cancel work on, the work queue of one CPU.  The work
+ *   runs on the worker thread pinned to that CPU.  Otherwise these behave
+ *   like work_queue() and work_cancel().
+ *
+ * Input Parameters:
+ *   cpu    - The CPU index, 0 .. CONFIG_SMP_NCPUS - 1
+ *   work   - The work structure to queue or cancel
+ *   worker - The worker callback to be invoked
+ *   arg    - The argument that will be passed to the worker callback
+ *   delay  - Delay (in clock ticks) from the time queue until the worker
+ *            is invoked. Zero means to perform the work immediately.
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPUWORK
+int work_queue_on(int cpu, FAR struct work_s *work, worker_t worker,
+                  FAR void *arg, clock_t delay);
+int work_cancel_on(int cpu, FAR struct work_s *work);
+#endif
+
 /****************************************************************************
  * Name: work_cancel_sync/work_cancel_sync_wq
  *
@@ -0,0 +1,192 @@
+/****************************************************************************
+ * include/sys/io_uring.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __INCLUDE_SYS_IO_URING_H
+#define __INCLUDE_SYS_IO_URING_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+/* The structure layouts, opcodes and mmap offsets follow the Linux
+ * io_uring ABI so that existing ring helpers can be reused.  Only the
+ * subset listed below is implemented.
+ */
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* io_uring_sqe.flags */
+
+#define IOSQE_FIXED_FILE          (1 << 0) /* fd indexes the registered files */
+
+/* io_uring_params.flags (none supported yet, must be zero) */
+
+/* io_uring_params.features */
+
+#define IORING_FEAT_SINGLE_MMAP   (1 << 0) /* SQ and CQ rings share a mapping */
+#define IORING_FEAT_NODROP        (1 << 1) /* CQ never overflows */
+#define IORING_FEAT_SUBMIT_STABLE (1 << 2) /* SQE may be reused on return */
+
+/* Supported opcodes */
+
+#define IORING_OP_NOP             0
+#define IORING_OP_READV           1
+#define IORING_OP_WRITEV          2
+#define IORING_OP_FSYNC           3
+#define IORING_OP_READ_FIXED      4
+#define IORING_OP_WRITE_FIXED     5
+#define IORING_OP_READ            22
+#define IORING_OP_WRITE           23
+#define IORING_OP_SEND            26
+#define IORING_OP_RECV            27
+
+/* io_uring_enter() flags */
+
+#define IORING_ENTER_GETEVENTS    (1 << 0)
+
+/* io_uring_register() opcodes */
+
+#define IORING_REGISTER_BUFFERS   0
+#define IORING_UNREGISTER_BUFFERS 1
+#define IORING_REGISTER_FILES     2
+#define IORING_UNREGISTER_FILES   3
+
+/* mmap() offsets of the shared regions */
+
+#define IORING_OFF_SQ_RING        0
+#define IORING_OFF_CQ_RING        0x8000000
+#define IORING_OFF_SQES           0x10000000
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+/* Submission queue entry.  off == (uint64_t)-1 means "use and advance the
+ * current file position".
+ */
+
+struct io_uring_sqe
+{
+  uint8_t  opcode;      /* IORING_OP_* */
+  uint8_t  flags;       /* IOSQE_* */
+  uint16_t ioprio;
+  int32_t  fd;          /* File descriptor or registered file index */
+  uint64_t off;         /* File offset */
+  uint64_t addr;        /* Buffer or iovec array */
+  uint32_t len;         /* Buffer length or iovec count */
+  union
+  {
+    uint32_t rw_flags;
+    uint32_t fsync_flags;
+    uint32_t msg_flags; /* MSG_* for SEND and RECV */
+  };
+
+  uint64_t user_data;   /* Returned untouched in the completion */
+  uint16_t buf_index;   /* Registered buffer for *_FIXED */
+  uint16_t personality;
+  int32_t  splice_fd_in;
+  uint64_t resv[2];
+};
+
+/* Completion queue entry */
+
+struct io_uring_cqe
+{
+  uint64_t user_data;   /* sqe->user_data */
+  int32_t  res;         /* Result, or a negated errno value */
+  uint32_t flags;
+};
+
+/* Byte offsets of the ring fields within the IORING_OFF_SQ_RING and
+ * IORING_OFF_CQ_RING mappings.
+ */
+
+struct io_sqring_offsets
+{
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t flags;
+  uint32_t dropped;
+  uint32_t array;
+  uint32_t resv1;
+  uint64_t resv2;
+};
+
+struct io_cqring_offsets
+{
+  uint32_t head;
+  uint32_t tail;
+  uint32_t ring_mask;
+  uint32_t ring_entries;
+  uint32_t overflow;
+  uint32_t cqes;
+  uint32_t flags;
+  uint32_t resv1;
+  uint64_t resv2;
+};
+
+struct io_uring_params
+{
+  uint32_t sq_entries;  /* Returns: SQ size (power of two) */
+  uint32_t cq_entries;  /* Returns: CQ size, twice sq_entries */
+  uint32_t flags;
+  uint32_t sq_thread_cpu;
+  uint32_t sq_thread_idle;
+  uint32_t features;    /* Returns: IORING_FEAT_* */
+  uint32_t wq_fd;
+  uint32_t resv[3];
+  struct io_sqring_offsets sq_off;
+  struct io_cqring_offsets cq_off;
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+int io_uring_setup(unsigned int entries, FAR struct io_uring_params *p);
+int io_uring_enter(int fd, unsigned int to_submit,
+                   unsigned int min_complete, unsigned int flags);
+int io_uring_register(int fd, unsigned int opcode, FAR void *arg,
+                      unsigned int nr_args);
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __INCLUDE_SYS_IO_URING_H */
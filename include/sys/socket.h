@@ -136,10 +136,15 @@
 #define MSG_ERRQUEUE     0x002000 /* Fetch message from error queue.  */
 #define MSG_NOSIGNAL     0x004000 /* Do not generate SIGPIPE.  */
 #define MSG_MORE         0x008000 /* Sender will send more.  */
+#define MSG_WAITFORONE   0x010000 /* recvmmsg(): block until one message.  */
 #define MSG_CMSG_CLOEXEC 0x100000 /* Set close_on_exit for file
                                    * descriptor received through SCM_RIGHTS.
                                    */
 
+/* Send without copying the user data, needs SO_ZEROCOPY */
+
+#define MSG_ZEROCOPY     0x4000000
+
 /* Protocol levels supported by get/setsockopt(): */
 
 #define SOL_SOCKET       1 /* Only socket-level options supported */
@@ -220,6 +225,15 @@
 #define SO_PEERCRED     18 /* Return the credentials of the peer process
                             * connected to this socket.
                             */
+#define SO_ZEROCOPY     19 /* Allow MSG_ZEROCOPY sends; completions are
+                            * read with recvmsg(MSG_ERRQUEUE) (get/set).
+                            * arg: pointer to integer containing a boolean
+                            * value
+                            */
+#define SO_BUSY_POLL    20 /* Poll the device for up to this long before a
+                            * receive blocks (get/set).
+                            * arg: integer value (in microseconds)
+                            */
 
 /* The options are unsupported but included for compatibility
  * and portability
@@ -297,6 +311,17 @@
 #define SCM_SECURITY    0x03    /* rw: security label */
 #define SCM_TIMESTAMP   SO_TIMESTAMP
 
+/* Origins and codes of struct sock_extended_err, as in Linux */
+
+#define SO_EE_ORIGIN_NONE          0
+#define SO_EE_ORIGIN_LOCAL         1
+#define SO_EE_ORIGIN_ICMP          2
+#define SO_EE_ORIGIN_ICMP6         3
+#define SO_EE_ORIGIN_TXSTATUS      4
+#define SO_EE_ORIGIN_ZEROCOPY      5
+
+#define SO_EE_CODE_ZEROCOPY_COPIED 1 /* The data was copied after all */
+
 /* Desired design of maximum size and alignment (see RFC2553) */
 
 #define SS_MAXSIZE   128               /* Implementation-defined maximum size. */
@@ -372,6 +397,14 @@ struct msghdr
   unsigned int msg_flags;
 };
 
+/* One message of sendmmsg()/recvmmsg() */
+
+struct mmsghdr
+{
+  struct msghdr msg_hdr;        /* The message */
+  unsigned int msg_len;         /* Bytes sent or received of the message */
+};
+
 struct cmsghdr
 {
   unsigned long cmsg_len;       /* Data byte count, including hdr */
@@ -386,6 +419,23 @@ struct ucred
   gid_t gid;
 };
 
+/* Error queue message, returned by recvmsg(MSG_ERRQUEUE) as IP_RECVERR or
+ * IPV6_RECVERR control message.  A MSG_ZEROCOPY completion reports the
+ * sends ee_info to ee_data (inclusive), counted from 0 per socket, whose
+ * buffers may be reused.
+ */
+
+struct sock_extended_err
+{
+  uint32_t ee_errno;            /* Error number, 0 for completions */
+  uint8_t  ee_origin;           /* SO_EE_ORIGIN_* */
+  uint8_t  ee_type;
+  uint8_t  ee_code;             /* SO_EE_CODE_* */
+  uint8_t  ee_pad;
+  uint32_t ee_info;
+  uint32_t ee_data;
+};
+
 /****************************************************************************
  * Inline Functions
  ****************************************************************************/
@@ -459,6 +509,12 @@ int getpeername(int sockfd, FAR struct sockaddr *addr,
 ssize_t recvmsg(int sockfd, FAR struct msghdr *msg, int flags);
 ssize_t sendmsg(int sockfd, FAR struct msghdr *msg, int flags);
 
+struct timespec;
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout);
+int sendmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags);
+
 #if CONFIG_FORTIFY_SOURCE > 0
 fortify_function(send) ssize_t send(int sockfd, FAR const void *buf,
                                     size_t len, int flags)
@@ -30,6 +30,25 @@
 #include <nuttx/addrenv.h>
 #include <nuttx/lib/elf.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Accumulate the time spent between LIBELF_TIME_START(t) and
+ * LIBELF_TIME_END(l,p,t) in loadinfo l, phase p.
+ */
+
+#ifdef CONFIG_LIBC_ELF_LOADTIME
+#  define LIBELF_TIME_DEF(t)      uint32_t t
+#  define LIBELF_TIME_START(t)    ((t) = libelf_timestamp())
+#  define LIBELF_TIME_END(l,p,t)  ((l)->loadtime[p] += \
+                                   libelf_timestamp() - (t))
+#else
+#  define LIBELF_TIME_DEF(t)
+#  define LIBELF_TIME_START(t)
+#  define LIBELF_TIME_END(l,p,t)
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -49,6 +68,18 @@
 
 int libelf_verifyheader(FAR const Elf_Ehdr *header);
 
+/****************************************************************************
+ * Name: libelf_timestamp
+ *
+ * Description:
+ *   Return a free running microsecond count for load time statistics.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_ELF_LOADTIME
+uint32_t libelf_timestamp(void);
+#endif
+
 /****************************************************************************
  * Name: libelf_findsymtab
  *
@@ -115,6 +146,24 @@ int libelf_symvalue(FAR struct module_s *modp,
                     Elf_Off sh_offset,
                     FAR const struct symtab_s *exports, int nexports);
 
+/****************************************************************************
+ * Name: libelf_freeexporthash
+ *
+ * Description:
+ *   Free the index of the base code symbol table.  It is rebuilt on the
+ *   next lookup.
+ *
+ * Assumptions:
+ *   The caller holds the lock on the module registry.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_ELF_SYMHASH
+void libelf_freeexporthash(void);
+#else
+#  define libelf_freeexporthash()
+#endif
+
 /****************************************************************************
  * Name: libelf_insertsymtab
  *
@@ -101,6 +101,8 @@ static inline int libelf_readrels(FAR struct mod_loadinfo_s *loadinfo,
 {
   off_t offset;
   int size;
+  int ret;
+  LIBELF_TIME_DEF(start);
 
   /* Verify that the symbol table index lies within symbol table */
 
@@ -121,8 +123,11 @@ static inline int libelf_readrels(FAR struct mod_loadinfo_s *loadinfo,
 
   /* And, finally, read the symbol table entry into memory */
 
-  return libelf_read(loadinfo, (FAR uint8_t *)rels, size,
-                     relsec->sh_offset + offset);
+  LIBELF_TIME_START(start);
+  ret = libelf_read(loadinfo, (FAR uint8_t *)rels, size,
+                    relsec->sh_offset + offset);
+  LIBELF_TIME_END(loadinfo, LIBELF_TIME_RELREAD, start);
+  return ret;
 }
 
 /****************************************************************************
@@ -140,6 +145,8 @@ static inline int libelf_readrelas(FAR struct mod_loadinfo_s *loadinfo,
 {
   off_t offset;
   int size;
+  int ret;
+  LIBELF_TIME_DEF(start);
 
   /* Verify that the symbol table index lies within symbol table */
 
@@ -160,10 +167,157 @@ static inline int libelf_readrelas(FAR struct mod_loadinfo_s *loadinfo,
 
   /* And, finally, read the symbol table entry into memory */
 
-  return libelf_read(loadinfo, (FAR uint8_t *)relas, size,
-                     relsec->sh_offset + offset);
+  LIBELF_TIME_START(start);
+  ret = libelf_read(loadinfo, (FAR uint8_t *)relas, size,
+                    relsec->sh_offset + offset);
+  LIBELF_TIME_END(loadinfo, LIBELF_TIME_RELREAD, start);
+  return ret;
+}
+
+/****************************************************************************
+ * Name: libelf_allocrels
+ *
+ * Description:
+ *   Allocate the buffer for reading the relocation section relsec and
+ *   return the number of entries it holds in count.  With
+ *   CONFIG_LIBC_ELF_BULKREAD the whole section is read at once if memory
+ *   allows.
+ *
+ ****************************************************************************/
+
+static FAR void *libelf_allocrels(FAR const Elf_Shdr *relsec,
+                                  size_t entsize, FAR int *count)
+{
+#ifdef CONFIG_LIBC_ELF_BULKREAD
+  FAR void *buffer;
+
+  *count = relsec->sh_size / entsize;
+  if (*count > CONFIG_LIBC_ELF_RELOCATION_BUFFERCOUNT)
+    {
+      buffer = lib_malloc(*count * entsize);
+      if (buffer != NULL)
+        {
+          return buffer;
+        }
+    }
+#endif
+
+  *count = CONFIG_LIBC_ELF_RELOCATION_BUFFERCOUNT;
+  return lib_malloc(*count * entsize);
+}
+
+#ifdef CONFIG_LIBC_ELF_BULKREAD
+
+/****************************************************************************
+ * Name: libelf_freesyms
+ *
+ * Description:
+ *   Release the symbol table read by libelf_loadsyms().
+ *
+ ****************************************************************************/
+
+static void libelf_freesyms(FAR struct mod_loadinfo_s *loadinfo)
+{
+  lib_free(loadinfo->symbols);
+  lib_free(loadinfo->symdone);
+
+  loadinfo->symbols  = NULL;
+  loadinfo->symdone  = NULL;
+  loadinfo->nsymbols = 0;
 }
 
+/****************************************************************************
+ * Name: libelf_loadsyms
+ *
+ * Description:
+ *   Read the whole symbol table into memory so that every symbol is read
+ *   and resolved only once.  loadinfo->symbols is left NULL if that fails,
+ *   and the relocation code then falls back to the symbol cache.
+ *
+ ****************************************************************************/
+
+static void libelf_loadsyms(FAR struct mod_loadinfo_s *loadinfo)
+{
+  FAR const Elf_Shdr *symtab = &loadinfo->shdr[loadinfo->symtabidx];
+  size_t nsyms = symtab->sh_size / sizeof(Elf_Sym);
+  int ret;
+
+  if (nsyms == 0)
+    {
+      return;
+    }
+
+  loadinfo->symbols = lib_malloc(nsyms * sizeof(Elf_Sym));
+  loadinfo->symdone = lib_zalloc((nsyms + 7) / 8);
+  if (loadinfo->symbols == NULL || loadinfo->symdone == NULL)
+    {
+      binfo("No memory for %zu symbols, using the symbol cache\n", nsyms);
+      libelf_freesyms(loadinfo);
+      return;
+    }
+
+  ret = libelf_read(loadinfo, (FAR uint8_t *)loadinfo->symbols,
+                    nsyms * sizeof(Elf_Sym), symtab->sh_offset);
+  if (ret < 0)
+    {
+      berr("ERROR: Failed to read symbol table: %d\n", ret);
+      libelf_freesyms(loadinfo);
+      return;
+    }
+
+  loadinfo->nsymbols = nsyms;
+}
+
+/****************************************************************************
+ * Name: libelf_getsym
+ *
+ * Description:
+ *   Return symbol symidx from the table read by libelf_loadsyms(),
+ *   resolving its value on first use.  A nameless undefined symbol is not
+ *   an error here either; see libelf_relocate().
+ *
+ ****************************************************************************/
+
+static int libelf_getsym(FAR struct module_s *modp,
+                         FAR struct mod_loadinfo_s *loadinfo, int symidx,
+                         FAR const struct symtab_s *exports, int nexports,
+                         FAR Elf_Sym **sym)
+{
+  int ret;
+  LIBELF_TIME_DEF(start);
+
+  if (symidx < 0 || (size_t)symidx >= loadinfo->nsymbols)
+    {
+      berr("ERROR: Bad relocation symbol index: %d\n", symidx);
+      return -EINVAL;
+    }
+
+  *sym = &loadinfo->symbols[symidx];
+  if ((loadinfo->symdone[symidx >> 3] & (1 << (symidx & 7))) != 0)
+    {
+      return OK;
+    }
+
+  LIBELF_TIME_START(start);
+  ret = libelf_symvalue(modp, loadinfo, *sym,
+                        loadinfo->shdr[loadinfo->strtabidx].sh_offset,
+                        exports, nexports);
+  LIBELF_TIME_END(loadinfo, LIBELF_TIME_SYMBOLS, start);
+  if (ret == -ESRCH)
+    {
+      berr("ERROR: Undefined symbol[%d] has no name\n", symidx);
+    }
+  else if (ret < 0)
+    {
+      berr("ERROR: Failed to get value of symbol[%d]: %d\n", symidx, ret);
+      return ret;
+    }
+
+  loadinfo->symdone[symidx >> 3] |= 1 << (symidx & 7);
+  return OK;
+}
+#endif /* CONFIG_LIBC_ELF_BULKREAD */
+
 /****************************************************************************
  * Name: libelf_relocate and libelf_relocateadd
  *
@@ -191,15 +345,16 @@ static int libelf_relocate(FAR struct module_s *modp,
   uintptr_t         addr;
   int               symidx;
   int               ret = OK;
+  int               nbuf;
   int               i;
   int               j;
+  LIBELF_TIME_DEF(start);
 
   /* Define potential architecture specific elf data container */
 
   ARCH_ELFDATA_DEF;
 
-  rels = lib_malloc(CONFIG_LIBC_ELF_RELOCATION_BUFFERCOUNT *
-                    sizeof(Elf_Rel));
+  rels = libelf_allocrels(relsec, sizeof(Elf_Rel), &nbuf);
   if (!rels)
     {
       berr("Failed to allocate memory for elf relocation rels\n");
@@ -217,12 +372,11 @@ static int libelf_relocate(FAR struct module_s *modp,
     {
       /* Read the relocation entry into memory */
 
-      rel = &rels[i % CONFIG_LIBC_ELF_RELOCATION_BUFFERCOUNT];
+      rel = &rels[i % nbuf];
 
-      if (!(i % CONFIG_LIBC_ELF_RELOCATION_BUFFERCOUNT))
+      if (!(i % nbuf))
         {
-          ret = libelf_readrels(loadinfo, relsec, i, rels,
-                                CONFIG_LIBC_ELF_RELOCATION_BUFFERCOUNT);
+          ret = libelf_readrels(loadinfo, relsec, i, rels, nbuf);
           if (ret < 0)
             {
               berr("ERROR: Section %d reloc %d: "
@@ -237,10 +391,22 @@ static int libelf_relocate(FAR struct module_s *modp,
        */
 
       symidx = ELF_R_SYM(rel->r_info);
+      sym    = NULL;
+
+#ifdef CONFIG_LIBC_ELF_BULKREAD
+      if (loadinfo->symbols != NULL)
+        {
+          ret = libelf_getsym(modp, loadinfo, symidx, exports, nexports,
+                              &sym);
+          if (ret < 0)
+            {
+              break;
+            }
+        }
+#endif
 
-      /* First try the cache */
+      /* Otherwise try the cache */
 
-      sym = NULL;
       for (e = dq_peek(&q); e; e = dq_next(e))
         {
           cache = (FAR Elf_SymCache *)e;
@@ -293,9 +459,11 @@ static int libelf_relocate(FAR struct module_s *modp,
 
           /* Get the value of the symbol (in sym.st_value) */
 
+          LIBELF_TIME_START(start);
           ret = libelf_symvalue(modp, loadinfo, sym,
                   loadinfo->shdr[loadinfo->strtabidx].sh_offset,
                   exports, nexports);
+          LIBELF_TIME_END(loadinfo, LIBELF_TIME_SYMBOLS, start);
           if (ret < 0)
             {
               /* The special error -ESRCH is returned only in one condition:
@@ -443,15 +611,16 @@ static int libelf_relocateadd(FAR struct module_s *modp,
   uintptr_t         addr;
   int               symidx;
   int               ret = OK;
+  int               nbuf;
   int               i;
   int               j;
+  LIBELF_TIME_DEF(start);
 
   /* Define potential architecture specific elf data container */
 
   ARCH_ELFDATA_DEF;
 
-  relas = lib_malloc(CONFIG_LIBC_ELF_RELOCATION_BUFFERCOUNT *
-                     sizeof(Elf_Rela));
+  relas = libelf_allocrels(relsec, sizeof(Elf_Rela), &nbuf);
   if (!relas)
     {
       berr("Failed to allocate memory for elf relocation relas\n");
@@ -469,12 +638,11 @@ static int libelf_relocateadd(FAR struct module_s *modp,
     {
       /* Read the relocation entry into memory */
 
-      rela = &relas[i % CONFIG_LIBC_ELF_RELOCATION_BUFFERCOUNT];
+      rela = &relas[i % nbuf];
 
-      if (!(i % CONFIG_LIBC_ELF_RELOCATION_BUFFERCOUNT))
+      if (!(i % nbuf))
         {
-          ret = libelf_readrelas(loadinfo, relsec, i, relas,
-                                 CONFIG_LIBC_ELF_RELOCATION_BUFFERCOUNT);
+          ret = libelf_readrelas(loadinfo, relsec, i, relas, nbuf);
           if (ret < 0)
             {
               berr("ERROR: Section %d reloc %d: "
@@ -489,10 +657,22 @@ static int libelf_relocateadd(FAR struct module_s *modp,
        */
 
       symidx = ELF_R_SYM(rela->r_info);
+      sym    = NULL;
+
+#ifdef CONFIG_LIBC_ELF_BULKREAD
+      if (loadinfo->symbols != NULL)
+        {
+          ret = libelf_getsym(modp, loadinfo, symidx, exports, nexports,
+                              &sym);
+          if (ret < 0)
+            {
+              break;
+            }
+        }
+#endif
 
-      /* First try the cache */
+      /* Otherwise try the cache */
 
-      sym = NULL;
       for (e = dq_peek(&q); e; e = dq_next(e))
         {
           cache = (FAR Elf_SymCache *)e;
@@ -545,9 +725,11 @@ static int libelf_relocateadd(FAR struct module_s *modp,
 
           /* Get the value of the symbol (in sym.st_value) */
 
+          LIBELF_TIME_START(start);
           ret = libelf_symvalue(modp, loadinfo, sym,
                            loadinfo->shdr[loadinfo->strtabidx].sh_offset,
                            exports, nexports);
+          LIBELF_TIME_END(loadinfo, LIBELF_TIME_SYMBOLS, start);
           if (ret < 0)
             {
               /* The special error -ESRCH is returned only in one condition:
@@ -651,6 +833,7 @@ static int libelf_relocatedyn(FAR struct module_s *modp,
   int           i;
   int           idx_rel;
   int           idx_sym;
+  LIBELF_TIME_DEF(start);
 
   /* Define potential architecture specific elf data container */
 
@@ -792,10 +975,12 @@ static int libelf_relocatedyn(FAR struct module_s *modp,
                   relsize = reldata.relsz[idx_rel];
                 }
 
+              LIBELF_TIME_START(start);
               ret = libelf_read(loadinfo, (FAR uint8_t *)rels,
                                 relsize,
                                 reldata.reloff[idx_rel] +
                                 i * sizeof(Elf_Rel));
+              LIBELF_TIME_END(loadinfo, LIBELF_TIME_RELREAD, start);
 
               if (ret < 0)
                 {
@@ -917,6 +1102,9 @@ int libelf_bind(FAR struct module_s *modp,
 {
   int ret;
   int i;
+  LIBELF_TIME_DEF(start);
+
+  LIBELF_TIME_START(start);
 
 #ifdef CONFIG_ARCH_ADDRENV
   /* If CONFIG_ARCH_ADDRENV=y, then the loaded ELF lies in a virtual address
@@ -943,6 +1131,13 @@ int libelf_bind(FAR struct module_s *modp,
       goto errout_with_addrenv;
     }
 
+#ifdef CONFIG_LIBC_ELF_BULKREAD
+  if (loadinfo->ehdr.e_type != ET_DYN)
+    {
+      libelf_loadsyms(loadinfo);
+    }
+#endif
+
   /* Process relocations in every allocated section */
 
   for (i = 1; i < loadinfo->ehdr.e_shnum; i++)
@@ -1080,6 +1275,10 @@ int libelf_bind(FAR struct module_s *modp,
 
 errout_with_addrenv:
 
+#ifdef CONFIG_LIBC_ELF_BULKREAD
+  libelf_freesyms(loadinfo);
+#endif
+
 #ifdef CONFIG_ARCH_ADDRENV
   if (loadinfo->addrenv != NULL)
     {
@@ -1095,5 +1294,6 @@ errout_with_addrenv:
     }
 #endif
 
+  LIBELF_TIME_END(loadinfo, LIBELF_TIME_BIND, start);
   return ret;
 }
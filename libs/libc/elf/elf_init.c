@@ -33,6 +33,7 @@
 #include <fcntl.h>
 #include <debug.h>
 #include <errno.h>
+#include <time.h>
 
 #include <nuttx/fs/fs.h>
 #include <nuttx/lib/elf.h>
@@ -83,6 +84,20 @@ static inline int libelf_fileinfo(FAR struct mod_loadinfo_s *loadinfo)
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: libelf_timestamp
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_ELF_LOADTIME
+uint32_t libelf_timestamp(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+#endif
+
 /****************************************************************************
  * Name: libelf_initialize
  *
@@ -100,9 +115,12 @@ int libelf_initialize(FAR const char *filename,
                       FAR struct mod_loadinfo_s *loadinfo)
 {
   int ret;
+  LIBELF_TIME_DEF(start);
 
   binfo("filename: %s loadinfo: %p\n", filename, loadinfo);
 
+  LIBELF_TIME_START(start);
+
   /* Clear the load info structure */
 
   memset(loadinfo, 0, sizeof(struct mod_loadinfo_s));
@@ -154,5 +172,6 @@ int libelf_initialize(FAR const char *filename,
       berr("ERROR: Bad ELF header: %d\n", ret);
     }
 
+  LIBELF_TIME_END(loadinfo, LIBELF_TIME_INIT, start);
   return ret;
 }
@@ -57,6 +57,10 @@
 
 #define _ALIGN_UP(v, a)  (((v) + ((a) - 1)) & ~((a) - 1))
 
+#ifndef CONFIG_LIBC_ELF_XIP
+#  define libelf_xipsection(l,i) false
+#endif
+
 #ifdef CONFIG_ARCH_USE_TEXT_HEAP
 #  define buffer_data_address(p) \
             (FAR uint8_t *)up_textheap_data_address((FAR void *)p)
@@ -140,6 +144,50 @@ static int libelf_section_alloc(FAR struct mod_loadinfo_s *loadinfo,
 }
 #endif
 
+/****************************************************************************
+ * Name: libelf_xipsection
+ *
+ * Description:
+ *   Return true if section idx of a relocatable module can be used in
+ *   place: the file is mapped, the section is read-only, holds data in the
+ *   file at a suitably aligned address, and no relocations apply to it.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_ELF_XIP
+static bool libelf_xipsection(FAR struct mod_loadinfo_s *loadinfo, int idx)
+{
+  FAR const Elf_Shdr *shdr = &loadinfo->shdr[idx];
+  int i;
+
+  if (loadinfo->xipfile == 0 || loadinfo->ehdr.e_type != ET_REL ||
+      shdr->sh_type == SHT_NOBITS ||
+      (shdr->sh_flags & (SHF_ALLOC | SHF_WRITE)) != SHF_ALLOC)
+    {
+      return false;
+    }
+
+  if (shdr->sh_addralign > 1 &&
+      (loadinfo->xipfile + shdr->sh_offset) % shdr->sh_addralign != 0)
+    {
+      return false;
+    }
+
+  for (i = 1; i < loadinfo->ehdr.e_shnum; i++)
+    {
+      FAR const Elf_Shdr *relsec = &loadinfo->shdr[i];
+
+      if ((relsec->sh_type == SHT_REL || relsec->sh_type == SHT_RELA) &&
+          relsec->sh_info == idx && relsec->sh_size > 0)
+        {
+          return false;
+        }
+    }
+
+  return true;
+}
+#endif
+
 /****************************************************************************
  * Name: libelf_elfsize
  *
@@ -190,10 +238,11 @@ static void libelf_elfsize(FAR struct mod_loadinfo_s *loadinfo, bool alloc)
           FAR Elf_Shdr *shdr = &loadinfo->shdr[i];
 
           /* SHF_ALLOC indicates that the section requires memory during
-           * execution.
+           * execution, unless it can be used in place.
            */
 
-          if ((shdr->sh_flags & SHF_ALLOC) != 0)
+          if ((shdr->sh_flags & SHF_ALLOC) != 0 &&
+              !libelf_xipsection(loadinfo, i))
             {
               /* SHF_WRITE indicates that the section address space is write-
                * able
@@ -332,6 +381,9 @@ static inline int libelf_loadfile(FAR struct mod_loadinfo_s *loadinfo)
 {
   FAR uint8_t *text = (FAR uint8_t *)loadinfo->textalloc;
   FAR uint8_t *data = (FAR uint8_t *)loadinfo->datastart;
+#ifdef CONFIG_LIBC_ELF_XIP
+  uintptr_t addr;
+#endif
   int ret;
   int i;
 
@@ -389,6 +441,22 @@ static inline int libelf_loadfile(FAR struct mod_loadinfo_s *loadinfo)
               continue;
             }
 
+#ifdef CONFIG_LIBC_ELF_XIP
+          if (libelf_xipsection(loadinfo, i))
+            {
+              binfo("%d. %08lx->%08lx in place\n", i,
+                    (unsigned long)shdr->sh_addr,
+                    (unsigned long)(loadinfo->xipfile + shdr->sh_offset));
+
+              /* Use offset to remember the original file address */
+
+              addr            = loadinfo->xipfile + shdr->sh_offset;
+              shdr->sh_offset = (uintptr_t)shdr->sh_addr;
+              shdr->sh_addr   = addr;
+              continue;
+            }
+#endif
+
 #ifdef CONFIG_ARCH_USE_SEPARATED_SECTION
           if (loadinfo->ehdr.e_type == ET_REL ||
               loadinfo->ehdr.e_type == ET_EXEC)
@@ -545,10 +613,13 @@ skipload:
 int libelf_load(FAR struct mod_loadinfo_s *loadinfo)
 {
   int ret;
+  LIBELF_TIME_DEF(start);
 
   binfo("loadinfo: %p\n", loadinfo);
   DEBUGASSERT(loadinfo && loadinfo->filfd >= 0);
 
+  LIBELF_TIME_START(start);
+
   /* Load section and program headers into memory */
 
   ret = libelf_loadhdrs(loadinfo);
@@ -568,6 +639,20 @@ int libelf_load(FAR struct mod_loadinfo_s *loadinfo)
           binfo("can use xipbase %zu\n", loadinfo->xipbase);
         }
     }
+#ifdef CONFIG_LIBC_ELF_XIP
+  else if (loadinfo->ehdr.e_type == ET_REL)
+    {
+      /* Without a GOT the text may still need relocation, so only the
+       * sections without relocations are used in place.
+       */
+
+      if (ioctl(loadinfo->filfd, FIOC_XIPBASE,
+                (unsigned long)&loadinfo->xipfile) < 0)
+        {
+          loadinfo->xipfile = 0;
+        }
+    }
+#endif
 
   /* Determine total size to allocate */
 
@@ -675,6 +760,7 @@ int libelf_load(FAR struct mod_loadinfo_s *loadinfo)
     }
 #endif
 
+  LIBELF_TIME_END(loadinfo, LIBELF_TIME_LOAD, start);
   return OK;
 
   /* Error exits */
@@ -701,10 +787,13 @@ errout_with_buffers:
 int libelf_load_with_addrenv(FAR struct mod_loadinfo_s *loadinfo)
 {
   int ret;
+  LIBELF_TIME_DEF(start);
 
   binfo("loadinfo: %p\n", loadinfo);
   DEBUGASSERT(loadinfo && loadinfo->filfd >= 0);
 
+  LIBELF_TIME_START(start);
+
   /* Load section and program headers into memory */
 
   ret = libelf_loadhdrs(loadinfo);
@@ -765,6 +854,7 @@ int libelf_load_with_addrenv(FAR struct mod_loadinfo_s *loadinfo)
       goto errout_with_buffers;
     }
 
+  LIBELF_TIME_END(loadinfo, LIBELF_TIME_LOAD, start);
   return OK;
 
 errout_with_addrenv:
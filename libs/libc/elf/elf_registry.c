@@ -34,6 +34,8 @@
 #include <nuttx/mutex.h>
 #include <nuttx/lib/elf.h>
 
+#include "elf/elf.h"
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -158,6 +160,16 @@ int libelf_registry_del(FAR struct module_s *modp)
     }
 
   modp->flink = NULL;
+
+  /* The index of the base code symbol table is only needed to bind
+   * modules, free it with the last one.
+   */
+
+  if (g_mod_registry == NULL)
+    {
+      libelf_freeexporthash();
+    }
+
   return OK;
 }
 
@@ -72,10 +72,57 @@ struct eptable_s
 extern struct eptable_s global_table[];
 extern int nglobals;
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_ELF_SYMHASH
+/* Index of the base code symbol table, protected by the registry lock */
+
+static struct symtab_hash_s g_libelf_exporthash;
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: libelf_findexport
+ *
+ * Description:
+ *   Find name in the exported symbol table symtab.  With
+ *   CONFIG_LIBC_ELF_SYMHASH the lookup goes through hash, which is
+ *   (re)built whenever it does not describe symtab; the table is searched
+ *   directly if there is no memory for the index.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_ELF_SYMHASH
+static FAR const struct symtab_s *
+libelf_findexport(FAR struct symtab_hash_s *hash,
+                  FAR const struct symtab_s *symtab, int nsyms,
+                  FAR const char *name)
+{
+  if (symtab == NULL)
+    {
+      return NULL;
+    }
+
+  if (hash->symtab != symtab || hash->nsyms != nsyms)
+    {
+      symtab_hashfree(hash);
+      if (symtab_hashinit(hash, symtab, nsyms) < 0)
+        {
+          return symtab_findbyname(symtab, name, nsyms);
+        }
+    }
+
+  return symtab_hashfind(hash, name);
+}
+#else
+#  define libelf_findexport(h,s,n,name) symtab_findbyname(s,name,n)
+#endif
+
 /****************************************************************************
  * Name: libelf_symname
  *
@@ -203,9 +250,10 @@ static int libelf_symcallback(FAR struct module_s *modp, FAR void *arg)
 
   /* Check if this module exports a symbol of that name */
 
-  exportinfo->symbol = symtab_findbyname(modp->modinfo.exports,
-                                         exportinfo->name,
-                                         modp->modinfo.nexports);
+  exportinfo->symbol = libelf_findexport(&modp->exporthash,
+                                         modp->modinfo.exports,
+                                         modp->modinfo.nexports,
+                                         exportinfo->name);
 
   if (exportinfo->symbol != NULL)
     {
@@ -408,8 +456,10 @@ int libelf_symvalue(FAR struct module_s *modp,
 
         if (symbol == NULL)
           {
-            symbol = symtab_findbyname(exports, exportinfo.name,
-                                       nexports);
+            libelf_registry_lock();
+            symbol = libelf_findexport(&g_libelf_exporthash, exports,
+                                       nexports, exportinfo.name);
+            libelf_registry_unlock();
           }
 
         /* Was the symbol found from any exporter? */
@@ -614,6 +664,21 @@ void *libelf_findglobal(FAR struct module_s *modp,
     }
 }
 
+/****************************************************************************
+ * Name: libelf_freeexporthash
+ *
+ * Description:
+ *   Free the index of the base code symbol table.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_ELF_SYMHASH
+void libelf_freeexporthash(void)
+{
+  symtab_hashfree(&g_libelf_exporthash);
+}
+#endif
+
 /****************************************************************************
  * Name: libelf_freesymtab
  *
@@ -639,4 +704,8 @@ void libelf_freesymtab(FAR struct module_s *modp)
 
       lib_free((FAR void *)symbol);
     }
+
+#ifdef CONFIG_LIBC_ELF_SYMHASH
+  symtab_hashfree(&modp->exporthash);
+#endif
 }
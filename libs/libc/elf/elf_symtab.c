@@ -31,6 +31,8 @@
 #include <nuttx/symtab.h>
 #include <nuttx/lib/elf.h>
 
+#include "elf/elf.h"
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -127,5 +129,9 @@ void libelf_setsymtab(FAR const struct symtab_s *symtab, int nsymbols)
   libelf_registry_lock();
   g_libelf_symtab   = symtab;
   g_libelf_nsymbols = nsymbols;
+
+  /* The index of the old table must not outlive it */
+
+  libelf_freeexporthash();
   libelf_registry_unlock();
 }
@@ -26,7 +26,9 @@
 
 #include <nuttx/config.h>
 
+#include <inttypes.h>
 #include <unistd.h>
+#include <syslog.h>
 #include <debug.h>
 #include <errno.h>
 
@@ -62,6 +64,17 @@ int libelf_uninitialize(FAR struct mod_loadinfo_s *loadinfo)
 
   if (loadinfo->filfd >= 0)
     {
+#ifdef CONFIG_LIBC_ELF_LOADTIME
+      syslog(LOG_INFO, "libelf: init %" PRIu32 " load %" PRIu32
+             " bind %" PRIu32 " (symbols %" PRIu32 " relocs read %" PRIu32
+             ") us\n",
+             loadinfo->loadtime[LIBELF_TIME_INIT],
+             loadinfo->loadtime[LIBELF_TIME_LOAD],
+             loadinfo->loadtime[LIBELF_TIME_BIND],
+             loadinfo->loadtime[LIBELF_TIME_SYMBOLS],
+             loadinfo->loadtime[LIBELF_TIME_RELREAD]);
+#endif
+
       _NX_CLOSE(loadinfo->filfd);
       loadinfo->filfd = -1;
     }
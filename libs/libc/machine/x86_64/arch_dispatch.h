@@ -0,0 +1,94 @@
+/****************************************************************************
+ * libs/libc/machine/x86_64/arch_dispatch.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __LIBS_LIBC_MACHINE_X86_64_ARCH_DISPATCH_H
+#define __LIBS_LIBC_MACHINE_X86_64_ARCH_DISPATCH_H
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifndef L
+#  define L(label)  .L##label
+#endif
+
+#define ENTRY(__f)         \
+  .text;                   \
+  .global __f;             \
+  .balign 16;              \
+  .type __f, @function;    \
+__f:                       \
+  .cfi_startproc;
+
+#define LOCAL_ENTRY(__f)   \
+  .text;                   \
+  .balign 16;              \
+  .type __f, @function;    \
+__f:                       \
+  .cfi_startproc;
+
+#define END(__f)           \
+  .cfi_endproc;            \
+  .size __f, .- __f;
+
+/* DISPATCH(name, sse2, avx2) defines the public symbol 'name' as an
+ * indirect jump through a function pointer.  The pointer initially refers
+ * to a resolver that probes the CPU once (see arch_cpuid.S), selects the
+ * AVX2 or the SSE2 variant and then jumps to it, so that every later call
+ * costs a single indirect branch.  Only the argument registers of the
+ * string functions (rdi, rsi, rdx) have to be preserved by the resolver.
+ */
+
+#define DISPATCH(name, sse2, avx2) _DISPATCH(name, sse2, avx2)
+
+#define _DISPATCH(name, sse2, avx2)          \
+ENTRY(name)                                  \
+  jmp     *name##_impl(%rip);                \
+END(name)                                    \
+LOCAL_ENTRY(name##_resolve)                  \
+  pushq   %rdi;                              \
+  .cfi_adjust_cfa_offset 8;                  \
+  pushq   %rsi;                              \
+  .cfi_adjust_cfa_offset 8;                  \
+  pushq   %rdx;                              \
+  .cfi_adjust_cfa_offset 8;                  \
+  call    x86_64_libc_avx2;                  \
+  leaq    sse2(%rip), %rcx;                  \
+  leaq    avx2(%rip), %r8;                   \
+  testl   %eax, %eax;                        \
+  cmovnzq %r8, %rcx;                         \
+  movq    %rcx, name##_impl(%rip);           \
+  popq    %rdx;                              \
+  .cfi_adjust_cfa_offset -8;                 \
+  popq    %rsi;                              \
+  .cfi_adjust_cfa_offset -8;                 \
+  popq    %rdi;                              \
+  .cfi_adjust_cfa_offset -8;                 \
+  jmp     *%rcx;                             \
+END(name##_resolve)                          \
+  .data;                                     \
+  .balign 8;                                 \
+name##_impl:                                 \
+  .quad   name##_resolve;                    \
+  .text;
+
+#endif /* __LIBS_LIBC_MACHINE_X86_64_ARCH_DISPATCH_H */
@@ -25,11 +25,43 @@
  ****************************************************************************/
 
 #include <errno.h>
+#include <string.h>
 
 #include <nuttx/sched.h>
 #include <nuttx/clock.h>
 #include <nuttx/mutex.h>
 #include <nuttx/semaphore.h>
+#include <nuttx/spinlock.h>
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: nxmutex_running
+ *
+ * Description:
+ *   Return true if the thread is running on a CPU, as last published by
+ *   the scheduler.  No lock is taken and no TCB is looked at.
+ *
+ ****************************************************************************/
+
+#ifdef NXMUTEX_SPIN
+static bool nxmutex_running(pid_t pid)
+{
+  int cpu;
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      if ((pid_t)atomic_read(&g_running_pids[cpu]) == pid)
+        {
+          return true;
+        }
+    }
+
+  return false;
+}
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -62,6 +94,109 @@ void nxmutex_add_backtrace(FAR mutex_t *mutex)
 }
 #endif
 
+/****************************************************************************
+ * Name: nxmutex_spin
+ *
+ * Description:
+ *   Try to take the mutex without blocking.  If the mutex is held by a
+ *   thread that is running on another CPU, poll it up to
+ *   CONFIG_LIBC_MUTEX_SPIN times before giving up, the holder will likely
+ *   release it sooner than a block and wakeup would take.
+ *
+ * Parameters:
+ *   mutex - mutex descriptor.
+ *
+ * Return Value:
+ *   Zero (OK) if the mutex was taken; -EAGAIN if the caller has to block.
+ *
+ ****************************************************************************/
+
+#ifdef NXMUTEX_ADAPTIVE
+int nxmutex_spin(FAR mutex_t *mutex)
+{
+#ifdef NXMUTEX_SPIN
+  uint32_t mholder;
+  int budget;
+#endif
+
+  if (nxsem_trywait(&mutex->sem) >= 0)
+    {
+      nxmutex_count(mutex, nlocks);
+      nxmutex_add_backtrace(mutex);
+      return OK;
+    }
+
+  nxmutex_count(mutex, ncontended);
+
+#ifdef NXMUTEX_SPIN
+  for (budget = NXMUTEX_SPIN; budget > 0; budget--)
+    {
+      UP_RELAX();
+
+      /* Stop when others already block on the mutex: the unlock hands it
+       * to them, never to us.  Stop too when the holder is ourselves or
+       * cannot release the mutex before it is scheduled again.
+       */
+
+      mholder = atomic_read(NXSEM_MHOLDER(&mutex->sem));
+      if (NXSEM_MBLOCKING(mholder))
+        {
+          break;
+        }
+
+      if (!NXSEM_MACQUIRED(mholder))
+        {
+          if (nxsem_trywait(&mutex->sem) >= 0)
+            {
+              nxmutex_count(mutex, nspin);
+              nxmutex_count(mutex, nlocks);
+              nxmutex_add_backtrace(mutex);
+              return OK;
+            }
+
+          continue;
+        }
+
+      if ((pid_t)mholder == _SCHED_GETTID())
+        {
+          break;
+        }
+
+      if (!nxmutex_running((pid_t)mholder))
+        {
+          break;
+        }
+    }
+#endif
+
+  nxmutex_count(mutex, nblocked);
+  return -EAGAIN;
+}
+#endif
+
+/****************************************************************************
+ * Name: nxmutex_get_stats
+ *
+ * Description:
+ *   Return a snapshot of the contention statistics of the mutex.
+ *
+ * Parameters:
+ *   mutex - mutex descriptor.
+ *   stats - Location to return the statistics.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_LIBC_MUTEX_STATS
+void nxmutex_get_stats(FAR mutex_t *mutex,
+                       FAR struct mutex_stats_s *stats)
+{
+  atomic_set(&stats->nlocks, atomic_read(&mutex->stats.nlocks));
+  atomic_set(&stats->ncontended, atomic_read(&mutex->stats.ncontended));
+  atomic_set(&stats->nspin, atomic_read(&mutex->stats.nspin));
+  atomic_set(&stats->nblocked, atomic_read(&mutex->stats.nblocked));
+}
+#endif
+
 /****************************************************************************
  * Name: nxmutex_init
  *
@@ -95,6 +230,11 @@ int nxmutex_init(FAR mutex_t *mutex)
 #else
   nxsem_set_protocol(&mutex->sem, SEM_TYPE_MUTEX);
 #endif
+
+#ifdef CONFIG_LIBC_MUTEX_STATS
+  memset(&mutex->stats, 0, sizeof(mutex->stats));
+#endif
+
   return ret;
 }
 
@@ -151,6 +291,13 @@ int nxmutex_ticklock(FAR mutex_t *mutex, uint32_t delay)
 
   if (delay)
     {
+#ifdef NXMUTEX_ADAPTIVE
+      if (nxmutex_spin(mutex) >= 0)
+        {
+          return OK;
+        }
+#endif
+
       ret = nxsem_tickwait(&mutex->sem, delay);
     }
   else
@@ -160,6 +307,7 @@ int nxmutex_ticklock(FAR mutex_t *mutex, uint32_t delay)
 
   if (ret >= 0)
     {
+      nxmutex_count(mutex, nlocks);
       nxmutex_add_backtrace(mutex);
     }
 
@@ -196,6 +344,13 @@ int nxmutex_clocklock(FAR mutex_t *mutex, clockid_t clockid,
 {
   int ret;
 
+#ifdef NXMUTEX_ADAPTIVE
+  if (nxmutex_spin(mutex) >= 0)
+    {
+      return OK;
+    }
+#endif
+
   /* Wait until we get the lock or until the timeout expires */
 
   if (abstime)
@@ -209,6 +364,7 @@ int nxmutex_clocklock(FAR mutex_t *mutex, clockid_t clockid,
 
   if (ret >= 0)
     {
+      nxmutex_count(mutex, nlocks);
       nxmutex_add_backtrace(mutex);
     }
 
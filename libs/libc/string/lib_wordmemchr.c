@@ -0,0 +1,114 @@
+/****************************************************************************
+ * libs/libc/string/lib_wordmemchr.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WORDSIZE       sizeof(uintptr_t)
+#define WORDMASK       (WORDSIZE - 1)
+
+/* ONES has 0x01 in every byte, HIGHS has 0x80 in every byte.  HASZERO(x)
+ * is non-zero if any byte of the word 'x' is zero.
+ */
+
+#define ONES           ((uintptr_t)-1 / 0xff)
+#define HIGHS          (ONES * 0x80)
+#define HASZERO(x)     (((x) - ONES) & ~(x) & HIGHS)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: memchr
+ *
+ * Description:
+ *   The memchr() function locates the first occurrence of 'c' (converted to
+ *   an unsigned char) in the initial 'n' bytes (each interpreted as
+ *   unsigned char) of the object pointed to by s.
+ *
+ *   This version compares a whole word per iteration: the word is XORed
+ *   with 'c' replicated in every byte, so that a matching byte becomes a
+ *   zero byte.  Only words inside the object are read.
+ *
+ * Returned Value:
+ *   The memchr() function returns a pointer to the located byte, or a null
+ *   pointer if the byte does not occur in the object.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_LIBC_ARCH_MEMCHR) && defined(LIBC_BUILD_MEMCHR)
+#undef memchr /* See mm/README.txt */
+FAR void *memchr(FAR const void *s, int c, size_t n)
+{
+  FAR const unsigned char *p = (FAR const unsigned char *)s;
+  FAR const uintptr_t *ws;
+  unsigned char d = c;
+  uintptr_t mask;
+
+  /* Scan bytes until the pointer is word aligned */
+
+  for (; n > 0 && ((uintptr_t)p & WORDMASK) != 0; n--, p++)
+    {
+      if (*p == d)
+        {
+          return (FAR void *)p;
+        }
+    }
+
+  /* Scan whole words until one of them holds the character */
+
+  mask = ONES * d;
+  for (ws = (FAR const uintptr_t *)p; n >= WORDSIZE; n -= WORDSIZE, ws++)
+    {
+      if (HASZERO(*ws ^ mask))
+        {
+          break;
+        }
+    }
+
+  /* Locate the character in the word or in the remaining bytes */
+
+  for (p = (FAR const unsigned char *)ws; n > 0; n--, p++)
+    {
+      if (*p == d)
+        {
+          return (FAR void *)p;
+        }
+    }
+
+  return NULL;
+}
+#endif
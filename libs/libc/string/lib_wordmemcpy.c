@@ -0,0 +1,148 @@
+/****************************************************************************
+ * libs/libc/string/lib_wordmemcpy.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WORDSIZE       sizeof(uintptr_t)
+#define WORDMASK       (WORDSIZE - 1)
+#define WORDBITS       (8 * WORDSIZE)
+
+/* Below this size the setup cost of the word loops does not pay off */
+
+#define SMALLCOPY      (2 * WORDSIZE)
+
+/* Combine two consecutive aligned source words into the word that starts
+ * 'shift' bits into the first one.
+ */
+
+#ifdef CONFIG_ENDIAN_BIG
+#  define MERGE(w0, w1, shift) \
+     (((w0) << (shift)) | ((w1) >> (WORDBITS - (shift))))
+#else
+#  define MERGE(w0, w1, shift) \
+     (((w0) >> (shift)) | ((w1) << (WORDBITS - (shift))))
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: memcpy
+ *
+ * Description:
+ *   Word at a time memcpy().  The destination is aligned first.  If the
+ *   source is then aligned too, whole words are copied; otherwise each
+ *   destination word is assembled from two aligned source loads, so that
+ *   no unaligned access is ever issued.  This matters on cores such as
+ *   RISC-V and Xtensa where unaligned loads trap or are emulated.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_LIBC_ARCH_MEMCPY) && defined(LIBC_BUILD_MEMCPY)
+#undef memcpy /* See mm/README.txt */
+no_builtin("memcpy")
+FAR void *memcpy(FAR void *dest, FAR const void *src, size_t n)
+{
+  FAR unsigned char *pout = (FAR unsigned char *)dest;
+  FAR const unsigned char *pin = (FAR const unsigned char *)src;
+  FAR uintptr_t *wout;
+  FAR const uintptr_t *win;
+  unsigned int shift;
+  uintptr_t w0;
+  uintptr_t w1;
+
+  if (n >= SMALLCOPY)
+    {
+      /* Align the destination */
+
+      for (; ((uintptr_t)pout & WORDMASK) != 0; n--)
+        {
+          *pout++ = *pin++;
+        }
+
+      wout  = (FAR uintptr_t *)pout;
+      shift = 8 * ((uintptr_t)pin & WORDMASK);
+
+      if (shift == 0)
+        {
+          /* Both pointers are aligned */
+
+          win = (FAR const uintptr_t *)pin;
+          for (; n >= 4 * WORDSIZE; n -= 4 * WORDSIZE)
+            {
+              wout[0] = win[0];
+              wout[1] = win[1];
+              wout[2] = win[2];
+              wout[3] = win[3];
+              wout   += 4;
+              win    += 4;
+            }
+
+          for (; n >= WORDSIZE; n -= WORDSIZE)
+            {
+              *wout++ = *win++;
+            }
+        }
+      else
+        {
+          /* The source is misaligned.  Every aligned source word that is
+           * loaded holds at least one byte that is copied, so nothing
+           * outside of the source object is touched.
+           */
+
+          win = (FAR const uintptr_t *)((uintptr_t)pin & ~WORDMASK);
+          w0  = *win++;
+          for (; n >= WORDSIZE; n -= WORDSIZE)
+            {
+              w1      = *win++;
+              *wout++ = MERGE(w0, w1, shift);
+              w0      = w1;
+            }
+        }
+
+      pin += (FAR unsigned char *)wout - pout;
+      pout = (FAR unsigned char *)wout;
+    }
+
+  while (n-- > 0)
+    {
+      *pout++ = *pin++;
+    }
+
+  return dest;
+}
+#endif
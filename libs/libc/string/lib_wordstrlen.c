@@ -0,0 +1,91 @@
+/****************************************************************************
+ * libs/libc/string/lib_wordstrlen.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WORDSIZE       sizeof(uintptr_t)
+#define WORDMASK       (WORDSIZE - 1)
+
+/* ONES has 0x01 in every byte, HIGHS has 0x80 in every byte.  HASZERO(x)
+ * is non-zero if any byte of the word 'x' is zero.
+ */
+
+#define ONES           ((uintptr_t)-1 / 0xff)
+#define HIGHS          (ONES * 0x80)
+#define HASZERO(x)     (((x) - ONES) & ~(x) & HIGHS)
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: strlen
+ *
+ * Description:
+ *   Word at a time strlen().  Aligned words are read past the terminating
+ *   NUL, which is safe because an aligned word never crosses a page, but
+ *   is invisible to the address sanitizer.
+ *
+ ****************************************************************************/
+
+#if !defined(CONFIG_LIBC_ARCH_STRLEN) && defined(LIBC_BUILD_STRLEN)
+#undef strlen /* See mm/README.txt */
+nosanitize_address
+size_t strlen(FAR const char *s)
+{
+  FAR const char *sc = s;
+  FAR const uintptr_t *ws;
+
+  /* Scan bytes until the pointer is word aligned */
+
+  for (; ((uintptr_t)sc & WORDMASK) != 0; sc++)
+    {
+      if (*sc == '\0')
+        {
+          return sc - s;
+        }
+    }
+
+  /* Scan whole words until one of them holds the NUL */
+
+  for (ws = (FAR const uintptr_t *)sc; !HASZERO(*ws); ws++);
+
+  /* Locate the NUL inside the word */
+
+  for (sc = (FAR const char *)ws; *sc != '\0'; sc++);
+  return sc - s;
+}
+#endif
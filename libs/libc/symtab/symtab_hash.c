@@ -0,0 +1,253 @@
+/****************************************************************************
+ * libs/libc/symtab/symtab_hash.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+
+#include <nuttx/symtab.h>
+
+#include "libc.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define SYMTAB_HASH_NONE  UINT32_MAX
+#define SYMTAB_BLOOM_BITS (8 * sizeof(uintptr_t))
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: symtab_roundup
+ *
+ * Description:
+ *   Return the smallest power of two not less than n (at least 1).
+ *
+ ****************************************************************************/
+
+static uint32_t symtab_roundup(uint32_t n)
+{
+  uint32_t p = 1;
+
+  while (p < n)
+    {
+      p <<= 1;
+    }
+
+  return p;
+}
+
+/****************************************************************************
+ * Name: symtab_bloommask
+ ****************************************************************************/
+
+static inline uintptr_t
+symtab_bloommask(FAR const struct symtab_hash_s *hash, uint32_t h)
+{
+  return ((uintptr_t)1 << (h % SYMTAB_BLOOM_BITS)) |
+         ((uintptr_t)1 << ((h >> hash->shift) % SYMTAB_BLOOM_BITS));
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: symtab_gnuhash
+ ****************************************************************************/
+
+uint32_t symtab_gnuhash(FAR const char *name)
+{
+  FAR const uint8_t *p = (FAR const uint8_t *)name;
+  uint32_t h = 5381;
+
+  while (*p != '\0')
+    {
+      h = (h << 5) + h + *p++;
+    }
+
+  return h;
+}
+
+/****************************************************************************
+ * Name: symtab_hashinit
+ ****************************************************************************/
+
+int symtab_hashinit(FAR struct symtab_hash_s *hash,
+                    FAR const struct symtab_s *symtab, int nsyms)
+{
+  uint32_t bucket;
+  uint32_t start;
+  uint32_t end;
+  uint32_t pos;
+  uint32_t h;
+  int i;
+
+  DEBUGASSERT(hash != NULL && nsyms >= 0);
+
+  memset(hash, 0, sizeof(*hash));
+
+  /* About two symbols per bucket and per Bloom filter word half, which is
+   * roughly what the GNU linker aims for as well.
+   */
+
+  hash->nbuckets = symtab_roundup(nsyms / 2);
+  hash->nbloom   = symtab_roundup(nsyms / (SYMTAB_BLOOM_BITS / 2));
+  hash->shift    = SYMTAB_BLOOM_BITS == 64 ? 6 : 5;
+
+  hash->bloom = lib_zalloc(hash->nbloom * sizeof(uintptr_t) +
+                           hash->nbuckets * sizeof(uint32_t) +
+                           2 * nsyms * sizeof(uint32_t));
+  if (hash->bloom == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  hash->buckets = (FAR uint32_t *)(hash->bloom + hash->nbloom);
+  hash->chain   = hash->buckets + hash->nbuckets;
+  hash->order   = hash->chain + nsyms;
+
+  /* Count the symbols per bucket and turn the counts into run ends */
+
+  for (i = 0; i < nsyms; i++)
+    {
+      h = symtab_gnuhash(symtab[i].sym_name);
+      hash->buckets[h & (hash->nbuckets - 1)]++;
+      hash->bloom[(h / SYMTAB_BLOOM_BITS) & (hash->nbloom - 1)] |=
+        symtab_bloommask(hash, h);
+    }
+
+  for (pos = 0, bucket = 0; bucket < hash->nbuckets; bucket++)
+    {
+      pos += hash->buckets[bucket];
+      hash->buckets[bucket] = pos;
+    }
+
+  /* Fill the runs back to front, which keeps the table order within a run
+   * (so duplicates resolve like a linear search) and leaves each bucket
+   * holding the start of its run.
+   */
+
+  for (i = nsyms - 1; i >= 0; i--)
+    {
+      h   = symtab_gnuhash(symtab[i].sym_name);
+      pos = --hash->buckets[h & (hash->nbuckets - 1)];
+      hash->chain[pos] = h & ~1u;
+      hash->order[pos] = i;
+    }
+
+  /* Mark the end of every run */
+
+  for (bucket = 0; bucket < hash->nbuckets; bucket++)
+    {
+      start = hash->buckets[bucket];
+      end   = bucket + 1 < hash->nbuckets ?
+              hash->buckets[bucket + 1] : (uint32_t)nsyms;
+
+      if (start == end)
+        {
+          hash->buckets[bucket] = SYMTAB_HASH_NONE;
+        }
+      else
+        {
+          hash->chain[end - 1] |= 1;
+        }
+    }
+
+  hash->symtab = symtab;
+  hash->nsyms  = nsyms;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: symtab_hashfind
+ ****************************************************************************/
+
+FAR const struct symtab_s *
+symtab_hashfind(FAR const struct symtab_hash_s *hash, FAR const char *name)
+{
+  uintptr_t mask;
+  uint32_t pos;
+  uint32_t h;
+
+  DEBUGASSERT(hash != NULL && name != NULL);
+
+#ifdef CONFIG_SYMTAB_DECORATED
+  if (name[0] == '_')
+    {
+      name++;
+    }
+#endif
+
+  if (hash->nsyms == 0)
+    {
+      return NULL;
+    }
+
+  h    = symtab_gnuhash(name);
+  mask = symtab_bloommask(hash, h);
+  if ((hash->bloom[(h / SYMTAB_BLOOM_BITS) & (hash->nbloom - 1)] & mask) !=
+      mask)
+    {
+      return NULL;
+    }
+
+  pos = hash->buckets[h & (hash->nbuckets - 1)];
+  if (pos == SYMTAB_HASH_NONE)
+    {
+      return NULL;
+    }
+
+  for (; ; pos++)
+    {
+      if ((hash->chain[pos] | 1) == (h | 1) &&
+          strcmp(name, hash->symtab[hash->order[pos]].sym_name) == 0)
+        {
+          return &hash->symtab[hash->order[pos]];
+        }
+
+      if ((hash->chain[pos] & 1) != 0)
+        {
+          return NULL;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: symtab_hashfree
+ ****************************************************************************/
+
+void symtab_hashfree(FAR struct symtab_hash_s *hash)
+{
+  lib_free(hash->bloom);
+  memset(hash, 0, sizeof(*hash));
+}
@@ -0,0 +1,541 @@
+/****************************************************************************
+ * libs/libc/wqueue/work_threadpool.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <errno.h>
+
+#include <nuttx/list.h>
+#include <nuttx/mutex.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/threadpool.h>
+
+#include "libc.h"
+
+#ifdef CONFIG_LIBC_THREADPOOL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* threadpool_parallel_for() makes at most this many sub-ranges per worker,
+ * enough to even out uneven sub-ranges without drowning in tasks.
+ */
+
+#define THREADPOOL_SPLIT 4
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One worker thread and its deque.  The worker takes its own tasks from the
+ * tail, other workers steal from the head.
+ */
+
+struct threadpool_worker_s
+{
+  FAR struct threadpool_s *pool;   /* The pool of the worker */
+  pthread_t                thread; /* The worker thread */
+  mutex_t                  lock;   /* Protects the deque */
+  struct list_node         deque;  /* Queued tasks */
+};
+
+struct threadpool_s
+{
+  sem_t    wake;                   /* Posted when idle workers have work */
+  atomic_t idle;                   /* The number of idle workers */
+  atomic_t next;                   /* The deque of the next outside task */
+  bool     exit;                   /* Ask the workers to exit */
+  int      nthreads;               /* The number of workers */
+  struct threadpool_worker_s workers[1];
+};
+
+/* One sub-range of threadpool_parallel_for() */
+
+struct threadpool_range_s
+{
+  struct threadpool_task_s task;
+  threadpool_range_t       func;
+  FAR void                *arg;
+  size_t                   begin;
+  size_t                   end;
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static FAR struct threadpool_worker_s *
+threadpool_self(FAR struct threadpool_s *pool)
+{
+  pthread_t self = pthread_self();
+  int i;
+
+  for (i = 0; i < pool->nthreads; i++)
+    {
+      if (pthread_equal(pool->workers[i].thread, self))
+        {
+          return &pool->workers[i];
+        }
+    }
+
+  return NULL;
+}
+
+/* Take the newest task of our own deque, or else steal the oldest task of
+ * the next worker that has one.
+ */
+
+static FAR struct threadpool_task_s *
+threadpool_take(FAR struct threadpool_s *pool,
+                FAR struct threadpool_worker_s *self)
+{
+  FAR struct threadpool_worker_s *worker;
+  FAR struct threadpool_task_s *task = NULL;
+  int first = 0;
+  int i;
+
+  if (self != NULL)
+    {
+      nxmutex_lock(&self->lock);
+      if (!list_is_empty(&self->deque))
+        {
+          task = list_last_entry(&self->deque, struct threadpool_task_s,
+                                 node);
+          list_delete(&task->node);
+        }
+
+      nxmutex_unlock(&self->lock);
+      if (task != NULL)
+        {
+          return task;
+        }
+
+      first = self - pool->workers + 1;
+    }
+
+  for (i = 0; i < pool->nthreads; i++)
+    {
+      worker = &pool->workers[(first + i) % pool->nthreads];
+      if (worker == self)
+        {
+          continue;
+        }
+
+      nxmutex_lock(&worker->lock);
+      if (!list_is_empty(&worker->deque))
+        {
+          task = list_first_entry(&worker->deque, struct threadpool_task_s,
+                                  node);
+          list_delete(&task->node);
+        }
+
+      nxmutex_unlock(&worker->lock);
+      if (task != NULL)
+        {
+          break;
+        }
+    }
+
+  return task;
+}
+
+static void threadpool_run(FAR struct threadpool_task_s *task)
+{
+  task->func(task->arg);
+
+  /* The post is the last access, the waiter may free the task after it */
+
+  atomic_set_release(&task->finished, 1);
+  nxsem_post(&task->done);
+}
+
+/* Complete a task that will never run, threadpool_wait() returns
+ * -ECANCELED for it.
+ */
+
+static void threadpool_cancel(FAR struct threadpool_task_s *task)
+{
+  atomic_set_release(&task->finished, -1);
+  nxsem_post(&task->done);
+}
+
+static FAR void *threadpool_thread(FAR void *arg)
+{
+  FAR struct threadpool_worker_s *self = arg;
+  FAR struct threadpool_s *pool = self->pool;
+  FAR struct threadpool_task_s *task;
+
+  while (!pool->exit)
+    {
+      task = threadpool_take(pool, self);
+      if (task == NULL)
+        {
+          /* Announce that we are idle before the last look, so that a
+           * task queued after that look is certain to post the wakeup.
+           */
+
+          atomic_fetch_add(&pool->idle, 1);
+          task = threadpool_take(pool, self);
+          if (task == NULL && !pool->exit)
+            {
+              nxsem_wait(&pool->wake);
+            }
+
+          atomic_fetch_sub(&pool->idle, 1);
+        }
+
+      if (task != NULL)
+        {
+          threadpool_run(task);
+        }
+    }
+
+  return NULL;
+}
+
+static void threadpool_range(FAR void *arg)
+{
+  FAR struct threadpool_range_s *range = arg;
+
+  range->func(range->begin, range->end, range->arg);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: threadpool_create
+ ****************************************************************************/
+
+FAR struct threadpool_s *threadpool_create(int nthreads, int priority,
+                                           size_t stacksize)
+{
+  FAR struct threadpool_s *pool;
+  struct sched_param param;
+  pthread_attr_t attr;
+  int ret;
+  int i;
+
+  if (nthreads <= 0)
+    {
+      nthreads = sysconf(_SC_NPROCESSORS_ONLN);
+      if (nthreads <= 0)
+        {
+          nthreads = 1;
+        }
+    }
+
+  pool = lib_zalloc(sizeof(struct threadpool_s) +
+                    (nthreads - 1) * sizeof(struct threadpool_worker_s));
+  if (pool == NULL)
+    {
+      return NULL;
+    }
+
+  nxsem_init(&pool->wake, 0, 0);
+
+  pthread_attr_init(&attr);
+  if (stacksize > 0)
+    {
+      pthread_attr_setstacksize(&attr, stacksize);
+    }
+
+  if (priority > 0)
+    {
+      pthread_attr_getschedparam(&attr, &param);
+      param.sched_priority = priority;
+      pthread_attr_setschedparam(&attr, &param);
+      pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+    }
+
+  for (i = 0; i < nthreads; i++)
+    {
+      FAR struct threadpool_worker_s *worker = &pool->workers[i];
+
+      worker->pool = pool;
+      nxmutex_init(&worker->lock);
+      list_initialize(&worker->deque);
+    }
+
+  for (i = 0; i < nthreads; i++)
+    {
+      ret = pthread_create(&pool->workers[i].thread, &attr,
+                           threadpool_thread, &pool->workers[i]);
+      if (ret != 0)
+        {
+          break;
+        }
+
+      pool->nthreads++;
+      pthread_setname_np(pool->workers[i].thread, "tpool");
+    }
+
+  pthread_attr_destroy(&attr);
+
+  if (pool->nthreads < nthreads)
+    {
+      threadpool_destroy(pool);
+      return NULL;
+    }
+
+  return pool;
+}
+
+/****************************************************************************
+ * Name: threadpool_destroy
+ ****************************************************************************/
+
+void threadpool_destroy(FAR struct threadpool_s *pool)
+{
+  FAR struct threadpool_worker_s *worker;
+  FAR struct threadpool_task_s *task;
+  FAR struct threadpool_task_s *tmp;
+  int i;
+
+  if (pool == NULL)
+    {
+      return;
+    }
+
+  pool->exit = true;
+  for (i = 0; i < pool->nthreads; i++)
+    {
+      nxsem_post(&pool->wake);
+    }
+
+  for (i = 0; i < pool->nthreads; i++)
+    {
+      pthread_join(pool->workers[i].thread, NULL);
+    }
+
+  /* Cancel the tasks that are still queued, so that their waiters wake up
+   * instead of blocking forever.
+   */
+
+  for (i = 0; i < pool->nthreads; i++)
+    {
+      worker = &pool->workers[i];
+
+      nxmutex_lock(&worker->lock);
+      list_for_every_entry_safe(&worker->deque, task, tmp,
+                                struct threadpool_task_s, node)
+        {
+          list_delete(&task->node);
+          threadpool_cancel(task);
+        }
+
+      nxmutex_unlock(&worker->lock);
+      nxmutex_destroy(&worker->lock);
+    }
+
+  nxsem_destroy(&pool->wake);
+  lib_free(pool);
+}
+
+/****************************************************************************
+ * Name: threadpool_submit
+ ****************************************************************************/
+
+int threadpool_submit(FAR struct threadpool_s *pool,
+                      FAR struct threadpool_task_s *task,
+                      threadpool_func_t func, FAR void *arg)
+{
+  FAR struct threadpool_worker_s *worker;
+
+  if (pool == NULL || task == NULL || func == NULL)
+    {
+      return -EINVAL;
+    }
+
+  task->func = func;
+  task->arg  = arg;
+  atomic_set(&task->finished, 0);
+  nxsem_init(&task->done, 0, 0);
+
+  worker = threadpool_self(pool);
+  if (worker == NULL)
+    {
+      worker = &pool->workers[(unsigned int)atomic_fetch_add(&pool->next, 1)
+                              % pool->nthreads];
+    }
+
+  nxmutex_lock(&worker->lock);
+  list_add_tail(&worker->deque, &task->node);
+  nxmutex_unlock(&worker->lock);
+
+  if (atomic_read(&pool->idle) > 0)
+    {
+      nxsem_post(&pool->wake);
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: threadpool_wait
+ ****************************************************************************/
+
+int threadpool_wait(FAR struct threadpool_s *pool,
+                    FAR struct threadpool_task_s *task)
+{
+  FAR struct threadpool_worker_s *self;
+  FAR struct threadpool_task_s *other;
+  int ret;
+
+  if (pool == NULL || task == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* A worker helps with the queued tasks instead of blocking, the task we
+   * wait for may well be one of them.
+   */
+
+  self = threadpool_self(pool);
+  if (self != NULL)
+    {
+      while (atomic_read_acquire(&task->finished) == 0 &&
+             (other = threadpool_take(pool, self)) != NULL)
+        {
+          threadpool_run(other);
+        }
+    }
+
+  /* Retry only on signals, any other error (e.g. ECANCELED) is returned
+   * with the task still owning its semaphore.
+   */
+
+  do
+    {
+      ret = nxsem_wait(&task->done);
+    }
+  while (ret == -EINTR);
+
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  nxsem_destroy(&task->done);
+  return atomic_read_acquire(&task->finished) < 0 ? -ECANCELED : OK;
+}
+
+/****************************************************************************
+ * Name: threadpool_parallel_for
+ ****************************************************************************/
+
+int threadpool_parallel_for(FAR struct threadpool_s *pool,
+                            size_t begin, size_t end, size_t grain,
+                            threadpool_range_t func, FAR void *arg)
+{
+  FAR struct threadpool_range_s *ranges;
+  size_t nranges;
+  size_t size;
+  size_t i;
+  int err;
+  int ret;
+
+  if (pool == NULL || func == NULL || begin > end)
+    {
+      return -EINVAL;
+    }
+
+  if (grain == 0)
+    {
+      grain = 1;
+    }
+
+  nranges = (end - begin + grain - 1) / grain;
+  if (nranges > (size_t)pool->nthreads * THREADPOOL_SPLIT)
+    {
+      nranges = (size_t)pool->nthreads * THREADPOOL_SPLIT;
+    }
+
+  if (nranges <= 1)
+    {
+      if (begin < end)
+        {
+          func(begin, end, arg);
+        }
+
+      return OK;
+    }
+
+  size    = (end - begin + nranges - 1) / nranges;
+  nranges = (end - begin + size - 1) / size;
+
+  ranges = lib_malloc(nranges * sizeof(struct threadpool_range_s));
+  if (ranges == NULL)
+    {
+      return -ENOMEM;
+    }
+
+  /* Queue all but the first sub-range, which we run ourselves */
+
+  for (i = 0; i < nranges; i++)
+    {
+      ranges[i].func  = func;
+      ranges[i].arg   = arg;
+      ranges[i].begin = begin + i * size;
+      ranges[i].end   = i + 1 < nranges ? ranges[i].begin + size : end;
+
+      if (i > 0)
+        {
+          threadpool_submit(pool, &ranges[i].task, threadpool_range,
+                            &ranges[i]);
+        }
+    }
+
+  threadpool_range(&ranges[0]);
+
+  for (i = 1, err = OK; i < nranges; i++)
+    {
+      ret = threadpool_wait(pool, &ranges[i].task);
+      if (ret == -ECANCELED)
+        {
+          /* The pool was destroyed before the sub-range ran */
+
+          err = ret;
+        }
+      else if (ret < 0)
+        {
+          /* Workers may still use the ranges, they cannot be freed */
+
+          return ret;
+        }
+    }
+
+  lib_free(ranges);
+  return err;
+}
+
+#endif /* CONFIG_LIBC_THREADPOOL */
@@ -345,6 +345,7 @@ FAR struct iob_s *iob_alloc_dynamic(uint16_t size)
       iob->io_bufsize = size;             /* Total length of the iob buffer */
       iob->io_pktlen  = 0;                /* Total length of the packet */
       iob->io_free    = iob_free_dynamic; /* Customer free callback */
+      iob->io_priv    = NULL;             /* Argument of the free callback */
       iob->io_data    = (FAR uint8_t *)ALIGN_UP((uintptr_t)(iob + 1),
                                                 CONFIG_IOB_ALIGNMENT);
     }
@@ -373,6 +374,10 @@ FAR struct iob_s *iob_alloc_dynamic(uint16_t size)
  *             perform additional operations on the data before it is freed.
  *             The free_cb is called when the iob is freed.
  *
+ *   free_cb receives io_priv, which is initialized to data.  The owner may
+ *   point io_priv to its own bookkeeping instead, e.g. when many iobs
+ *   share one external buffer.
+ *
  ****************************************************************************/
 
 FAR struct iob_s *iob_alloc_with_data(FAR void *data, uint16_t size,
@@ -391,6 +396,7 @@ FAR struct iob_s *iob_alloc_with_data(FAR void *data, uint16_t size,
       iob->io_bufsize = size;    /* Total length of the iob buffer */
       iob->io_pktlen  = 0;       /* Total length of the packet */
       iob->io_free    = free_cb; /* Customer free callback */
+      iob->io_priv    = data;    /* Argument of the free callback */
       iob->io_data    = data;
     }
 
@@ -120,7 +120,7 @@ FAR struct iob_s *iob_free(FAR struct iob_s *iob)
 #ifdef CONFIG_IOB_ALLOC
   if (iob->io_free != NULL)
     {
-      iob->io_free(iob->io_data);
+      iob->io_free(iob->io_priv);
       kmm_free(iob);
       return next;
     }
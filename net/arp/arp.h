@@ -45,6 +45,7 @@
 #include <netinet/arp.h>
 #include <netinet/in.h>
 
+#include <nuttx/queue.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/semaphore.h>
 
@@ -157,14 +158,27 @@ struct arp_notify_s
 };
 #endif
 
+/* The states of an ARP table entry */
+
+enum arp_state_e
+{
+  ARP_STATE_FREE = 0,                   /* Not in use */
+  ARP_STATE_FAILED,                     /* Resolution failed, no address */
+  ARP_STATE_REACHABLE,                  /* Resolved and not yet expired */
+  ARP_STATE_STALE                       /* Expired, has to be resolved */
+};
+
 /* One entry in the ARP table (volatile!) */
 
 struct arp_entry_s
 {
+  dq_entry_t               at_node;     /* Link in the LRU list */
+  FAR struct arp_entry_s  *at_hnext;    /* Next entry in the hash chain */
   in_addr_t                at_ipaddr;   /* IP address */
   struct ether_addr        at_ethaddr;  /* Hardware address */
-  clock_t                  at_time;     /* Time of last usage */
+  clock_t                  at_time;     /* Time of last update */
   FAR struct net_driver_s *at_dev;      /* The device driver structure */
+  uint8_t                  at_state;    /* See enum arp_state_e */
 };
 
 /****************************************************************************
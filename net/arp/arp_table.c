@@ -56,10 +56,13 @@
 #include <net/ethernet.h>
 
 #include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/queue.h>
 #include <nuttx/net/netconfig.h>
 #include <nuttx/net/net.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/ip.h>
+#include <nuttx/net/netstats.h>
 
 #include "netdev/netdev.h"
 #include "netlink/netlink.h"
@@ -73,6 +76,16 @@
 
 #define ARP_MAXAGE_TICK SEC2TICK(10 * CONFIG_NET_ARP_MAXAGE)
 
+/* About two entries per hash chain when the table is full */
+
+#define ARP_HASH_NBUCKETS (CONFIG_NET_ARPTAB_MAXSIZE / 2 + 1)
+
+#ifdef CONFIG_NET_STATISTICS
+#  define ARP_STATS(f) (g_netstats.arp.f++)
+#else
+#  define ARP_STATS(f)
+#endif
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
@@ -87,9 +100,20 @@ struct arp_table_info_s
  * Private Data
  ****************************************************************************/
 
-/* The table of known address mappings */
+/* The preallocated entries of the table of known address mappings, more
+ * entries are allocated from the heap up to CONFIG_NET_ARPTAB_MAXSIZE.
+ */
 
 static struct arp_entry_s g_arptable[CONFIG_NET_ARPTAB_SIZE];
+static unsigned int g_arpnentries;
+
+/* The entries in use by IP address hash and least recently used first,
+ * and the entries that were released.
+ */
+
+static FAR struct arp_entry_s *g_arphash[ARP_HASH_NBUCKETS];
+static dq_queue_t g_arplru;
+static sq_queue_t g_arpfree;
 
 static const struct ether_addr g_zero_ethaddr =
 {
@@ -149,32 +173,86 @@ static int arp_match(FAR struct net_driver_s *dev, FAR void *arg)
 }
 
 /****************************************************************************
- * Name: arp_return_old_entry
+ * Name: arp_hash
+ ****************************************************************************/
+
+static inline FAR struct arp_entry_s **arp_hash(in_addr_t ipaddr)
+{
+  return &g_arphash[(uint32_t)(ipaddr * 0x9e3779b1u) % ARP_HASH_NBUCKETS];
+}
+
+/****************************************************************************
+ * Name: arp_unlink
  *
  * Description:
- *   Compare and return the old ARP table entry.
+ *   Remove an entry in use from the hash chain and from the LRU list.
  *
  ****************************************************************************/
 
-static FAR struct arp_entry_s *
-arp_return_old_entry(FAR struct arp_entry_s *e1, FAR struct arp_entry_s *e2)
+static void arp_unlink(FAR struct arp_entry_s *tabptr)
 {
-  if (e1->at_ipaddr == 0)
+  FAR struct arp_entry_s **pprev = arp_hash(tabptr->at_ipaddr);
+
+  while (*pprev != tabptr)
     {
-      return e1;
+      pprev = &(*pprev)->at_hnext;
     }
-  else if (e2->at_ipaddr == 0)
+
+  *pprev = tabptr->at_hnext;
+  dq_rem(&tabptr->at_node, &g_arplru);
+  tabptr->at_state = ARP_STATE_FREE;
+}
+
+/****************************************************************************
+ * Name: arp_release
+ *
+ * Description:
+ *   Unlink an entry in use and keep it for reuse.
+ *
+ ****************************************************************************/
+
+static void arp_release(FAR struct arp_entry_s *tabptr)
+{
+  arp_unlink(tabptr);
+  sq_addlast((FAR sq_entry_t *)&tabptr->at_node, &g_arpfree);
+}
+
+/****************************************************************************
+ * Name: arp_alloc
+ *
+ * Description:
+ *   Return a free entry: a released one, a preallocated one, one from the
+ *   heap while the table is below its maximum size or, failing these, the
+ *   least recently used entry.  The entry is not linked anywhere yet.
+ *
+ ****************************************************************************/
+
+static FAR struct arp_entry_s *arp_alloc(void)
+{
+  FAR struct arp_entry_s *tabptr;
+
+  tabptr = (FAR struct arp_entry_s *)sq_remfirst(&g_arpfree);
+  if (tabptr != NULL)
     {
-      return e2;
+      return tabptr;
     }
-  else if ((int)(e1->at_time - e2->at_time) <= 0)
+
+  if (g_arpnentries < CONFIG_NET_ARPTAB_SIZE)
     {
-      return e1;
+      return &g_arptable[g_arpnentries++];
     }
-  else
+
+  if (g_arpnentries < CONFIG_NET_ARPTAB_MAXSIZE)
     {
-      return e2;
+      tabptr = kmm_zalloc(sizeof(struct arp_entry_s));
+      if (tabptr != NULL)
+        {
+          g_arpnentries++;
+          return tabptr;
+        }
     }
+
+  return NULL;
 }
 
 /****************************************************************************
@@ -199,13 +277,12 @@ static FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr,
                                           bool check_expiry)
 {
   FAR struct arp_entry_s *tabptr;
-  int i;
 
   /* Check if the IPv4 address is already in the ARP table. */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  for (tabptr = *arp_hash(ipaddr); tabptr != NULL;
+       tabptr = tabptr->at_hnext)
     {
-      tabptr = &g_arptable[i];
       if (tabptr->at_dev == dev &&
           net_ipv4addr_cmp(ipaddr, tabptr->at_ipaddr))
         {
@@ -218,11 +295,13 @@ static FAR struct arp_entry_s *arp_lookup(in_addr_t ipaddr,
 
           /* Check if it has expired */
 
-          if (clock_systime_ticks() - tabptr->at_time <= ARP_MAXAGE_TICK)
+          if (tabptr->at_state != ARP_STATE_STALE &&
+              clock_systime_ticks() - tabptr->at_time <= ARP_MAXAGE_TICK)
             {
               return tabptr;
             }
 
+          tabptr->at_state = ARP_STATE_STALE;
           return NULL;  /* Expired */
         }
     }
@@ -290,61 +369,78 @@ static void arp_get_arpreq(FAR struct arpreq *output,
 int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
                FAR const uint8_t *ethaddr)
 {
-  FAR struct arp_entry_s *tabptr = &g_arptable[0];
+  FAR struct arp_entry_s *tabptr;
+  FAR struct arp_entry_s **bucket;
 #ifdef CONFIG_NETLINK_ROUTE
   struct arpreq arp_notify;
-  bool found = false;
+  bool found;
   bool new_entry;
 #endif
-  int i;
 
-  /* Walk through the ARP mapping table and try to find an entry to
-   * update. If none is found, the IP -> MAC address mapping is
-   * inserted in the ARP table.
+  /* Look up an entry to update.  If none is found, the IP -> MAC address
+   * mapping is inserted in the ARP table.
    */
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
-    {
-      /* Check if the source IP address of the incoming packet matches
-       * the IP address in this ARP table entry.
-       */
+  tabptr = arp_lookup(ipaddr, dev, false);
+#ifdef CONFIG_NETLINK_ROUTE
+  found  = tabptr != NULL;
+#endif
 
-      if (g_arptable[i].at_dev == dev &&
-          g_arptable[i].at_ipaddr != 0 &&
-          net_ipv4addr_cmp(ipaddr, g_arptable[i].at_ipaddr))
+  if (tabptr == NULL)
+    {
+      tabptr = arp_alloc();
+      if (tabptr == NULL)
         {
-          /* An old entry found, break. */
+          /* The table is full, reuse the least recently used entry and
+           * notify the old entry RTM_DELNEIGH.
+           */
+
+          tabptr = (FAR struct arp_entry_s *)dq_peek(&g_arplru);
+          if (tabptr == NULL)
+            {
+              return -ENOMEM;
+            }
 
-          tabptr = &g_arptable[i];
 #ifdef CONFIG_NETLINK_ROUTE
-          found = true;
+          arp_get_arpreq(&arp_notify, tabptr);
+          netlink_neigh_notify(&arp_notify, RTM_DELNEIGH, AF_INET);
 #endif
-          break;
+          arp_unlink(tabptr);
+          ARP_STATS(evict);
         }
-      else
-        {
-          /* Record the oldest entry. */
 
-          tabptr = arp_return_old_entry(tabptr, &g_arptable[i]);
-        }
+      tabptr->at_ipaddr = ipaddr;
+      tabptr->at_dev    = dev;
+      memset(&tabptr->at_ethaddr, 0, sizeof(tabptr->at_ethaddr));
+
+      bucket            = arp_hash(ipaddr);
+      tabptr->at_hnext  = *bucket;
+      *bucket           = tabptr;
     }
+  else
+    {
+      dq_rem(&tabptr->at_node, &g_arplru);
+    }
+
+  dq_addlast(&tabptr->at_node, &g_arplru);
+
+  /* Addresses that failed to resolve are kept as entries in the failed
+   * state with an all zero MAC address.
+   */
 
   if (ethaddr == NULL)
     {
       ethaddr = g_zero_ethaddr.ether_addr_octet;
+      tabptr->at_state = ARP_STATE_FAILED;
     }
-
-  /* When overwrite old entry, notify old entry RTM_DELNEIGH */
-
-#ifdef CONFIG_NETLINK_ROUTE
-  if (!found && tabptr->at_ipaddr != 0)
+  else
     {
-      arp_get_arpreq(&arp_notify, tabptr);
-      netlink_neigh_notify(&arp_notify, RTM_DELNEIGH, AF_INET);
+      tabptr->at_state = ARP_STATE_REACHABLE;
     }
 
   /* Need to notify when entry is not found or changes in table */
 
+#ifdef CONFIG_NETLINK_ROUTE
   new_entry = !found || memcmp(tabptr->at_ethaddr.ether_addr_octet,
                                ethaddr, ETHER_ADDR_LEN) != 0;
 #endif
@@ -353,9 +449,7 @@ int arp_update(FAR struct net_driver_s *dev, in_addr_t ipaddr,
    * information.
    */
 
-  tabptr->at_ipaddr = ipaddr;
   memcpy(tabptr->at_ethaddr.ether_addr_octet, ethaddr, ETHER_ADDR_LEN);
-  tabptr->at_dev = dev;
   tabptr->at_time = clock_systime_ticks();
 
   /* Notify the new entry */
@@ -418,6 +512,9 @@ void arp_hdr_update(FAR struct net_driver_s *dev, FAR uint16_t *pipaddr,
  *   dev     - Device structure
  *   check_expiry  - Expiry check
  *
+ *   Every lookup is counted as a hit or a miss and a hit makes the entry
+ *   the most recently used one, whether or not check_expiry is set.
+ *
  * Assumptions
  *   The network is locked to assure exclusive access to the ARP table.
  *
@@ -434,12 +531,15 @@ int arp_find(in_addr_t ipaddr, FAR uint8_t *ethaddr,
   tabptr = arp_lookup(ipaddr, dev, check_expiry);
   if (tabptr != NULL)
     {
+      ARP_STATS(hit);
+      dq_rem(&tabptr->at_node, &g_arplru);
+      dq_addlast(&tabptr->at_node, &g_arplru);
+
       /* Addresses that have failed to be searched will return a special
        * error code so that the upper layer can return faster.
        */
 
-      if (memcmp(&tabptr->at_ethaddr, &g_zero_ethaddr,
-                 sizeof(tabptr->at_ethaddr)) == 0)
+      if (tabptr->at_state == ARP_STATE_FAILED)
         {
           return -ENETUNREACH;
         }
@@ -475,6 +575,7 @@ int arp_find(in_addr_t ipaddr, FAR uint8_t *ethaddr,
 
   /* Not found */
 
+  ARP_STATS(miss);
   return -ENOENT;
 }
 
@@ -511,9 +612,9 @@ int arp_delete(in_addr_t ipaddr, FAR struct net_driver_s *dev)
       netlink_neigh_notify(&arp_notify, RTM_DELNEIGH, AF_INET);
 #endif
 
-      /* Yes.. Set the IP address to zero to "delete" it */
+      /* Yes.. Release the entry */
 
-      tabptr->at_ipaddr = 0;
+      arp_release(tabptr);
       return OK;
     }
 
@@ -536,13 +637,17 @@ int arp_delete(in_addr_t ipaddr, FAR struct net_driver_s *dev)
 
 void arp_cleanup(FAR struct net_driver_s *dev)
 {
-  int i;
+  FAR struct arp_entry_s *tabptr;
+  FAR dq_entry_t *node;
+  FAR dq_entry_t *next;
 
-  for (i = 0; i < CONFIG_NET_ARPTAB_SIZE; ++i)
+  for (node = dq_peek(&g_arplru); node != NULL; node = next)
     {
-      if (dev == g_arptable[i].at_dev)
+      next   = dq_next(node);
+      tabptr = (FAR struct arp_entry_s *)node;
+      if (dev == tabptr->at_dev)
         {
-          memset(&g_arptable[i], 0, sizeof(g_arptable[i]));
+          arp_release(tabptr);
         }
     }
 }
@@ -572,18 +677,18 @@ unsigned int arp_snapshot(FAR struct arpreq *snapshot,
                           unsigned int nentries)
 {
   FAR struct arp_entry_s *tabptr;
+  FAR dq_entry_t *node;
   clock_t now;
   unsigned int ncopied;
-  int i;
 
-  /* Copy all non-empty, non-expired entries in the ARP table. */
+  /* Copy all non-expired entries in the ARP table. */
 
-  for (i = 0, now = clock_systime_ticks(), ncopied = 0;
-       nentries > ncopied && i < CONFIG_NET_ARPTAB_SIZE;
-       i++)
+  for (node = dq_peek(&g_arplru), now = clock_systime_ticks(), ncopied = 0;
+       nentries > ncopied && node != NULL;
+       node = dq_next(node))
     {
-      tabptr = &g_arptable[i];
-      if (tabptr->at_ipaddr != 0 &&
+      tabptr = (FAR struct arp_entry_s *)node;
+      if (tabptr->at_state != ARP_STATE_STALE &&
           now - tabptr->at_time <= ARP_MAXAGE_TICK)
         {
           arp_get_arpreq(&snapshot[ncopied], tabptr);
@@ -123,6 +123,11 @@
  *                        retransmissions. (TCP only)
  *                   OUT: Not used
  *
+ *   SOCK_ERRQUEUE    IN: Completed MSG_ZEROCOPY sends were queued for
+ *                        recvmsg(MSG_ERRQUEUE).  Raised from work queue
+ *                        context with no device.
+ *                   OUT: Not used
+ *
  * Device Specific Events:  These are events that may be notified through
  * callback lists residing in the network device structure.
  *
@@ -193,7 +198,9 @@
 #define TCP_TIMEDOUT       (1 << 9)
 #define TCP_WAITALL        (1 << 10)
 
-/* Bits 10-11: Unused, available */
+/* Bit 11: Socket error queue event bit */
+
+#define SOCK_ERRQUEUE      (1 << 11)
 
 /* Bit 12: Device specific event bits */
 
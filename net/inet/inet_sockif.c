@@ -45,6 +45,7 @@
 #include "sixlowpan/sixlowpan.h"
 #include "socket/socket.h"
 #include "inet/inet.h"
+#include "utils/utils.h"
 
 #ifdef HAVE_INET_SOCKETS
 
@@ -1788,7 +1789,8 @@ static ssize_t inet_send(FAR struct socket *psock, FAR const void *buf,
               /* UDP/IP packet send */
 
               ret = _SS_ISCONNECTED(conn->s_flags) ?
-                psock_udp_sendto(psock, buf, len, 0, NULL, 0) : -ENOTCONN;
+                psock_udp_sendto(psock, buf, len, flags, NULL, 0) :
+                -ENOTCONN;
             }
 #endif /* NET_UDP_HAVE_STACK */
 
@@ -1796,7 +1798,7 @@ static ssize_t inet_send(FAR struct socket *psock, FAR const void *buf,
           /* Only UDP/IP packet send */
 
           ret = _SS_ISCONNECTED(conn->s_flags) ?
-            psock_udp_sendto(psock, buf, len, 0, NULL, 0) : -ENOTCONN;
+            psock_udp_sendto(psock, buf, len, flags, NULL, 0) : -ENOTCONN;
 #else
           ret = -ENOSYS;
 #endif /* CONFIG_NET_6LOWPAN */
@@ -1949,6 +1951,10 @@ static ssize_t inet_sendmsg(FAR struct socket *psock,
   socklen_t tolen = msg->msg_namelen;
   FAR const struct iovec *iov;
   FAR const struct iovec *end;
+#ifdef CONFIG_NET_ZEROCOPY
+  FAR struct socket_conn_s *conn = psock->s_conn;
+  FAR struct net_zcopy_s *zc = NULL;
+#endif
   int ret;
 
   if (msg->msg_iovlen == 1)
@@ -1980,9 +1986,35 @@ static ssize_t inet_sendmsg(FAR struct socket *psock,
       len += iov->iov_len;
     }
 
+#ifdef CONFIG_NET_ZEROCOPY
+  /* The gathered data is freed on return, so it cannot be sent by
+   * reference.  Report the send as a copied MSG_ZEROCOPY send instead.
+   */
+
+  if ((flags & MSG_ZEROCOPY) != 0 &&
+      _SO_GETOPT(conn->s_options, SO_ZEROCOPY))
+    {
+      zc = net_zcopy_alloc(conn);
+      if (zc == NULL)
+        {
+          kmm_free(buf);
+          return -ENOBUFS;
+        }
+
+      flags &= ~MSG_ZEROCOPY;
+    }
+#endif
+
   ret = to ? inet_sendto(psock, buf, len, flags, to, tolen) :
              inet_send(psock, buf, len, flags);
 
+#ifdef CONFIG_NET_ZEROCOPY
+  if (zc != NULL)
+    {
+      net_zcopy_release(zc, ret);
+    }
+#endif
+
   kmm_free(buf);
 
   return ret;
@@ -26,10 +26,13 @@
 
 #include <nuttx/config.h>
 
+#include <inttypes.h>
+#include <stdlib.h>
 #include <debug.h>
 
 #include <nuttx/kmalloc.h>
 #include <nuttx/net/icmpv6.h>
+#include <nuttx/net/ipv6ext.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/udp.h>
 #include <nuttx/queue.h>
@@ -57,29 +60,292 @@
   (((entry)->match.icmp.type == 0xFF || \
     (entry)->match.icmp.type == (icmphdr)->type) ^ (entry)->inv_icmp)
 
-/* Getting L4 header from IPv4/IPv6 header. */
+/* Getting L4 header from IPv4 header. */
 
 #define IPv4_L4HDR(ipv4) \
   ((FAR void *)((FAR uint8_t *)(ipv4) + (((ipv4)->vhl & IPv4_HLMASK) << 2)))
 
-#define IPv6_L4HDR(ipv6, proto) \
-  ((FAR void *)(net_ipv6_payload((FAR struct ipv6_hdr_s *)(ipv6), &(proto))))
+/* The L4 bytes that the entries look at: the TCP/UDP ports or the ICMP
+ * type and code.
+ */
+
+#define IPFILTER_L4_MINLEN 4
+
+/* Index keys: the entries that match any protocol, and the entries of one
+ * protocol that match any or exactly one destination port.
+ */
+
+#define IPFILTER_KEY_ANY          UINT32_MAX
+#define IPFILTER_KEY_PROTO(proto) (((uint32_t)(proto) << 17) | 0x10000)
+#define IPFILTER_KEY_PORT(proto, port) \
+  (((uint32_t)(proto) << 17) | (port))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFILTER_INDEX
+/* The entries of a chain with the same key */
+
+struct ipfilter_run_s
+{
+  uint32_t key;   /* The key of the entries */
+  uint32_t start; /* The first entry of the run in rules */
+  uint32_t end;   /* One past the last entry of the run in rules */
+};
+
+/* A compiled chain: the entries sorted by key and then by their position
+ * in the chain, and the runs of entries with the same key sorted by key.
+ */
+
+struct ipfilter_index_s
+{
+  FAR struct ipfilter_entry_s **rules;
+  FAR struct ipfilter_run_s    *runs;
+  uint32_t                      nruns;
+};
+
+/* The candidate entries for a packet, at most one run per key */
+
+struct ipfilter_cursor_s
+{
+  FAR struct ipfilter_entry_s **pos[3];
+  FAR struct ipfilter_entry_s **end[3];
+  int                           nruns;
+};
+#endif
+
+struct ipfilter_chain_s
+{
+  sq_queue_t                   rules;  /* The entries in order */
+  uint32_t                     nrules; /* The number of entries */
+#ifdef CONFIG_NET_IPFILTER_INDEX
+  FAR struct ipfilter_index_s *index;  /* The compiled entries, or NULL */
+#endif
+};
 
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
 #ifdef CONFIG_NET_IPv4
-static sq_queue_t g_ipv4_filters[IPFILTER_CHAIN_MAX];
+static struct ipfilter_chain_s g_ipv4_filters[IPFILTER_CHAIN_MAX];
 #endif
 #ifdef CONFIG_NET_IPv6
-static sq_queue_t g_ipv6_filters[IPFILTER_CHAIN_MAX];
+static struct ipfilter_chain_s g_ipv6_filters[IPFILTER_CHAIN_MAX];
 #endif
 
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: ipfilter_chain
+ *
+ * Description:
+ *   Return the chain of the address family, NULL if the address family is
+ *   not supported.
+ *
+ ****************************************************************************/
+
+static FAR struct ipfilter_chain_s *
+ipfilter_chain(sa_family_t family, enum ipfilter_chain_e chain)
+{
+#ifdef CONFIG_NET_IPv4
+  if (family == PF_INET)
+    {
+      return &g_ipv4_filters[chain];
+    }
+#endif
+
+#ifdef CONFIG_NET_IPv6
+  if (family == PF_INET6)
+    {
+      return &g_ipv6_filters[chain];
+    }
+#endif
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: ipfilter_hit
+ *
+ * Description:
+ *   Account a packet of len bytes to a matching entry and return the target
+ *   action of the entry.
+ *
+ ****************************************************************************/
+
+static int ipfilter_hit(FAR struct ipfilter_entry_s *entry, uint32_t len)
+{
+  entry->pcnt++;
+  entry->bcnt += len;
+  return entry->target;
+}
+
+#ifdef CONFIG_NET_IPFILTER_INDEX
+
+/****************************************************************************
+ * Name: ipfilter_index_free
+ ****************************************************************************/
+
+static void ipfilter_index_free(FAR struct ipfilter_chain_s *chain)
+{
+  kmm_free(chain->index);
+  chain->index = NULL;
+}
+
+/****************************************************************************
+ * Name: ipfilter_entry_key
+ *
+ * Description:
+ *   Return the index key of an entry.  An entry with a key other than
+ *   IPFILTER_KEY_ANY can only match packets of its protocol and, if the key
+ *   has a port, packets to that destination port.
+ *
+ ****************************************************************************/
+
+static uint32_t ipfilter_entry_key(FAR const struct ipfilter_entry_s *entry)
+{
+  if (entry->proto == 0 || entry->inv_proto)
+    {
+      return IPFILTER_KEY_ANY;
+    }
+
+  if ((entry->proto == IP_PROTO_TCP || entry->proto == IP_PROTO_UDP) &&
+      entry->match_tcpudp && !entry->inv_dport &&
+      entry->match.tcpudp.dports[0] == entry->match.tcpudp.dports[1])
+    {
+      return IPFILTER_KEY_PORT(entry->proto, entry->match.tcpudp.dports[0]);
+    }
+
+  return IPFILTER_KEY_PROTO(entry->proto);
+}
+
+/****************************************************************************
+ * Name: ipfilter_entry_compare
+ ****************************************************************************/
+
+static int ipfilter_entry_compare(FAR const void *a, FAR const void *b)
+{
+  FAR const struct ipfilter_entry_s *ea =
+                              *(FAR struct ipfilter_entry_s * const *)a;
+  FAR const struct ipfilter_entry_s *eb =
+                              *(FAR struct ipfilter_entry_s * const *)b;
+  uint32_t ka = ipfilter_entry_key(ea);
+  uint32_t kb = ipfilter_entry_key(eb);
+
+  if (ka != kb)
+    {
+      return ka < kb ? -1 : 1;
+    }
+
+  return ea->seq < eb->seq ? -1 : ea->seq > eb->seq;
+}
+
+/****************************************************************************
+ * Name: ipfilter_cursor_add
+ *
+ * Description:
+ *   Add the run of entries with the key to the candidates, if there is one.
+ *
+ ****************************************************************************/
+
+static void ipfilter_cursor_add(FAR struct ipfilter_cursor_s *cursor,
+                                FAR const struct ipfilter_index_s *index,
+                                uint32_t key)
+{
+  FAR const struct ipfilter_run_s *run;
+  uint32_t low = 0;
+  uint32_t high = index->nruns;
+  uint32_t mid;
+
+  while (low < high)
+    {
+      mid = (low + high) / 2;
+      run = &index->runs[mid];
+
+      if (run->key == key)
+        {
+          cursor->pos[cursor->nruns] = &index->rules[run->start];
+          cursor->end[cursor->nruns] = &index->rules[run->end];
+          cursor->nruns++;
+          return;
+        }
+      else if (run->key < key)
+        {
+          low = mid + 1;
+        }
+      else
+        {
+          high = mid;
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: ipfilter_cursor_init
+ *
+ * Description:
+ *   Collect the runs of entries that can match a packet of the protocol.
+ *
+ ****************************************************************************/
+
+static void ipfilter_cursor_init(FAR struct ipfilter_cursor_s *cursor,
+                                 FAR const struct ipfilter_index_s *index,
+                                 FAR const void *l4hdr, uint8_t proto)
+{
+  cursor->nruns = 0;
+
+  ipfilter_cursor_add(cursor, index, IPFILTER_KEY_ANY);
+  ipfilter_cursor_add(cursor, index, IPFILTER_KEY_PROTO(proto));
+
+  if (proto == IP_PROTO_TCP || proto == IP_PROTO_UDP)
+    {
+      /* Ports in TCP & UDP headers have same offset.  A packet without
+       * the L4 header can only match the entries that take any port.
+       */
+
+      FAR const struct udp_hdr_s *udp = l4hdr;
+      if (udp != NULL)
+        {
+          ipfilter_cursor_add(cursor, index,
+                              IPFILTER_KEY_PORT(proto,
+                                                NTOHS(udp->destport)));
+        }
+    }
+}
+
+/****************************************************************************
+ * Name: ipfilter_cursor_next
+ *
+ * Description:
+ *   Return the next candidate entry in the order of the chain, NULL if
+ *   there are no more candidates.
+ *
+ ****************************************************************************/
+
+static FAR struct ipfilter_entry_s *
+ipfilter_cursor_next(FAR struct ipfilter_cursor_s *cursor)
+{
+  int best = -1;
+  int i;
+
+  for (i = 0; i < cursor->nruns; i++)
+    {
+      if (cursor->pos[i] < cursor->end[i] &&
+          (best < 0 || (*cursor->pos[i])->seq < (*cursor->pos[best])->seq))
+        {
+          best = i;
+        }
+    }
+
+  return best < 0 ? NULL : *cursor->pos[best]++;
+}
+
+#endif /* CONFIG_NET_IPFILTER_INDEX */
+
 /****************************************************************************
  * Name: ipfilter_match_device
  *
@@ -156,6 +422,15 @@ static bool ipfilter_match_proto(FAR const struct ipfilter_entry_s *entry,
       return true;
     }
 
+  if (l4hdr == NULL)
+    {
+      /* Without the L4 header, only entries that do not look at it can
+       * match.
+       */
+
+      return !entry->match_tcpudp && !entry->match_icmp;
+    }
+
   switch (proto)
     {
       case IP_PROTO_TCP:
@@ -188,11 +463,184 @@ static bool ipfilter_match_proto(FAR const struct ipfilter_entry_s *entry,
     }
 }
 
+/****************************************************************************
+ * Name: ipv4_filter_l4hdr / ipv6_filter_l4hdr
+ *
+ * Description:
+ *   Return the L4 header of the packet, or NULL if the packet does not
+ *   carry it: a fragment other than the first one, or a packet too short
+ *   to hold the fields that the entries match.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static FAR const void *
+ipv4_filter_l4hdr(FAR const struct ipv4_hdr_s *ipv4)
+{
+  uint32_t hdrlen = (ipv4->vhl & IPv4_HLMASK) << 2;
+  uint32_t len = ((uint32_t)ipv4->len[0] << 8) + ipv4->len[1];
+
+  if ((ipv4->ipoffset[0] & 0x1f) != 0 || ipv4->ipoffset[1] != 0 ||
+      len < hdrlen + IPFILTER_L4_MINLEN)
+    {
+      return NULL;
+    }
+
+  return IPv4_L4HDR(ipv4);
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static FAR const void *
+ipv6_filter_l4hdr(FAR const struct ipv6_hdr_s *ipv6, FAR uint8_t *proto)
+{
+  FAR const uint8_t *payload = (FAR const uint8_t *)ipv6 + IPv6_HDRLEN;
+  FAR const uint8_t *end = payload + ((uint32_t)ipv6->len[0] << 8) +
+                           ipv6->len[1];
+  FAR const struct ipv6_fragment_extension_s *frag;
+  FAR const struct ipv6_extension_s *exthdr;
+  uint8_t nxthdr = ipv6->proto;
+  bool first = true;
+
+  while (ipv6_exthdr(nxthdr))
+    {
+      if (payload + sizeof(struct ipv6_extension_s) > end)
+        {
+          first = false;
+          break;
+        }
+
+      exthdr = (FAR const struct ipv6_extension_s *)payload;
+      if (nxthdr == NEXT_FRAGMENT_EH)
+        {
+          frag = (FAR const struct ipv6_fragment_extension_s *)payload;
+          if (frag->msoffset != 0 || (frag->lsoffset & 0xf8) != 0)
+            {
+              first = false;
+            }
+        }
+
+      payload += EXTHDR_LEN(exthdr->len);
+      nxthdr   = exthdr->nxthdr;
+    }
+
+  *proto = nxthdr;
+  if (!first || payload + IPFILTER_L4_MINLEN > end)
+    {
+      return NULL;
+    }
+
+  return payload;
+}
+#endif
+
+/****************************************************************************
+ * Name: ipv4_filter_entry / ipv6_filter_entry
+ *
+ * Description:
+ *   Match the packet with one filter entry.
+ *
+ * Input Parameters:
+ *   filter    - The filter entry to match
+ *   indev     - The network device that the packet comes from
+ *   outdev    - The network device that the packet goes to
+ *   ipv4/ipv6 - The IPv4/IPv6 header
+ *   l4hdr     - The transport layer header
+ *   proto     - The transport layer protocol (IPv6 only)
+ *
+ * Returned Value:
+ *   true  - The packet is matched
+ *   false - The packet is not matched
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+static bool ipv4_filter_entry(FAR const struct ipv4_filter_entry_s *filter,
+                              FAR const struct net_driver_s *indev,
+                              FAR const struct net_driver_s *outdev,
+                              FAR const struct ipv4_hdr_s *ipv4,
+                              FAR const void *l4hdr)
+{
+  in_addr_t ipaddr;
+  bool matched;
+
+  /* Match device */
+
+  if (!ipfilter_match_device(&filter->common, indev, outdev))
+    {
+      return false;
+    }
+
+  /* Match addresses */
+
+  ipaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
+  matched = net_ipv4addr_maskcmp(filter->sip, ipaddr, filter->smsk)
+            ^ filter->common.inv_srcip;
+  if (!matched)
+    {
+      return false;
+    }
+
+  ipaddr  = net_ip4addr_conv32(ipv4->destipaddr);
+  matched = net_ipv4addr_maskcmp(filter->dip, ipaddr, filter->dmsk)
+            ^ filter->common.inv_dstip;
+  if (!matched)
+    {
+      return false;
+    }
+
+  /* Match protocol */
+
+  return ipfilter_match_proto(&filter->common, l4hdr, ipv4->proto);
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+static bool ipv6_filter_entry(FAR const struct ipv6_filter_entry_s *filter,
+                              FAR const struct net_driver_s *indev,
+                              FAR const struct net_driver_s *outdev,
+                              FAR const struct ipv6_hdr_s *ipv6,
+                              FAR const void *l4hdr, uint8_t proto)
+{
+  bool matched;
+
+  /* Match device */
+
+  if (!ipfilter_match_device(&filter->common, indev, outdev))
+    {
+      return false;
+    }
+
+  /* Match addresses */
+
+  matched = net_ipv6addr_maskcmp(filter->sip, ipv6->srcipaddr,
+                                 filter->smsk)
+            ^ filter->common.inv_srcip;
+  if (!matched)
+    {
+      return false;
+    }
+
+  matched = net_ipv6addr_maskcmp(filter->dip, ipv6->destipaddr,
+                                 filter->dmsk)
+            ^ filter->common.inv_dstip;
+  if (!matched)
+    {
+      return false;
+    }
+
+  /* Match protocol */
+
+  return ipfilter_match_proto(&filter->common, l4hdr, proto);
+}
+#endif
+
 /****************************************************************************
  * Name: ipv4_filter_match / ipv6_filter_match
  *
  * Description:
  *   Match the input packet with the filter entries in the specified chain.
+ *   The first matching entry counts the packet and decides.
  *
  * Input Parameters:
  *   indev     - The network device that the packet comes from
@@ -213,12 +661,13 @@ static int ipv4_filter_match(FAR const struct net_driver_s *indev,
                              FAR const struct ipv4_hdr_s *ipv4,
                              enum ipfilter_chain_e chain)
 {
-  FAR const struct ipv4_filter_entry_s *filter;
-  FAR const sq_queue_t *queue = &g_ipv4_filters[chain];
-  FAR const sq_entry_t *entry;
+  FAR struct ipfilter_chain_s *filters = &g_ipv4_filters[chain];
+  FAR struct ipfilter_entry_s *entry;
+#ifdef CONFIG_NET_IPFILTER_INDEX
+  struct ipfilter_cursor_s cursor;
+#endif
   FAR const void *l4hdr;
-  in_addr_t ipaddr;
-  bool matched;
+  uint32_t len;
 
   /* Handle unexpected status, return ACCEPT to indicate doing nothing. */
 
@@ -227,47 +676,34 @@ static int ipv4_filter_match(FAR const struct net_driver_s *indev,
       return IPFILTER_TARGET_ACCEPT;
     }
 
-  l4hdr = IPv4_L4HDR(ipv4);
+  l4hdr = ipv4_filter_l4hdr(ipv4);
+  len   = ((uint32_t)ipv4->len[0] << 8) + ipv4->len[1];
 
-  sq_for_every(queue, entry)
+#ifdef CONFIG_NET_IPFILTER_INDEX
+  if (filters->index != NULL)
     {
-      filter = (FAR struct ipv4_filter_entry_s *)entry;
-
-      /* Match device */
-
-      if (!ipfilter_match_device(&filter->common, indev, outdev))
+      ipfilter_cursor_init(&cursor, filters->index, l4hdr, ipv4->proto);
+      while ((entry = ipfilter_cursor_next(&cursor)) != NULL)
         {
-          continue;
+          if (ipv4_filter_entry((FAR struct ipv4_filter_entry_s *)entry,
+                                indev, outdev, ipv4, l4hdr))
+            {
+              return ipfilter_hit(entry, len);
+            }
         }
-
-      /* Match addresses */
-
-      ipaddr  = net_ip4addr_conv32(ipv4->srcipaddr);
-      matched = net_ipv4addr_maskcmp(filter->sip, ipaddr, filter->smsk)
-                ^ filter->common.inv_srcip;
-      if (!matched)
-        {
-          continue;
-        }
-
-      ipaddr  = net_ip4addr_conv32(ipv4->destipaddr);
-      matched = net_ipv4addr_maskcmp(filter->dip, ipaddr, filter->dmsk)
-                ^ filter->common.inv_dstip;
-      if (!matched)
-        {
-          continue;
-        }
-
-      /* Match protocol */
-
-      if (!ipfilter_match_proto(&filter->common, l4hdr, ipv4->proto))
+    }
+  else
+#endif
+    {
+      for (entry = (FAR struct ipfilter_entry_s *)sq_peek(&filters->rules);
+           entry != NULL; entry = entry->flink)
         {
-          continue;
+          if (ipv4_filter_entry((FAR struct ipv4_filter_entry_s *)entry,
+                                indev, outdev, ipv4, l4hdr))
+            {
+              return ipfilter_hit(entry, len);
+            }
         }
-
-      /* Return the target action if matched. */
-
-      return filter->common.target;
     }
 
   /* Normally there should be a default rule in chain, won't reach here. */
@@ -283,12 +719,14 @@ static int ipv6_filter_match(FAR const struct net_driver_s *indev,
                              FAR const struct ipv6_hdr_s *ipv6,
                              enum ipfilter_chain_e chain)
 {
-  FAR const struct ipv6_filter_entry_s *filter;
-  FAR const sq_queue_t *queue = &g_ipv6_filters[chain];
-  FAR const sq_entry_t *entry;
+  FAR struct ipfilter_chain_s *filters = &g_ipv6_filters[chain];
+  FAR struct ipfilter_entry_s *entry;
+#ifdef CONFIG_NET_IPFILTER_INDEX
+  struct ipfilter_cursor_s cursor;
+#endif
   FAR const void *l4hdr;
+  uint32_t len;
   uint8_t proto;
-  bool matched;
 
   /* Handle unexpected status, return ACCEPT to indicate doing nothing. */
 
@@ -297,47 +735,34 @@ static int ipv6_filter_match(FAR const struct net_driver_s *indev,
       return IPFILTER_TARGET_ACCEPT;
     }
 
-  l4hdr = IPv6_L4HDR(ipv6, proto);
+  l4hdr = ipv6_filter_l4hdr(ipv6, &proto);
+  len   = ((uint32_t)ipv6->len[0] << 8) + ipv6->len[1] + IPv6_HDRLEN;
 
-  sq_for_every(queue, entry)
+#ifdef CONFIG_NET_IPFILTER_INDEX
+  if (filters->index != NULL)
     {
-      filter = (FAR struct ipv6_filter_entry_s *)entry;
-
-      /* Match device */
-
-      if (!ipfilter_match_device(&filter->common, indev, outdev))
-        {
-          continue;
-        }
-
-      /* Match addresses */
-
-      matched = net_ipv6addr_maskcmp(filter->sip, ipv6->srcipaddr,
-                                     filter->smsk)
-                ^ filter->common.inv_srcip;
-      if (!matched)
-        {
-          continue;
-        }
-
-      matched = net_ipv6addr_maskcmp(filter->dip, ipv6->destipaddr,
-                                     filter->dmsk)
-                ^ filter->common.inv_dstip;
-      if (!matched)
+      ipfilter_cursor_init(&cursor, filters->index, l4hdr, proto);
+      while ((entry = ipfilter_cursor_next(&cursor)) != NULL)
         {
-          continue;
+          if (ipv6_filter_entry((FAR struct ipv6_filter_entry_s *)entry,
+                                indev, outdev, ipv6, l4hdr, proto))
+            {
+              return ipfilter_hit(entry, len);
+            }
         }
-
-      /* Match protocol */
-
-      if (!ipfilter_match_proto(&filter->common, l4hdr, proto))
+    }
+  else
+#endif
+    {
+      for (entry = (FAR struct ipfilter_entry_s *)sq_peek(&filters->rules);
+           entry != NULL; entry = entry->flink)
         {
-          continue;
+          if (ipv6_filter_entry((FAR struct ipv6_filter_entry_s *)entry,
+                                indev, outdev, ipv6, l4hdr, proto))
+            {
+              return ipfilter_hit(entry, len);
+            }
         }
-
-      /* Return the target action if matched. */
-
-      return filter->common.target;
     }
 
   /* Normally there should be a default rule in chain, won't reach here. */
@@ -407,19 +832,17 @@ FAR struct ipfilter_entry_s *ipfilter_cfg_alloc(sa_family_t family)
 void ipfilter_cfg_add(FAR struct ipfilter_entry_s *entry,
                       sa_family_t family, enum ipfilter_chain_e chain)
 {
-#ifdef CONFIG_NET_IPv4
-  if (family == PF_INET)
+  FAR struct ipfilter_chain_s *filters = ipfilter_chain(family, chain);
+
+  if (filters != NULL)
     {
-      sq_addlast((FAR sq_entry_t *)entry, &g_ipv4_filters[chain]);
-    }
+#ifdef CONFIG_NET_IPFILTER_INDEX
+      ipfilter_index_free(filters);
 #endif
 
-#ifdef CONFIG_NET_IPv6
-  if (family == PF_INET6)
-    {
-      sq_addlast((FAR sq_entry_t *)entry, &g_ipv6_filters[chain]);
+      entry->seq = filters->nrules++;
+      sq_addlast((FAR sq_entry_t *)entry, &filters->rules);
     }
-#endif
 }
 
 /****************************************************************************
@@ -440,28 +863,135 @@ void ipfilter_cfg_add(FAR struct ipfilter_entry_s *entry,
 
 void ipfilter_cfg_clear(sa_family_t family, enum ipfilter_chain_e chain)
 {
-#ifdef CONFIG_NET_IPv4
-  if (family == PF_INET)
+  FAR struct ipfilter_chain_s *filters = ipfilter_chain(family, chain);
+
+  if (filters != NULL)
     {
-      FAR sq_queue_t *queue = &g_ipv4_filters[chain];
-      while (!sq_empty(queue))
+#ifdef CONFIG_NET_IPFILTER_INDEX
+      ipfilter_index_free(filters);
+#endif
+
+      while (!sq_empty(&filters->rules))
         {
-          kmm_free(sq_remfirst(queue));
+          kmm_free(sq_remfirst(&filters->rules));
         }
+
+      filters->nrules = 0;
     }
-#endif
+}
 
-#ifdef CONFIG_NET_IPv6
-  if (family == PF_INET6)
+/****************************************************************************
+ * Name: ipfilter_cfg_head
+ *
+ * Description:
+ *   Return the first filter configuration entry of the specified chain, the
+ *   following entries are linked through flink in the order of the chain.
+ *
+ * Input Parameters:
+ *   family - The address family of the filter entries
+ *   chain  - The chain to return the first entry of
+ *
+ * Returned Value:
+ *   The first entry of the chain, NULL if the chain is empty.
+ *
+ ****************************************************************************/
+
+FAR struct ipfilter_entry_s *ipfilter_cfg_head(sa_family_t family,
+                                               enum ipfilter_chain_e chain)
+{
+  FAR struct ipfilter_chain_s *filters = ipfilter_chain(family, chain);
+
+  if (filters == NULL)
     {
-      FAR sq_queue_t *queue = &g_ipv6_filters[chain];
-      while (!sq_empty(queue))
+      return NULL;
+    }
+
+  return (FAR struct ipfilter_entry_s *)sq_peek(&filters->rules);
+}
+
+/****************************************************************************
+ * Name: ipfilter_cfg_compile
+ *
+ * Description:
+ *   Index the filter configuration entries of the specified chain by
+ *   protocol and destination port, so that a packet is only checked
+ *   against the entries that can match it.  Adding an entry drops the
+ *   index; the chain is then searched linearly until it is compiled again.
+ *
+ * Input Parameters:
+ *   family - The address family of the filter entries
+ *   chain  - The chain to compile
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFILTER_INDEX
+void ipfilter_cfg_compile(sa_family_t family, enum ipfilter_chain_e chain)
+{
+  FAR struct ipfilter_chain_s *filters = ipfilter_chain(family, chain);
+  FAR struct ipfilter_index_s *index;
+  FAR struct ipfilter_entry_s *entry;
+  uint32_t key;
+  uint32_t i;
+
+  if (filters == NULL)
+    {
+      return;
+    }
+
+  ipfilter_index_free(filters);
+  if (filters->nrules == 0)
+    {
+      return;
+    }
+
+  /* One allocation holds the index, the entries and at most one run per
+   * entry.  If it fails, the chain is just searched linearly.
+   */
+
+  index = kmm_malloc(sizeof(struct ipfilter_index_s) +
+                     filters->nrules * (sizeof(FAR void *) +
+                                        sizeof(struct ipfilter_run_s)));
+  if (index == NULL)
+    {
+      nwarn("WARNING: No memory to index %" PRIu32 " filters\n",
+            filters->nrules);
+      return;
+    }
+
+  index->rules = (FAR struct ipfilter_entry_s **)(index + 1);
+  index->runs  = (FAR struct ipfilter_run_s *)
+                 (index->rules + filters->nrules);
+  index->nruns = 0;
+
+  i = 0;
+  for (entry = (FAR struct ipfilter_entry_s *)sq_peek(&filters->rules);
+       entry != NULL; entry = entry->flink)
+    {
+      index->rules[i++] = entry;
+    }
+
+  qsort(index->rules, filters->nrules, sizeof(FAR void *),
+        ipfilter_entry_compare);
+
+  for (i = 0; i < filters->nrules; i++)
+    {
+      key = ipfilter_entry_key(index->rules[i]);
+      if (index->nruns == 0 || index->runs[index->nruns - 1].key != key)
         {
-          kmm_free(sq_remfirst(queue));
+          index->runs[index->nruns].key   = key;
+          index->runs[index->nruns].start = i;
+          index->nruns++;
         }
+
+      index->runs[index->nruns - 1].end = i + 1;
     }
-#endif
+
+  filters->index = index;
 }
+#endif
 
 /****************************************************************************
  * Name: ipv4_filter_in / ipv6_filter_in
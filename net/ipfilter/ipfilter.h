@@ -82,6 +82,13 @@ struct ipfilter_entry_s
   uint8_t proto;          /* Protocol to match, 0 = ALL (Same as Linux) */
   int8_t  target;
 
+  /* Position in the chain and hit counters, maintained by ipfilter */
+
+  uint32_t seq;
+  uint32_t srcidx;        /* Index of the source rule, kept for the owner */
+  uint64_t pcnt;          /* Packets matched */
+  uint64_t bcnt;          /* Bytes matched */
+
   /* Match flags, whether we need to match protocol in detail */
 
   uint8_t match_tcpudp : 1; /* Match TCP/UDP */
@@ -182,6 +189,49 @@ void ipfilter_cfg_add(FAR struct ipfilter_entry_s *entry,
 
 void ipfilter_cfg_clear(sa_family_t family, enum ipfilter_chain_e chain);
 
+/****************************************************************************
+ * Name: ipfilter_cfg_head
+ *
+ * Description:
+ *   Return the first filter configuration entry of the specified chain, the
+ *   following entries are linked through flink in the order of the chain.
+ *
+ * Input Parameters:
+ *   family - The address family of the filter entries
+ *   chain  - The chain to return the first entry of
+ *
+ * Returned Value:
+ *   The first entry of the chain, NULL if the chain is empty.
+ *
+ ****************************************************************************/
+
+FAR struct ipfilter_entry_s *ipfilter_cfg_head(sa_family_t family,
+                                               enum ipfilter_chain_e chain);
+
+/****************************************************************************
+ * Name: ipfilter_cfg_compile
+ *
+ * Description:
+ *   Index the filter configuration entries of the specified chain by
+ *   protocol and destination port, so that a packet is only checked
+ *   against the entries that can match it.  Adding an entry drops the
+ *   index; the chain is then searched linearly until it is compiled again.
+ *
+ * Input Parameters:
+ *   family - The address family of the filter entries
+ *   chain  - The chain to compile
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFILTER_INDEX
+void ipfilter_cfg_compile(sa_family_t family, enum ipfilter_chain_e chain);
+#else
+#  define ipfilter_cfg_compile(family, chain)
+#endif
+
 /****************************************************************************
  * Name: ipv4_filter_in / ipv6_filter_in
  *
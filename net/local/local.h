@@ -35,6 +35,7 @@
 #include <stdbool.h>
 #include <poll.h>
 
+#include <nuttx/circbuf.h>
 #include <nuttx/fs/fs.h>
 #include <nuttx/queue.h>
 #include <nuttx/net/net.h>
@@ -50,6 +51,11 @@
 #define LOCAL_NPOLLWAITERS 2
 #define LOCAL_NCONTROLFDS  4
 
+/* Bits of lc_shutdown */
+
+#define LOCAL_SHUT_RD      (1 << 0)
+#define LOCAL_SHUT_WR      (1 << 1)
+
 #if CONFIG_DEV_PIPE_MAXSIZE > 65535
 typedef uint32_t lc_size_t;  /* 32-bit index */
 #elif CONFIG_DEV_PIPE_MAXSIZE > 255
@@ -155,6 +161,15 @@ struct local_conn_s
   FAR struct pollfd *lc_event_fds[LOCAL_NPOLLWAITERS];
   struct pollfd lc_inout_fds[2*LOCAL_NPOLLWAITERS];
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  /* Connected peers send straight into each other's receive buffer */
+
+  struct circbuf_s lc_rxbuf;   /* Data sent to us by the peer */
+  sem_t lc_rxsem;              /* Posted when data or EOF arrives */
+  sem_t lc_txsem;              /* Posted when the peer buffer drains */
+  uint8_t lc_shutdown;         /* See LOCAL_SHUT_* */
+#endif
+
   /* Union of fields unique to SOCK_STREAM client, server, and connected
    * peers.
    */
@@ -671,6 +686,94 @@ int local_open_sender(FAR struct local_conn_s *conn, FAR const char *path,
                       bool nonblock);
 #endif
 
+/****************************************************************************
+ * Name: local_direct_connect
+ *
+ * Description:
+ *   Connect two SOCK_STREAM connections through in-memory receive buffers
+ *   instead of FIFOs.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_LOCAL_DIRECT
+int local_direct_connect(FAR struct local_conn_s *conn0,
+                         FAR struct local_conn_s *conn1);
+
+/****************************************************************************
+ * Name: local_direct_release
+ *
+ * Description:
+ *   Disconnect from the peer and free the receive buffer.
+ *
+ ****************************************************************************/
+
+void local_direct_release(FAR struct local_conn_s *conn);
+
+/****************************************************************************
+ * Name: local_direct_send
+ *
+ * Description:
+ *   Send stream data straight into the receive buffer of the peer.
+ *
+ ****************************************************************************/
+
+ssize_t local_direct_send(FAR struct local_conn_s *conn,
+                          FAR const struct iovec *buf, size_t iovcnt,
+                          int flags);
+
+/****************************************************************************
+ * Name: local_direct_recv
+ *
+ * Description:
+ *   Receive stream data from the receive buffer.
+ *
+ ****************************************************************************/
+
+ssize_t local_direct_recv(FAR struct local_conn_s *conn, FAR void *buf,
+                          size_t len, int flags);
+
+/****************************************************************************
+ * Name: local_direct_pollstate
+ *
+ * Description:
+ *   Return the poll events that are currently true for the connection.
+ *
+ ****************************************************************************/
+
+pollevent_t local_direct_pollstate(FAR struct local_conn_s *conn);
+
+/****************************************************************************
+ * Name: local_direct_shutdown
+ *
+ * Description:
+ *   Shut down one or both directions of a connection.
+ *
+ ****************************************************************************/
+
+int local_direct_shutdown(FAR struct local_conn_s *conn, int how);
+
+/****************************************************************************
+ * Name: local_direct_resize
+ *
+ * Description:
+ *   Change the size of the receive buffer of a connection.
+ *
+ ****************************************************************************/
+
+int local_direct_resize(FAR struct local_conn_s *conn, size_t size);
+
+/****************************************************************************
+ * Name: local_direct_ioctl
+ *
+ * Description:
+ *   Handle the FIONREAD, FIONWRITE and FIONSPACE ioctl commands.
+ *
+ ****************************************************************************/
+
+int local_direct_ioctl(FAR struct local_conn_s *conn, int cmd,
+                       unsigned long arg);
+#endif /* CONFIG_NET_LOCAL_DIRECT */
+
 /****************************************************************************
  * Name: local_event_pollnotify
  ****************************************************************************/
@@ -103,7 +103,9 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
   FAR struct local_conn_s *server = psock->s_conn;
   FAR struct local_conn_s *conn;
   FAR dq_entry_t *waiter;
+#ifndef CONFIG_NET_LOCAL_DIRECT
   bool nonblock = !!(flags & SOCK_NONBLOCK);
+#endif
   int ret = OK;
 
   /* Some sanity checks */
@@ -156,10 +158,12 @@ int local_accept(FAR struct socket *psock, FAR struct sockaddr *addr,
               ret = local_getaddr(conn->lc_peer, addr, addrlen);
             }
 
+#ifndef CONFIG_NET_LOCAL_DIRECT
           if (ret == OK && nonblock)
             {
               ret = local_set_nonblocking(conn);
             }
+#endif
 
           return ret;
         }
@@ -162,6 +162,11 @@ FAR struct local_conn_s *local_alloc(void)
       nxsem_init(&conn->lc_waitsem, 0, 0);
 #endif
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+      nxsem_init(&conn->lc_rxsem, 0, 0);
+      nxsem_init(&conn->lc_txsem, 0, 0);
+#endif
+
       /* This semaphore is used for sending safely in multithread.
        * Make sure data will not be garbled when multi-thread sends.
        */
@@ -223,6 +228,22 @@ int local_alloc_accept(FAR struct local_conn_s *server,
   strlcpy(conn->lc_path, server->lc_path, sizeof(conn->lc_path));
   conn->lc_instance_id = client->lc_instance_id;
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  /* The peers exchange data through their receive buffers, no FIFOs */
+
+  conn->lc_rcvsize = server->lc_rcvsize;
+  ret = local_direct_connect(conn, client);
+  if (ret < 0)
+    {
+      client->lc_peer = NULL;
+      conn->lc_peer   = NULL;
+      local_free(conn);
+      return ret;
+    }
+
+  *accept = conn;
+  return OK;
+#else
   /* Create the FIFOs needed for the connection */
 
   ret = local_create_fifos(conn, server->lc_rcvsize, client->lc_rcvsize);
@@ -274,6 +295,7 @@ errout_with_fifos:
 err:
   local_free(conn);
   return ret;
+#endif /* CONFIG_NET_LOCAL_DIRECT */
 }
 
 /****************************************************************************
@@ -300,6 +322,12 @@ void local_free(FAR struct local_conn_s *conn)
 
   dq_rem(&conn->lc_conn.node, &g_local_connections);
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  /* Wake up the peer, it sees the end of the stream now */
+
+  local_direct_release(conn);
+#endif
+
   if (conn->lc_peer)
     {
       conn->lc_peer->lc_peer = NULL;
@@ -338,11 +366,22 @@ void local_free(FAR struct local_conn_s *conn)
 
   /* Destroy all FIFOs associated with the connection */
 
-  local_release_fifos(conn);
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  if (conn->lc_proto != SOCK_STREAM)
+#endif
+    {
+      local_release_fifos(conn);
+    }
+
 #ifdef CONFIG_NET_LOCAL_STREAM
   nxsem_destroy(&conn->lc_waitsem);
 #endif
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  nxsem_destroy(&conn->lc_rxsem);
+  nxsem_destroy(&conn->lc_txsem);
+#endif
+
   /* Destroy sem associated with the connection */
 
   nxmutex_destroy(&conn->lc_sendlock);
@@ -0,0 +1,500 @@
+/****************************************************************************
+ * net/local/local_direct.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/circbuf.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+#include "local/local.h"
+
+#ifdef CONFIG_NET_LOCAL_DIRECT
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_direct_post
+ *
+ * Description:
+ *   Wake up a thread waiting on a connection semaphore, without letting
+ *   the count grow past one.
+ *
+ ****************************************************************************/
+
+static void local_direct_post(FAR sem_t *sem)
+{
+  int sval;
+
+  if (nxsem_get_value(sem, &sval) >= 0 && sval < 1)
+    {
+      nxsem_post(sem);
+    }
+}
+
+/****************************************************************************
+ * Name: local_direct_wait
+ *
+ * Description:
+ *   Wait on a connection semaphore with the network unlocked, honoring the
+ *   socket timeout.  A timeout is reported as -EAGAIN like on the other
+ *   socket types.
+ *
+ ****************************************************************************/
+
+static int local_direct_wait(FAR sem_t *sem, unsigned int timeout)
+{
+  int ret;
+
+  ret = net_sem_timedwait(sem, timeout);
+  return ret == -ETIMEDOUT ? -EAGAIN : ret;
+}
+
+/****************************************************************************
+ * Name: local_direct_writable
+ *
+ * Description:
+ *   Return the peer whose receive buffer the connection sends to, or NULL
+ *   if either side shut the direction down or the peer is gone.
+ *
+ ****************************************************************************/
+
+static FAR struct local_conn_s *
+local_direct_writable(FAR struct local_conn_s *conn)
+{
+  FAR struct local_conn_s *peer = conn->lc_peer;
+
+  if ((conn->lc_shutdown & LOCAL_SHUT_WR) != 0 || peer == NULL ||
+      (peer->lc_shutdown & LOCAL_SHUT_RD) != 0)
+    {
+      return NULL;
+    }
+
+  return peer;
+}
+
+/****************************************************************************
+ * Name: local_direct_eof
+ *
+ * Description:
+ *   Return true if no more data can arrive on the connection.
+ *
+ ****************************************************************************/
+
+static bool local_direct_eof(FAR struct local_conn_s *conn)
+{
+  return (conn->lc_shutdown & LOCAL_SHUT_RD) != 0 || conn->lc_peer == NULL ||
+         (conn->lc_peer->lc_shutdown & LOCAL_SHUT_WR) != 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: local_direct_connect
+ *
+ * Description:
+ *   Connect two stream connections to each other and allocate the receive
+ *   buffer of both, sized after their lc_rcvsize.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+int local_direct_connect(FAR struct local_conn_s *conn0,
+                         FAR struct local_conn_s *conn1)
+{
+  int ret;
+
+  ret = circbuf_resize(&conn0->lc_rxbuf, conn0->lc_rcvsize);
+  if (ret >= 0)
+    {
+      ret = circbuf_resize(&conn1->lc_rxbuf, conn1->lc_rcvsize);
+      if (ret < 0)
+        {
+          circbuf_uninit(&conn0->lc_rxbuf);
+        }
+    }
+
+  if (ret < 0)
+    {
+      nerr("ERROR: Failed to allocate the receive buffers: %d\n", ret);
+      return ret;
+    }
+
+  conn0->lc_peer = conn1;
+  conn1->lc_peer = conn0;
+  return OK;
+}
+
+/****************************************************************************
+ * Name: local_direct_release
+ *
+ * Description:
+ *   Disconnect the connection from its peer, wake up the threads of the
+ *   peer that wait for us and free the receive buffer.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+void local_direct_release(FAR struct local_conn_s *conn)
+{
+  FAR struct local_conn_s *peer = conn->lc_peer;
+
+  if (peer != NULL)
+    {
+      conn->lc_peer = NULL;
+      peer->lc_peer = NULL;
+
+      local_direct_post(&peer->lc_rxsem);
+      local_direct_post(&peer->lc_txsem);
+      local_event_pollnotify(peer, POLLIN | POLLHUP);
+    }
+
+  circbuf_uninit(&conn->lc_rxbuf);
+}
+
+/****************************************************************************
+ * Name: local_direct_send
+ *
+ * Description:
+ *   Copy the data straight into the receive buffer of the peer.  Blocking
+ *   sends wait until all data is queued, non-blocking sends queue what
+ *   fits.
+ *
+ * Returned Value:
+ *   The number of bytes queued on success; a negated errno value on
+ *   failure.
+ *
+ ****************************************************************************/
+
+ssize_t local_direct_send(FAR struct local_conn_s *conn,
+                          FAR const struct iovec *buf, size_t iovcnt,
+                          int flags)
+{
+  FAR const struct iovec *end = buf + iovcnt;
+  FAR struct local_conn_s *peer;
+  bool nonblock;
+  ssize_t nsent = 0;
+  size_t offset = 0;
+  size_t nbytes;
+  int ret = OK;
+
+  nonblock = _SS_ISNONBLOCK(conn->lc_conn.s_flags) ||
+             (flags & MSG_DONTWAIT) != 0;
+
+  ret = nxmutex_lock(&conn->lc_sendlock);
+  if (ret < 0)
+    {
+      return ret;
+    }
+
+  net_lock();
+
+  while (buf != end)
+    {
+      if (offset == buf->iov_len)
+        {
+          buf++;
+          offset = 0;
+          continue;
+        }
+
+      peer = local_direct_writable(conn);
+      if (peer == NULL)
+        {
+          ret = -EPIPE;
+          break;
+        }
+
+      nbytes = MIN(buf->iov_len - offset, circbuf_space(&peer->lc_rxbuf));
+      if (nbytes == 0)
+        {
+          if (nonblock)
+            {
+              ret = -EAGAIN;
+              break;
+            }
+
+          ret = local_direct_wait(&conn->lc_txsem,
+                                  _SO_TIMEOUT(conn->lc_conn.s_sndtimeo));
+          if (ret < 0)
+            {
+              break;
+            }
+
+          continue;
+        }
+
+      circbuf_write(&peer->lc_rxbuf,
+                    (FAR const uint8_t *)buf->iov_base + offset, nbytes);
+      offset += nbytes;
+      nsent  += nbytes;
+
+      local_direct_post(&peer->lc_rxsem);
+      local_event_pollnotify(peer, POLLIN);
+    }
+
+  net_unlock();
+  nxmutex_unlock(&conn->lc_sendlock);
+  return nsent > 0 ? nsent : ret;
+}
+
+/****************************************************************************
+ * Name: local_direct_recv
+ *
+ * Description:
+ *   Wait for data in the receive buffer and copy out what is there, up to
+ *   len bytes.
+ *
+ * Returned Value:
+ *   The number of bytes received, zero at the end of the stream, or a
+ *   negated errno value on failure.
+ *
+ ****************************************************************************/
+
+ssize_t local_direct_recv(FAR struct local_conn_s *conn, FAR void *buf,
+                          size_t len, int flags)
+{
+  FAR struct local_conn_s *peer;
+  ssize_t ret;
+
+  net_lock();
+
+  while (circbuf_is_empty(&conn->lc_rxbuf))
+    {
+      if (local_direct_eof(conn))
+        {
+          net_unlock();
+          return 0;
+        }
+
+      if (_SS_ISNONBLOCK(conn->lc_conn.s_flags) ||
+          (flags & MSG_DONTWAIT) != 0)
+        {
+          net_unlock();
+          return -EAGAIN;
+        }
+
+      ret = local_direct_wait(&conn->lc_rxsem,
+                              _SO_TIMEOUT(conn->lc_conn.s_rcvtimeo));
+      if (ret < 0)
+        {
+          net_unlock();
+          return ret;
+        }
+    }
+
+  if ((flags & MSG_PEEK) != 0)
+    {
+      ret = circbuf_peek(&conn->lc_rxbuf, buf, len);
+    }
+  else
+    {
+      ret = circbuf_read(&conn->lc_rxbuf, buf, len);
+
+      /* Room was made, let the peer go on sending */
+
+      peer = conn->lc_peer;
+      if (peer != NULL)
+        {
+          local_direct_post(&peer->lc_txsem);
+          local_event_pollnotify(peer, POLLOUT);
+        }
+    }
+
+  net_unlock();
+  return ret;
+}
+
+/****************************************************************************
+ * Name: local_direct_pollstate
+ *
+ * Description:
+ *   Return the poll events that are currently true for the connection.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+pollevent_t local_direct_pollstate(FAR struct local_conn_s *conn)
+{
+  FAR struct local_conn_s *peer;
+  pollevent_t eventset = 0;
+
+  if (!circbuf_is_empty(&conn->lc_rxbuf) || local_direct_eof(conn))
+    {
+      eventset |= POLLIN;
+    }
+
+  peer = local_direct_writable(conn);
+  if (peer != NULL && !circbuf_is_full(&peer->lc_rxbuf))
+    {
+      eventset |= POLLOUT;
+    }
+
+  if (conn->lc_peer == NULL)
+    {
+      eventset |= POLLHUP;
+    }
+
+  return eventset;
+}
+
+/****************************************************************************
+ * Name: local_direct_shutdown
+ *
+ * Description:
+ *   Shut down one or both directions and wake up the threads that wait
+ *   on them, on either side.
+ *
+ ****************************************************************************/
+
+int local_direct_shutdown(FAR struct local_conn_s *conn, int how)
+{
+  FAR struct local_conn_s *peer;
+
+  net_lock();
+
+  peer = conn->lc_peer;
+  if (how & SHUT_RD)
+    {
+      conn->lc_shutdown |= LOCAL_SHUT_RD;
+      local_direct_post(&conn->lc_rxsem);
+      if (peer != NULL)
+        {
+          local_direct_post(&peer->lc_txsem);
+          local_event_pollnotify(peer, POLLOUT);
+        }
+    }
+
+  if (how & SHUT_WR)
+    {
+      conn->lc_shutdown |= LOCAL_SHUT_WR;
+      local_direct_post(&conn->lc_txsem);
+      if (peer != NULL)
+        {
+          local_direct_post(&peer->lc_rxsem);
+          local_event_pollnotify(peer, POLLIN);
+        }
+    }
+
+  net_unlock();
+  return OK;
+}
+
+/****************************************************************************
+ * Name: local_direct_resize
+ *
+ * Description:
+ *   Change the size of the receive buffer of a connected stream
+ *   connection.  The buffer never shrinks below the data it holds.
+ *
+ * Assumptions:
+ *   This function must be called with the network locked.
+ *
+ ****************************************************************************/
+
+int local_direct_resize(FAR struct local_conn_s *conn, size_t size)
+{
+  int ret;
+
+  ret = circbuf_resize(&conn->lc_rxbuf,
+                       MAX(size, circbuf_used(&conn->lc_rxbuf)));
+  if (ret >= 0 && conn->lc_peer != NULL)
+    {
+      local_direct_post(&conn->lc_peer->lc_txsem);
+      local_event_pollnotify(conn->lc_peer, POLLOUT);
+    }
+
+  return ret;
+}
+
+/****************************************************************************
+ * Name: local_direct_ioctl
+ *
+ * Description:
+ *   Handle the buffer related ioctl commands of a connected stream
+ *   connection.  Returns -ENOTTY for the commands it does not handle.
+ *
+ ****************************************************************************/
+
+int local_direct_ioctl(FAR struct local_conn_s *conn, int cmd,
+                       unsigned long arg)
+{
+  FAR struct local_conn_s *peer;
+  int ret = OK;
+
+  net_lock();
+
+  switch (cmd)
+    {
+      case FIONREAD:
+        *(FAR int *)((uintptr_t)arg) = circbuf_used(&conn->lc_rxbuf);
+        break;
+
+      case FIONWRITE:
+      case FIONSPACE:
+        peer = conn->lc_peer;
+        if (peer == NULL)
+          {
+            ret = -ENOTCONN;
+          }
+        else if (cmd == FIONWRITE)
+          {
+            *(FAR int *)((uintptr_t)arg) = circbuf_used(&peer->lc_rxbuf);
+          }
+        else
+          {
+            *(FAR int *)((uintptr_t)arg) = circbuf_space(&peer->lc_rxbuf);
+          }
+        break;
+
+      default:
+        ret = -ENOTTY;
+        break;
+    }
+
+  net_unlock();
+  return ret;
+}
+
+#endif /* CONFIG_NET_LOCAL_DIRECT */
@@ -176,6 +176,23 @@ int local_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
       goto pollerr;
     }
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  /* Connected peers notify each other through the event slots */
+
+  if (conn->lc_state == LOCAL_STATE_CONNECTED)
+    {
+      ret = local_event_pollsetup(conn, fds, true);
+      if (ret >= 0)
+        {
+          net_lock();
+          poll_notify(&fds, 1, local_direct_pollstate(conn));
+          net_unlock();
+        }
+
+      return ret;
+    }
+#endif
+
   switch (fds->events & (POLLIN | POLLOUT))
     {
       case (POLLIN | POLLOUT):
@@ -314,7 +331,12 @@ int local_pollteardown(FAR struct socket *psock, FAR struct pollfd *fds)
     }
 
 #ifdef CONFIG_NET_LOCAL_STREAM
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  if (conn->lc_state == LOCAL_STATE_LISTENING ||
+      conn->lc_state == LOCAL_STATE_CONNECTED)
+#else
   if (conn->lc_state == LOCAL_STATE_LISTENING)
+#endif
     {
       return local_event_pollsetup(conn, fds, false);
     }
@@ -57,6 +57,7 @@
  *
  ****************************************************************************/
 
+#if !defined(CONFIG_NET_LOCAL_DIRECT) || defined(CONFIG_NET_LOCAL_DGRAM)
 static int psock_fifo_read(FAR struct socket *psock, FAR void *buf,
                            size_t offset, FAR size_t *readlen,
                            int flags, bool once)
@@ -123,6 +124,7 @@ static int psock_fifo_read(FAR struct socket *psock, FAR void *buf,
 
   return OK;
 }
+#endif
 
 /****************************************************************************
  * Name: local_recvctl
@@ -242,6 +244,15 @@ psock_stream_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
       return -ENOTCONN;
     }
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+  ret = local_direct_recv(conn, buf, len, flags);
+  if (ret <= 0)
+    {
+      return ret;
+    }
+
+  readlen = ret;
+#else
   /* Check shutdown state */
 
   if (conn->lc_infile.f_inode == NULL)
@@ -275,6 +286,7 @@ psock_stream_recvfrom(FAR struct socket *psock, FAR void *buf, size_t len,
     {
       return ret;
     }
+#endif /* CONFIG_NET_LOCAL_DIRECT */
 
   /* Return the address family */
 
@@ -197,6 +197,14 @@ static ssize_t local_send(FAR struct socket *psock,
               return -ENOTCONN;
             }
 
+#ifdef CONFIG_NET_LOCAL_DIRECT
+          if (psock->s_type == SOCK_STREAM)
+            {
+              ret = local_direct_send(conn, buf, len, flags);
+              break;
+            }
+#endif
+
           /* Check shutdown state */
 
           if (conn->lc_outfile.f_inode == NULL)
@@ -31,6 +31,7 @@
 
 #include <net/ethernet.h>
 
+#include <nuttx/queue.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/netdev.h>
 #include <nuttx/net/sixlowpan.h>
@@ -38,15 +39,46 @@
 
 #ifdef CONFIG_NET_IPv6
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* About two entries per hash chain when the table is full */
+
+#define NEIGHBOR_HASH_NBUCKETS (CONFIG_NET_IPv6_NCONF_MAXENTRIES / 2 + 1)
+
+#ifdef CONFIG_NET_STATISTICS
+#  define NEIGHBOR_STATS(f) (g_netstats.nd.f++)
+#else
+#  define NEIGHBOR_STATS(f)
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* One entry of the Neighbor table in use.  struct neighbor_entry_s is what
+ * netlink reports, the links are kept around it.
+ */
+
+struct neighbor_node_s
+{
+  dq_entry_t                  nn_node;  /* Link in the LRU list */
+  FAR struct neighbor_node_s *nn_hnext; /* Next entry in the hash chain */
+  struct neighbor_entry_s     nn_entry; /* The neighbor entry */
+};
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
 
-/* This is the Neighbor table.  The network should be locked when accessing
+/* This is the Neighbor table: the entries in use by IPv6 address hash and
+ * least recently used first.  The network should be locked when accessing
  * this table.
  */
 
-extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+extern FAR struct neighbor_node_s *g_neighbor_hash[NEIGHBOR_HASH_NBUCKETS];
+extern dq_queue_t g_neighbor_lru;
 
 /****************************************************************************
  * Public Function Prototypes
@@ -54,6 +86,45 @@ extern struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
 
 struct net_driver_s; /* Forward reference */
 
+/****************************************************************************
+ * Name: neighbor_hash
+ *
+ * Description:
+ *   Return the hash chain of the IPv6 address.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_node_s **neighbor_hash(const net_ipv6addr_t ipaddr);
+
+/****************************************************************************
+ * Name: neighbor_alloc
+ *
+ * Description:
+ *   Add a cleared entry for the IPv6 address to the Neighbor Table as the
+ *   most recently used one.  The entry is preallocated or allocated from
+ *   the heap while the table is below CONFIG_NET_IPv6_NCONF_MAXENTRIES,
+ *   otherwise the least recently used entry is reused.
+ *
+ * Input Parameters:
+ *   ipaddr - The IPv6 address of the new entry
+ *
+ * Returned Value:
+ *   The new entry; NULL if there is none.
+ *
+ ****************************************************************************/
+
+FAR struct neighbor_node_s *neighbor_alloc(const net_ipv6addr_t ipaddr);
+
+/****************************************************************************
+ * Name: neighbor_touch
+ *
+ * Description:
+ *   Make an entry the most recently used one.
+ *
+ ****************************************************************************/
+
+void neighbor_touch(FAR struct neighbor_node_s *node);
+
 /****************************************************************************
  * Name: neighbor_findentry
  *
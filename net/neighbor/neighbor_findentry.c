@@ -53,16 +53,14 @@
 
 FAR struct neighbor_entry_s *neighbor_findentry(const net_ipv6addr_t ipaddr)
 {
-  int i;
+  FAR struct neighbor_node_s *node;
 
-  for (i = 0; i < CONFIG_NET_IPv6_NCONF_ENTRIES; ++i)
+  for (node = *neighbor_hash(ipaddr); node != NULL; node = node->nn_hnext)
     {
-      FAR struct neighbor_entry_s *neighbor = &g_neighbors[i];
-
-      if (net_ipv6addr_cmp(neighbor->ne_ipaddr, ipaddr))
+      if (net_ipv6addr_cmp(node->nn_entry.ne_ipaddr, ipaddr))
         {
-          neighbor_dumpentry("Entry found", neighbor);
-          return neighbor;
+          neighbor_dumpentry("Entry found", &node->nn_entry);
+          return &node->nn_entry;
         }
     }
 
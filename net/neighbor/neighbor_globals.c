@@ -26,8 +26,25 @@
 
 #include <nuttx/config.h>
 
+#include <string.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/net/netstats.h>
+
+#include "netlink/netlink.h"
 #include "neighbor/neighbor.h"
 
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The preallocated entries, more entries are allocated from the heap up to
+ * CONFIG_NET_IPv6_NCONF_MAXENTRIES.
+ */
+
+static struct neighbor_node_s g_neighbor_pool[CONFIG_NET_IPv6_NCONF_ENTRIES];
+static unsigned int g_neighbor_nentries;
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -36,8 +53,96 @@
  * this table.
  */
 
-struct neighbor_entry_s g_neighbors[CONFIG_NET_IPv6_NCONF_ENTRIES];
+FAR struct neighbor_node_s *g_neighbor_hash[NEIGHBOR_HASH_NBUCKETS];
+dq_queue_t g_neighbor_lru;
 
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
+
+/****************************************************************************
+ * Name: neighbor_hash
+ ****************************************************************************/
+
+FAR struct neighbor_node_s **neighbor_hash(const net_ipv6addr_t ipaddr)
+{
+  uint32_t hash = 0;
+  int i;
+
+  for (i = 0; i < 8; i += 2)
+    {
+      hash ^= ((uint32_t)ipaddr[i] << 16) | ipaddr[i + 1];
+      hash *= 0x9e3779b1u;
+    }
+
+  return &g_neighbor_hash[hash % NEIGHBOR_HASH_NBUCKETS];
+}
+
+/****************************************************************************
+ * Name: neighbor_alloc
+ ****************************************************************************/
+
+FAR struct neighbor_node_s *neighbor_alloc(const net_ipv6addr_t ipaddr)
+{
+  FAR struct neighbor_node_s **pprev;
+  FAR struct neighbor_node_s *node = NULL;
+
+  if (g_neighbor_nentries < CONFIG_NET_IPv6_NCONF_ENTRIES)
+    {
+      node = &g_neighbor_pool[g_neighbor_nentries++];
+    }
+
+  if (node == NULL &&
+      g_neighbor_nentries < CONFIG_NET_IPv6_NCONF_MAXENTRIES)
+    {
+      node = kmm_zalloc(sizeof(struct neighbor_node_s));
+      if (node != NULL)
+        {
+          g_neighbor_nentries++;
+        }
+    }
+
+  if (node == NULL)
+    {
+      /* The table is full, reuse the least recently used entry.  When
+       * overwriting an old entry, need to notify RTM_DELNEIGH.
+       */
+
+      node = (FAR struct neighbor_node_s *)dq_remfirst(&g_neighbor_lru);
+      if (node == NULL)
+        {
+          return NULL;
+        }
+
+      netlink_neigh_notify(&node->nn_entry, RTM_DELNEIGH, AF_INET6);
+
+      pprev = neighbor_hash(node->nn_entry.ne_ipaddr);
+      while (*pprev != node)
+        {
+          pprev = &(*pprev)->nn_hnext;
+        }
+
+      *pprev = node->nn_hnext;
+      NEIGHBOR_STATS(evict);
+    }
+
+  memset(&node->nn_entry, 0, sizeof(node->nn_entry));
+  net_ipv6addr_copy(node->nn_entry.ne_ipaddr, ipaddr);
+
+  pprev          = neighbor_hash(ipaddr);
+  node->nn_hnext = *pprev;
+  *pprev         = node;
+
+  dq_addlast(&node->nn_node, &g_neighbor_lru);
+  return node;
+}
+
+/****************************************************************************
+ * Name: neighbor_touch
+ ****************************************************************************/
+
+void neighbor_touch(FAR struct neighbor_node_s *node)
+{
+  dq_rem(&node->nn_node, &g_neighbor_lru);
+  dq_addlast(&node->nn_node, &g_neighbor_lru);
+}
@@ -30,8 +30,10 @@
 #include <debug.h>
 #include <string.h>
 
+#include <nuttx/nuttx.h>
 #include <nuttx/net/ip.h>
 #include <nuttx/net/neighbor.h>
+#include <nuttx/net/netstats.h>
 
 #include "netdev/netdev.h"
 #include "neighbor/neighbor.h"
@@ -123,6 +125,10 @@ int neighbor_lookup(FAR const net_ipv6addr_t ipaddr,
   neighbor = neighbor_findentry(ipaddr);
   if (neighbor != NULL)
     {
+      NEIGHBOR_STATS(hit);
+      neighbor_touch(container_of(neighbor, struct neighbor_node_s,
+                                  nn_entry));
+
       /* Yes.. return the link layer address if the caller has provided a
        * non-NULL address in 'laddr'.
        */
@@ -154,5 +160,6 @@ int neighbor_lookup(FAR const net_ipv6addr_t ipaddr,
 
   /* Not found */
 
+  NEIGHBOR_STATS(miss);
   return -ENOENT;
 }
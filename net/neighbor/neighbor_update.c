@@ -26,6 +26,8 @@
 
 #include <nuttx/config.h>
 
+#include <nuttx/nuttx.h>
+
 #include "neighbor/neighbor.h"
 
 /****************************************************************************
@@ -56,5 +58,7 @@ void neighbor_update(const net_ipv6addr_t ipaddr)
   if (neighbor != NULL)
     {
       neighbor->ne_time = clock_systime_ticks();
+      neighbor_touch(container_of(neighbor, struct neighbor_node_s,
+                                  nn_entry));
     }
 }
@@ -526,6 +526,36 @@ void netdev_ipv6_removemcastmac(FAR struct net_driver_s *dev,
 #  define netdev_ipv6_removemcastmac(dev,addr)
 #endif
 
+/****************************************************************************
+ * Name: netdev_busypoll
+ *
+ * Description:
+ *   Poll the device for received packets on the calling CPU until the
+ *   semaphore is posted or the time budget is spent (SO_BUSY_POLL).
+ *
+ * Input Parameters:
+ *   dev     - The device to poll, NULL to poll all devices
+ *   sem     - The semaphore that is posted when the receive is complete
+ *   usec    - The time budget (in microseconds)
+ *   timeout - The receive timeout (in milliseconds), UINT_MAX if none.
+ *             The budget never exceeds it.
+ *
+ * Returned Value:
+ *   Zero (OK) when the caller should go on and wait for the semaphore.
+ *   -EINTR if a signal is pending for the calling thread.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_BUSY_POLL
+int netdev_busypoll(FAR struct net_driver_s *dev, FAR sem_t *sem,
+                    uint32_t usec, unsigned int timeout);
+#else
+#  define netdev_busypoll(dev,sem,usec,timeout) (OK)
+#endif
+
 #ifdef CONFIG_NETDEV_RSS
 void netdev_notify_recvcpu(FAR struct net_driver_s *dev,
                            int cpu, uint8_t domain,
@@ -0,0 +1,165 @@
+/****************************************************************************
+ * net/netdev/netdev_busypoll.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <limits.h>
+#include <errno.h>
+#include <time.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/queue.h>
+#include <nuttx/sched.h>
+#include <nuttx/semaphore.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/netdev.h>
+
+#include "netdev/netdev.h"
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_BUSY_POLL
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_busypoll_callback
+ *
+ * Description:
+ *   Let one device receive the packets that are waiting in its lower half.
+ *
+ ****************************************************************************/
+
+static int netdev_busypoll_callback(FAR struct net_driver_s *dev,
+                                    FAR void *arg)
+{
+  if (dev->d_rxpoll != NULL && IFF_IS_UP(dev->d_flags))
+    {
+      dev->d_rxpoll(dev);
+    }
+
+  return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: netdev_busypoll
+ *
+ * Description:
+ *   Poll the device for received packets on the calling CPU until the
+ *   semaphore is posted or the time budget is spent, instead of waiting
+ *   for the bottom half of the driver to run.  The network lock is given
+ *   up between two polls so that other tasks are not locked out.
+ *
+ * Input Parameters:
+ *   dev     - The device to poll, NULL to poll all devices
+ *   sem     - The semaphore that is posted when the receive is complete
+ *   usec    - The time budget (in microseconds)
+ *   timeout - The receive timeout (in milliseconds), UINT_MAX if none.
+ *             The budget never exceeds it.
+ *
+ * Returned Value:
+ *   Zero (OK) when the caller should go on and wait for the semaphore.
+ *   -EINTR if a signal is pending for the calling thread.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int netdev_busypoll(FAR struct net_driver_s *dev, FAR sem_t *sem,
+                    uint32_t usec, unsigned int timeout)
+{
+  struct timespec ts;
+  unsigned int count;
+  clock_t start;
+  int semcount;
+
+  if (timeout != UINT_MAX && (uint64_t)timeout * USEC_PER_MSEC < usec)
+    {
+      usec = timeout * USEC_PER_MSEC;
+    }
+
+  if (usec == 0)
+    {
+      return OK;
+    }
+
+  start = perf_gettime();
+  for (; ; )
+    {
+      /* Each check is repeated after the network lock was given up: the
+       * receive may have completed, a signal may have arrived and the
+       * device may have been brought down or unregistered meanwhile.
+       */
+
+      if (nxsem_get_value(sem, &semcount) == OK && semcount > 0)
+        {
+          break;
+        }
+
+      if (!sq_empty(&nxsched_self()->sigpendactionq))
+        {
+          return -EINTR;
+        }
+
+      if (dev != NULL)
+        {
+          if (!netdev_verify(dev) || !IFF_IS_UP(dev->d_flags))
+            {
+              break;
+            }
+
+          netdev_busypoll_callback(dev, NULL);
+        }
+      else
+        {
+          netdev_foreach(netdev_busypoll_callback, NULL);
+        }
+
+      perf_convert(perf_gettime() - start, &ts);
+      if ((uint64_t)ts.tv_sec * USEC_PER_SEC +
+          ts.tv_nsec / NSEC_PER_USEC >= usec)
+        {
+          break;
+        }
+
+      if (net_breaklock(&count) >= 0)
+        {
+          net_restorelock(count);
+        }
+    }
+
+  return OK;
+}
+
+#endif /* CONFIG_NET_BUSY_POLL */
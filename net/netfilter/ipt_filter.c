@@ -370,6 +370,7 @@ static void adjust_ipv4filter(FAR const struct ipt_replace *repl)
   FAR const uint8_t *head;
   enum ipfilter_chain_e chain;
   enum nf_inet_hooks hook;
+  uint32_t idx;
   size_t size;
 
   for (hook = NF_INET_LOCAL_IN; hook <= NF_INET_LOCAL_OUT; hook++)
@@ -388,11 +389,17 @@ static void adjust_ipv4filter(FAR const struct ipt_replace *repl)
 
       size++;
 
+      idx = 0;
       ipt_entry_for_every(entry, head, size)
         {
           FAR struct ipv4_filter_entry_s *filter = convert_ipv4entry(entry);
+
+          /* Remember the rule, entries that fail to convert are skipped */
+
+          idx++;
           if (filter != NULL)
             {
+              filter->common.srcidx = idx - 1;
               ipfilter_cfg_add(&filter->common, PF_INET, chain);
             }
           else
@@ -400,6 +407,8 @@ static void adjust_ipv4filter(FAR const struct ipt_replace *repl)
               nwarn("WARNING: Failed to convert entry!\n");
             }
         }
+
+      ipfilter_cfg_compile(PF_INET, chain);
     }
 }
 #endif
@@ -411,6 +420,7 @@ static void adjust_ipv6filter(FAR const struct ip6t_replace *repl)
   FAR const uint8_t *head;
   enum ipfilter_chain_e chain;
   enum nf_inet_hooks hook;
+  uint32_t idx;
   size_t size;
 
   for (hook = NF_INET_LOCAL_IN; hook <= NF_INET_LOCAL_OUT; hook++)
@@ -429,11 +439,17 @@ static void adjust_ipv6filter(FAR const struct ip6t_replace *repl)
 
       size++;
 
+      idx = 0;
       ip6t_entry_for_every(entry, head, size)
         {
           FAR struct ipv6_filter_entry_s *filter = convert_ipv6entry(entry);
+
+          /* Remember the rule, entries that fail to convert are skipped */
+
+          idx++;
           if (filter != NULL)
             {
+              filter->common.srcidx = idx - 1;
               ipfilter_cfg_add(&filter->common, PF_INET6, chain);
             }
           else
@@ -441,6 +457,8 @@ static void adjust_ipv6filter(FAR const struct ip6t_replace *repl)
               nwarn("WARNING: Failed to convert entry!\n");
             }
         }
+
+      ipfilter_cfg_compile(PF_INET6, chain);
     }
 }
 #endif
@@ -599,3 +617,94 @@ int ip6t_filter_apply(FAR const struct ip6t_replace *repl)
   return OK;
 }
 #endif
+
+/****************************************************************************
+ * Name: ipt_filter_counters
+ *
+ * Description:
+ *   Copy the hit counters of the filter rules into the table data.
+ *
+ * Input Parameters:
+ *   repl - The table data applied last.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPv4
+void ipt_filter_counters(FAR struct ipt_replace *repl)
+{
+  FAR struct ipfilter_entry_s *filter;
+  FAR struct ipt_entry *entry;
+  FAR uint8_t *head;
+  enum nf_inet_hooks hook;
+  uint32_t idx;
+  size_t size;
+
+  /* The entries of a hook were added to its chain in order, including the
+   * underflow entry, but the ones that failed to convert are missing; map
+   * the counters through the index of the source rule, see
+   * adjust_ipv4filter().
+   */
+
+  for (hook = NF_INET_LOCAL_IN; hook <= NF_INET_LOCAL_OUT; hook++)
+    {
+      filter = ipfilter_cfg_head(PF_INET, convert_chain(hook));
+      head   = (FAR uint8_t *)repl->entries + repl->hook_entry[hook];
+      size   = repl->underflow[hook] - repl->hook_entry[hook] + 1;
+      idx    = 0;
+
+      ipt_entry_for_every(entry, head, size)
+        {
+          if (filter != NULL && filter->srcidx == idx)
+            {
+              entry->counters.pcnt = filter->pcnt;
+              entry->counters.bcnt = filter->bcnt;
+              filter = filter->flink;
+            }
+          else
+            {
+              entry->counters.pcnt = 0;
+              entry->counters.bcnt = 0;
+            }
+
+          idx++;
+        }
+    }
+}
+#endif
+
+#ifdef CONFIG_NET_IPv6
+void ip6t_filter_counters(FAR struct ip6t_replace *repl)
+{
+  FAR struct ipfilter_entry_s *filter;
+  FAR struct ip6t_entry *entry;
+  FAR uint8_t *head;
+  enum nf_inet_hooks hook;
+  uint32_t idx;
+  size_t size;
+
+  for (hook = NF_INET_LOCAL_IN; hook <= NF_INET_LOCAL_OUT; hook++)
+    {
+      filter = ipfilter_cfg_head(PF_INET6, convert_chain(hook));
+      head   = (FAR uint8_t *)repl->entries + repl->hook_entry[hook];
+      size   = repl->underflow[hook] - repl->hook_entry[hook] + 1;
+      idx    = 0;
+
+      ip6t_entry_for_every(entry, head, size)
+        {
+          if (filter != NULL && filter->srcidx == idx)
+            {
+              entry->counters.pcnt = filter->pcnt;
+              entry->counters.bcnt = filter->bcnt;
+              filter = filter->flink;
+            }
+          else
+            {
+              entry->counters.pcnt = 0;
+              entry->counters.bcnt = 0;
+            }
+
+          idx++;
+        }
+    }
+}
+#endif
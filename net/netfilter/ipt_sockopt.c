@@ -47,7 +47,8 @@
  ****************************************************************************/
 
 /* Structure to store all info we need, including table data and
- * init/apply functions.
+ * init/apply functions, and optionally a function to update the counters
+ * in the table data.
  */
 
 struct ipt_table_s
@@ -55,6 +56,7 @@ struct ipt_table_s
   FAR struct ipt_replace *repl;
   FAR struct ipt_replace *(*init_func)(void);
   FAR int (*apply_func)(FAR const struct ipt_replace *);
+  CODE void (*counters_func)(FAR struct ipt_replace *);
 };
 
 /* Following structs represent the layout of an entry with standard/error
@@ -85,7 +87,7 @@ static struct ipt_table_s g_tables[] =
   {NULL, ipt_nat_init, ipt_nat_apply},
 #endif
 #ifdef CONFIG_NET_IPFILTER
-  {NULL, ipt_filter_init, ipt_filter_apply},
+  {NULL, ipt_filter_init, ipt_filter_apply, ipt_filter_counters},
 #endif
 };
 
@@ -200,6 +202,7 @@ static int get_info(FAR struct ipt_getinfo *get, FAR socklen_t *len)
 
 static int get_entries(FAR struct ipt_get_entries *get, FAR socklen_t *len)
 {
+  FAR struct ipt_table_s *table;
   FAR struct ipt_replace *repl;
 
   if (*len < sizeof(*get) || *len != sizeof(*get) + get->size)
@@ -207,17 +210,23 @@ static int get_entries(FAR struct ipt_get_entries *get, FAR socklen_t *len)
       return -EINVAL;
     }
 
-  repl = ipt_table_repl(get->name);
-  if (repl == NULL)
+  table = ipt_table(get->name);
+  if (table == NULL || table->repl == NULL)
     {
       return -ENOENT;
     }
 
+  repl = table->repl;
   if (get->size != repl->size)
     {
       return -EAGAIN;
     }
 
+  if (table->counters_func != NULL)
+    {
+      table->counters_func(repl);
+    }
+
   memcpy(get->entrytable, repl->entries, get->size);
 
   return OK;
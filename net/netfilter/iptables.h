@@ -163,5 +163,25 @@ int ip6t_filter_apply(FAR const struct ip6t_replace *repl);
 #  endif
 #endif
 
+/****************************************************************************
+ * Name: ipt_filter_counters
+ *
+ * Description:
+ *   Copy the hit counters of the filter rules into the table data.
+ *
+ * Input Parameters:
+ *   repl - The table data applied last.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_IPFILTER
+#  ifdef CONFIG_NET_IPv4
+void ipt_filter_counters(FAR struct ipt_replace *repl);
+#  endif
+#  ifdef CONFIG_NET_IPv6
+void ip6t_filter_counters(FAR struct ip6t_replace *repl);
+#  endif
+#endif
+
 #endif /* CONFIG_NET_IPTABLES */
 #endif /* __NET_NETFILTER_IPTABLES_H */
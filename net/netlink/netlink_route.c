@@ -540,7 +540,7 @@ static size_t netlink_fill_arptable(
 
   net_lock();
   ncopied = arp_snapshot((FAR struct arpreq *)(*entry)->payload.data,
-                         CONFIG_NET_ARPTAB_SIZE);
+                         CONFIG_NET_ARPTAB_MAXSIZE);
   net_unlock();
 
   /* Now we have the real number of valid entries in the ARP table and
@@ -594,7 +594,7 @@ static size_t netlink_fill_nbtable(
   net_lock();
   ncopied = neighbor_snapshot(
                       (FAR struct neighbor_entry_s *)(*entry)->payload.data,
-                      CONFIG_NET_IPv6_NCONF_ENTRIES);
+                      CONFIG_NET_IPv6_NCONF_MAXENTRIES);
   net_unlock();
 
   /* Now we have the real number of valid entries in the Neighbor table
@@ -653,7 +653,7 @@ netlink_get_neighbor(FAR const void *neigh, int domain, int type,
 #if defined(CONFIG_NET_ARP)
   if (domain == AF_INET)
     {
-      tabnum  = req ? CONFIG_NET_ARPTAB_SIZE : 1;
+      tabnum  = req ? CONFIG_NET_ARPTAB_MAXSIZE : 1;
       tabsize = tabnum * sizeof(struct arpreq);
     }
   else
@@ -661,7 +661,7 @@ netlink_get_neighbor(FAR const void *neigh, int domain, int type,
 #if defined(CONFIG_NET_IPv6)
   if (domain == AF_INET6)
     {
-      tabnum  = req ? CONFIG_NET_IPv6_NCONF_ENTRIES : 1;
+      tabnum  = req ? CONFIG_NET_IPv6_NCONF_MAXENTRIES : 1;
       tabsize = tabnum * sizeof(struct neighbor_entry_s);
     }
   else
@@ -122,22 +122,22 @@ static const struct netprocfs_entry_s g_net_entries[] =
     }
   },
 #  endif
-#  ifdef NET_TCP_HAVE_STACK
+#  ifdef NET_UDP_HAVE_STACK
   {
-    DTYPE_FILE, "tcp",
+    DTYPE_FILE, "udp",
     {
-      netprocfs_read_tcpstats
+      netprocfs_read_udpstats
     }
   },
 #  endif
-#  ifdef NET_UDP_HAVE_STACK
+#endif
+#ifdef NET_TCP_HAVE_STACK
   {
-    DTYPE_FILE, "udp",
+    DTYPE_FILE, "tcp",
     {
-      netprocfs_read_udpstats
+      netprocfs_read_tcpstats
     }
   },
-#  endif
 #endif
 #ifdef CONFIG_NET_ROUTE
   {
@@ -33,6 +33,7 @@
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 
 #include <nuttx/net/netstats.h>
 
@@ -46,9 +47,9 @@
 #ifdef NET_TCP_HAVE_STACK
 
 #ifdef CONFIG_NET_IPv6
-#  define TCP_LINELEN 180
+#  define TCP_LINELEN 210
 #else
-#  define TCP_LINELEN 120
+#  define TCP_LINELEN 150
 #endif
 
 /****************************************************************************
@@ -64,6 +65,7 @@ static ssize_t netprocfs_tcpstats(FAR struct netprocfs_file_s *priv,
   FAR struct tcp_conn_s *conn = NULL;
   char remote[INET6_ADDRSTRLEN];
   char local[INET6_ADDRSTRLEN];
+  struct tcp_info info;
   int len = 0;
   FAR void *laddr;
   FAR void *raddr;
@@ -91,6 +93,7 @@ static ssize_t netprocfs_tcpstats(FAR struct netprocfs_file_s *priv,
 
       laddr = net_ip_binding_laddr(&conn->u, domain);
       raddr = net_ip_binding_raddr(&conn->u, domain);
+      tcp_getinfo(conn, &info);
 
       len += snprintf(buffer + len, buflen - len,
                       "    %2" PRIu8
@@ -102,7 +105,9 @@ static ssize_t netprocfs_tcpstats(FAR struct netprocfs_file_s *priv,
 #if CONFIG_NET_SEND_BUFSIZE > 0
                       " %6" PRIu32
 #endif
-                      " %6u",
+                      " %6" PRIu32
+                      " %6" PRIu32 " %10" PRIu32
+                      " %5" PRIu32 " %3" PRIu32,
                       priv->offset++,
                       conn->tcpstateflags,
                       conn->sconn.s_flags,
@@ -113,7 +118,11 @@ static ssize_t netprocfs_tcpstats(FAR struct netprocfs_file_s *priv,
 #if CONFIG_NET_SEND_BUFSIZE > 0
                       tcp_wrbuffer_inqueue_size(conn),
 #endif
-                      (conn->readahead) ? conn->readahead->io_pktlen : 0);
+                      info.tcpi_rcv_buf,
+                      info.tcpi_snd_cwnd,
+                      info.tcpi_snd_ssthresh,
+                      (uint32_t)(info.tcpi_rtt / USEC_PER_MSEC),
+                      info.tcpi_ofo_segs);
 
       len += snprintf(buffer + len, buflen - len,
                       " %*s:%-6" PRIu16 " %*s:%-6" PRIu16 "\n",
@@ -164,20 +173,36 @@ ssize_t netprocfs_read_tcpstats(FAR struct netprocfs_file_s *priv,
     {
       if (priv->offset == 0)
         {
+          /* The numeric column titles use the same field widths as the
+           * values printed by netprocfs_tcpstats().
+           */
+
           len = snprintf(buffer, buflen, "TCP sl  "
-                                         "st flg ref tmr uack nrt   "
+                                         "st flg ref tmr uack nrt"
+#if CONFIG_NET_SEND_BUFSIZE > 0
+                                         " %6s"
+#endif
+                                         " %6s"
+                                         " %6s"
+                                         " %10s"
+                                         " %5s"
+                                         " %3s"
+                                         " %-*s"
+                                         " %-*s\n"
+                                         ,
 #if CONFIG_NET_SEND_BUFSIZE > 0
-                                          "txsz   "
+                                         "txsz",
 #endif
-                                          "rxsz "
-                                          "%-*s "
-                                          "%-*s\n"
-                                          ,
-                                          INET6_ADDRSTRLEN / 2,
-                                          "local_address",
-                                          INET6_ADDRSTRLEN / 2,
-                                          "remote_address"
-                                          );
+                                         "rxsz",
+                                         "cwnd",
+                                         "ssth",
+                                         "rtt",
+                                         "ofo",
+                                         INET6_ADDRSTRLEN / 2,
+                                         "local_address",
+                                         INET6_ADDRSTRLEN / 2,
+                                         "remote_address"
+                                         );
           priv->offset = 1;
         }
 
@@ -0,0 +1,111 @@
+/****************************************************************************
+ * net/route/fibroute.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __NET_ROUTE_FIBROUTE_H
+#define __NET_ROUTE_FIBROUTE_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+
+#include <nuttx/net/ip.h>
+
+#ifdef CONFIG_ROUTE_FIB
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#ifdef __cplusplus
+#define EXTERN extern "C"
+extern "C"
+{
+#else
+#define EXTERN extern
+#endif
+
+/****************************************************************************
+ * Name: net_fibupdate_ipv4 and net_fibupdate_ipv6
+ *
+ * Description:
+ *   Rebuild the longest prefix match index from the in-memory routing
+ *   table and publish it.  Lookups that still use the previous index are
+ *   waited for before it is freed.  Must be called after every change of
+ *   the routing table, without holding the network lock.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+void net_fibupdate_ipv4(void);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+void net_fibupdate_ipv6(void);
+#endif
+
+/****************************************************************************
+ * Name: net_fiblookup_ipv4 and net_fiblookup_ipv6
+ *
+ * Description:
+ *   Find the router of the longest prefix that matches the target in the
+ *   index.  The lookup takes no lock and visits at most one index node per
+ *   four address bits, whatever the size of the routing table.
+ *
+ * Input Parameters:
+ *   target    - An IP address on a remote network to use in the lookup.
+ *   router    - The address of router on a local network that can forward
+ *               our packets to the target.
+ *   prefixlen - Only match prefixes longer than prefixlen.
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if no route matched; -EAGAIN if there is no
+ *   index (it could not be allocated) and the table has to be searched.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_fiblookup_ipv4(in_addr_t target, FAR in_addr_t *router,
+                       int8_t prefixlen);
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_fiblookup_ipv6(const net_ipv6addr_t target, net_ipv6addr_t router,
+                       int16_t prefixlen);
+#endif
+
+#undef EXTERN
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CONFIG_ROUTE_FIB */
+#endif /* __NET_ROUTE_FIBROUTE_H */
@@ -37,6 +37,7 @@
 #include <arch/irq.h>
 
 #include "netlink/netlink.h"
+#include "route/fibroute.h"
 #include "route/ramroute.h"
 #include "route/route.h"
 
@@ -91,6 +92,11 @@ int net_addroute_ipv4(in_addr_t target, in_addr_t netmask, in_addr_t router)
   net_unlock();
 
   netlink_route_notify(route, RTM_NEWROUTE, AF_INET);
+
+#ifdef CONFIG_ROUTE_FIB
+  net_fibupdate_ipv4();
+#endif
+
   return OK;
 }
 #endif
@@ -128,6 +134,11 @@ int net_addroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask,
   net_unlock();
 
   netlink_route_notify(route, RTM_NEWROUTE, AF_INET6);
+
+#ifdef CONFIG_ROUTE_FIB
+  net_fibupdate_ipv6();
+#endif
+
   return OK;
 }
 #endif
@@ -35,6 +35,7 @@
 #include <nuttx/net/ip.h>
 
 #include "netlink/netlink.h"
+#include "route/fibroute.h"
 #include "route/ramroute.h"
 #include "route/route.h"
 
@@ -210,6 +211,7 @@ static int net_del_ipv6route(FAR struct net_route_ipv6_s *route,
 int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 {
   struct route_match_ipv4_s match;
+  int ret;
 
   /* Set up the comparison structure */
 
@@ -219,7 +221,16 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 
   /* Then remove the entry from the routing table */
 
-  return net_foreachroute_ipv4(net_del_ipv4route, &match) ? OK : -ENOENT;
+  ret = net_foreachroute_ipv4(net_del_ipv4route, &match) ? OK : -ENOENT;
+
+#ifdef CONFIG_ROUTE_FIB
+  if (ret == OK)
+    {
+      net_fibupdate_ipv4();
+    }
+#endif
+
+  return ret;
 }
 #endif
 
@@ -227,6 +238,7 @@ int net_delroute_ipv4(in_addr_t target, in_addr_t netmask)
 int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
 {
   struct route_match_ipv6_s match;
+  int ret;
 
   /* Set up the comparison structure */
 
@@ -236,7 +248,16 @@ int net_delroute_ipv6(net_ipv6addr_t target, net_ipv6addr_t netmask)
 
   /* Then remove the entry from the routing table */
 
-  return net_foreachroute_ipv6(net_del_ipv6route, &match) ? OK : -ENOENT;
+  ret = net_foreachroute_ipv6(net_del_ipv6route, &match) ? OK : -ENOENT;
+
+#ifdef CONFIG_ROUTE_FIB
+  if (ret == OK)
+    {
+      net_fibupdate_ipv6();
+    }
+#endif
+
+  return ret;
 }
 #endif
 
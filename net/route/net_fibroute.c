@@ -0,0 +1,565 @@
+/****************************************************************************
+ * net/route/net_fibroute.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <nuttx/atomic.h>
+#include <nuttx/clock.h>
+#include <nuttx/kmalloc.h>
+#include <nuttx/mutex.h>
+#include <nuttx/signal.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/net/net.h>
+#include <nuttx/net/ip.h>
+
+#include "route/fibroute.h"
+#include "route/ramroute.h"
+#include "utils/utils.h"
+
+#ifdef CONFIG_ROUTE_FIB
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Every index node resolves four bits of the address */
+
+#define ROUTE_FIB_STRIDE 4
+#define ROUTE_FIB_FANOUT (1 << ROUTE_FIB_STRIDE)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* The index is a multibit trie.  The prefixes of length (4k, 4k + 4] are
+ * expanded into all the slots they cover in the nodes of level k, so a
+ * lookup takes the route of the deepest slot on its path that has one.
+ * The default route lives in the root slot.
+ */
+
+struct route_fib_node_s;
+
+struct route_fib_slot_s
+{
+  FAR struct route_fib_node_s *child; /* The next level, NULL if none */
+  uint16_t route;                     /* 1 + index of the route, or 0 */
+  uint8_t prefixlen;                  /* The prefix length of the route */
+};
+
+struct route_fib_node_s
+{
+  FAR struct route_fib_node_s *flink; /* The next node of the index */
+  struct route_fib_slot_s slot[ROUTE_FIB_FANOUT];
+};
+
+struct route_fib_s
+{
+  FAR struct route_fib_node_s *nodes; /* All nodes, for freeing */
+  struct route_fib_slot_s root;       /* The default route and level 0 */
+  FAR uint8_t *routers;               /* The router of every route */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Serializes the index updates */
+
+static mutex_t g_fib_lock = NXMUTEX_INITIALIZER;
+
+/* The lookups in progress, counted in the slot of the epoch they started
+ * in.  An update flips the epoch twice and waits for the slot it left to
+ * drain each time, after which no lookup can still see the old index.
+ */
+
+static atomic_t g_fib_epoch;
+static atomic_t g_fib_readers[2];
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+static FAR struct route_fib_s *volatile g_ipv4_fib;
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+static FAR struct route_fib_s *volatile g_ipv6_fib;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: route_fib_nibble
+ *
+ * Description:
+ *   Return the level'th group of four bits of a network order address.
+ *
+ ****************************************************************************/
+
+static inline unsigned int route_fib_nibble(FAR const uint8_t *addr,
+                                            unsigned int level)
+{
+  return (addr[level >> 1] >> ((level & 1) ? 0 : 4)) & 0xf;
+}
+
+/****************************************************************************
+ * Name: route_fib_alloc and route_fib_free
+ ****************************************************************************/
+
+static FAR struct route_fib_s *route_fib_alloc(unsigned int nroutes,
+                                               size_t addrlen)
+{
+  FAR struct route_fib_s *fib;
+
+  if (nroutes > UINT16_MAX)
+    {
+      return NULL;
+    }
+
+  fib = kmm_zalloc(sizeof(struct route_fib_s) + nroutes * addrlen);
+  if (fib != NULL)
+    {
+      fib->routers = (FAR uint8_t *)(fib + 1);
+    }
+
+  return fib;
+}
+
+static void route_fib_free(FAR struct route_fib_s *fib)
+{
+  FAR struct route_fib_node_s *node;
+
+  if (fib != NULL)
+    {
+      while ((node = fib->nodes) != NULL)
+        {
+          fib->nodes = node->flink;
+          kmm_free(node);
+        }
+
+      kmm_free(fib);
+    }
+}
+
+/****************************************************************************
+ * Name: route_fib_insert
+ *
+ * Description:
+ *   Add one route to an index that is not published yet.  Of two routes
+ *   with the same prefix the first one is kept, as the table search does.
+ *
+ ****************************************************************************/
+
+static int route_fib_insert(FAR struct route_fib_s *fib,
+                            FAR const uint8_t *target, uint8_t prefixlen,
+                            uint16_t route)
+{
+  FAR struct route_fib_slot_s *slot = &fib->root;
+  FAR struct route_fib_node_s *node;
+  unsigned int level;
+  unsigned int first;
+  unsigned int span;
+  unsigned int i;
+
+  if (prefixlen == 0)
+    {
+      if (slot->route == 0)
+        {
+          slot->route = route;
+        }
+
+      return OK;
+    }
+
+  for (level = 0; ; level++)
+    {
+      if (slot->child == NULL)
+        {
+          node = kmm_zalloc(sizeof(struct route_fib_node_s));
+          if (node == NULL)
+            {
+              return -ENOMEM;
+            }
+
+          node->flink = fib->nodes;
+          fib->nodes  = node;
+          slot->child = node;
+        }
+
+      node = slot->child;
+      if (prefixlen <= (level + 1) * ROUTE_FIB_STRIDE)
+        {
+          break;
+        }
+
+      slot = &node->slot[route_fib_nibble(target, level)];
+    }
+
+  /* Expand the prefix into all slots it covers at this level */
+
+  span  = 1 << ((level + 1) * ROUTE_FIB_STRIDE - prefixlen);
+  first = route_fib_nibble(target, level) & ~(span - 1);
+
+  for (i = first; i < first + span; i++)
+    {
+      slot = &node->slot[i];
+      if (slot->route == 0 || slot->prefixlen < prefixlen)
+        {
+          slot->route     = route;
+          slot->prefixlen = prefixlen;
+        }
+    }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: route_fib_lookup
+ *
+ * Description:
+ *   Return the longest prefix route of the address (0 if none) and its
+ *   prefix length.  Deeper levels only hold longer prefixes, so the last
+ *   route met on the way down is the one.
+ *
+ ****************************************************************************/
+
+static uint16_t route_fib_lookup(FAR const struct route_fib_s *fib,
+                                 FAR const uint8_t *addr,
+                                 FAR uint8_t *prefixlen)
+{
+  FAR const struct route_fib_slot_s *slot = &fib->root;
+  uint16_t route = slot->route;
+  unsigned int level = 0;
+
+  *prefixlen = 0;
+  while (slot->child != NULL)
+    {
+      slot = &slot->child->slot[route_fib_nibble(addr, level++)];
+      if (slot->route != 0)
+        {
+          route      = slot->route;
+          *prefixlen = slot->prefixlen;
+        }
+    }
+
+  return route;
+}
+
+/****************************************************************************
+ * Name: route_fib_enter and route_fib_leave
+ *
+ * Description:
+ *   Bracket a lookup, see g_fib_readers.
+ *
+ ****************************************************************************/
+
+static inline int route_fib_enter(void)
+{
+  int epoch = atomic_read(&g_fib_epoch) & 1;
+
+  atomic_fetch_add(&g_fib_readers[epoch], 1);
+  UP_DMB();
+  return epoch;
+}
+
+static inline void route_fib_leave(int epoch)
+{
+  atomic_fetch_sub(&g_fib_readers[epoch], 1);
+}
+
+/****************************************************************************
+ * Name: route_fib_synchronize
+ *
+ * Description:
+ *   Wait until no lookup can use an index that was just replaced.  The
+ *   network lock is released while waiting, as with net_sem_wait().
+ *
+ ****************************************************************************/
+
+static void route_fib_synchronize(void)
+{
+  unsigned int count;
+  int blresult;
+  int epoch;
+  int i;
+
+  blresult = net_breaklock(&count);
+
+  UP_DMB();
+  for (i = 0; i < 2; i++)
+    {
+      epoch = atomic_fetch_add(&g_fib_epoch, 1) & 1;
+      while (atomic_read(&g_fib_readers[epoch]) != 0)
+        {
+          nxsig_usleep(USEC_PER_TICK);
+        }
+    }
+
+  if (blresult >= 0)
+    {
+      net_restorelock(count);
+    }
+}
+
+/****************************************************************************
+ * Name: route_fib_publish
+ *
+ * Description:
+ *   Replace an index and free the old one once no lookup uses it anymore.
+ *   Called with the network lock and g_fib_lock held.
+ *
+ ****************************************************************************/
+
+static void route_fib_publish(FAR struct route_fib_s *volatile *pfib,
+                              FAR struct route_fib_s *fib)
+{
+  FAR struct route_fib_s *old = *pfib;
+
+  /* Make the index visible only once it is complete */
+
+  UP_DMB();
+  *pfib = fib;
+
+  if (old != NULL)
+    {
+      route_fib_synchronize();
+      route_fib_free(old);
+    }
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_fibupdate_ipv4 and net_fibupdate_ipv6
+ *
+ * Description:
+ *   Rebuild the longest prefix match index from the in-memory routing
+ *   table and publish it.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   None
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+void net_fibupdate_ipv4(void)
+{
+  FAR struct net_route_ipv4_entry_s *entry;
+  FAR struct route_fib_s *fib;
+  unsigned int nroutes = 0;
+  uint16_t route = 0;
+  in_addr_t target;
+
+  /* The caller may already hold the network lock, so take it first and
+   * release it while waiting for another update.
+   */
+
+  net_lock();
+  net_mutex_lock(&g_fib_lock);
+
+  for (entry = g_ipv4_routes.head; entry != NULL; entry = entry->flink)
+    {
+      nroutes++;
+    }
+
+  fib = route_fib_alloc(nroutes, sizeof(in_addr_t));
+  for (entry = g_ipv4_routes.head; fib != NULL && entry != NULL;
+       entry = entry->flink)
+    {
+      target = entry->entry.target & entry->entry.netmask;
+      memcpy(fib->routers + route * sizeof(in_addr_t),
+             &entry->entry.router, sizeof(in_addr_t));
+
+      if (route_fib_insert(fib, (FAR const uint8_t *)&target,
+                           net_ipv4_mask2pref(entry->entry.netmask),
+                           ++route) < 0)
+        {
+          route_fib_free(fib);
+          fib = NULL;
+        }
+    }
+
+  if (fib == NULL)
+    {
+      nerr("ERROR: No memory for the IPv4 route index\n");
+    }
+
+  route_fib_publish(&g_ipv4_fib, fib);
+  nxmutex_unlock(&g_fib_lock);
+  net_unlock();
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+void net_fibupdate_ipv6(void)
+{
+  FAR struct net_route_ipv6_entry_s *entry;
+  FAR struct route_fib_s *fib;
+  unsigned int nroutes = 0;
+  uint16_t route = 0;
+  net_ipv6addr_t target;
+  int i;
+
+  /* The caller may already hold the network lock, so take it first and
+   * release it while waiting for another update.
+   */
+
+  net_lock();
+  net_mutex_lock(&g_fib_lock);
+
+  for (entry = g_ipv6_routes.head; entry != NULL; entry = entry->flink)
+    {
+      nroutes++;
+    }
+
+  fib = route_fib_alloc(nroutes, sizeof(net_ipv6addr_t));
+  for (entry = g_ipv6_routes.head; fib != NULL && entry != NULL;
+       entry = entry->flink)
+    {
+      for (i = 0; i < 8; i++)
+        {
+          target[i] = entry->entry.target[i] & entry->entry.netmask[i];
+        }
+
+      memcpy(fib->routers + route * sizeof(net_ipv6addr_t),
+             entry->entry.router, sizeof(net_ipv6addr_t));
+
+      if (route_fib_insert(fib, (FAR const uint8_t *)target,
+                           net_ipv6_mask2pref(entry->entry.netmask),
+                           ++route) < 0)
+        {
+          route_fib_free(fib);
+          fib = NULL;
+        }
+    }
+
+  if (fib == NULL)
+    {
+      nerr("ERROR: No memory for the IPv6 route index\n");
+    }
+
+  route_fib_publish(&g_ipv6_fib, fib);
+  nxmutex_unlock(&g_fib_lock);
+  net_unlock();
+}
+#endif
+
+/****************************************************************************
+ * Name: net_fiblookup_ipv4 and net_fiblookup_ipv6
+ *
+ * Description:
+ *   Find the router of the longest prefix that matches the target in the
+ *   index.
+ *
+ * Input Parameters:
+ *   target    - An IP address on a remote network to use in the lookup.
+ *   router    - The address of router on a local network that can forward
+ *               our packets to the target.
+ *   prefixlen - Only match prefixes longer than prefixlen.
+ *
+ * Returned Value:
+ *   OK on success; -ENOENT if no route matched; -EAGAIN if there is no
+ *   index and the table has to be searched.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_ROUTE_IPv4_RAMROUTE
+int net_fiblookup_ipv4(in_addr_t target, FAR in_addr_t *router,
+                       int8_t prefixlen)
+{
+  FAR struct route_fib_s *fib;
+  uint8_t matchlen;
+  uint16_t route;
+  int epoch;
+  int ret = -EAGAIN;
+
+  epoch = route_fib_enter();
+  fib   = g_ipv4_fib;
+  if (fib != NULL)
+    {
+      route = route_fib_lookup(fib, (FAR const uint8_t *)&target,
+                               &matchlen);
+      if (route != 0 && matchlen > prefixlen)
+        {
+          memcpy(router, fib->routers + (route - 1) * sizeof(in_addr_t),
+                 sizeof(in_addr_t));
+          ret = OK;
+        }
+      else
+        {
+          ret = -ENOENT;
+        }
+    }
+
+  route_fib_leave(epoch);
+  return ret;
+}
+#endif
+
+#ifdef CONFIG_ROUTE_IPv6_RAMROUTE
+int net_fiblookup_ipv6(const net_ipv6addr_t target, net_ipv6addr_t router,
+                       int16_t prefixlen)
+{
+  FAR struct route_fib_s *fib;
+  uint8_t matchlen;
+  uint16_t route;
+  int epoch;
+  int ret = -EAGAIN;
+
+  epoch = route_fib_enter();
+  fib   = g_ipv6_fib;
+  if (fib != NULL)
+    {
+      route = route_fib_lookup(fib, (FAR const uint8_t *)target,
+                               &matchlen);
+      if (route != 0 && matchlen > prefixlen)
+        {
+          memcpy(router,
+                 fib->routers + (route - 1) * sizeof(net_ipv6addr_t),
+                 sizeof(net_ipv6addr_t));
+          ret = OK;
+        }
+      else
+        {
+          ret = -ENOENT;
+        }
+    }
+
+  route_fib_leave(epoch);
+  return ret;
+}
+#endif
+
+#endif /* CONFIG_ROUTE_FIB */
@@ -36,6 +36,7 @@
 
 #include "devif/devif.h"
 #include "route/cacheroute.h"
+#include "route/fibroute.h"
 #include "route/route.h"
 #include "utils/utils.h"
 
@@ -264,6 +265,16 @@ int net_ipv4_router(in_addr_t target, FAR in_addr_t *router,
       return -ENOENT;
     }
 
+#if defined(CONFIG_ROUTE_FIB) && defined(CONFIG_ROUTE_IPv4_RAMROUTE)
+  /* Try the longest prefix match index first */
+
+  ret = net_fiblookup_ipv4(target, router, prefixlen);
+  if (ret != -EAGAIN)
+    {
+      return ret;
+    }
+#endif
+
   /* Set up the comparison structure */
 
   memset(&match, 0, sizeof(struct route_ipv4_match_s));
@@ -358,6 +369,16 @@ int net_ipv6_router(const net_ipv6addr_t target, net_ipv6addr_t router,
       return -ENOENT;
     }
 
+#if defined(CONFIG_ROUTE_FIB) && defined(CONFIG_ROUTE_IPv6_RAMROUTE)
+  /* Try the longest prefix match index first */
+
+  ret = net_fiblookup_ipv6(target, router, prefixlen);
+  if (ret != -EAGAIN)
+    {
+      return ret;
+    }
+#endif
+
   /* Set up the comparison structure */
 
   memset(&match, 0, sizeof(struct route_ipv6_match_s));
@@ -149,6 +149,9 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
       case SO_REUSEADDR:  /* Allow reuse of local addresses */
 #ifdef CONFIG_NET_TIMESTAMP
       case SO_TIMESTAMP:  /* Generates a timestamp for each incoming packet */
+#endif
+#ifdef CONFIG_NET_ZEROCOPY
+      case SO_ZEROCOPY:   /* Allows MSG_ZEROCOPY sends */
 #endif
         {
           sockopt_t optionset;
@@ -174,6 +177,20 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
         }
         break;
 
+#ifdef CONFIG_NET_BUSY_POLL
+      case SO_BUSY_POLL:  /* Poll the device before a receive blocks */
+        {
+          if (*value_len < sizeof(int))
+            {
+              return -EINVAL;
+            }
+
+          *(FAR int *)value = conn->s_busypoll;
+          *value_len        = sizeof(int);
+        }
+        break;
+#endif
+
       case SO_TYPE:       /* Reports the socket type */
         {
           /* Verify that option is the size of an 'int'.  Should also check
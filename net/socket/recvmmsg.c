@@ -0,0 +1,197 @@
+/****************************************************************************
+ * net/socket/recvmmsg.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <errno.h>
+
+#include <nuttx/cancelpt.h>
+#include <nuttx/clock.h>
+#include <nuttx/fs/fs.h>
+#include <nuttx/net/net.h>
+
+#include "socket/socket.h"
+
+#ifdef CONFIG_NET
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: psock_recvmmsg
+ *
+ * Description:
+ *   psock_recvmmsg() receives up to vlen messages with one call.  For
+ *   internet and packet sockets the network lock is held across the
+ *   batch, so the per message receives only nest it; a receive that
+ *   blocks still releases it.  This is an internal OS interface.  It is
+ *   functionally equivalent to recvmmsg() except that:
+ *
+ *   - It is not a cancellation point,
+ *   - It does not modify the errno variable, and
+ *   - It accepts the internal socket structure as an input rather than an
+ *     task-specific socket descriptor.
+ *
+ * Input Parameters:
+ *   psock     A pointer to a NuttX-specific, internal socket structure
+ *   msgvec    The messages to receive, msg_len returns the bytes of each
+ *   vlen      The number of messages in msgvec
+ *   flags     Receive flags, MSG_WAITFORONE makes all but the first
+ *             receive non-blocking
+ *   timeout   If not NULL, stop once this time passed.  As on Linux it
+ *             is checked after each received message only.
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received.  If no message
+ *   could be received, a negated errno value is returned (see comments
+ *   with recvmsg() for a list of appropriate errno values).
+ *
+ ****************************************************************************/
+
+int psock_recvmmsg(FAR struct socket *psock, FAR struct mmsghdr *msgvec,
+                   unsigned int vlen, int flags,
+                   FAR struct timespec *timeout)
+{
+  struct timespec deadline;
+  struct timespec now;
+  unsigned int i;
+  ssize_t ret = OK;
+  bool batch;
+
+  if ((msgvec == NULL && vlen > 0) ||
+      (timeout != NULL && (timeout->tv_sec < 0 || timeout->tv_nsec < 0 ||
+                           timeout->tv_nsec >= NSEC_PER_SEC)))
+    {
+      return -EINVAL;
+    }
+
+  if (timeout != NULL)
+    {
+      clock_systime_timespec(&now);
+      clock_timespec_add(&now, timeout, &deadline);
+    }
+
+  batch = psock != NULL && _SO_BATCH_NETLOCK(psock);
+  if (batch)
+    {
+      net_lock();
+    }
+
+  for (i = 0; i < vlen; i++)
+    {
+      ret = psock_recvmsg(psock, &msgvec[i].msg_hdr,
+                          flags & ~MSG_WAITFORONE);
+      if (ret < 0)
+        {
+          break;
+        }
+
+      msgvec[i].msg_len = ret;
+
+      if ((flags & MSG_WAITFORONE) != 0)
+        {
+          flags |= MSG_DONTWAIT;
+        }
+
+      if (timeout != NULL)
+        {
+          clock_systime_timespec(&now);
+          if (clock_timespec_compare(&now, &deadline) >= 0)
+            {
+              i++;
+              break;
+            }
+        }
+    }
+
+  if (batch)
+    {
+      net_unlock();
+    }
+
+  /* An error is only reported if no message was received at all */
+
+  return i > 0 ? (int)i : (int)ret;
+}
+
+/****************************************************************************
+ * Function: recvmmsg
+ *
+ * Description:
+ *   The recvmmsg() call receives multiple messages from a socket with a
+ *   single call, as if recvmsg() was called for each of them.
+ *
+ * Parameters:
+ *   sockfd   Socket descriptor of socket
+ *   msgvec   The messages to receive, msg_len returns the bytes of each
+ *   vlen     The number of messages in msgvec
+ *   flags    Receive flags, MSG_WAITFORONE makes all but the first receive
+ *            non-blocking
+ *   timeout  If not NULL, stop once this time passed
+ *
+ * Returned Value:
+ *   On success, returns the number of messages received in msgvec.  If no
+ *   message could be received, -1 is returned, and errno is set as for
+ *   recvmsg().
+ *
+ ****************************************************************************/
+
+int recvmmsg(int sockfd, FAR struct mmsghdr *msgvec, unsigned int vlen,
+             int flags, FAR struct timespec *timeout)
+{
+  FAR struct socket *psock;
+  FAR struct file *filep;
+  int ret;
+
+  /* recvmmsg() is a cancellation point */
+
+  enter_cancellation_point();
+
+  /* Get the underlying socket structure */
+
+  ret = sockfd_socket(sockfd, &filep, &psock);
+
+  /* Let psock_recvmmsg() do all of the work */
+
+  if (ret == OK)
+    {
+      ret = psock_recvmmsg(psock, msgvec, vlen, flags, timeout);
+      file_put(filep);
+    }
+
+  if (ret < 0)
+    {
+      set_errno(-ret);
+      ret = ERROR;
+    }
+
+  leave_cancellation_point();
+  return ret;
+}
+
+#endif /* CONFIG_NET */
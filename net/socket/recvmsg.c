@@ -34,6 +34,7 @@
 #include <nuttx/net/net.h>
 
 #include "socket/socket.h"
+#include "utils/utils.h"
 
 #ifdef CONFIG_NET
 
@@ -76,13 +77,25 @@ ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
   FAR void *msg_control;
   int ret;
 
-  /* Verify that non-NULL pointers were passed */
+  /* Verify that non-NULL pointers were passed.  MSG_ERRQUEUE returns no
+   * data, only control messages.
+   */
 
-  if (msg == NULL || msg->msg_iov == NULL || msg->msg_iov->iov_base == NULL)
+  if (msg == NULL)
     {
       return -EINVAL;
     }
 
+#ifdef CONFIG_NET_ZEROCOPY
+  if ((flags & MSG_ERRQUEUE) == 0)
+#endif
+    {
+      if (msg->msg_iov == NULL || msg->msg_iov->iov_base == NULL)
+        {
+          return -EINVAL;
+        }
+    }
+
   if (msg->msg_name != NULL && msg->msg_namelen <= 0)
     {
       return -EINVAL;
@@ -107,7 +120,18 @@ ssize_t psock_recvmsg(FAR struct socket *psock, FAR struct msghdr *msg,
   msg_control         = msg->msg_control;
   msg_controllen      = msg->msg_controllen;
 
-  ret = psock->s_sockif->si_recvmsg(psock, msg, flags);
+#ifdef CONFIG_NET_ZEROCOPY
+  /* The error queue holds the completions of MSG_ZEROCOPY sends */
+
+  if ((flags & MSG_ERRQUEUE) != 0)
+    {
+      ret = net_zcopy_recverr(psock, msg);
+    }
+  else
+#endif
+    {
+      ret = psock->s_sockif->si_recvmsg(psock, msg, flags);
+    }
 
   /* Recover the pointer and calculate the cmsg's true data length */
 
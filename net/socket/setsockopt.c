@@ -28,6 +28,7 @@
 #if defined(CONFIG_NET) && defined(CONFIG_NET_SOCKOPTS)
 
 #include <sys/types.h>
+#include <sys/param.h>
 #include <sys/socket.h>
 #include <sys/time.h>
 #include <errno.h>
@@ -139,6 +140,9 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
       case SO_REUSEADDR:  /* Allow reuse of local addresses */
 #ifdef CONFIG_NET_TIMESTAMP
       case SO_TIMESTAMP:  /* Generates a timestamp for each incoming packet */
+#endif
+#ifdef CONFIG_NET_ZEROCOPY
+      case SO_ZEROCOPY:   /* Allows MSG_ZEROCOPY sends */
 #endif
         {
           int setting;
@@ -222,6 +226,27 @@ static int psock_socketlevel_option(FAR struct socket *psock, int option,
         }
 #endif
 
+#ifdef CONFIG_NET_BUSY_POLL
+      case SO_BUSY_POLL:  /* Poll the device before a receive blocks */
+        {
+          int usec;
+
+          if (value_len != sizeof(int))
+            {
+              return -EINVAL;
+            }
+
+          usec = *(FAR const int *)value;
+          if (usec < 0)
+            {
+              return -EINVAL;
+            }
+
+          conn->s_busypoll = MIN(usec, CONFIG_NET_BUSY_POLL_MAX);
+        }
+        break;
+#endif
+
       /* There options are only valid when used with getopt */
 
       case SO_ACCEPTCONN: /* Reports whether socket listening is enabled */
@@ -66,10 +66,12 @@
 #define _SO_TYPE         _SO_BIT(SO_TYPE)
 #define _SO_TIMESTAMP    _SO_BIT(SO_TIMESTAMP)
 #define _SO_BINDTODEVICE _SO_BIT(SO_BINDTODEVICE)
+#define _SO_ZEROCOPY     _SO_BIT(SO_ZEROCOPY)
+#define _SO_BUSY_POLL    _SO_BIT(SO_BUSY_POLL)
 
 /* This is the largest option value.  REVISIT: belongs in sys/socket.h */
 
-#define _SO_MAXOPT       (18)
+#define _SO_MAXOPT       (20)
 
 /* Macros to set, test, clear options */
 
@@ -123,6 +125,15 @@
 #  define _SO_SETERRNO(s,e)
 #endif /* CONFIG_NET_SOCKOPTS */
 
+/* The address families whose send and receive paths block only in
+ * net_sem_wait() and friends, which release the network lock.  Batched
+ * sends and receives on them may hold the lock across the whole batch.
+ */
+
+#define _SO_BATCH_NETLOCK(s) \
+  ((s)->s_domain == PF_INET || (s)->s_domain == PF_INET6 || \
+   (s)->s_domain == PF_PACKET)
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
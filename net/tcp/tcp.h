@@ -105,6 +105,7 @@
 #define TCP_WSCALE            0x01U /* Window Scale option enabled */
 #define TCP_SACK              0x02U /* Selective ACKs enabled */
 #define TCP_CLOSE_ARRANGED    0x04U /* Connection is arranged to be freed */
+#define TCP_TSTAMP            0x20U /* Timestamps option enabled */
 
 #ifdef CONFIG_NET_TCP_CC_NEWRENO
 /* The TCP flags for congestion control */
@@ -118,6 +119,20 @@
 
 #define TCP_SACK_RANGES_MAX   4
 
+/* The timestamps option: its size in every segment of a connection and
+ * the timestamp clock (units: milliseconds).  The timestamp of the peer
+ * is considered too old for PAWS after 24 days of idle (RFC 7323, 5.5).
+ */
+
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+#  define TCP_TSOPT_LEN(conn) \
+     (((conn)->flags & TCP_TSTAMP) ? TCP_OPT_TS_ALIGNED_LEN : 0)
+#  define TCP_TSCLOCK()       ((uint32_t)TICK2MSEC(clock_systime_ticks()))
+#  define TCP_PAWS_IDLE       (24 * 24 * 3600 * (clock_t)TICK_PER_SEC)
+#else
+#  define TCP_TSOPT_LEN(conn) 0
+#endif
+
 /* After receiving 3 duplicate ACKs, TCP performs a retransmission
  * (RFC 5681 (3.2))
  */
@@ -135,6 +150,7 @@ struct file;      /* Forward reference */
 struct sockaddr;  /* Forward reference */
 struct socket;    /* Forward reference */
 struct pollfd;    /* Forward reference */
+struct tcp_info;  /* Forward reference */
 
 /* Representation of a TCP connection.
  *
@@ -149,6 +165,90 @@ struct net_driver_s;      /* Forward reference */
 struct devif_callback_s;  /* Forward reference */
 struct tcp_backlog_s;     /* Forward reference */
 struct tcp_hdr_s;         /* Forward reference */
+struct tcp_conn_s;        /* Forward reference */
+
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+/* What an ACK of new data tells the congestion control.  The RTT and the
+ * delivery rate are sampled once per round trip, from the first segment
+ * sent after the previous sample; they are zero on the other ACKs.
+ */
+
+struct tcp_cc_sample_s
+{
+  uint32_t acked;         /* Number of bytes newly ACKed */
+  uint32_t rtt;           /* Round trip time (microseconds), or 0 */
+  uint32_t rate;          /* Delivery rate over that round trip (bytes/s),
+                           * or 0 */
+};
+
+/* A congestion control algorithm.  The common code in tcp_cc.c counts the
+ * duplicate ACKs and runs fast retransmit and fast recovery (RFC 6582);
+ * the algorithm decides how cwnd grows and where it restarts after a loss.
+ */
+
+struct tcp_cc_ops_s
+{
+  FAR const char *name;   /* Name used with the TCP_CONGESTION option */
+
+  /* Reset the private state of the algorithm (optional) */
+
+  CODE void (*init)(FAR struct tcp_conn_s *conn);
+
+  /* Return the ssthresh to use after a fast retransmit or a retransmission
+   * timeout.
+   */
+
+  CODE uint32_t (*ssthresh)(FAR struct tcp_conn_s *conn);
+
+  /* Grow cwnd when new data is ACKed outside of fast recovery */
+
+  CODE void (*cong_avoid)(FAR struct tcp_conn_s *conn,
+                          FAR const struct tcp_cc_sample_s *rs);
+
+  /* Look at every ACK of new data, also in fast recovery (optional) */
+
+  CODE void (*sample)(FAR struct tcp_conn_s *conn,
+                      FAR const struct tcp_cc_sample_s *rs);
+};
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+/* CUBIC (RFC 8312) private state */
+
+struct tcp_cubic_s
+{
+  uint32_t wmax;          /* cwnd before the last reduction */
+  uint32_t k;             /* Time to grow back to wmax (milliseconds) */
+  uint32_t minrtt;        /* Smallest RTT seen (microseconds) */
+  clock_t  epoch;         /* Start of the growth epoch, 0 if none */
+};
+#endif
+
+#ifdef CONFIG_NET_TCP_CC_BBR
+/* The number of round trips the bottleneck bandwidth is the maximum of */
+
+#  define TCP_BBR_BWROUNDS  10
+
+/* BBR private state */
+
+struct tcp_bbr_s
+{
+  uint32_t round;         /* Round trips counted so far */
+  uint32_t minrtt;        /* Min RTT of the last 10 seconds (usec) */
+  clock_t  minrtt_stamp;  /* When minrtt was taken */
+  clock_t  cycle_stamp;   /* Start of the current gain cycle phase */
+  clock_t  probertt_done; /* End of the PROBE_RTT phase */
+  uint32_t full_bw;       /* Bandwidth at the last STARTUP growth */
+  uint32_t prior_cwnd;    /* cwnd before PROBE_RTT */
+  uint8_t  full_cnt;      /* Rounds without STARTUP growth */
+  uint8_t  mode;          /* STARTUP, DRAIN, PROBE_BW or PROBE_RTT */
+  uint8_t  cycle;         /* Index into the PROBE_BW gain cycle */
+
+  /* Delivery rate of the last rounds */
+
+  uint32_t bw[TCP_BBR_BWROUNDS];
+};
+#endif
+#endif /* CONFIG_NET_TCP_CC_NEWRENO */
 
 /* This is a container that holds the poll-related information */
 
@@ -252,6 +352,37 @@ struct tcp_conn_s
   uint32_t cwnd;          /* The Congestion window */
   uint32_t max_cwnd;      /* The Congestion window maximum value */
   uint32_t ssthresh;      /* The Slow start threshold */
+
+  /* The congestion control algorithm and the RTT and delivery rate
+   * sampling (one timed segment per round trip).
+   */
+
+  FAR const struct tcp_cc_ops_s *cc_ops;
+  uint32_t cc_delivered;  /* Number of bytes ACKed so far */
+  uint32_t cc_rtseq;      /* End of the segment being timed */
+  uint32_t cc_rtdlvd;     /* cc_delivered when cc_rtseq was sent */
+  clock_t  cc_rttime;     /* When cc_rtseq was sent */
+  bool     cc_rtvalid;    /* A segment is being timed */
+#ifdef CONFIG_NET_TCP_CC_PACING
+  uint32_t cc_pacing;     /* Pacing rate (bytes/s), 0 if not paced */
+  uint32_t cc_credit;     /* Bytes that may be sent right now */
+  clock_t  cc_pacetime;   /* When cc_credit was updated */
+
+  /* Polls the device again when the pacing rate allows to send */
+
+  struct work_s cc_pacework;
+#endif
+
+  union
+  {
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+    struct tcp_cubic_s cubic;
+#endif
+#ifdef CONFIG_NET_TCP_CC_BBR
+    struct tcp_bbr_s bbr;
+#endif
+    uint32_t none;
+  } cc;
 #endif
 #ifdef CONFIG_NET_TCP_WINDOW_SCALE
   uint32_t snd_wnd;       /* Sequence and acknowledgement numbers of last
@@ -278,6 +409,12 @@ struct tcp_conn_s
   uint16_t tx_unacked;    /* Number bytes sent but not yet ACKed */
 #endif
   uint16_t flags;         /* Flags of TCP-specific options */
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+  uint32_t ts_recent;     /* The timestamp of the peer to echo */
+  clock_t  ts_stamp;      /* When ts_recent was taken */
+  uint32_t srtt;          /* Smoothed RTT (units: 1/8 milliseconds) */
+  uint32_t rttvar;        /* RTT variation (units: 1/4 milliseconds) */
+#endif
 #ifdef CONFIG_NET_SOLINGER
   sclock_t ltimeout;      /* Linger timeout expiration */
 #endif
@@ -2207,6 +2344,49 @@ void tcp_sendbuffer_notify(FAR struct tcp_conn_s *conn);
 
 uint16_t tcpip_hdrsize(FAR struct tcp_conn_s *conn);
 
+/****************************************************************************
+ * Name: tcp_update_rto
+ *
+ * Description:
+ *   Update the smoothed RTT, the RTT variation and the retransmission
+ *   timeout with an RTT sample (RFC 6298).
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   rtt    - The RTT sample (units: milliseconds)
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+void tcp_update_rto(FAR struct tcp_conn_s *conn, uint32_t rtt);
+#endif
+
+/****************************************************************************
+ * Name: tcp_getinfo
+ *
+ * Description:
+ *   Fill a struct tcp_info with the state of a TCP connection.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *   info - The location to return the information
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_getinfo(FAR struct tcp_conn_s *conn, FAR struct tcp_info *info);
+
 /****************************************************************************
  * Name: tcp_ofoseg_bufsize
  *
@@ -2308,7 +2488,123 @@ void tcp_cc_update(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp);
  ****************************************************************************/
 
 void tcp_cc_recv_ack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp);
+
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Update the congestion control variables after a retransmission
+ *   timeout.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn);
+
+/****************************************************************************
+ * Name: tcp_cc_sent
+ *
+ * Description:
+ *   Account for a segment sent from the write buffers: start timing it if
+ *   no segment is timed yet and charge it to the pacing budget.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   seq    - The sequence number of the segment
+ *   len    - The length of the segment
+ *   rexmit - True if the segment is retransmitted
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_sent(FAR struct tcp_conn_s *conn, uint32_t seq, uint32_t len,
+                 bool rexmit);
+
+/****************************************************************************
+ * Name: tcp_cc_pace
+ *
+ * Description:
+ *   Check whether the pacing rate allows to send len bytes now.  If not,
+ *   arrange for the device to be polled again when it does.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   len    - The length of the segment to send
+ *
+ * Returned Value:
+ *   True if the segment may be sent now.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC_PACING
+bool tcp_cc_pace(FAR struct tcp_conn_s *conn, uint32_t len);
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_stop
+ *
+ * Description:
+ *   Cancel the pending work of the congestion control when the connection
+ *   is freed.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC_PACING
+void tcp_cc_stop(FAR struct tcp_conn_s *conn);
+#else
+#  define tcp_cc_stop(conn)
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_setalgo
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by name
+ *   (TCP_CONGESTION socket option).
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   name   - The name of the algorithm, not necessarily NUL terminated
+ *   len    - The maximum length of the name
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if there is no such algorithm.
+ *
+ ****************************************************************************/
+
+int tcp_cc_setalgo(FAR struct tcp_conn_s *conn, FAR const char *name,
+                   size_t len);
+
+/****************************************************************************
+ * Name: tcp_cc_getalgo
+ *
+ * Description:
+ *   Return the name of the congestion control algorithm of a connection.
+ *
+ ****************************************************************************/
+
+FAR const char *tcp_cc_getalgo(FAR struct tcp_conn_s *conn);
+
+/* The congestion control algorithms */
+
+extern const struct tcp_cc_ops_s g_tcp_cc_newreno;
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+extern const struct tcp_cc_ops_s g_tcp_cc_cubic;
+#endif
+#ifdef CONFIG_NET_TCP_CC_BBR
+extern const struct tcp_cc_ops_s g_tcp_cc_bbr;
 #endif
+#endif /* CONFIG_NET_TCP_CC_NEWRENO */
 
 #ifdef __cplusplus
 }
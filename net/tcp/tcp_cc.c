@@ -24,8 +24,17 @@
  * Included Files
  ****************************************************************************/
 
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
 #include <debug.h>
+#include <errno.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/wqueue.h>
 
+#include "netdev/netdev.h"
 #include "tcp/tcp.h"
 
 /****************************************************************************
@@ -74,10 +83,187 @@
     } \
  } while(0)
 
+/* The algorithm new connections start with */
+
+#if defined(CONFIG_NET_TCP_CC_DEFAULT_CUBIC)
+#  define TCP_CC_DEFAULT (&g_tcp_cc_cubic)
+#elif defined(CONFIG_NET_TCP_CC_DEFAULT_BBR)
+#  define TCP_CC_DEFAULT (&g_tcp_cc_bbr)
+#else
+#  define TCP_CC_DEFAULT (&g_tcp_cc_newreno)
+#endif
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static uint32_t tcp_newreno_ssthresh(FAR struct tcp_conn_s *conn);
+static void tcp_newreno_cong_avoid(FAR struct tcp_conn_s *conn,
+                                   FAR const struct tcp_cc_sample_s *rs);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_newreno =
+{
+  "reno",                       /* name */
+  NULL,                         /* init */
+  tcp_newreno_ssthresh,         /* ssthresh */
+  tcp_newreno_cong_avoid,       /* cong_avoid */
+  NULL                          /* sample */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static FAR const struct tcp_cc_ops_s * const g_tcp_cc_algos[] =
+{
+  &g_tcp_cc_newreno,
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+  &g_tcp_cc_cubic,
+#endif
+#ifdef CONFIG_NET_TCP_CC_BBR
+  &g_tcp_cc_bbr,
+#endif
+};
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: tcp_newreno_ssthresh
+ *
+ * Description:
+ *   ssthresh = max (FlightSize / 2, 2*SMSS) referring to rfc5681
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_newreno_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  return MAX(conn->tx_unacked / 2, 2 * conn->mss);
+}
+
+/****************************************************************************
+ * Name: tcp_newreno_cong_avoid
+ *
+ * Description:
+ *   Slow start and congestion avoidance of RFC 5681.
+ *
+ ****************************************************************************/
+
+static void tcp_newreno_cong_avoid(FAR struct tcp_conn_s *conn,
+                                   FAR const struct tcp_cc_sample_s *rs)
+{
+  uint32_t increase;
+
+  if (conn->cwnd < conn->ssthresh)
+    {
+      /* slow start (RFC 5681):
+       * Grow cwnd exponentially by maxseg(smss) per ACK.
+       */
+
+      increase = rs->acked > 0 ? MIN(rs->acked, conn->mss) : conn->mss;
+
+      CC_CWND_INC(conn->cwnd, increase);
+      ninfo("update slow start cwnd to %u\n", conn->cwnd);
+    }
+  else
+    {
+      /* cong avoid (RFC 5681):
+       * Grow cwnd linearly by approximately maxseg per RTT using
+       * maxseg^2 / cwnd per ACK as the increment.
+       * If cwnd > maxseg^2, fix the cwnd increment at 1 byte to
+       * avoid capping cwnd.
+       */
+
+      increase = MAX((conn->mss * conn->mss / conn->cwnd), 1);
+
+      CC_CWND_INC(conn->cwnd, increase);
+      conn->cwnd = MIN(conn->cwnd, conn->max_cwnd);
+      ninfo("update congestion avoidance cwnd to %u\n", conn->cwnd);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_find
+ *
+ * Description:
+ *   Look up a congestion control algorithm by name.
+ *
+ ****************************************************************************/
+
+static FAR const struct tcp_cc_ops_s *tcp_cc_find(FAR const char *name,
+                                                  size_t len)
+{
+  int i;
+
+  for (i = 0; i < nitems(g_tcp_cc_algos); i++)
+    {
+      if (strlen(g_tcp_cc_algos[i]->name) == len &&
+          strncmp(g_tcp_cc_algos[i]->name, name, len) == 0)
+        {
+          return g_tcp_cc_algos[i];
+        }
+    }
+
+  return NULL;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_reset
+ *
+ * Description:
+ *   Reset the state shared by all algorithms and the private state of the
+ *   selected one.
+ *
+ ****************************************************************************/
+
+static void tcp_cc_reset(FAR struct tcp_conn_s *conn)
+{
+  conn->cc_rtvalid = false;
+#ifdef CONFIG_NET_TCP_CC_PACING
+  conn->cc_pacing  = 0;
+  conn->cc_credit  = 0;
+#endif
+
+  memset(&conn->cc, 0, sizeof(conn->cc));
+  if (conn->cc_ops->init != NULL)
+    {
+      conn->cc_ops->init(conn);
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_cc_pace_work
+ *
+ * Description:
+ *   Poll the device again when the pacing rate allows to send more.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC_PACING
+static void tcp_cc_pace_work(FAR void *arg)
+{
+  FAR struct tcp_conn_s *conn = NULL;
+
+  net_lock();
+
+  while ((conn = tcp_nextconn(conn)) != NULL)
+    {
+      if (conn == arg)
+        {
+          netdev_txnotify_dev(conn->dev);
+          break;
+        }
+    }
+
+  net_unlock();
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -103,6 +289,15 @@
 
 void tcp_cc_init(FAR struct tcp_conn_s *conn)
 {
+  /* Keep the algorithm chosen with TCP_CONGESTION or inherited from the
+   * listener.
+   */
+
+  if (conn->cc_ops == NULL)
+    {
+      conn->cc_ops = TCP_CC_DEFAULT;
+    }
+
   CC_INIT_CWND(conn->cwnd, conn->mss);
 
   /* RFC 5681 recommends setting ssthresh arbitrarily high and
@@ -117,6 +312,9 @@ void tcp_cc_init(FAR struct tcp_conn_s *conn)
 
   conn->ssthresh = 2 * TCP_IPV4_DEFAULT_MSS;
   conn->dupacks = 0;
+  conn->cc_delivered = 0;
+
+  tcp_cc_reset(conn);
 }
 
 /****************************************************************************
@@ -140,16 +338,16 @@ void tcp_cc_init(FAR struct tcp_conn_s *conn)
 
 void tcp_cc_update(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp)
 {
-  /* After Fast retransmitted, set ssthresh to the maximum of
-   * the unacked and the 2*SMSS, and enter to Fast Recovery.
-   * ssthresh = max (FlightSize / 2, 2*SMSS) referring to rfc5681
+  /* After Fast retransmitted, let the algorithm set ssthresh and enter
+   * to Fast Recovery.
    * cwnd=ssthresh + 3*SMSS  referring to rfc5681
    */
 
   if (conn->flags & TCP_INFT)
     {
-      conn->ssthresh = MAX(conn->tx_unacked / 2, 2 * conn->mss);
+      conn->ssthresh = conn->cc_ops->ssthresh(conn);
       conn->cwnd = conn->ssthresh + 3 * conn->mss;
+      conn->cc_rtvalid = false;
 
       conn->flags &= ~TCP_INFT;
       conn->flags |= TCP_INFR;
@@ -236,12 +434,39 @@ void tcp_cc_recv_ack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp)
     {
       /* We come here when the ACK acknowledges new data. */
 
-      uint32_t acked = TCP_SEQ_SUB(ackno, conn->last_ackno);
+      struct tcp_cc_sample_s rs;
+
+      rs.acked = TCP_SEQ_SUB(ackno, conn->last_ackno);
+      rs.rtt   = 0;
+      rs.rate  = 0;
 
       /* Reset dupacks and update last_ackno. */
 
       conn->dupacks = 0;
       conn->last_ackno = ackno;
+      conn->cc_delivered += rs.acked;
+
+      /* Take the RTT and delivery rate sample once the timed segment is
+       * ACKed.
+       */
+
+      if (conn->cc_rtvalid && TCP_SEQ_GTE(ackno, conn->cc_rtseq))
+        {
+          clock_t elapsed = clock_systime_ticks() - conn->cc_rttime;
+          uint64_t rate;
+
+          rs.rtt = TICK2USEC(MAX(elapsed, 1));
+          rate   = (uint64_t)(conn->cc_delivered - conn->cc_rtdlvd) *
+                   USEC_PER_SEC / rs.rtt;
+          rs.rate = MIN(rate, UINT32_MAX);
+
+          conn->cc_rtvalid = false;
+        }
+
+      if (conn->cc_ops->sample != NULL)
+        {
+          conn->cc_ops->sample(conn, &rs);
+        }
 
       /* When the ackno covers more than the fr_recover, exit the
        * fast recovery. Then, reset the "IN Fast Recovery" flags.
@@ -269,34 +494,230 @@ void tcp_cc_recv_ack(FAR struct tcp_conn_s *conn, FAR struct tcp_hdr_s *tcp)
 
       if (conn->tcpstateflags >= TCP_ESTABLISHED)
         {
-          uint32_t increase;
+          conn->cc_ops->cong_avoid(conn, &rs);
+        }
+    }
+}
 
-          if (conn->cwnd < conn->ssthresh)
-            {
-              /* slow start (RFC 5681):
-               * Grow cwnd exponentially by maxseg(smss) per ACK.
-               */
+/****************************************************************************
+ * Name: tcp_cc_timeout
+ *
+ * Description:
+ *   Update the congestion control variables after a retransmission
+ *   timeout.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
 
-              increase = acked > 0 ? MIN(acked, conn->mss) : conn->mss;
+void tcp_cc_timeout(FAR struct tcp_conn_s *conn)
+{
+  /* If conn is TCP_INFR, it should enter to slow start */
 
-              CC_CWND_INC(conn->cwnd, increase);
-              ninfo("update slow start cwnd to %u\n", conn->cwnd);
-            }
-          else
-            {
-              /* cong avoid (RFC 5681):
-               * Grow cwnd linearly by approximately maxseg per RTT using
-               * maxseg^2 / cwnd per ACK as the increment.
-               * If cwnd > maxseg^2, fix the cwnd increment at 1 byte to
-               * avoid capping cwnd.
-               */
+  conn->flags &= ~TCP_INFR;
 
-              increase = MAX((conn->mss * conn->mss / conn->cwnd), 1);
+  /* update the max_cwnd */
 
-              CC_CWND_INC(conn->cwnd, increase);
-              conn->cwnd = MIN(conn->cwnd, conn->max_cwnd);
-              ninfo("update congestion avoidance cwnd to %u\n", conn->cwnd);
-            }
+  conn->max_cwnd = (conn->max_cwnd + 7 * conn->cwnd) >> 3;
+
+  /* reset cwnd and ssthresh, refers to RFC5861. */
+
+  conn->ssthresh = conn->cc_ops->ssthresh(conn);
+  conn->cwnd = conn->mss;
+
+  /* The ACK of a retransmitted segment says nothing about the RTT */
+
+  conn->cc_rtvalid = false;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_sent
+ *
+ * Description:
+ *   Account for a segment sent from the write buffers: start timing it if
+ *   no segment is timed yet and charge it to the pacing budget.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   seq    - The sequence number of the segment
+ *   len    - The length of the segment
+ *   rexmit - True if the segment is retransmitted
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_cc_sent(FAR struct tcp_conn_s *conn, uint32_t seq, uint32_t len,
+                 bool rexmit)
+{
+  if (rexmit)
+    {
+      /* Karn's algorithm: do not time across a retransmission */
+
+      conn->cc_rtvalid = false;
+    }
+  else if (!conn->cc_rtvalid)
+    {
+      conn->cc_rtseq       = seq + len;
+      conn->cc_rttime      = clock_systime_ticks();
+      conn->cc_rtdlvd      = conn->cc_delivered;
+      conn->cc_rtvalid     = true;
+    }
+
+#ifdef CONFIG_NET_TCP_CC_PACING
+  conn->cc_credit -= MIN(conn->cc_credit, len);
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_cc_pace
+ *
+ * Description:
+ *   Check whether the pacing rate allows to send len bytes now.  If not,
+ *   arrange for the device to be polled again when it does.
+ *
+ *   The credit is a token bucket that fills at the pacing rate and holds
+ *   at most one tick worth of data, but no less than two segments, so
+ *   that pacing does not depend on sub-tick timers.
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   len    - The length of the segment to send
+ *
+ * Returned Value:
+ *   True if the segment may be sent now.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_CC_PACING
+bool tcp_cc_pace(FAR struct tcp_conn_s *conn, uint32_t len)
+{
+  clock_t now;
+  clock_t elapsed;
+  uint64_t credit;
+  uint32_t burst;
+  uint32_t delay;
+
+  if (conn->cc_pacing == 0)
+    {
+      return true;
+    }
+
+  now     = clock_systime_ticks();
+  elapsed = MIN(now - conn->cc_pacetime, TICK_PER_SEC);
+  burst   = MAX(2 * conn->mss, conn->cc_pacing / TICK_PER_SEC);
+  burst   = MAX(burst, len);
+
+  if (elapsed > 0)
+    {
+      credit = conn->cc_credit +
+               (uint64_t)conn->cc_pacing * elapsed / TICK_PER_SEC;
+      conn->cc_credit   = MIN(credit, burst);
+      conn->cc_pacetime = now;
+    }
+
+  if (conn->cc_credit >= len)
+    {
+      return true;
+    }
+
+  /* Come back when the bucket holds enough for the segment */
+
+  if (work_available(&conn->cc_pacework))
+    {
+      delay = ((uint64_t)(len - conn->cc_credit) * TICK_PER_SEC +
+               conn->cc_pacing - 1) / conn->cc_pacing;
+      work_queue(LPWORK, &conn->cc_pacework, tcp_cc_pace_work, conn,
+                 MAX(delay, 1));
+    }
+
+  return false;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_stop
+ *
+ * Description:
+ *   Cancel the pending work of the congestion control when the connection
+ *   is freed.
+ *
+ ****************************************************************************/
+
+void tcp_cc_stop(FAR struct tcp_conn_s *conn)
+{
+  work_cancel(LPWORK, &conn->cc_pacework);
+}
+#endif
+
+/****************************************************************************
+ * Name: tcp_cc_setalgo
+ *
+ * Description:
+ *   Select the congestion control algorithm of a connection by name
+ *   (TCP_CONGESTION socket option).
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   name   - The name of the algorithm, not necessarily NUL terminated
+ *   len    - The maximum length of the name
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -ENOENT if there is no such algorithm.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+int tcp_cc_setalgo(FAR struct tcp_conn_s *conn, FAR const char *name,
+                   size_t len)
+{
+  FAR const struct tcp_cc_ops_s *ops;
+
+  ops = tcp_cc_find(name, strnlen(name, len));
+  if (ops == NULL)
+    {
+      return -ENOENT;
+    }
+
+  if (ops != conn->cc_ops)
+    {
+      conn->cc_ops = ops;
+
+      /* Before the connection is set up tcp_cc_init() does the rest */
+
+      if (conn->tcpstateflags >= TCP_ESTABLISHED)
+        {
+          tcp_cc_reset(conn);
         }
     }
+
+  return OK;
+}
+
+/****************************************************************************
+ * Name: tcp_cc_getalgo
+ *
+ * Description:
+ *   Return the name of the congestion control algorithm of a connection.
+ *
+ ****************************************************************************/
+
+FAR const char *tcp_cc_getalgo(FAR struct tcp_conn_s *conn)
+{
+  return conn->cc_ops != NULL ? conn->cc_ops->name : TCP_CC_DEFAULT->name;
 }
@@ -0,0 +1,339 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_bbr.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC_BBR
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Gains are in units of 1/256 */
+
+#define BBR_UNIT           256
+#define BBR_HIGH_GAIN      739    /* 2/ln(2), STARTUP pacing and cwnd */
+#define BBR_DRAIN_GAIN     89     /* ln(2)/2, DRAIN pacing */
+#define BBR_CWND_GAIN      512    /* cwnd after STARTUP */
+#define BBR_FULL_BW_GAIN   320    /* Growth STARTUP expects per round */
+
+/* STARTUP is over after this many rounds without the expected growth */
+
+#define BBR_FULL_BW_CNT    3
+
+/* The min RTT is refreshed in PROBE_RTT after this long */
+
+#define BBR_MINRTT_TICKS   (10 * TICK_PER_SEC)
+#define BBR_PROBERTT_TICKS MSEC2TICK(200)
+
+/* The smallest cwnd */
+
+#define BBR_MIN_CWND(conn) (4 * (conn)->mss)
+
+/* Modes */
+
+#define BBR_STARTUP        0
+#define BBR_DRAIN          1
+#define BBR_PROBE_BW       2
+#define BBR_PROBE_RTT      3
+
+/* The PROBE_BW gain cycle, one phase per min RTT */
+
+#define BBR_CYCLE_LEN      8
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static void tcp_bbr_init(FAR struct tcp_conn_s *conn);
+static uint32_t tcp_bbr_ssthresh(FAR struct tcp_conn_s *conn);
+static void tcp_bbr_cong_avoid(FAR struct tcp_conn_s *conn,
+                               FAR const struct tcp_cc_sample_s *rs);
+static void tcp_bbr_sample(FAR struct tcp_conn_s *conn,
+                           FAR const struct tcp_cc_sample_s *rs);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_bbr =
+{
+  "bbr",                        /* name */
+  tcp_bbr_init,                 /* init */
+  tcp_bbr_ssthresh,             /* ssthresh */
+  tcp_bbr_cong_avoid,           /* cong_avoid */
+  tcp_bbr_sample                /* sample */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const uint16_t g_bbr_cycle[BBR_CYCLE_LEN] =
+{
+  320, 192, 256, 256, 256, 256, 256, 256
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_bbr_bw
+ *
+ * Description:
+ *   The bottleneck bandwidth: the largest delivery rate of the last
+ *   TCP_BBR_BWROUNDS round trips.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_bbr_bw(FAR struct tcp_bbr_s *bbr)
+{
+  uint32_t bw = 0;
+  int i;
+
+  for (i = 0; i < TCP_BBR_BWROUNDS; i++)
+    {
+      bw = MAX(bw, bbr->bw[i]);
+    }
+
+  return bw;
+}
+
+/****************************************************************************
+ * Name: tcp_bbr_bdp
+ *
+ * Description:
+ *   The bandwidth delay product times gain, or 0 while it is unknown.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_bbr_bdp(FAR struct tcp_bbr_s *bbr, uint32_t gain)
+{
+  uint64_t bdp;
+
+  bdp = (uint64_t)tcp_bbr_bw(bbr) * bbr->minrtt / USEC_PER_SEC;
+  bdp = bdp * gain / BBR_UNIT;
+  return MIN(bdp, UINT32_MAX);
+}
+
+/****************************************************************************
+ * Name: tcp_bbr_full_bw
+ *
+ * Description:
+ *   Return true once STARTUP has filled the pipe.
+ *
+ ****************************************************************************/
+
+static bool tcp_bbr_full_bw(FAR struct tcp_bbr_s *bbr)
+{
+  return bbr->full_cnt >= BBR_FULL_BW_CNT;
+}
+
+/****************************************************************************
+ * Name: tcp_bbr_pacing_gain
+ ****************************************************************************/
+
+static uint32_t tcp_bbr_pacing_gain(FAR struct tcp_bbr_s *bbr)
+{
+  switch (bbr->mode)
+    {
+      case BBR_STARTUP:
+        return BBR_HIGH_GAIN;
+
+      case BBR_DRAIN:
+        return BBR_DRAIN_GAIN;
+
+      case BBR_PROBE_BW:
+        return g_bbr_cycle[bbr->cycle];
+
+      default:
+        return BBR_UNIT;
+    }
+}
+
+/****************************************************************************
+ * Name: tcp_bbr_init
+ ****************************************************************************/
+
+static void tcp_bbr_init(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_bbr_s *bbr = &conn->cc.bbr;
+
+  bbr->mode         = BBR_STARTUP;
+  bbr->minrtt_stamp = clock_systime_ticks();
+}
+
+/****************************************************************************
+ * Name: tcp_bbr_ssthresh
+ *
+ * Description:
+ *   BBR does not back off on loss; recovery just keeps the data in flight.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_bbr_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  return MAX(conn->tx_unacked, BBR_MIN_CWND(conn));
+}
+
+/****************************************************************************
+ * Name: tcp_bbr_sample
+ *
+ * Description:
+ *   Update the bandwidth and min RTT filters once per round trip and run
+ *   the state machine: STARTUP until the bandwidth stops growing, DRAIN
+ *   until the queue built in STARTUP is gone, then PROBE_BW, with a visit
+ *   to PROBE_RTT when the min RTT was not refreshed for 10 seconds.
+ *
+ ****************************************************************************/
+
+static void tcp_bbr_sample(FAR struct tcp_conn_s *conn,
+                           FAR const struct tcp_cc_sample_s *rs)
+{
+  FAR struct tcp_bbr_s *bbr = &conn->cc.bbr;
+  clock_t now = clock_systime_ticks();
+  bool expired;
+  uint32_t bw;
+
+  if (rs->rtt == 0)
+    {
+      return;
+    }
+
+  bbr->round++;
+  bbr->bw[bbr->round % TCP_BBR_BWROUNDS] = rs->rate;
+  bw = tcp_bbr_bw(bbr);
+
+  expired = now - bbr->minrtt_stamp > BBR_MINRTT_TICKS;
+  if (bbr->minrtt == 0 || rs->rtt <= bbr->minrtt ||
+      (expired && bbr->mode == BBR_PROBE_RTT))
+    {
+      bbr->minrtt       = rs->rtt;
+      bbr->minrtt_stamp = now;
+      expired           = false;
+    }
+
+  switch (bbr->mode)
+    {
+      case BBR_STARTUP:
+        if ((uint64_t)bw * BBR_UNIT >=
+            (uint64_t)bbr->full_bw * BBR_FULL_BW_GAIN)
+          {
+            bbr->full_bw  = bw;
+            bbr->full_cnt = 0;
+          }
+        else if (++bbr->full_cnt >= BBR_FULL_BW_CNT)
+          {
+            bbr->mode = BBR_DRAIN;
+          }
+        break;
+
+      case BBR_DRAIN:
+        if (conn->tx_unacked <= tcp_bbr_bdp(bbr, BBR_UNIT))
+          {
+            bbr->mode        = BBR_PROBE_BW;
+            bbr->cycle       = bbr->round % BBR_CYCLE_LEN;
+            bbr->cycle       = bbr->cycle == 1 ? 2 : bbr->cycle;
+            bbr->cycle_stamp = now;
+          }
+        break;
+
+      case BBR_PROBE_BW:
+        if (now - bbr->cycle_stamp > USEC2TICK(bbr->minrtt))
+          {
+            bbr->cycle       = (bbr->cycle + 1) % BBR_CYCLE_LEN;
+            bbr->cycle_stamp = now;
+          }
+        break;
+
+      case BBR_PROBE_RTT:
+        if ((sclock_t)(now - bbr->probertt_done) >= 0)
+          {
+            bbr->minrtt_stamp = now;
+            bbr->mode         = tcp_bbr_full_bw(bbr) ? BBR_PROBE_BW :
+                                                       BBR_STARTUP;
+            bbr->cycle_stamp  = now;
+            conn->cwnd        = MAX(conn->cwnd, bbr->prior_cwnd);
+          }
+        break;
+    }
+
+  if (expired && bbr->mode != BBR_PROBE_RTT)
+    {
+      bbr->mode          = BBR_PROBE_RTT;
+      bbr->prior_cwnd    = conn->cwnd;
+      bbr->probertt_done = now + BBR_PROBERTT_TICKS;
+    }
+
+  conn->cc_pacing = (uint64_t)bw * tcp_bbr_pacing_gain(bbr) / BBR_UNIT;
+  ninfo("bbr mode %u bw %" PRIu32 " minrtt %" PRIu32 " pacing %" PRIu32
+        "\n", bbr->mode, bw, bbr->minrtt, conn->cc_pacing);
+}
+
+/****************************************************************************
+ * Name: tcp_bbr_cong_avoid
+ *
+ * Description:
+ *   Grow cwnd by what was ACKed up to cwnd_gain times the BDP, or without
+ *   bound while STARTUP has not filled the pipe.
+ *
+ ****************************************************************************/
+
+static void tcp_bbr_cong_avoid(FAR struct tcp_conn_s *conn,
+                               FAR const struct tcp_cc_sample_s *rs)
+{
+  FAR struct tcp_bbr_s *bbr = &conn->cc.bbr;
+  uint32_t target;
+
+  if (bbr->mode == BBR_PROBE_RTT)
+    {
+      conn->cwnd = BBR_MIN_CWND(conn);
+      return;
+    }
+
+  target = tcp_bbr_bdp(bbr, bbr->mode == BBR_STARTUP ? BBR_HIGH_GAIN :
+                                                       BBR_CWND_GAIN);
+
+  conn->cwnd = MIN((uint64_t)conn->cwnd + rs->acked, UINT32_MAX);
+  if (tcp_bbr_full_bw(bbr) && target != 0)
+    {
+      conn->cwnd = MIN(conn->cwnd, target);
+    }
+
+  conn->cwnd = MAX(conn->cwnd, BBR_MIN_CWND(conn));
+}
+
+#endif /* CONFIG_NET_TCP_CC_BBR */
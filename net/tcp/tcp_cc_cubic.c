@@ -0,0 +1,222 @@
+/****************************************************************************
+ * net/tcp/tcp_cc_cubic.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <debug.h>
+
+#include <nuttx/clock.h>
+
+#include "tcp/tcp.h"
+
+#ifdef CONFIG_NET_TCP_CC_CUBIC
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* RFC 8312 constants: C = 0.4 segments/s^3 and beta = 0.7.  With the time
+ * in milliseconds, K^3 = (Wmax - cwnd) / C = (Wmax - cwnd) * 2.5e9 ms^3
+ * per segment.
+ */
+
+#define CUBIC_K3_SCALE     2500000000ull
+
+/* The cubic term is only evaluated up to 100 seconds from K, enough for
+ * the window to grow by 400000 segments.
+ */
+
+#define CUBIC_MAX_DELTA    100000
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static uint32_t tcp_cubic_ssthresh(FAR struct tcp_conn_s *conn);
+static void tcp_cubic_cong_avoid(FAR struct tcp_conn_s *conn,
+                                 FAR const struct tcp_cc_sample_s *rs);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+const struct tcp_cc_ops_s g_tcp_cc_cubic =
+{
+  "cubic",                      /* name */
+  NULL,                         /* init */
+  tcp_cubic_ssthresh,           /* ssthresh */
+  tcp_cubic_cong_avoid,         /* cong_avoid */
+  NULL                          /* sample */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_cubic_cbrt
+ *
+ * Description:
+ *   Integer cube root (Hacker's Delight, figure 11-5, widened to 64 bits).
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cubic_cbrt(uint64_t x)
+{
+  uint64_t y = 0;
+  uint64_t b;
+  int s;
+
+  for (s = 63; s >= 0; s -= 3)
+    {
+      y += y;
+      b  = 3 * y * (y + 1) + 1;
+      if ((x >> s) >= b)
+        {
+          x -= b << s;
+          y++;
+        }
+    }
+
+  return (uint32_t)y;
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_ssthresh
+ *
+ * Description:
+ *   Remember the window at the loss and reduce it by beta, with the fast
+ *   convergence of RFC 8312 section 4.6.
+ *
+ ****************************************************************************/
+
+static uint32_t tcp_cubic_ssthresh(FAR struct tcp_conn_s *conn)
+{
+  FAR struct tcp_cubic_s *cubic = &conn->cc.cubic;
+
+  if (conn->cwnd < cubic->wmax)
+    {
+      cubic->wmax = conn->cwnd * 17 / 20;
+    }
+  else
+    {
+      cubic->wmax = conn->cwnd;
+    }
+
+  cubic->epoch = 0;
+  return MAX(conn->cwnd * 7 / 10, 2 * conn->mss);
+}
+
+/****************************************************************************
+ * Name: tcp_cubic_cong_avoid
+ *
+ * Description:
+ *   Slow start below ssthresh, else grow cwnd towards the cubic function
+ *   W(t) = C * (t - K)^3 + Wmax, or the Reno friendly estimate if that is
+ *   larger (RFC 8312 sections 4.1 to 4.4).
+ *
+ ****************************************************************************/
+
+static void tcp_cubic_cong_avoid(FAR struct tcp_conn_s *conn,
+                                 FAR const struct tcp_cc_sample_s *rs)
+{
+  FAR struct tcp_cubic_s *cubic = &conn->cc.cubic;
+  clock_t now = clock_systime_ticks();
+  uint32_t increase;
+  uint32_t target;
+  uint64_t west;
+  int64_t delta;
+  int64_t wcubic;
+  int64_t t;
+
+  if (rs->rtt != 0 && (cubic->minrtt == 0 || rs->rtt < cubic->minrtt))
+    {
+      cubic->minrtt = rs->rtt;
+    }
+
+  if (conn->cwnd < conn->ssthresh)
+    {
+      increase = rs->acked > 0 ? MIN(rs->acked, conn->mss) : conn->mss;
+      conn->cwnd = MIN((uint64_t)conn->cwnd + increase, UINT32_MAX);
+      ninfo("update slow start cwnd to %u\n", conn->cwnd);
+      return;
+    }
+
+  /* Start a new epoch on the first ACK after a loss */
+
+  if (cubic->epoch == 0)
+    {
+      cubic->epoch = now;
+      if (conn->cwnd < cubic->wmax)
+        {
+          cubic->k = tcp_cubic_cbrt((uint64_t)(cubic->wmax - conn->cwnd) *
+                                    CUBIC_K3_SCALE / conn->mss);
+        }
+      else
+        {
+          cubic->k    = 0;
+          cubic->wmax = conn->cwnd;
+        }
+    }
+
+  /* The target is W(t + RTT), in bytes */
+
+  t     = TICK2MSEC(now - cubic->epoch) + cubic->minrtt / 1000;
+  delta = t - cubic->k;
+  delta = MIN(MAX(delta, -CUBIC_MAX_DELTA), CUBIC_MAX_DELTA);
+
+  wcubic = (int64_t)cubic->wmax +
+           delta * delta * delta / 1000 * 4 * conn->mss / 10000000;
+  wcubic = MAX(wcubic, (int64_t)conn->cwnd);
+  target = MIN(wcubic, (int64_t)conn->cwnd * 3 / 2);
+
+  /* The window standard TCP would have by now, W_est of section 4.2 */
+
+  if (cubic->minrtt >= 1000)
+    {
+      west = (uint64_t)cubic->wmax * 7 / 10 +
+             (uint64_t)conn->mss * 9 * t / (17 * (cubic->minrtt / 1000));
+      target = MAX(target, MIN(west, (uint64_t)conn->cwnd * 3 / 2));
+    }
+
+  if (target > conn->cwnd)
+    {
+      increase = (uint64_t)(target - conn->cwnd) * rs->acked / conn->cwnd;
+    }
+  else
+    {
+      /* Grow by one segment per 100 windows at the plateau */
+
+      increase = (uint64_t)conn->mss * rs->acked / (100 * conn->cwnd);
+    }
+
+  increase   = MAX(increase, 1);
+  conn->cwnd = MIN((uint64_t)conn->cwnd + increase, conn->max_cwnd);
+  ninfo("update cubic cwnd to %u target %u\n", conn->cwnd, target);
+}
+
+#endif /* CONFIG_NET_TCP_CC_CUBIC */
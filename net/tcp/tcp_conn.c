@@ -837,6 +837,12 @@ void tcp_free(FAR struct tcp_conn_s *conn)
 
   tcp_stop_timer(conn);
 
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+  /* Cancel the pacing work */
+
+  tcp_cc_stop(conn);
+#endif
+
   /* Make sure monitor is stopped. */
 
   tcp_stop_monitor(conn, TCP_CLOSE);
@@ -879,6 +885,12 @@ void tcp_free(FAR struct tcp_conn_s *conn)
       tcp_wrbuffer_release(wrbuffer);
     }
 
+#ifdef CONFIG_NET_ZEROCOPY
+  /* Sends still referenced by the driver complete without being reported */
+
+  net_zcopy_detach(&conn->sconn);
+#endif
+
 #if CONFIG_NET_SEND_BUFSIZE > 0
   /* Notify the send buffer available */
 
@@ -1131,8 +1143,11 @@ FAR struct tcp_conn_s *tcp_alloc_accept(FAR struct net_driver_s *dev,
 #endif
 
 #ifdef CONFIG_NET_TCP_CC_NEWRENO
-      /* Initialize the variables of congestion control */
+      /* Initialize the variables of congestion control, with the
+       * algorithm of the listener.
+       */
 
+      conn->cc_ops = listener->cc_ops;
       tcp_cc_init(conn);
 #endif
 
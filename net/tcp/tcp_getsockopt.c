@@ -28,6 +28,7 @@
 
 #include <sys/time.h>
 #include <stdint.h>
+#include <string.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -239,6 +240,37 @@ int tcp_getsockopt(FAR struct socket *psock, int option,
           }
         break;
 
+      case TCP_INFO:     /* Connection information */
+        {
+          struct tcp_info info;
+
+          net_lock();
+          tcp_getinfo(conn, &info);
+          net_unlock();
+
+          *value_len = MIN(*value_len, sizeof(info));
+          memcpy(value, &info, *value_len);
+          ret = OK;
+        }
+        break;
+
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+      case TCP_CONGESTION: /* Congestion control algorithm */
+        if (*value_len == 0)
+          {
+            ret = -EINVAL;
+          }
+        else
+          {
+            /* The name is truncated to the buffer, like Linux does */
+
+            strlcpy(value, tcp_cc_getalgo(conn), *value_len);
+            *value_len = MIN(*value_len, TCP_CA_NAME_MAX);
+            ret        = OK;
+          }
+        break;
+#endif
+
       default:
         nerr("ERROR: Unrecognized TCP option: %d\n", option);
         ret = -ENOPROTOOPT;
@@ -0,0 +1,126 @@
+/****************************************************************************
+ * net/tcp/tcp_info.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <stdint.h>
+#include <string.h>
+
+#include <netinet/tcp.h>
+
+#include <nuttx/clock.h>
+#include <nuttx/net/net.h>
+
+#include "tcp/tcp.h"
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: tcp_getinfo
+ *
+ * Description:
+ *   Fill a struct tcp_info with the state of a TCP connection.  This backs
+ *   the TCP_INFO socket option and the /proc/net/tcp view.
+ *
+ * Input Parameters:
+ *   conn - The TCP connection of interest
+ *   info - The location to return the information
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+void tcp_getinfo(FAR struct tcp_conn_s *conn, FAR struct tcp_info *info)
+{
+  memset(info, 0, sizeof(*info));
+
+  info->tcpi_state       = conn->tcpstateflags & TCP_STATE_MASK;
+  info->tcpi_rto         = conn->rto * USEC_PER_HSEC;
+  info->tcpi_snd_mss     = conn->mss;
+  info->tcpi_retransmits = conn->nrtx;
+  info->tcpi_unacked     = conn->tx_unacked;
+  info->tcpi_snd_wnd     = conn->snd_wnd;
+
+#ifdef CONFIG_NET_TCP_WINDOW_SCALE
+  if ((conn->flags & TCP_WSCALE) != 0)
+    {
+      info->tcpi_options   |= TCPI_OPT_WSCALE;
+      info->tcpi_snd_wscale = conn->snd_scale;
+      info->tcpi_rcv_wscale = conn->rcv_scale;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_SELECTIVE_ACK
+  if ((conn->flags & TCP_SACK) != 0)
+    {
+      info->tcpi_options |= TCPI_OPT_SACK;
+    }
+#endif
+
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+  if ((conn->flags & TCP_TSTAMP) != 0)
+    {
+      info->tcpi_options |= TCPI_OPT_TIMESTAMPS;
+    }
+
+  if (conn->srtt != 0)
+    {
+      info->tcpi_rtt    = (conn->srtt >> 3) * USEC_PER_MSEC;
+      info->tcpi_rttvar = (conn->rttvar >> 2) * USEC_PER_MSEC;
+    }
+  else
+#endif
+    {
+      /* The coarse estimation kept in half-seconds */
+
+      info->tcpi_rtt    = (conn->sa >> 3) * USEC_PER_HSEC;
+      info->tcpi_rttvar = (conn->sv >> 2) * USEC_PER_HSEC;
+    }
+
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+  info->tcpi_snd_cwnd     = conn->cwnd;
+  info->tcpi_snd_ssthresh = conn->ssthresh;
+#endif
+
+#if CONFIG_NET_SEND_BUFSIZE > 0
+  info->tcpi_snd_buf = tcp_wrbuffer_inqueue_size(conn);
+#endif
+
+  if (conn->readahead != NULL)
+    {
+      info->tcpi_rcv_buf = conn->readahead->io_pktlen;
+    }
+
+#ifdef CONFIG_NET_TCP_OUT_OF_ORDER
+  info->tcpi_ofo_segs = conn->nofosegs;
+#endif
+}
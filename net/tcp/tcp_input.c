@@ -554,6 +554,9 @@ static void tcp_parse_option(FAR struct net_driver_s *dev,
   unsigned int tcpiplen;
   uint16_t tmp16;
   uint8_t  opt;
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+  bool     tsopt = false;
+#endif
   int i;
 
   tcp = IPBUF(iplen);
@@ -615,6 +618,24 @@ static void tcp_parse_option(FAR struct net_driver_s *dev,
         {
           conn->flags    |= TCP_SACK;
         }
+#endif
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+      else if (opt == TCP_OPT_TS &&
+               IPDATA(tcpiplen + 1 + i) == TCP_OPT_TS_LEN)
+        {
+          /* Every segment carries the option from now on, which leaves
+           * that much less room for data.
+           */
+
+          if ((conn->flags & TCP_TSTAMP) == 0)
+            {
+              conn->flags |= TCP_TSTAMP;
+              tsopt        = true;
+            }
+
+          conn->ts_recent = tcp_getsequence(&IPDATA(tcpiplen + 2 + i));
+          conn->ts_stamp  = clock_systime_ticks();
+        }
 #endif
       else
         {
@@ -634,7 +655,79 @@ static void tcp_parse_option(FAR struct net_driver_s *dev,
 
       i += IPDATA(tcpiplen + 1 + i);
     }
+
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+  if (tsopt)
+    {
+      conn->mss -= TCP_OPT_TS_ALIGNED_LEN;
+    }
+#endif
+}
+
+/****************************************************************************
+ * Name: tcp_parse_timestamp
+ *
+ * Description:
+ *   Find the timestamps option of an incoming segment
+ *
+ * Input Parameters:
+ *   dev    - The device driver structure containing the received TCP packet.
+ *   iplen  - Length of the IP header (IPv4_HDRLEN or IPv6_HDRLEN).
+ *   tsval  - Returns the timestamp of the peer
+ *   tsecr  - Returns the timestamp echoed by the peer
+ *
+ * Returned Value:
+ *   True if the segment carries the option.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+static bool tcp_parse_timestamp(FAR struct net_driver_s *dev,
+                                unsigned int iplen, FAR uint32_t *tsval,
+                                FAR uint32_t *tsecr)
+{
+  FAR struct tcp_hdr_s *tcp = IPBUF(iplen);
+  unsigned int tcpiplen = iplen + TCP_HDRLEN;
+  int optlen = ((tcp->tcpoffset >> 4) - 5) << 2;
+  uint8_t opt;
+  int i;
+
+  for (i = 0; i < optlen; )
+    {
+      opt = IPDATA(tcpiplen + i);
+      if (opt == TCP_OPT_END)
+        {
+          break;
+        }
+      else if (opt == TCP_OPT_NOOP)
+        {
+          i++;
+          continue;
+        }
+      else if (i + 1 >= optlen || IPDATA(tcpiplen + 1 + i) < 2)
+        {
+          /* Malformed options */
+
+          break;
+        }
+      else if (opt == TCP_OPT_TS &&
+               IPDATA(tcpiplen + 1 + i) == TCP_OPT_TS_LEN &&
+               i + TCP_OPT_TS_LEN <= optlen)
+        {
+          *tsval = tcp_getsequence(&IPDATA(tcpiplen + 2 + i));
+          *tsecr = tcp_getsequence(&IPDATA(tcpiplen + 6 + i));
+          return true;
+        }
+
+      i += IPDATA(tcpiplen + 1 + i);
+    }
+
+  return false;
 }
+#endif
 
 /****************************************************************************
  * Name: tcp_clear_zero_probe
@@ -695,7 +788,10 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
   FAR struct tcp_conn_s *conn = NULL;
   FAR struct tcp_hdr_s *tcp;
   union ip_binding_u uaddr;
-  unsigned int tcpiplen;
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+  uint32_t tsval;
+  uint32_t tsecr = 0;
+#endif
   uint16_t tmp16;
   uint16_t flags;
   uint16_t result;
@@ -713,16 +809,6 @@ static void tcp_input(FAR struct net_driver_s *dev, uint8_t domain,
 
   tcp = IPBUF(iplen);
 
-  /* Get the size of the IP header and the TCP header.
-   *
-   * REVISIT:  TCP header is *not* a constant!  It can be larger if the
-   * TCP header includes options.  The constant TCP_HDRLEN should be
-   * replaced with the macro TCP_OPT_HDRLEN(n) which will calculate the
-   * correct header length in all cases.
-   */
-
-  tcpiplen = iplen + TCP_HDRLEN;
-
 #ifdef CONFIG_NET_TCP_CHECKSUMS
   /* Start of TCP input header processing code. */
 
@@ -934,6 +1020,40 @@ found:
       goto drop;
     }
 
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+  if ((conn->flags & TCP_TSTAMP) != 0 &&
+      tcp_parse_timestamp(dev, iplen, &tsval, &tsecr))
+    {
+      /* PAWS (RFC 7323, 5.3): a timestamp older than the last one is an
+       * old duplicate, unless the connection was idle for so long that
+       * the timestamp clock of the peer may have wrapped.  An RST is
+       * processed before the PAWS test and is never acknowledged.
+       */
+
+      if ((tcp->flags & TCP_RST) == 0 &&
+          TCP_SEQ_LT(tsval, conn->ts_recent) &&
+          clock_systime_ticks() - conn->ts_stamp < TCP_PAWS_IDLE)
+        {
+#ifdef CONFIG_NET_STATISTICS
+          g_netstats.tcp.drop++;
+#endif
+          tcp_send(dev, conn, TCP_ACK, tcpip_hdrsize(conn));
+          return;
+        }
+
+      /* Echo the timestamp of the segment that is next in sequence
+       * (RFC 7323, 4.3).
+       */
+
+      if (TCP_SEQ_LTE(tcp_getsequence(tcp->seqno),
+                      tcp_getsequence(conn->rcvseq)))
+        {
+          conn->ts_recent = tsval;
+          conn->ts_stamp  = clock_systime_ticks();
+        }
+    }
+#endif
+
   /* Calculated the length of the data, if the application has sent
    * any data to us.
    */
@@ -998,6 +1118,9 @@ found:
       uint32_t unackseq;
       uint32_t ackseq;
       int timeout;
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+      bool newack;
+#endif
 
       /* The next sequence number is equal to the current sequence
        * number (sndseq) plus the size of the outstanding, unacknowledged
@@ -1025,6 +1148,14 @@ found:
 
       ackseq = tcp_getsequence(tcp->ackno);
 
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+      /* Only an ACK of new data echoes the timestamp of the segment it
+       * acknowledges.
+       */
+
+      newack = TCP_SEQ_GT(ackseq, unackseq - conn->tx_unacked);
+#endif
+
       /* Check how many of the outstanding bytes have been acknowledged. For
        * most send operations, this should always be true.  However,
        * the send() API sends data ahead when it can without waiting for
@@ -1082,25 +1213,45 @@ found:
         }
 #endif
 
-      /* Do RTT estimation, unless we have done retransmissions. */
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+      /* With timestamps every ACK of new data is an RTT sample, even
+       * after retransmissions (RFC 7323, 4.1).
+       */
 
-      if (conn->nrtx == 0)
+      if ((conn->flags & TCP_TSTAMP) != 0)
         {
-          signed char m;
-          m = conn->rto - conn->timer;
-
-          /* This is taken directly from VJs original code in his paper */
+          uint32_t rtt = TCP_TSCLOCK() - tsecr;
 
-          m = m - (conn->sa >> 3);
-          conn->sa += m;
-          if (m < 0)
+          if (tsecr != 0 && newack && rtt < TCP_RTO_MAX * MSEC_PER_HSEC)
             {
-              m = -m;
+              tcp_update_rto(conn, rtt);
             }
+        }
+      else
+#endif
+        {
+          /* Do RTT estimation, unless we have done retransmissions. */
+
+          if (conn->nrtx == 0)
+            {
+              signed char m;
+              m = conn->rto - conn->timer;
 
-          m = m - (conn->sv >> 2);
-          conn->sv += m;
-          conn->rto = (conn->sa >> 3) + conn->sv;
+              /* This is taken directly from VJs original code in his
+               * paper
+               */
+
+              m = m - (conn->sa >> 3);
+              conn->sa += m;
+              if (m < 0)
+                {
+                  m = -m;
+                }
+
+              m = m - (conn->sv >> 2);
+              conn->sv += m;
+              conn->rto = (conn->sa >> 3) + conn->sv;
+            }
         }
 
       /* Set the acknowledged flag. */
@@ -1176,7 +1327,7 @@ found:
                    * E.g. a keep-alive segment.
                    */
 
-                  tcp_send(dev, conn, TCP_ACK, tcpiplen);
+                  tcp_send(dev, conn, TCP_ACK, tcpip_hdrsize(conn));
                   return;
                 }
             }
@@ -1189,7 +1340,7 @@ found:
 #endif
               if ((conn->tcpstateflags & TCP_STATE_MASK) <= TCP_ESTABLISHED)
                 {
-                  tcp_send(dev, conn, TCP_ACK, tcpiplen);
+                  tcp_send(dev, conn, TCP_ACK, tcpip_hdrsize(conn));
                   return;
                 }
             }
@@ -1416,7 +1567,7 @@ found:
                 conn->sndseq_max    = tcp_getsequence(conn->sndseq) + 1;
 #endif
                 ninfo("TCP state: TCP_LAST_ACK\n");
-                tcp_send(dev, conn, TCP_FIN | TCP_ACK, tcpiplen);
+                tcp_send(dev, conn, TCP_FIN | TCP_ACK, tcpip_hdrsize(conn));
               }
             else
               {
@@ -1597,7 +1748,7 @@ found:
 
             net_incr32(conn->rcvseq, 1); /* ack FIN */
             tcp_callback(dev, conn, TCP_CLOSE);
-            tcp_send(dev, conn, TCP_ACK, tcpiplen);
+            tcp_send(dev, conn, TCP_ACK, tcpip_hdrsize(conn));
             return;
           }
         else if ((flags & TCP_ACKDATA) != 0 && conn->tx_unacked == 0)
@@ -1644,7 +1795,7 @@ found:
 
             net_incr32(conn->rcvseq, 1); /* ack FIN */
             tcp_callback(dev, conn, TCP_CLOSE);
-            tcp_send(dev, conn, TCP_ACK, tcpiplen);
+            tcp_send(dev, conn, TCP_ACK, tcpip_hdrsize(conn));
             return;
           }
 
@@ -1669,7 +1820,7 @@ found:
         goto drop;
 
       case TCP_TIME_WAIT:
-        tcp_send(dev, conn, TCP_ACK, tcpiplen);
+        tcp_send(dev, conn, TCP_ACK, tcpip_hdrsize(conn));
         return;
 
       case TCP_CLOSING:
@@ -40,6 +40,7 @@
 #include "socket/socket.h"
 #include "inet/inet.h"
 #include "tcp/tcp.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Private Functions
@@ -159,6 +160,15 @@ static uint16_t tcp_poll_eventhandler(FAR struct net_driver_s *dev,
           eventset |= POLLOUT;
         }
 
+#ifdef CONFIG_NET_ZEROCOPY
+      /* Completed MSG_ZEROCOPY sends wait in the error queue */
+
+      if (net_zcopy_pending(&info->conn->sconn))
+        {
+          eventset |= POLLERR;
+        }
+#endif
+
       /* Awaken the caller of poll() if requested event occurred. */
 
       poll_notify(&info->fds, 1, eventset);
@@ -259,6 +269,9 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
    */
 
   cb->flags = TCP_DISCONN_EVENTS;
+#ifdef CONFIG_NET_ZEROCOPY
+  cb->flags |= SOCK_ERRQUEUE;
+#endif
   cb->priv  = info;
   cb->event = tcp_poll_eventhandler;
 
@@ -354,6 +367,15 @@ int tcp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
       eventset |= POLLWRNORM;
     }
 
+#ifdef CONFIG_NET_ZEROCOPY
+  /* Completed MSG_ZEROCOPY sends wait in the error queue */
+
+  if (net_zcopy_pending(&conn->sconn))
+    {
+      eventset |= POLLERR;
+    }
+#endif
+
   /* Check if any requested events are already in effect */
 
   poll_notify(&fds, 1, eventset);
@@ -807,13 +807,26 @@ static ssize_t tcp_recvfrom_one(FAR struct tcp_conn_s *conn, FAR void *buf,
           info.tc_sem  = &state.ir_sem;
           tls_cleanup_push(tls_get_info(), tcp_callback_cleanup, &info);
 
-          /* Wait for either the receive to complete or for an
-           * error/timeout to occur.  net_sem_timedwait will also
-           * terminate if a signal is received.
+#ifdef CONFIG_NET_BUSY_POLL
+          /* Poll the device ourselves for a while before going to sleep,
+           * tcp_recvhandler() posts ir_sem when the receive is complete.
            */
 
-          ret = net_sem_timedwait(&state.ir_sem,
-                              _SO_TIMEOUT(conn->sconn.s_rcvtimeo));
+          ret = netdev_busypoll(conn->dev, &state.ir_sem,
+                                conn->sconn.s_busypoll,
+                                _SO_TIMEOUT(conn->sconn.s_rcvtimeo));
+          if (ret >= 0)
+#endif
+            {
+              /* Wait for either the receive to complete or for an
+               * error/timeout to occur.  net_sem_timedwait will also
+               * terminate if a signal is received.
+               */
+
+              ret = net_sem_timedwait(&state.ir_sem,
+                                      _SO_TIMEOUT(conn->sconn.s_rcvtimeo));
+            }
+
           tls_cleanup_pop(tls_get_info(), 0);
           if (ret == -ETIMEDOUT)
             {
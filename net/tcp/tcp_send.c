@@ -258,6 +258,36 @@ static void tcp_sendcommon(FAR struct net_driver_s *dev,
 #endif
 }
 
+/****************************************************************************
+ * Name: tcp_tsopt
+ *
+ * Description:
+ *   Write the timestamps option, preceded by two NOOPs, to optdata.
+ *
+ * Input Parameters:
+ *   conn    - The TCP connection structure holding connection information
+ *   optdata - Where to write the option
+ *   tsecr   - The timestamp to echo
+ *
+ * Returned Value:
+ *   The length of the option (TCP_OPT_TS_ALIGNED_LEN)
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+static int tcp_tsopt(FAR struct tcp_conn_s *conn, FAR uint8_t *optdata,
+                     uint32_t tsecr)
+{
+  optdata[0] = TCP_OPT_NOOP;
+  optdata[1] = TCP_OPT_NOOP;
+  optdata[2] = TCP_OPT_TS;
+  optdata[3] = TCP_OPT_TS_LEN;
+  tcp_setsequence(&optdata[4], TCP_TSCLOCK());
+  tcp_setsequence(&optdata[8], tsecr);
+  return TCP_OPT_TS_ALIGNED_LEN;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -287,6 +317,7 @@ void tcp_send(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
               uint16_t flags, uint16_t len)
 {
   FAR struct tcp_hdr_s *tcp;
+  int tsoptlen = 0;
 
   if (dev->d_iob == NULL)
     {
@@ -297,38 +328,60 @@ void tcp_send(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
   tcp->flags = flags;
   dev->d_len = len;
 
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+  /* Every segment carries the timestamps, len already accounts for them
+   * (see tcpip_hdrsize()).
+   */
+
+  if ((conn->flags & TCP_TSTAMP) != 0)
+    {
+      tsoptlen = tcp_tsopt(conn, tcp->optdata, conn->ts_recent);
+    }
+#endif
+
 #ifdef CONFIG_NET_TCP_SELECTIVE_ACK
   if ((conn->flags & TCP_SACK) && (flags == TCP_ACK) && conn->nofosegs > 0)
     {
-      int optlen = conn->nofosegs * sizeof(struct tcp_sack_s);
+      FAR uint8_t *optdata = &tcp->optdata[tsoptlen];
+      int nsacks = conn->nofosegs;
+      int optlen;
       int i;
 
-      tcp->optdata[0] = TCP_OPT_NOOP;
-      tcp->optdata[1] = TCP_OPT_NOOP;
-      tcp->optdata[2] = TCP_OPT_SACK;
-      tcp->optdata[3] = TCP_OPT_SACK_PERM_LEN + optlen;
+      /* Only three blocks fit into the options next to the timestamps */
+
+      if (tsoptlen > 0 && nsacks > 3)
+        {
+          nsacks = 3;
+        }
+
+      optlen = nsacks * sizeof(struct tcp_sack_s);
+
+      optdata[0] = TCP_OPT_NOOP;
+      optdata[1] = TCP_OPT_NOOP;
+      optdata[2] = TCP_OPT_SACK;
+      optdata[3] = TCP_OPT_SACK_PERM_LEN + optlen;
 
       optlen += 4;
 
-      for (i = 0; i < conn->nofosegs; i++)
+      for (i = 0; i < nsacks; i++)
         {
           ninfo("TCP SACK [%d]"
                 "[%" PRIu32 " : %" PRIu32 " : %" PRIu32 "]\n", i,
                 conn->ofosegs[i].left, conn->ofosegs[i].right,
                 TCP_SEQ_SUB(conn->ofosegs[i].right, conn->ofosegs[i].left));
-          tcp_setsequence(&tcp->optdata[4 + i * 2 * sizeof(uint32_t)],
+          tcp_setsequence(&optdata[4 + i * 2 * sizeof(uint32_t)],
                           conn->ofosegs[i].left);
-          tcp_setsequence(&tcp->optdata[4 + (i * 2 + 1) * sizeof(uint32_t)],
+          tcp_setsequence(&optdata[4 + (i * 2 + 1) * sizeof(uint32_t)],
                           conn->ofosegs[i].right);
         }
 
       dev->d_len += optlen;
-      tcp->tcpoffset = ((TCP_HDRLEN + optlen) / 4) << 4;
+      tcp->tcpoffset = ((TCP_HDRLEN + tsoptlen + optlen) / 4) << 4;
     }
   else
 #endif /* CONFIG_NET_TCP_SELECTIVE_ACK */
     {
-      tcp->tcpoffset = (TCP_HDRLEN / 4) << 4;
+      tcp->tcpoffset = ((TCP_HDRLEN + tsoptlen) / 4) << 4;
     }
 
   tcp_sendcommon(dev, conn, tcp);
@@ -607,9 +660,11 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
 
   tcp = tcp_header(dev);
 
-  /* Set the packet length for the TCP Maximum Segment Size */
+  /* Set the packet length for the TCP Maximum Segment Size, the options
+   * are added below.
+   */
 
-  dev->d_len = tcpip_hdrsize(conn);
+  dev->d_len = tcpip_hdrsize(conn) - TCP_TSOPT_LEN(conn);
 
   /* Set the packet length for the TCP Maximum Segment Size */
 
@@ -657,6 +712,21 @@ void tcp_synack(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn,
     }
 #endif
 
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+  /* Offer the timestamps in our SYN, keep them if the peer offered them
+   * too.  There is nothing to echo in a SYN (RFC 7323, 3.2).
+   */
+
+  if (tcp->flags == TCP_SYN)
+    {
+      optlen += tcp_tsopt(conn, &tcp->optdata[optlen], 0);
+    }
+  else if ((conn->flags & TCP_TSTAMP) != 0)
+    {
+      optlen += tcp_tsopt(conn, &tcp->optdata[optlen], conn->ts_recent);
+    }
+#endif
+
   tcp->tcpoffset         = ((TCP_HDRLEN + optlen) / 4) << 4;
   dev->d_len            += optlen;
 
@@ -728,7 +798,7 @@ void tcp_send_txnotify(FAR struct socket *psock,
 
 uint16_t tcpip_hdrsize(FAR struct tcp_conn_s *conn)
 {
-  uint16_t hdrsize = sizeof(struct tcp_hdr_s);
+  uint16_t hdrsize = sizeof(struct tcp_hdr_s) + TCP_TSOPT_LEN(conn);
 
   UNUSED(conn);
   return net_ip_domain_select(conn->domain,
@@ -778,9 +778,10 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
             }
 
 #ifdef CONFIG_NET_TCP_CC_NEWRENO
-          /* After Fast retransmitted, set ssthresh to the maximum of
-           * the unacked and the 2*SMSS, and enter to Fast Recovery.
-           * ssthresh = max (FlightSize / 2, 2*SMSS) referring to rfc5681
+          tcp_cc_sent(conn, TCP_WBSEQNO(wrb), sndlen, true);
+
+          /* After Fast retransmitted, let the congestion control set
+           * ssthresh and enter to Fast Recovery.
            * cwnd=ssthresh + 3*SMSS  referring to rfc5681
            */
 
@@ -850,9 +851,8 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
         }
 
 #ifdef CONFIG_NET_TCP_CC_NEWRENO
-          /* After Fast retransmitted, set ssthresh to the maximum of
-           * the unacked and the 2*SMSS, and enter to Fast Recovery.
-           * ssthresh = max (FlightSize / 2, 2*SMSS) referring to rfc5681
+          /* After Fast retransmitted, let the congestion control set
+           * ssthresh and enter to Fast Recovery.
            * cwnd=ssthresh + 3*SMSS  referring to rfc5681
            */
 
@@ -1067,6 +1067,15 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
               sndlen = CONFIG_IOB_BUFSIZE;
             }
 
+#ifdef CONFIG_NET_TCP_CC_PACING
+          /* Hold the segment back if it would exceed the pacing rate */
+
+          if (!tcp_cc_pace(conn, sndlen))
+            {
+              return flags;
+            }
+#endif
+
           ninfo("SEND: wrb=%p seq=%" PRIu32 " pktlen=%u sent=%u sndlen=%zu "
                 "mss=%u snd_wnd=%" PRIu32 " seq=%" PRIu32
                 " remaining_snd_wnd=%" PRIu32 "\n",
@@ -1113,6 +1122,12 @@ static uint16_t psock_send_eventhandler(FAR struct net_driver_s *dev,
               return flags;
             }
 
+#ifdef CONFIG_NET_TCP_CC_NEWRENO
+          /* Time the segment and charge it to the pacing rate */
+
+          tcp_cc_sent(conn, seq, sndlen, TCP_WBNRTX(wrb) > 0);
+#endif
+
           /* Remember how much data we send out now so that we know
            * when everything has been acknowledged.  Just increment
            * the amount of data sent. This will be needed in sequence
@@ -1315,6 +1330,9 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
   FAR struct tcp_conn_s *conn;
   FAR struct tcp_wrbuffer_s *wrb;
   FAR const uint8_t *cp;
+#ifdef CONFIG_NET_ZEROCOPY
+  FAR struct net_zcopy_s *zc = NULL;
+#endif
   unsigned int timeout;
   ssize_t    result = 0;
   bool       nonblock;
@@ -1378,6 +1396,21 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
 
   BUF_DUMP("psock_tcp_send", buf, len);
 
+#ifdef CONFIG_NET_ZEROCOPY
+  /* A MSG_ZEROCOPY send queues I/O buffers that refer to the user data */
+
+  if ((flags & MSG_ZEROCOPY) != 0 &&
+      _SO_GETOPT(conn->sconn.s_options, SO_ZEROCOPY))
+    {
+      zc = net_zcopy_alloc(&conn->sconn);
+      if (zc == NULL)
+        {
+          ret = -ENOBUFS;
+          goto errout;
+        }
+    }
+#endif
+
   cp = buf;
   while (len > 0)
     {
@@ -1546,6 +1579,29 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
            * remaining data.
            */
 
+#ifdef CONFIG_NET_ZEROCOPY
+          /* Queue the user data by reference if we can, and copy it if
+           * we cannot.
+           */
+
+          iob = zc != NULL ? net_zcopy_iob(zc, cp, chunk_len) : NULL;
+          if (iob != NULL)
+            {
+              if (off == 0)
+                {
+                  iob_free_chain(wrb->wb_iob);
+                  wrb->wb_iob = iob;
+                }
+              else
+                {
+                  iob_concat(wrb->wb_iob, iob);
+                }
+
+              chunk_result = chunk_len;
+              break;
+            }
+#endif
+
           chunk_result = TCP_WBTRYCOPYIN(wrb, cp, chunk_len, off);
           if (chunk_result == -ENOMEM)
             {
@@ -1671,6 +1727,13 @@ ssize_t psock_tcp_send(FAR struct socket *psock, FAR const void *buf,
       goto errout;
     }
 
+#ifdef CONFIG_NET_ZEROCOPY
+  if (zc != NULL)
+    {
+      net_zcopy_release(zc, result);
+    }
+#endif
+
   /* Return the number of bytes actually sent */
 
   return result;
@@ -1679,6 +1742,13 @@ errout_with_lock:
   net_unlock();
 
 errout:
+#ifdef CONFIG_NET_ZEROCOPY
+  if (zc != NULL)
+    {
+      net_zcopy_release(zc, result > 0 ? result : ret);
+    }
+#endif
+
   if (result > 0)
     {
       return result;
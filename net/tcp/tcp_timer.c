@@ -290,6 +290,63 @@ void tcp_update_retrantimer(FAR struct tcp_conn_s *conn, int timeout)
   tcp_update_timer(conn);
 }
 
+/****************************************************************************
+ * Name: tcp_update_rto
+ *
+ * Description:
+ *   Update the smoothed RTT, the RTT variation and the retransmission
+ *   timeout with an RTT sample (RFC 6298).
+ *
+ * Input Parameters:
+ *   conn   - The TCP connection of interest
+ *   rtt    - The RTT sample (units: milliseconds)
+ *
+ * Returned Value:
+ *   None
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_NET_TCP_TIMESTAMP
+void tcp_update_rto(FAR struct tcp_conn_s *conn, uint32_t rtt)
+{
+  int32_t m = rtt;
+  uint32_t rto;
+
+  if (conn->srtt == 0)
+    {
+      /* The first measurement: SRTT = R, RTTVAR = R/2 */
+
+      conn->srtt   = m << 3;
+      conn->rttvar = m << 1;
+    }
+  else
+    {
+      /* SRTT += (R - SRTT) / 8, RTTVAR += (|R - SRTT| - RTTVAR) / 4 */
+
+      m -= conn->srtt >> 3;
+      conn->srtt += m;
+      if (m < 0)
+        {
+          m = -m;
+        }
+
+      m -= conn->rttvar >> 2;
+      conn->rttvar += m;
+    }
+
+  /* RTO = SRTT + max(G, 4 * RTTVAR), with the clock granularity G of the
+   * retransmission timer, a half-second.
+   */
+
+  rto = (conn->srtt >> 3) + MAX(conn->rttvar, MSEC_PER_HSEC);
+  rto = (rto + MSEC_PER_HSEC - 1) / MSEC_PER_HSEC;
+  conn->rto = MIN(MAX(rto, TCP_RTO_MIN), TCP_RTO_MAX);
+}
+#endif
+
 /****************************************************************************
  * Name: tcp_update_keeptimer
  *
@@ -633,22 +690,7 @@ void tcp_timer(FAR struct net_driver_s *dev, FAR struct tcp_conn_s *conn)
                     tcp_rexmit(dev, conn, result);
 
 #ifdef CONFIG_NET_TCP_CC_NEWRENO
-                    /* If conn is TCP_INFR, it should enter to slow start */
-
-                    if (conn->flags & TCP_INFR)
-                      {
-                        conn->flags &= ~TCP_INFR;
-                      }
-
-                    /* update the max_cwnd */
-
-                    conn->max_cwnd = (conn->max_cwnd + 7 * conn->cwnd) >> 3;
-
-                    /* reset cwnd and ssthresh, refers to RFC5861. */
-
-                    conn->ssthresh =
-                                    MAX(conn->tx_unacked / 2, 2 * conn->mss);
-                    conn->cwnd = conn->mss;
+                    tcp_cc_timeout(conn);
 #endif
                     goto done;
 
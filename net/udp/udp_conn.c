@@ -642,6 +642,12 @@ void udp_free(FAR struct udp_conn_s *conn)
       udp_wrbuffer_release(wrbuffer);
     }
 
+#ifdef CONFIG_NET_ZEROCOPY
+  /* Sends still referenced by the driver complete without being reported */
+
+  net_zcopy_detach(&conn->sconn);
+#endif
+
 #if CONFIG_NET_SEND_BUFSIZE > 0
   /* Notify the send buffer available */
 
@@ -38,6 +38,7 @@
 #include "netdev/netdev.h"
 #include "socket/socket.h"
 #include "udp/udp.h"
+#include "utils/utils.h"
 
 /****************************************************************************
  * Private Functions
@@ -99,6 +100,15 @@ static uint16_t udp_poll_eventhandler(FAR struct net_driver_s *dev,
           eventset |= POLLOUT;
         }
 
+#ifdef CONFIG_NET_ZEROCOPY
+      /* Completed MSG_ZEROCOPY sends wait in the error queue */
+
+      if (net_zcopy_pending(&info->conn->sconn))
+        {
+          eventset |= POLLERR;
+        }
+#endif
+
       /* Awaken the caller of poll() is requested event occurred. */
 
       poll_notify(&info->fds, 1, eventset);
@@ -189,6 +199,9 @@ int udp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
    */
 
   cb->flags = NETDEV_DOWN;
+#ifdef CONFIG_NET_ZEROCOPY
+  cb->flags |= SOCK_ERRQUEUE;
+#endif
   cb->priv  = info;
   cb->event = udp_poll_eventhandler;
 
@@ -224,6 +237,15 @@ int udp_pollsetup(FAR struct socket *psock, FAR struct pollfd *fds)
       eventset |= POLLWRNORM;
     }
 
+#ifdef CONFIG_NET_ZEROCOPY
+  /* Completed MSG_ZEROCOPY sends wait in the error queue */
+
+  if (net_zcopy_pending(&conn->sconn))
+    {
+      eventset |= POLLERR;
+    }
+#endif
+
   /* Check if any requested events are already in effect */
 
   poll_notify(&fds, 1, eventset);
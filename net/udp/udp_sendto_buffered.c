@@ -548,6 +548,10 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
 {
   FAR struct udp_wrbuffer_s *wrb;
   FAR struct udp_conn_s *conn;
+#ifdef CONFIG_NET_ZEROCOPY
+  FAR struct net_zcopy_s *zc = NULL;
+  FAR struct iob_s *iob = NULL;
+#endif
   unsigned int timeout;
   uint16_t udpiplen;
   bool nonblock;
@@ -813,31 +817,58 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
       iob_reserve(wrb->wb_iob, CONFIG_NET_LL_GUARDSIZE);
       iob_update_pktlen(wrb->wb_iob, udpiplen, false);
 
-      /* Copy the user data into the write buffer.  We cannot wait for
-       * buffer space if the socket was opened non-blocking.
+#ifdef CONFIG_NET_ZEROCOPY
+      /* A MSG_ZEROCOPY send hands I/O buffers that refer to the user data
+       * to the driver.  The data is copied if they cannot be allocated.
        */
 
-      if (nonblock)
+      if ((flags & MSG_ZEROCOPY) != 0 &&
+          _SO_GETOPT(conn->sconn.s_options, SO_ZEROCOPY))
         {
-          ret = iob_trycopyin(wrb->wb_iob, (FAR uint8_t *)buf,
-                              len, udpiplen, false);
+          zc = net_zcopy_alloc(&conn->sconn);
+          if (zc == NULL)
+            {
+              ret = -ENOBUFS;
+              goto errout_with_wrb;
+            }
+
+          iob = net_zcopy_iob(zc, buf, len);
+        }
+
+      if (iob != NULL)
+        {
+          iob_concat(wrb->wb_iob, iob);
+          ret = OK;
         }
       else
+#endif
         {
-          unsigned int count;
-          int blresult;
-
-          /* iob_copyin might wait for buffers to be freed, but if
-           * network is locked this might never happen, since network
-           * driver is also locked, therefore we need to break the lock
+          /* Copy the user data into the write buffer.  We cannot wait for
+           * buffer space if the socket was opened non-blocking.
            */
 
-          blresult = net_breaklock(&count);
-          ret = iob_copyin(wrb->wb_iob, (FAR uint8_t *)buf,
-                           len, udpiplen, false);
-          if (blresult >= 0)
+          if (nonblock)
+            {
+              ret = iob_trycopyin(wrb->wb_iob, (FAR uint8_t *)buf,
+                                  len, udpiplen, false);
+            }
+          else
             {
-              net_restorelock(count);
+              unsigned int count;
+              int blresult;
+
+              /* iob_copyin might wait for buffers to be freed, but if
+               * network is locked this might never happen, since network
+               * driver is also locked, therefore we need to break the lock
+               */
+
+              blresult = net_breaklock(&count);
+              ret = iob_copyin(wrb->wb_iob, (FAR uint8_t *)buf,
+                               len, udpiplen, false);
+              if (blresult >= 0)
+                {
+                  net_restorelock(count);
+                }
             }
         }
 
@@ -887,6 +918,13 @@ ssize_t psock_udp_sendto(FAR struct socket *psock, FAR const void *buf,
       net_unlock();
     }
 
+#ifdef CONFIG_NET_ZEROCOPY
+  if (zc != NULL)
+    {
+      net_zcopy_release(zc, len);
+    }
+#endif
+
   /* Return the number of bytes that will be sent */
 
   return len;
@@ -896,6 +934,14 @@ errout_with_wrb:
 
 errout_with_lock:
   net_unlock();
+
+#ifdef CONFIG_NET_ZEROCOPY
+  if (zc != NULL)
+    {
+      net_zcopy_release(zc, ret);
+    }
+#endif
+
   return ret;
 }
 
@@ -0,0 +1,491 @@
+/****************************************************************************
+ * net/utils/net_zerocopy.c
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.  The
+ * ASF licenses this file to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance with the
+ * License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.  See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <nuttx/config.h>
+
+#include <sys/param.h>
+#include <sys/socket.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+
+#include <netinet/in.h>
+
+#include <nuttx/kmalloc.h>
+#include <nuttx/queue.h>
+#include <nuttx/spinlock.h>
+#include <nuttx/wqueue.h>
+#include <nuttx/mm/iob.h>
+#include <nuttx/net/net.h>
+
+#include "devif/devif.h"
+#include "tcp/tcp.h"
+#include "udp/udp.h"
+#include "utils/utils.h"
+
+#ifdef CONFIG_NET_ZEROCOPY
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The most user data that one I/O buffer refers to */
+
+#define ZCOPY_MAXSLICE UINT16_MAX
+
+/* The work queue that tells the pollers of completions */
+
+#define ZCOPY_WORK     LPWORK
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One MSG_ZEROCOPY send.  It is referenced by the sender until the send
+ * returns and by every I/O buffer that refers to its data.
+ */
+
+struct net_zcopy_s
+{
+  dq_entry_t node;                /* Link in g_zcopy_list */
+  FAR struct socket_conn_s *conn; /* The socket, NULL once it is freed */
+  uint32_t id;                    /* The id of the send */
+  unsigned int refs;              /* The number of references */
+  bool shared;                    /* Some data was passed by reference */
+  bool copied;                    /* Some data was copied */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* All sends still in flight, oldest first.  The lock also protects the
+ * completion state of the sockets, I/O buffers may be freed from any
+ * context.
+ */
+
+static dq_queue_t g_zcopy_list;
+static spinlock_t g_zcopy_lock = SP_UNLOCKED;
+
+/* Completions may come from driver context, the pollers are woken up from
+ * the work queue.
+ */
+
+static struct work_s g_zcopy_work;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_zcopy_wakeup
+ *
+ * Description:
+ *   Raise SOCK_ERRQUEUE on a socket if completions arrived since its
+ *   pollers were last woken up.
+ *
+ * Assumptions:
+ *   The network is locked.
+ *
+ ****************************************************************************/
+
+static void net_zcopy_wakeup(FAR struct socket_conn_s *conn)
+{
+  irqstate_t flags;
+  bool notify;
+
+  flags = spin_lock_irqsave(&g_zcopy_lock);
+  notify = conn->s_zcnotify;
+  conn->s_zcnotify = false;
+  spin_unlock_irqrestore(&g_zcopy_lock, flags);
+
+  if (notify)
+    {
+      devif_conn_event(NULL, SOCK_ERRQUEUE, conn->list);
+    }
+}
+
+/****************************************************************************
+ * Name: net_zcopy_notify
+ *
+ * Description:
+ *   The work that wakes up the pollers of the sockets with new
+ *   completions.  Only live connections are visited, so the flag of a
+ *   freed socket is never looked at.
+ *
+ ****************************************************************************/
+
+static void net_zcopy_notify(FAR void *arg)
+{
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+  FAR struct tcp_conn_s *tcp = NULL;
+#endif
+#ifdef CONFIG_NET_UDP_WRITE_BUFFERS
+  FAR struct udp_conn_s *udp = NULL;
+#endif
+
+  net_lock();
+
+#ifdef CONFIG_NET_TCP_WRITE_BUFFERS
+  while ((tcp = tcp_nextconn(tcp)) != NULL)
+    {
+      net_zcopy_wakeup(&tcp->sconn);
+    }
+#endif
+
+#ifdef CONFIG_NET_UDP_WRITE_BUFFERS
+  while ((udp = udp_nextconn(udp)) != NULL)
+    {
+      net_zcopy_wakeup(&udp->sconn);
+    }
+#endif
+
+  net_unlock();
+}
+
+/****************************************************************************
+ * Name: net_zcopy_put
+ *
+ * Description:
+ *   Drop a reference to a send.  The last reference completes the send:
+ *   sends are reported in order, so everything before the oldest send of
+ *   the socket that is still in flight is complete.
+ *
+ ****************************************************************************/
+
+static void net_zcopy_put(FAR struct net_zcopy_s *zc)
+{
+  FAR struct socket_conn_s *conn;
+  FAR dq_entry_t *entry;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_zcopy_lock);
+
+  if (--zc->refs > 0)
+    {
+      spin_unlock_irqrestore(&g_zcopy_lock, flags);
+      return;
+    }
+
+  dq_rem(&zc->node, &g_zcopy_list);
+
+  conn = zc->conn;
+  if (conn != NULL)
+    {
+      if (zc->copied)
+        {
+          conn->s_zccopied = true;
+        }
+
+      conn->s_zcdone = conn->s_zcnext;
+      for (entry = dq_peek(&g_zcopy_list); entry; entry = dq_next(entry))
+        {
+          FAR struct net_zcopy_s *other = (FAR struct net_zcopy_s *)entry;
+
+          if (other->conn == conn)
+            {
+              conn->s_zcdone = other->id;
+              break;
+            }
+        }
+
+      /* Tell the pollers that the error queue is readable */
+
+      if (conn->s_zcdone != conn->s_zcread)
+        {
+          conn->s_zcnotify = true;
+          if (work_available(&g_zcopy_work))
+            {
+              work_queue(ZCOPY_WORK, &g_zcopy_work, net_zcopy_notify,
+                         NULL, 0);
+            }
+        }
+    }
+
+  spin_unlock_irqrestore(&g_zcopy_lock, flags);
+  kmm_free(zc);
+}
+
+/****************************************************************************
+ * Name: net_zcopy_iobfree
+ *
+ * Description:
+ *   The free callback of the I/O buffers that refer to user data.
+ *
+ ****************************************************************************/
+
+static void net_zcopy_iobfree(FAR void *priv)
+{
+  net_zcopy_put(priv);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: net_zcopy_alloc
+ *
+ * Description:
+ *   Start a MSG_ZEROCOPY send on a socket and give it the next id.
+ *
+ * Input Parameters:
+ *   conn - The socket connection
+ *
+ * Returned Value:
+ *   The send, or NULL if out of memory.
+ *
+ ****************************************************************************/
+
+FAR struct net_zcopy_s *net_zcopy_alloc(FAR struct socket_conn_s *conn)
+{
+  FAR struct net_zcopy_s *zc;
+  irqstate_t flags;
+
+  zc = kmm_zalloc(sizeof(struct net_zcopy_s));
+  if (zc == NULL)
+    {
+      return NULL;
+    }
+
+  zc->conn = conn;
+  zc->refs = 1;
+
+  flags = spin_lock_irqsave(&g_zcopy_lock);
+  zc->id = conn->s_zcnext++;
+  dq_addlast(&zc->node, &g_zcopy_list);
+  spin_unlock_irqrestore(&g_zcopy_lock, flags);
+
+  return zc;
+}
+
+/****************************************************************************
+ * Name: net_zcopy_iob
+ *
+ * Description:
+ *   Build an I/O buffer chain that refers to user data of a send instead
+ *   of holding a copy of it.
+ *
+ * Input Parameters:
+ *   zc  - The send
+ *   buf - The user data
+ *   len - The length of the user data
+ *
+ * Returned Value:
+ *   The I/O buffer chain, or NULL if out of memory.  The caller must copy
+ *   the data then, which is reported with the completion.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *net_zcopy_iob(FAR struct net_zcopy_s *zc,
+                                FAR const void *buf, unsigned int len)
+{
+  FAR const uint8_t *data = buf;
+  FAR struct iob_s *head = NULL;
+  FAR struct iob_s *tail = NULL;
+  FAR struct iob_s *iob;
+  unsigned int slice;
+  irqstate_t flags;
+
+  while (len > 0)
+    {
+      slice = MIN(len, ZCOPY_MAXSLICE);
+      iob   = iob_alloc_with_data((FAR void *)data, slice,
+                                  net_zcopy_iobfree);
+      if (iob == NULL)
+        {
+          iob_free_chain(head);
+          zc->copied = true;
+          return NULL;
+        }
+
+      flags = spin_lock_irqsave(&g_zcopy_lock);
+      zc->refs++;
+      spin_unlock_irqrestore(&g_zcopy_lock, flags);
+
+      iob->io_priv = zc;
+      iob->io_len  = slice;
+
+      if (head == NULL)
+        {
+          head = iob;
+        }
+      else
+        {
+          tail->io_flink = iob;
+        }
+
+      tail             = iob;
+      head->io_pktlen += slice;
+      data            += slice;
+      len             -= slice;
+    }
+
+  zc->shared = true;
+  return head;
+}
+
+/****************************************************************************
+ * Name: net_zcopy_release
+ *
+ * Description:
+ *   Drop the reference of the sender when the send returns.  A send that
+ *   queued nothing gives its id back.
+ *
+ * Input Parameters:
+ *   zc   - The send
+ *   sent - The return value of the send
+ *
+ ****************************************************************************/
+
+void net_zcopy_release(FAR struct net_zcopy_s *zc, ssize_t sent)
+{
+  FAR struct socket_conn_s *conn;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_zcopy_lock);
+
+  conn = zc->conn;
+  if (sent <= 0 && zc->refs == 1 && conn != NULL &&
+      zc->id + 1 == conn->s_zcnext)
+    {
+      conn->s_zcnext--;
+      zc->conn = NULL;
+    }
+  else if (!zc->shared)
+    {
+      zc->copied = true;
+    }
+
+  spin_unlock_irqrestore(&g_zcopy_lock, flags);
+  net_zcopy_put(zc);
+}
+
+/****************************************************************************
+ * Name: net_zcopy_detach
+ *
+ * Description:
+ *   Forget a socket that is being freed.  Its sends that are still in
+ *   flight complete without being reported.
+ *
+ * Input Parameters:
+ *   conn - The socket connection
+ *
+ ****************************************************************************/
+
+void net_zcopy_detach(FAR struct socket_conn_s *conn)
+{
+  FAR dq_entry_t *entry;
+  irqstate_t flags;
+
+  flags = spin_lock_irqsave(&g_zcopy_lock);
+
+  for (entry = dq_peek(&g_zcopy_list); entry; entry = dq_next(entry))
+    {
+      FAR struct net_zcopy_s *zc = (FAR struct net_zcopy_s *)entry;
+
+      if (zc->conn == conn)
+        {
+          zc->conn = NULL;
+        }
+    }
+
+  spin_unlock_irqrestore(&g_zcopy_lock, flags);
+}
+
+/****************************************************************************
+ * Name: net_zcopy_recverr
+ *
+ * Description:
+ *   Implement recvmsg(MSG_ERRQUEUE): return the range of completed sends
+ *   that were not reported yet as IP_RECVERR or IPV6_RECVERR control
+ *   message.
+ *
+ * Input Parameters:
+ *   psock - The socket
+ *   msg   - The message to return the control message in
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EAGAIN if no completion is pending; -EINVAL if
+ *   msg_control is too small.
+ *
+ ****************************************************************************/
+
+int net_zcopy_recverr(FAR struct socket *psock, FAR struct msghdr *msg)
+{
+  FAR struct socket_conn_s *conn = psock->s_conn;
+  struct sock_extended_err ee;
+  irqstate_t flags;
+  int level = SOL_IP;
+  int type = IP_RECVERR;
+
+  memset(&ee, 0, sizeof(ee));
+
+  flags = spin_lock_irqsave(&g_zcopy_lock);
+
+  if (conn->s_zcread == conn->s_zcdone)
+    {
+      spin_unlock_irqrestore(&g_zcopy_lock, flags);
+      return -EAGAIN;
+    }
+
+  ee.ee_origin = SO_EE_ORIGIN_ZEROCOPY;
+  ee.ee_code   = conn->s_zccopied ? SO_EE_CODE_ZEROCOPY_COPIED : 0;
+  ee.ee_info   = conn->s_zcread;
+  ee.ee_data   = conn->s_zcdone - 1;
+
+  spin_unlock_irqrestore(&g_zcopy_lock, flags);
+
+#ifdef CONFIG_NET_IPv6
+  if (psock->s_domain == PF_INET6)
+    {
+      level = SOL_IPV6;
+      type  = IPV6_RECVERR;
+    }
+#endif
+
+  if (cmsg_append(msg, level, type, &ee, sizeof(ee)) == NULL)
+    {
+      return -EINVAL;
+    }
+
+  /* Only now consume what was reported, more may have completed since */
+
+  flags = spin_lock_irqsave(&g_zcopy_lock);
+
+  conn->s_zcread = ee.ee_data + 1;
+  if (conn->s_zcread == conn->s_zcdone)
+    {
+      conn->s_zccopied = false;
+    }
+
+  spin_unlock_irqrestore(&g_zcopy_lock, flags);
+
+  msg->msg_flags |= MSG_ERRQUEUE;
+  return OK;
+}
+
+#endif /* CONFIG_NET_ZEROCOPY */
@@ -40,6 +40,14 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* True if MSG_ZEROCOPY sends completed that recvmsg(MSG_ERRQUEUE) did not
+ * report yet.
+ */
+
+#ifdef CONFIG_NET_ZEROCOPY
+#  define net_zcopy_pending(c) ((c)->s_zcread != (c)->s_zcdone)
+#endif
+
 /* Some utils for port selection */
 
 #define NET_PORT_RANDOM_INIT(port) \
@@ -153,6 +161,8 @@ extern "C"
 
 struct net_driver_s;      /* Forward reference */
 struct timeval;           /* Forward reference */
+struct iob_s;             /* Forward reference */
+struct net_zcopy_s;       /* Forward reference */
 
 /****************************************************************************
  * Name: net_breaklock
@@ -562,6 +572,76 @@ uint16_t icmpv6_chksum(FAR struct net_driver_s *dev, unsigned int iplen);
 FAR void *cmsg_append(FAR struct msghdr *msg, int level, int type,
                       FAR void *value, int value_len);
 
+#ifdef CONFIG_NET_ZEROCOPY
+
+/****************************************************************************
+ * Name: net_zcopy_alloc
+ *
+ * Description:
+ *   Start a MSG_ZEROCOPY send on a socket and give it the next id.  The
+ *   caller must call net_zcopy_release() when the send returns.
+ *
+ * Returned Value:
+ *   The send, or NULL if out of memory.
+ *
+ ****************************************************************************/
+
+FAR struct net_zcopy_s *net_zcopy_alloc(FAR struct socket_conn_s *conn);
+
+/****************************************************************************
+ * Name: net_zcopy_iob
+ *
+ * Description:
+ *   Build an I/O buffer chain that refers to len bytes of user data at buf
+ *   instead of holding a copy of it.  The send completes when the last of
+ *   these I/O buffers is freed.
+ *
+ * Returned Value:
+ *   The I/O buffer chain, or NULL if out of memory.  The caller must copy
+ *   the data then.
+ *
+ ****************************************************************************/
+
+FAR struct iob_s *net_zcopy_iob(FAR struct net_zcopy_s *zc,
+                                FAR const void *buf, unsigned int len);
+
+/****************************************************************************
+ * Name: net_zcopy_release
+ *
+ * Description:
+ *   Drop the reference of the sender, sent is the return value of the
+ *   send.  A send that queued nothing gives its id back.
+ *
+ ****************************************************************************/
+
+void net_zcopy_release(FAR struct net_zcopy_s *zc, ssize_t sent);
+
+/****************************************************************************
+ * Name: net_zcopy_detach
+ *
+ * Description:
+ *   Forget a socket connection that is being freed.
+ *
+ ****************************************************************************/
+
+void net_zcopy_detach(FAR struct socket_conn_s *conn);
+
+/****************************************************************************
+ * Name: net_zcopy_recverr
+ *
+ * Description:
+ *   Implement recvmsg(MSG_ERRQUEUE) for MSG_ZEROCOPY completions.
+ *
+ * Returned Value:
+ *   Zero (OK) on success; -EAGAIN if no completion is pending; -EINVAL if
+ *   msg_control is too small.
+ *
+ ****************************************************************************/
+
+int net_zcopy_recverr(FAR struct socket *psock, FAR struct msghdr *msg);
+
+#endif /* CONFIG_NET_ZEROCOPY */
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -30,6 +30,7 @@
 
 #include <nuttx/sched.h>
 #include <nuttx/clock.h>
+#include <nuttx/mutex.h>
 #include <nuttx/sched_note.h>
 
 #include "irq/irq.h"
@@ -37,6 +38,14 @@
 
 #if defined(CONFIG_SCHED_RESUMESCHEDULER)
 
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+#ifdef NXMUTEX_SPIN
+atomic_t g_running_pids[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -76,6 +85,10 @@ void nxsched_resume_scheduler(FAR struct tcb_s *tcb)
 #ifdef CONFIG_SCHED_INSTRUMENTATION
   sched_note_resume(tcb);
 #endif
+
+#ifdef NXMUTEX_SPIN
+  atomic_set(&g_running_pids[this_cpu()], tcb->pid);
+#endif
 }
 
 #endif /* CONFIG_SCHED_RESUMESCHEDULER */
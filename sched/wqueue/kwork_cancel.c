@@ -110,7 +110,7 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, bool sync,
  ****************************************************************************/
 
 /****************************************************************************
- * Name: work_cancel/work_cancel_wq
+ * Name: work_cancel/work_cancel_wq/work_cancel_on
  *
  * Description:
  *   Cancel previously queued work.  This removes work from the work queue.
@@ -120,6 +120,7 @@ static int work_qcancel(FAR struct kwork_wqueue_s *wqueue, bool sync,
  * Input Parameters:
  *   qid    - The work queue ID (must be HPWORK or LPWORK)
  *   wqueue - The work queue handle
+ *   cpu    - The CPU whose work queue holds the work
  *   work   - The previously queued work structure to cancel
  *
  * Returned Value:
@@ -141,6 +142,13 @@ int work_cancel_wq(FAR struct kwork_wqueue_s *wqueue,
   return work_qcancel(wqueue, false, work);
 }
 
+#ifdef CONFIG_SCHED_CPUWORK
+int work_cancel_on(int cpu, FAR struct work_s *work)
+{
+  return work_qcancel(work_cpu2wq(cpu), false, work);
+}
+#endif
+
 /****************************************************************************
  * Name: work_cancel_sync/work_cancel_sync_wq
  *
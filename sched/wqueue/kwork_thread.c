@@ -85,7 +85,7 @@ struct hp_wqueue_s g_hpwork =
 {
   {
     LIST_INITIAL_VALUE(g_hpwork.wq.expired),
-    LIST_INITIAL_VALUE(g_hpwork.wq.pending),
+    WORK_PENDING_INITIALIZER(g_hpwork.wq.pending),
     SEM_INITIALIZER(0),
     SEM_INITIALIZER(0),
     SP_UNLOCKED,
@@ -102,7 +102,7 @@ struct lp_wqueue_s g_lpwork =
 {
   {
     LIST_INITIAL_VALUE(g_lpwork.wq.expired),
-    LIST_INITIAL_VALUE(g_lpwork.wq.pending),
+    WORK_PENDING_INITIALIZER(g_lpwork.wq.pending),
     SEM_INITIALIZER(0),
     SEM_INITIALIZER(0),
     SP_UNLOCKED,
@@ -112,15 +112,24 @@ struct lp_wqueue_s g_lpwork =
 
 #endif /* CONFIG_SCHED_LPWORK */
 
+#ifdef CONFIG_SCHED_CPUWORK
+/* The kernel mode work queue of each CPU. */
+
+FAR struct kwork_wqueue_s *g_cpuwork[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_WQUEUE_PENDING_TREE
+RB_GENERATE(work_tree_s, work_s, entry, work_compare)
+#endif
+
 static inline_function
 void work_dispatch(FAR struct kwork_wqueue_s *wq)
 {
   FAR struct work_s *work;
-  FAR struct work_s *next;
   unsigned int count = 0;
   clock_t      ticks = clock_systime_ticks();
 
@@ -133,7 +142,7 @@ void work_dispatch(FAR struct kwork_wqueue_s *wq)
    * In this case we should not wake up any worker thread.
    */
 
-  list_for_every_entry_safe(&wq->pending, work, next, struct work_s, node)
+  while ((work = work_pending_first(wq)) != NULL)
     {
       /* Check whether the work has expired. */
 
@@ -146,7 +155,11 @@ void work_dispatch(FAR struct kwork_wqueue_s *wq)
 
       /* Expired work will be moved to tail of the expired queue. */
 
+#ifdef CONFIG_WQUEUE_PENDING_TREE
+      RB_REMOVE(work_tree_s, &wq->pending, work);
+#else
       list_delete(&work->node);
+#endif
       list_add_tail(&wq->expired, &work->node);
 
       /* Note that the thread execution this function is also
@@ -419,7 +432,11 @@ FAR struct kwork_wqueue_s *work_queue_create(FAR const char *name,
   /* Initialize the work queue structure */
 
   list_initialize(&wqueue->expired);
+#ifdef CONFIG_WQUEUE_PENDING_TREE
+  RB_INIT(&wqueue->pending);
+#else
   list_initialize(&wqueue->pending);
+#endif
   wqueue->timer.func = NULL;
   nxsem_init(&wqueue->sem, 0, 0);
   nxsem_init(&wqueue->exsem, 0, 0);
@@ -588,4 +605,61 @@ int work_start_lowpri(void)
 }
 #endif /* CONFIG_SCHED_LPWORK */
 
+/****************************************************************************
+ * Name: work_start_cpu
+ *
+ * Description:
+ *   Start the per-CPU, kernel-mode work queues, one worker thread for each
+ *   CPU, pinned to it.
+ *
+ * Input Parameters:
+ *   None
+ *
+ * Returned Value:
+ *   Return zero (OK) on success.  A negated errno value is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPUWORK
+int work_start_cpu(void)
+{
+  FAR struct kworker_s *worker;
+  cpu_set_t cpuset;
+  char name[16];
+  int ret;
+  int cpu;
+
+  sinfo("Starting per-CPU kernel worker threads\n");
+
+  for (cpu = 0; cpu < CONFIG_SMP_NCPUS; cpu++)
+    {
+      snprintf(name, sizeof(name), CPUWORKNAME, cpu);
+      g_cpuwork[cpu] = work_queue_create(name, CONFIG_SCHED_CPUWORKPRIORITY,
+                                         NULL, CONFIG_SCHED_CPUWORKSTACKSIZE,
+                                         1);
+      if (g_cpuwork[cpu] == NULL)
+        {
+          serr("ERROR: Failed to create %s\n", name);
+          return -ENOMEM;
+        }
+
+      /* The worker only waits on its semaphore until it is pinned */
+
+      CPU_ZERO(&cpuset);
+      CPU_SET(cpu, &cpuset);
+
+      worker = wq_get_worker(g_cpuwork[cpu]);
+      ret = nxsched_set_affinity(worker->pid, sizeof(cpuset), &cpuset);
+      if (ret < 0)
+        {
+          serr("ERROR: Failed to pin %s: %d\n", name, ret);
+          return ret;
+        }
+    }
+
+  return OK;
+}
+#endif /* CONFIG_SCHED_CPUWORK */
+
 #endif /* CONFIG_SCHED_WORKQUEUE */
@@ -47,6 +47,7 @@
 
 #define HPWORKNAME "hpwork"
 #define LPWORKNAME "lpwork"
+#define CPUWORKNAME "cpuwork%d"
 
 /* Get the worker structure from the work queue.
  * This function requires the workers are located next to the wqueue.
@@ -69,12 +70,25 @@ struct kworker_s
   int16_t           wait_count;
 };
 
+/* The pending (delayed) work of a queue, ordered by expiry time */
+
+#ifdef CONFIG_WQUEUE_PENDING_TREE
+RB_HEAD(work_tree_s, work_s);
+#  define WORK_PENDING_INITIALIZER(pending) RB_INITIALIZER(&(pending))
+#else
+#  define WORK_PENDING_INITIALIZER(pending) LIST_INITIAL_VALUE(pending)
+#endif
+
 /* This structure defines the state of one kernel-mode work queue */
 
 struct kwork_wqueue_s
 {
   struct list_node expired;   /* The queue of expired work. */
+#ifdef CONFIG_WQUEUE_PENDING_TREE
+  struct work_tree_s pending; /* The tree of pending work. */
+#else
   struct list_node pending;   /* The queue of pending work. */
+#endif
   sem_t            sem;       /* The counting semaphore of the wqueue */
   sem_t            exsem;     /* Sync waiting for thread exit */
   spinlock_t       lock;      /* Spinlock */
@@ -129,10 +143,29 @@ extern struct hp_wqueue_s g_hpwork;
 extern struct lp_wqueue_s g_lpwork;
 #endif
 
+#ifdef CONFIG_SCHED_CPUWORK
+/* The kernel mode work queue of each CPU. */
+
+extern FAR struct kwork_wqueue_s *g_cpuwork[CONFIG_SMP_NCPUS];
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
 
+#ifdef CONFIG_WQUEUE_PENDING_TREE
+/* Order by expiry time.  Equal times never compare equal, so that new work
+ * is placed after work that was queued earlier for the same time.
+ */
+
+static inline int work_compare(FAR struct work_s *a, FAR struct work_s *b)
+{
+  return clock_compare(b->qtime, a->qtime) ? 1 : -1;
+}
+
+RB_PROTOTYPE(work_tree_s, work_s, entry, work_compare)
+#endif
+
 static inline_function FAR struct kwork_wqueue_s *work_qid2wq(int qid)
 {
 #ifdef CONFIG_SCHED_HPWORK
@@ -154,6 +187,36 @@ static inline_function FAR struct kwork_wqueue_s *work_qid2wq(int qid)
     }
 }
 
+#ifdef CONFIG_SCHED_CPUWORK
+static inline_function FAR struct kwork_wqueue_s *work_cpu2wq(int cpu)
+{
+  return cpu >= 0 && cpu < CONFIG_SMP_NCPUS ? g_cpuwork[cpu] : NULL;
+}
+#endif
+
+/****************************************************************************
+ * Name: work_pending_first
+ *
+ * Description:
+ *   Return the pending work that expires first, or NULL.
+ *
+ ****************************************************************************/
+
+static inline_function
+FAR struct work_s *work_pending_first(FAR struct kwork_wqueue_s *wqueue)
+{
+#ifdef CONFIG_WQUEUE_PENDING_TREE
+  return RB_MIN(work_tree_s, &wqueue->pending);
+#else
+  if (list_is_empty(&wqueue->pending))
+    {
+      return NULL;
+    }
+
+  return list_first_entry(&wqueue->pending, struct work_s, node);
+#endif
+}
+
 /****************************************************************************
  * Name: work_insert_pending
  *
@@ -174,6 +237,12 @@ static inline_function
 bool work_insert_pending(FAR struct kwork_wqueue_s *wqueue,
                          FAR struct work_s         *work)
 {
+#ifdef CONFIG_WQUEUE_PENDING_TREE
+  DEBUGASSERT(wqueue != NULL && work != NULL);
+
+  RB_INSERT(work_tree_s, &wqueue->pending, work);
+  return work_pending_first(wqueue) == work;
+#else
   FAR struct work_s *curr;
   FAR struct work_s *head;
 
@@ -207,6 +276,7 @@ bool work_insert_pending(FAR struct kwork_wqueue_s *wqueue,
    */
 
   return curr == head;
+#endif
 }
 
 /****************************************************************************
@@ -231,13 +301,25 @@ bool work_remove(FAR struct kwork_wqueue_s *wqueue,
 {
   FAR struct work_s *head;
 
-  head = list_first_entry(&wqueue->pending, struct work_s, node);
+  head = work_pending_first(wqueue);
 
   /* Seize the ownership from the work thread. */
 
   work->worker = NULL;
 
+#ifdef CONFIG_WQUEUE_PENDING_TREE
+  /* Work on the expired list is linked there, pending work is not */
+
+  if (list_in_list(&work->node))
+    {
+      list_delete(&work->node);
+      return false;
+    }
+
+  RB_REMOVE(work_tree_s, &wqueue->pending, work);
+#else
   list_delete(&work->node);
+#endif
 
   return head == work;
 }
@@ -273,12 +355,10 @@ void work_timer_expired(wdparm_t arg);
 static inline_function
 void work_timer_reset(FAR struct kwork_wqueue_s *wqueue)
 {
-  if (!list_is_empty(&wqueue->pending))
-    {
-      FAR struct work_s *work;
-
-      work = list_first_entry(&wqueue->pending, struct work_s, node);
+  FAR struct work_s *work = work_pending_first(wqueue);
 
+  if (work != NULL)
+    {
       wd_start_abstick(&wqueue->timer, work->qtime,
                        work_timer_expired, (wdparm_t)wqueue);
     }
@@ -326,6 +406,22 @@ int work_start_highpri(void);
 int work_start_lowpri(void);
 #endif
 
+/****************************************************************************
+ * Name: work_start_cpu
+ *
+ * Description:
+ *   Start the per-CPU, kernel-mode work queues.
+ *
+ * Returned Value:
+ *   Return zero (OK) on success.  A negated errno value is returned on
+ *   failure.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPUWORK
+int work_start_cpu(void);
+#endif
+
 /****************************************************************************
  * Name: work_initialize_notifier
  *